@@ -0,0 +1,357 @@
+#include <iostream>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <string>
+#include <sstream>
+
+#include "signal_processing/signal_processing.hpp"
+
+#include "../fourier_transform/utils.hpp"
+
+using namespace sp::jpeg;
+
+/**
+ * Smallest and largest sides (powers of 2) of the synthetic square images: 2^8 ... 2^12.
+ */
+constexpr size_t MIN_POW = 8;
+constexpr size_t MAX_POW = 12;
+
+/**
+ * The DCT methods under test, with their names.
+ */
+const std::vector<std::pair<DCTMethod, std::string>> METHODS = {
+    {DCTMethod::FLOAT, "float"},
+    {DCTMethod::ISLOW, "islow"},
+    {DCTMethod::IFAST, "ifast"}
+};
+
+/**
+ * Generate a synthetic grayscale image: smooth gradients and waves (low frequencies)
+ * plus uniform noise (high frequencies), rounded to integers in [0, 255].
+ *
+ * @param side The side of the square image.
+ * @param seed The seed of the noise.
+ * @return The image matrix.
+ */
+std::vector<std::vector<double>> generateImage(const size_t side, const int seed = 42) {
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<double> noise(-12.0, 12.0);
+    std::vector<std::vector<double>> image(side, std::vector<double>(side));
+    for (size_t r = 0; r < side; ++r) {
+        for (size_t c = 0; c < side; ++c) {
+            const double x = static_cast<double>(c) / static_cast<double>(side);
+            const double y = static_cast<double>(r) / static_cast<double>(side);
+            const double value = 128.0 + 60.0 * (x - y) + 40.0 * std::sin(40.0 * x) * std::cos(25.0 * y) + noise(engine);
+            image[r][c] = std::round(std::min(255.0, std::max(0.0, value)));
+        }
+    }
+    return image;
+}
+
+/**
+ * Peak signal-to-noise ratio between two images, in dB (peak 255).
+ * The decoded pixels are clamped to [0, 255], as when saved to PNG.
+ *
+ * @param original The original image.
+ * @param decoded The decoded image.
+ * @return The PSNR, in dB.
+ */
+double psnr(const std::vector<std::vector<double>>& original, const std::vector<std::vector<double>>& decoded) {
+    double squaredError = 0.0;
+    size_t count = 0;
+    for (size_t r = 0; r < original.size(); ++r) {
+        for (size_t c = 0; c < original[r].size(); ++c) {
+            const double error = original[r][c] - std::min(255.0, std::max(0.0, decoded[r][c]));
+            squaredError += error * error;
+            ++count;
+        }
+    }
+    const double mse = squaredError / static_cast<double>(count);
+    return mse == 0.0 ? INFINITY : 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+
+/**
+ * Register the compression and decompression benchmarks of an image for every DCT method.
+ *
+ * Each benchmark reports the throughput (pixels per second) and the PSNR of the round trip
+ * (compressed and decompressed with the same method). compress_to_binary is the single-pass
+ * encoder, up to the bytes of the compressed binary file (zigzag + RLE); to_jpeg is the Huffman
+ * entropy coding of the .jpg file, which also reports the bits per pixel, and read_jpeg its decoding
+ * as a single segment (serial) or as stripes of one row of blocks (restart markers, concurrent).
+ * to_jpeg_with_size is the whole encoder with the rate control (half of the bytes of the default quality),
+ * decode_scaled the decoding of the file (with restart markers) at 1/1, 1/2, 1/4 and 1/8 of the resolution
+ * (the video codecs are registered by registerVideoBenchmarks).
+ *
+ * @param label The label of the image in the benchmark names.
+ * @param image The image matrix.
+ */
+void registerBenchmarks(const std::string& label, const std::vector<std::vector<double>>& image) {
+    const auto pixels = static_cast<int64_t>(image.size() * image[0].size());
+    for (const auto& entry : METHODS) {
+        const DCTMethod method = entry.first;
+        const std::string& methodName = entry.second;
+
+        // the quality of the round trip does not depend on the timing, compute it once
+        Image original(image);
+        CompressedImage compressed = original.compress(method);
+        const double quality = psnr(image, compressed.decompress(method).to_matrix());
+
+        // ReSharper disable once CppDFAUnusedValue
+        benchmark::RegisterBenchmark(("compress/" + methodName + "/" + label).c_str(), [=](benchmark::State& state) {
+            Image input(image);
+            for (auto _ : state) {
+                auto output = input.compress(method);
+                benchmark::DoNotOptimize(output);
+            }
+            state.SetItemsProcessed(state.iterations() * pixels);
+            state.counters["psnr"] = quality;
+        })->Unit(benchmark::kMillisecond);
+
+        // ReSharper disable once CppDFAUnusedValue
+        benchmark::RegisterBenchmark(("compress_to_binary/" + methodName + "/" + label).c_str(), [=](benchmark::State& state) {
+            Image input(image);
+            for (auto _ : state) {
+                auto output = input.compress_to_binary(method);
+                benchmark::DoNotOptimize(output.data());
+            }
+            state.SetItemsProcessed(state.iterations() * pixels);
+            state.counters["psnr"] = quality;
+        })->Unit(benchmark::kMillisecond);
+
+        // ReSharper disable once CppDFAUnusedValue
+        benchmark::RegisterBenchmark(("decompress/" + methodName + "/" + label).c_str(), [=](benchmark::State& state) {
+            CompressedImage input = compressed;
+            for (auto _ : state) {
+                auto output = input.decompress(method);
+                benchmark::DoNotOptimize(output);
+            }
+            state.SetItemsProcessed(state.iterations() * pixels);
+            state.counters["psnr"] = quality;
+        })->Unit(benchmark::kMillisecond);
+    }
+
+    // the entropy coding does not depend on the DCT method
+    const CompressedImage compressed = Image(image).compress();
+    for (const bool optimizeHuffman : {false, true}) {
+        const double bitsPerPixel = 8.0 * compressed.to_jpeg(optimizeHuffman).size() / pixels;
+        const std::string name = optimizeHuffman ? "optimized" : "standard";
+
+        // ReSharper disable once CppDFAUnusedValue
+        benchmark::RegisterBenchmark(("to_jpeg/" + name + "/" + label).c_str(), [=](benchmark::State& state) {
+            for (auto _ : state) {
+                auto output = compressed.to_jpeg(optimizeHuffman);
+                benchmark::DoNotOptimize(output.data());
+            }
+            state.SetItemsProcessed(state.iterations() * pixels);
+            state.counters["bpp"] = bitsPerPixel;
+        })->Unit(benchmark::kMillisecond);
+    }
+
+    // rate control: the search of the quality and the coding of the file, from the pixels
+    const size_t targetBytes = compressed.to_jpeg(true).size() / 2;
+    int targetQuality = 0;
+    const double targetBitsPerPixel = 8.0 * Image(image).to_jpeg_with_size(targetBytes, true, 1, &targetQuality).size() / pixels;
+
+    // ReSharper disable once CppDFAUnusedValue
+    benchmark::RegisterBenchmark(("to_jpeg_with_size/" + label).c_str(), [=](benchmark::State& state) {
+        Image input(image);
+        for (auto _ : state) {
+            auto output = input.to_jpeg_with_size(targetBytes, true);
+            benchmark::DoNotOptimize(output.data());
+        }
+        state.SetItemsProcessed(state.iterations() * pixels);
+        state.counters["bpp"] = targetBitsPerPixel;
+        state.counters["quality"] = targetQuality;
+    })->Unit(benchmark::kMillisecond);
+
+    for (const size_t restartRows : {0, 1}) {
+        const std::vector<uint8_t> jpeg = compressed.to_jpeg(false, restartRows);
+        const std::string name = restartRows > 0 ? "restart" : "serial";
+
+        // ReSharper disable once CppDFAUnusedValue
+        benchmark::RegisterBenchmark(("read_jpeg/" + name + "/" + label).c_str(), [=](benchmark::State& state) {
+            for (auto _ : state) {
+                auto output = readJFIF(jpeg.data(), jpeg.size());
+                benchmark::DoNotOptimize(output.components[0].coefficients.data());
+            }
+            state.SetItemsProcessed(state.iterations() * pixels);
+        })->Unit(benchmark::kMillisecond);
+    }
+
+    // decoding of the file at a reduced resolution: the corners of the blocks and the reduced inverse DCT
+    const std::vector<uint8_t> jpeg = compressed.to_jpeg(false, 1);
+    for (const size_t scale : {1, 2, 4, 8}) {
+        // ReSharper disable once CppDFAUnusedValue
+        benchmark::RegisterBenchmark(("decode_scaled/1_" + std::to_string(scale) + "/" + label).c_str(), [=](benchmark::State& state) {
+            for (auto _ : state) {
+                JFIFImage decoded = readJFIF(jpeg.data(), jpeg.size(), scale);
+                JFIFComponent& component = decoded.components[0];
+                auto output = scale == 1 ?
+                    CompressedImage(std::move(component.coefficients), component.quantization).decompress().pixels :
+                    decompressScaled(component.coefficients, component.quantization, scale, true);
+                benchmark::DoNotOptimize(output.data());
+            }
+            state.SetItemsProcessed(state.iterations() * pixels);
+        })->Unit(benchmark::kMillisecond);
+    }
+}
+
+/**
+ * Register the video benchmarks: a static-camera clip (the synthetic image with a moving square)
+ * coded as MJPEG and as 3D DCT, from the frames in memory to the bytes of the stream.
+ *
+ * Each benchmark reports the throughput (pixels per second) and the bits per pixel of the stream.
+ *
+ * @param side The side of the square frames.
+ * @param numFrames The number of frames of the clip.
+ */
+void registerVideoBenchmarks(const size_t side, const size_t numFrames) {
+    const std::vector<std::vector<double>> background = generateImage(side);
+    std::vector<Plane<uint8_t>> frames;
+    for (size_t t = 0; t < numFrames; ++t) {
+        Plane<uint8_t> frame(side, side);
+        for (size_t r = 0; r < side; ++r) {
+            for (size_t c = 0; c < side; ++c) {
+                const bool square = r >= side / 4 + t && r < side / 2 + t && c >= side / 4 + 2 * t && c < side / 2 + 2 * t;
+                frame(r, c) = square ? 230 : static_cast<uint8_t>(background[r][c]);
+            }
+        }
+        frames.push_back(std::move(frame));
+    }
+    const auto pixels = static_cast<int64_t>(side * side * numFrames);
+    const std::string label = std::to_string(side) + "x" + std::to_string(side) + "x" + std::to_string(numFrames);
+
+    for (const auto& entry : {std::make_pair(VideoCodec::MJPEG, "mjpeg"), std::make_pair(VideoCodec::DCT3D, "dct3d")}) {
+        VideoOptions options;
+        options.codec = entry.first;
+        const VideoEncoder encoder(side, side, 1, options);
+        PlaneFrameSource source(frames);
+        std::ostringstream stream;
+        encoder.encode(source, numFrames, stream);
+        const double bitsPerPixel = 8.0 * stream.str().size() / pixels;
+
+        // ReSharper disable once CppDFAUnusedValue
+        benchmark::RegisterBenchmark(("video/" + std::string(entry.second) + "/" + label).c_str(), [=](benchmark::State& state) {
+            for (auto _ : state) {
+                PlaneFrameSource input(frames);
+                std::ostringstream output;
+                encoder.encode(input, numFrames, output);
+                benchmark::DoNotOptimize(output.str().data());
+            }
+            state.SetItemsProcessed(state.iterations() * pixels);
+            state.counters["bpp"] = bitsPerPixel;
+        })->Unit(benchmark::kMillisecond);
+    }
+}
+
+/**
+ * Register the benchmarks of the entropy coding of the compressed binary files: the quantized blocks
+ * of the synthetic image (quality 50) are zigzag-scanned and run-length encoded by encodeBlock,
+ * then decoded back by decodeBlock.
+ *
+ * Each benchmark reports the throughput (coefficients per second).
+ *
+ * @param side The side of the square image.
+ */
+void registerBlockCoderBenchmarks(const size_t side) {
+    const std::vector<std::vector<double>> image = generateImage(side);
+    const QuantizationTable& table = getQuantizationTable(50);
+    const size_t numBlocks = (side / 8) * (side / 8);
+    std::vector<int16_t> coefficients(numBlocks * sp::dct::algo::DCT_BLOCK_AREA);
+    for (size_t b = 0; b < numBlocks; ++b) {
+        double block[sp::dct::algo::DCT_BLOCK_AREA];
+        for (size_t i = 0; i < sp::dct::algo::DCT_BLOCK_AREA; ++i) {
+            block[i] = image[(b / (side / 8)) * 8 + i / 8][(b % (side / 8)) * 8 + i % 8] - 128.0;
+        }
+        sp::dct::algo::computeDCT8x8(block);
+        for (size_t i = 0; i < sp::dct::algo::DCT_BLOCK_AREA; ++i) {
+            coefficients[b * sp::dct::algo::DCT_BLOCK_AREA + i] = static_cast<int16_t>(std::round(block[i] * table.reciprocal[i]));
+        }
+    }
+    std::vector<uint8_t> encoded(numBlocks * MAX_ENCODED_BLOCK_SIZE);
+    size_t encodedSize = 0;
+    for (size_t b = 0; b < numBlocks; ++b) {
+        encodedSize += encodeBlock(coefficients.data() + b * sp::dct::algo::DCT_BLOCK_AREA, encoded.data() + encodedSize);
+    }
+    const auto items = static_cast<int64_t>(numBlocks * sp::dct::algo::DCT_BLOCK_AREA);
+    const std::string label = std::to_string(side) + "x" + std::to_string(side);
+
+    // ReSharper disable once CppDFAUnusedValue
+    benchmark::RegisterBenchmark(("encode_blocks/" + label).c_str(), [=](benchmark::State& state) {
+        std::vector<uint8_t> output(numBlocks * MAX_ENCODED_BLOCK_SIZE);
+        for (auto _ : state) {
+            size_t size = 0;
+            for (size_t b = 0; b < numBlocks; ++b) {
+                size += encodeBlock(coefficients.data() + b * sp::dct::algo::DCT_BLOCK_AREA, output.data() + size);
+            }
+            benchmark::DoNotOptimize(size);
+        }
+        state.SetItemsProcessed(state.iterations() * items);
+    })->Unit(benchmark::kMillisecond);
+
+    // ReSharper disable once CppDFAUnusedValue
+    benchmark::RegisterBenchmark(("decode_blocks/" + label).c_str(), [=](benchmark::State& state) {
+        std::vector<int16_t> output(numBlocks * sp::dct::algo::DCT_BLOCK_AREA);
+        for (auto _ : state) {
+            size_t position = 0;
+            for (size_t b = 0; b < numBlocks; ++b) {
+                position += decodeBlock(
+                    encoded.data() + position, encodedSize - position, output.data() + b * sp::dct::algo::DCT_BLOCK_AREA
+                );
+            }
+            benchmark::DoNotOptimize(output.data());
+        }
+        state.SetItemsProcessed(state.iterations() * items);
+    })->Unit(benchmark::kMillisecond);
+}
+
+int main(const int argc, char** argv) {
+    if (
+        getArgValue(argc, argv, "h", false, false) != "" ||
+        getArgValue(argc, argv, "help", true, false) != ""
+    ) {
+        printf(
+            "Usage: ./program -image=<path.png>\n"
+            "  -image: Grayscale PNG image to compress, with sizes multiple of 8\n"
+            "          (default: synthetic images of side 2^%zu ... 2^%zu)\n"
+            "  -h or --help: Show this help message\n",
+            MIN_POW, MAX_POW
+        );
+        return 0;
+    }
+
+    const auto image_opt = getArgValue(argc, argv, "image");
+
+    std::ostringstream oss;
+    oss << "--benchmark_out=jpeg_results_"
+        << sp::utils::timestamp::createReadableTimestamp("%Y-%m-%d_%H-%M-%S")
+        << ".json";
+    const std::string benchmark_out = oss.str();
+
+    const char* args[] = {
+        argv[0],  // keep program name
+        benchmark_out.c_str(),
+        "--benchmark_out_format=json"
+    };
+    int custom_argc = sizeof(args) / sizeof(char*);
+
+    printf("Running benchmarks with the following parameters:\n");
+    if (image_opt != "") {
+        const Image image(image_opt.c_str());
+        registerBenchmarks(image_opt, image.to_matrix());
+        printf("  Image: %s\n", image_opt.c_str());
+    } else {
+        for (size_t pow = MIN_POW; pow <= MAX_POW; ++pow) {
+            const size_t side = static_cast<size_t>(1) << pow;
+            registerBenchmarks(std::to_string(side) + "x" + std::to_string(side), generateImage(side));
+        }
+        registerVideoBenchmarks(static_cast<size_t>(1) << MIN_POW, 4 * TEMPORAL_BLOCK_SIZE);
+        registerBlockCoderBenchmarks(static_cast<size_t>(1) << MAX_POW);
+        printf("  Sizes: 2^%zu ... 2^%zu\n", MIN_POW, MAX_POW);
+    }
+    printf("  Output file: %s\n", benchmark_out.c_str());
+
+    // Initialize with overridden args
+    benchmark::Initialize(&custom_argc, const_cast<char**>(args));
+    benchmark::RunSpecifiedBenchmarks();
+}
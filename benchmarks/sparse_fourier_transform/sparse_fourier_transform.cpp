@@ -0,0 +1,144 @@
+#include <iostream>
+#include <benchmark/benchmark.h>
+#include <string>
+#include <sstream>
+
+#include "signal_processing/signal_processing.hpp"
+
+#include "../fourier_transform/utils.hpp"
+
+using namespace sp::fft::solver;
+using namespace sp::fft::sparse;
+
+/**
+ * Smallest and largest signal sizes (powers of 2) of the benchmark: 2^20 ... 2^24.
+ */
+constexpr size_t MIN_POW = 20;
+constexpr size_t MAX_POW = 24;
+
+/**
+ * Generate a k-sparse test signal: the sum of k tones plus Gaussian noise,
+ * using the same generator of the examples.
+ *
+ * The tone frequencies are multiples of 1/N (DFT bins), so the spectrum is exactly k-sparse
+ * apart from the noise.
+ *
+ * @param size The signal length N.
+ * @param k The number of tones.
+ * @param noise The standard deviation of the noise.
+ * @param seed The seed of the generator.
+ * @return The generated signal.
+ */
+std::vector<std::complex<double>> generateSparseSignal(
+    const size_t size, const size_t k, const double noise, const int seed = 42
+) {
+    sp::signal_gen::TimeDomainSignalGenerator generator(seed);
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<size_t> bins(0, size - 1);
+    std::vector<std::complex<double>> signal(size, {0.0, 0.0});
+    for (size_t tone = 0; tone < k; ++tone) {
+        const double frequency = static_cast<double>(bins(engine)) / static_cast<double>(size);
+        // the noise is added only once
+        const auto component = generator.generate1DSignal(
+            static_cast<int>(size), frequency, static_cast<double>(tone), tone == 0 ? noise : 0.0
+        );
+        for (size_t n = 0; n < size; ++n) {
+            signal[n] += component[n];
+        }
+    }
+    return signal;
+}
+
+/**
+ * Register the sparse FFT and the full FFT (FastFourierTransform<1>) benchmarks
+ * for every size in [2^MIN_POW, 2^MAX_POW].
+ *
+ * @param k The sparsity (number of tones, and number of coefficients to recover).
+ * @param noise The standard deviation of the noise.
+ */
+void registerBenchmarks(const size_t k, const double noise) {
+    for (size_t pow = MIN_POW; pow <= MAX_POW; ++pow) {
+        const size_t size = static_cast<size_t>(1) << pow;
+
+        std::ostringstream sparseName;
+        sparseName << "sparse/k" << k << "/" << size;
+        // ReSharper disable once CppDFAUnusedValue
+        benchmark::RegisterBenchmark(sparseName.str().c_str(), [=](benchmark::State& state) {
+            const auto input = generateSparseSignal(size, k, noise);
+            SparseFourierTransform sparse(size, k);
+            size_t fallbacks = 0;
+            for (auto _ : state) {
+                auto coefficients = sparse.compute(input);
+                fallbacks += sparse.usedFallback() ? 1 : 0;
+                benchmark::DoNotOptimize(coefficients);
+            }
+            // fraction of the runs that fell back to the full transform
+            state.counters["fallback"] = benchmark::Counter(
+                static_cast<double>(fallbacks), benchmark::Counter::kAvgIterations
+            );
+        })->Unit(benchmark::kMillisecond);
+
+        std::ostringstream fullName;
+        fullName << "full/k" << k << "/" << size;
+        // ReSharper disable once CppDFAUnusedValue
+        benchmark::RegisterBenchmark(fullName.str().c_str(), [=](benchmark::State& state) {
+            const auto input = generateSparseSignal(size, k, noise);
+            FastFourierTransform<1> fft({size});
+            for (auto _ : state) {
+                auto copy = input;
+                fft.compute(copy, ComputationMode::SEQUENTIAL);
+                benchmark::DoNotOptimize(copy);
+            }
+        })->Unit(benchmark::kMillisecond);
+    }
+}
+
+int main(const int argc, char** argv) {
+    if (
+        getArgValue(argc, argv, "h", false, false) != "" ||
+        getArgValue(argc, argv, "help", true, false) != ""
+    ) {
+        printf(
+            "Usage: ./program -k=<1|2|4|...> -noise=<0.0|0.5|...>\n"
+            "  -k: Number of tones of the signal and of coefficients to recover (default 8)\n"
+            "  -noise: Standard deviation of the Gaussian noise (default 0.5)\n"
+            "  -h or --help: Show this help message\n"
+        );
+        return 0;
+    }
+
+    const auto k_opt = getArgValue(argc, argv, "k");
+    const auto noise_opt = getArgValue(argc, argv, "noise");
+    const size_t k = k_opt != "" ? std::stoul(k_opt) : 8;
+    const double noise = noise_opt != "" ? std::stod(noise_opt) : 0.5;
+
+    if (k == 0) {
+        std::cerr << "Invalid k. Must be greater than 0.\n";
+        return 1;
+    }
+
+    std::ostringstream oss;
+    oss << "--benchmark_out=sparse_results_k" << k << "_"
+        << sp::utils::timestamp::createReadableTimestamp("%Y-%m-%d_%H-%M-%S")
+        << ".json";
+    const std::string benchmark_out = oss.str();
+
+    const char* args[] = {
+        argv[0],  // keep program name
+        benchmark_out.c_str(),
+        "--benchmark_out_format=json"
+    };
+    int custom_argc = sizeof(args) / sizeof(char*);
+
+    registerBenchmarks(k, noise);
+
+    printf("Running benchmarks with the following parameters:\n");
+    printf("  k: %zu\n", k);
+    printf("  Noise: %f\n", noise);
+    printf("  Sizes: 2^%zu ... 2^%zu\n", MIN_POW, MAX_POW);
+    printf("  Output file: %s\n", benchmark_out.c_str());
+
+    // Initialize with overridden args
+    benchmark::Initialize(&custom_argc, const_cast<char**>(args));
+    benchmark::RunSpecifiedBenchmarks();
+}
@@ -4,10 +4,13 @@
  *
  * @details The demo generates a signal in time or space domain, computes the DCT and IDCT of the signal,
  *          and measures the time taken for each operation.
+ *          It also times the DCT-I, the DCT-IV and the MDCT/IMDCT on audio frame sizes, and the streaming
+ *          MDCT/IMDCT of one second of audio.
  *          It is not intended to be a comprehensive performance test, but rather a simple demonstration of the
  *          performance of the DCT solver.
  */
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <cmath>
@@ -33,8 +36,8 @@ void sequential_vs_parallel_dct(const std::vector<double>& signal, std::vector<d
     const auto end_time_seq = std::chrono::high_resolution_clock::now();
 
     printf(
-        "Time taken for sequential DCT: %ld ms\n",
-        std::chrono::duration_cast<std::chrono::milliseconds>(end_time_seq - start_time_seq).count()
+        "Time taken for sequential DCT: %ld us\n",
+        std::chrono::duration_cast<std::chrono::microseconds>(end_time_seq - start_time_seq).count()
     );
 
     // ================================================= Parallel DCT =================================================
@@ -43,14 +46,14 @@ void sequential_vs_parallel_dct(const std::vector<double>& signal, std::vector<d
     const auto end_time_par = std::chrono::high_resolution_clock::now();
 
     printf(
-        "Time taken for parallel (OpenMP, CPU) DCT: %ld ms\n",
-        std::chrono::duration_cast<std::chrono::milliseconds>(end_time_par - start_time_par).count()
+        "Time taken for parallel (OpenMP, CPU) DCT: %ld us\n",
+        std::chrono::duration_cast<std::chrono::microseconds>(end_time_par - start_time_par).count()
     );
     printf(
-        "With %d threads (CPU), the speedup is: %ld\n",
+        "With %d threads (CPU), the speedup is: %.2f\n",
         omp_get_max_threads(),
-        (std::chrono::duration_cast<std::chrono::milliseconds>(end_time_seq - start_time_seq).count()) /
-           (std::chrono::duration_cast<std::chrono::milliseconds>(end_time_par - start_time_par).count())
+        std::chrono::duration<double>(end_time_seq - start_time_seq).count() /
+            std::chrono::duration<double>(end_time_par - start_time_par).count()
     );
 
     // uncomment the following lines to save the result to a file
@@ -74,8 +77,8 @@ void sequential_vs_parallel_inverse_dct(const std::vector<double>& sequential_dc
     const auto end_time_seq = std::chrono::high_resolution_clock::now();
 
     printf(
-        "Time taken for sequential Inverse DCT: %ld ms\n",
-        std::chrono::duration_cast<std::chrono::milliseconds>(end_time_seq - start_time_seq).count()
+        "Time taken for sequential Inverse DCT: %ld us\n",
+        std::chrono::duration_cast<std::chrono::microseconds>(end_time_seq - start_time_seq).count()
     );
 
     // ============================================= Parallel Inverse DCT =============================================
@@ -86,14 +89,14 @@ void sequential_vs_parallel_inverse_dct(const std::vector<double>& sequential_dc
     const auto end_time_par = std::chrono::high_resolution_clock::now();
 
     printf(
-        "Time taken for parallel (OpenMP, CPU) Inverse DCT: %ld ms\n",
-        std::chrono::duration_cast<std::chrono::milliseconds>(end_time_par - start_time_par).count()
+        "Time taken for parallel (OpenMP, CPU) Inverse DCT: %ld us\n",
+        std::chrono::duration_cast<std::chrono::microseconds>(end_time_par - start_time_par).count()
     );
     printf(
-        "With %d threads (CPU), the speedup is: %ld\n\n",
+        "With %d threads (CPU), the speedup is: %.2f\n\n",
         omp_get_max_threads(),
-        (std::chrono::duration_cast<std::chrono::milliseconds>(end_time_seq - start_time_seq).count()) /
-            (std::chrono::duration_cast<std::chrono::milliseconds>(end_time_par - start_time_par).count())
+        std::chrono::duration<double>(end_time_seq - start_time_seq).count() /
+            std::chrono::duration<double>(end_time_par - start_time_par).count()
     );
 
     // uncomment the following lines to save the result to a file
@@ -102,6 +105,112 @@ void sequential_vs_parallel_inverse_dct(const std::vector<double>& sequential_dc
     // csv_signal_saver.saveToFile(parallel_idct, "examples/output/parallel_idct_signal");
 }
 
+/**
+ * Function that measures the average time of a call of an operation.
+ *
+ * @param repetitions: number of calls of the operation;
+ * @param operation: the operation to time.
+ * @return the average time of a call, in microseconds.
+ */
+template <typename Operation>
+double average_microseconds(const int repetitions, Operation operation) {
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < repetitions; ++i) {
+        operation();
+    }
+    const auto end_time = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::micro>(end_time - start_time).count() / repetitions;
+}
+
+// Function that generates an audio-like signal: sum of three tones sampled at sampling_rate
+std::vector<double> generate_audio_signal(const size_t length, const double sampling_rate) {
+    std::vector<double> signal(length);
+    for (size_t i = 0; i < length; ++i) {
+        const double t = static_cast<double>(i) / sampling_rate;
+        signal[i] = 0.5 * std::sin(2.0 * M_PI * 440.0 * t) + 0.3 * std::sin(2.0 * M_PI * 1250.0 * t) +
+                    0.2 * std::sin(2.0 * M_PI * 5100.0 * t);
+    }
+    return signal;
+}
+
+/**
+ * This demo measures the time of a DCT-I (N + 1 samples), a DCT-IV and a single-frame MDCT/IMDCT (N coefficients)
+ * for the usual frame sizes of audio codecs, N = 2^6 ... 2^12.
+ */
+void frame_transforms_performance() {
+    constexpr int repetitions = 2000;
+    printf("%8s %14s %14s %14s %14s\n", "N", "DCT-I [us]", "DCT-IV [us]", "MDCT [us]", "IMDCT [us]");
+    for (size_t size = 64; size <= 4096; size *= 2) {
+        std::vector<std::complex<double>> workspace;
+
+        const sp::dct::algo::FastDCT1Plan dct1(size + 1);
+        std::vector<double> dct1_data = generate_audio_signal(size + 1, 48000.0);
+        const double dct1_time = average_microseconds(repetitions, [&]() {
+            dct1.transform(dct1_data.data(), workspace);
+        });
+
+        const sp::dct::algo::FastDCT4Plan dct4(size);
+        std::vector<double> dct4_data = generate_audio_signal(size, 48000.0);
+        const double dct4_time = average_microseconds(repetitions, [&]() {
+            dct4.transform(dct4_data.data(), workspace);
+        });
+
+        const sp::dct::mdct::MDCTPlan mdct(size, sp::dct::mdct::makeMDCTWindow(sp::dct::mdct::MDCTWindow::SINE, size));
+        const std::vector<double> frame = generate_audio_signal(2 * size, 48000.0);
+        std::vector<double> coefficients(size);
+        std::vector<double> synthesized(2 * size);
+        const double mdct_time = average_microseconds(repetitions, [&]() {
+            mdct.forward(frame.data(), coefficients.data(), workspace);
+        });
+        const double imdct_time = average_microseconds(repetitions, [&]() {
+            mdct.inverse(coefficients.data(), synthesized.data(), workspace);
+        });
+
+        printf("%8zu %14.2f %14.2f %14.2f %14.2f\n", size, dct1_time, dct4_time, mdct_time, imdct_time);
+    }
+}
+
+/**
+ * This demo measures the streaming MDCT analysis and IMDCT synthesis (50% overlap, KBD window) of one second
+ * of audio at 48 kHz, pushed in blocks of 512 samples as an audio callback would do,
+ * and checks the reconstruction (time-domain aliasing cancellation).
+ */
+void streaming_mdct_performance() {
+    constexpr size_t sample_rate = 48000;
+    constexpr size_t block = 512;
+    const std::vector<double> signal = generate_audio_signal(sample_rate, static_cast<double>(sample_rate));
+
+    for (const size_t size : {256, 1024, 2048}) {
+        sp::dct::mdct::ModifiedDiscreteCosineTransform analysis(size, sp::dct::mdct::MDCTWindow::KAISER_BESSEL_DERIVED);
+        sp::dct::mdct::InverseModifiedDiscreteCosineTransform synthesis(size, sp::dct::mdct::MDCTWindow::KAISER_BESSEL_DERIVED);
+        std::vector<double> frames;
+        std::vector<double> output;
+
+        const auto start_time_analysis = std::chrono::high_resolution_clock::now();
+        for (size_t start = 0; start < signal.size(); start += block) {
+            analysis.push(signal.data() + start, std::min(block, signal.size() - start), frames);
+        }
+        analysis.flush(frames);
+        const auto end_time_analysis = std::chrono::high_resolution_clock::now();
+
+        const auto start_time_synthesis = std::chrono::high_resolution_clock::now();
+        synthesis.push(frames, output);
+        const auto end_time_synthesis = std::chrono::high_resolution_clock::now();
+
+        double max_error = 0.0;
+        for (size_t i = 0; i < std::min(signal.size(), output.size()); ++i) {
+            max_error = std::max(max_error, std::abs(signal[i] - output[i]));
+        }
+        printf(
+            "N = %4zu: MDCT %.3f ms, IMDCT %.3f ms, max reconstruction error %.2e\n",
+            size,
+            std::chrono::duration<double, std::milli>(end_time_analysis - start_time_analysis).count(),
+            std::chrono::duration<double, std::milli>(end_time_synthesis - start_time_synthesis).count(),
+            max_error
+        );
+    }
+}
+
 // Function that scales DCT coefficients to frequency
 std::vector<double> scale_dct_frequencies(int num_coefficients, double sampling_rate, double signal_duration) {
     std::vector<double> scaled_freq(num_coefficients);
@@ -188,6 +297,16 @@ int main() {
     sequential_vs_parallel_inverse_dct(sequential_dct, parallel_dct, sequential_idct, parallel_idct);
 
 
+    // ===================================== DCT-I, DCT-IV and MDCT on audio frames =====================================
+    printf("\n\nDCT-I, DCT-IV and MDCT/IMDCT (average time of a frame)\n");
+    frame_transforms_performance();
+
+
+    // ========================================= Streaming MDCT/IMDCT of audio =========================================
+    printf("\n\nStreaming MDCT/IMDCT of 1 s of audio at 48 kHz\n");
+    streaming_mdct_performance();
+
+
 
     // =================================================== Plotting ===================================================
     // Linear space for time axis
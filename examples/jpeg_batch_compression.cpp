@@ -0,0 +1,111 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+
+#include "signal_processing/signal_processing.hpp"
+
+/**
+ * Print the usage of the program.
+ *
+ * @param program The name of the program.
+ */
+void print_usage(const char* program) {
+    std::cout
+        << "Usage: " << program << " <input_dir> <output_dir> [options]\n"
+        << "  Compresses every image of input_dir (PNG, JPEG, BMP, TGA, GIF, PNM) to output_dir/<name>.jpg\n"
+        << "  -quality=<1-100>      quality of the files (default: " << sp::jpeg::DEFAULT_QUALITY << ")\n"
+        << "  -subsampling=<s>      chroma of the color images: 444, 422 or 420 (default: 420)\n"
+        << "  -optimize             optimized Huffman tables\n"
+        << "  -decoders=<n>         threads that decode the images (default: 2)\n"
+        << "  -workers=<n>          threads that compress the images (default: the OpenMP threads)\n"
+        << "  -writers=<n>          threads that write the files (default: 1)\n"
+        << "  -queue=<n>            images waiting between two stages (default: 8)\n"
+        << "  -h or --help          show this help message" << std::endl;
+}
+
+/**
+ * Read the value of an option "-name=value".
+ *
+ * @param argument The argument of the command line.
+ * @param name The name of the option.
+ * @param value The value (output).
+ * @return Whether the argument is the option.
+ */
+bool read_option(const std::string& argument, const std::string& name, std::string& value) {
+    const std::string prefix = "-" + name + "=";
+    if (argument.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    value = argument.substr(prefix.size());
+    return true;
+}
+
+int main(const int argc, char** argv) {
+    std::string input, output;
+    sp::jpeg::BatchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        std::string value;
+        if (argument == "-h" || argument == "--help") {
+            print_usage(argv[0]);
+            return 0;
+        } else if (argument == "-optimize") {
+            options.optimizeHuffman = true;
+        } else if (read_option(argument, "quality", value)) {
+            options.quality = std::stoi(value);
+        } else if (read_option(argument, "subsampling", value)) {
+            if (value == "444") {
+                options.subsampling = sp::jpeg::ChromaSubsampling::YUV444;
+            } else if (value == "422") {
+                options.subsampling = sp::jpeg::ChromaSubsampling::YUV422;
+            } else if (value == "420") {
+                options.subsampling = sp::jpeg::ChromaSubsampling::YUV420;
+            } else {
+                std::cerr << "Unknown subsampling: " << value << std::endl;
+                print_usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        } else if (read_option(argument, "decoders", value)) {
+            options.decodeThreads = std::stoul(value);
+        } else if (read_option(argument, "workers", value)) {
+            options.compressionThreads = std::stoul(value);
+        } else if (read_option(argument, "writers", value)) {
+            options.writeThreads = std::stoul(value);
+        } else if (read_option(argument, "queue", value)) {
+            options.queueCapacity = std::stoul(value);
+        } else if (input.empty()) {
+            input = argument;
+        } else if (output.empty()) {
+            output = argument;
+        } else {
+            std::cerr << "Unknown argument: " << argument << std::endl;
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (input.empty() || output.empty()) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    struct stat info;
+    if (stat(output.c_str(), &info) != 0 && mkdir(output.c_str(), 0755) != 0) {
+        std::cerr << "Error: could not create the output directory " << output << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (stat(output.c_str(), &info) != 0 || !(info.st_mode & S_IFDIR)) {
+        std::cerr << "Error: " << output << " is not a directory" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        const sp::jpeg::BatchCompressor compressor(options);
+        const sp::jpeg::BatchReport report = compressor.run(input, output);
+        report.print(std::cout, compressor.getOptions());
+        return report.errors.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,175 @@
+/**
+ * @file jpeg_video_compression.cpp
+ * @brief This program compresses a video with the JPEG block pipeline, as Motion JPEG
+ *        (a JPEG file per frame) and with the 8x8x8 3D DCT (temporal blocks of 8 frames).
+ *
+ * @details The frames are pulled from OpenCV one window at a time (see VideoEncoder), so the clip is
+ *          never whole in memory. Both streams are decoded back, and their sizes and PSNR are compared.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/stat.h>
+#include <utility>
+#include <vector>
+
+#include "opencv2/videoio.hpp"
+#include "opencv2/imgproc.hpp"
+#include "opencv2/core/mat.hpp"
+
+#include "signal_processing/signal_processing.hpp"
+
+/**
+ * Maximum number of frames of the clip.
+ */
+constexpr size_t MAX_FRAMES = 256;
+
+/**
+ * Frames of an OpenCV video, converted to RGB.
+ */
+class CaptureFrameSource : public sp::jpeg::FrameSource {
+public:
+    explicit CaptureFrameSource(const std::string& path): capture(path) {}
+
+    [[nodiscard]] bool isOpened() const {
+        return capture.isOpened();
+    }
+
+    void readFrame(uint8_t* pixels, const size_t pitch) override {
+        cv::Mat frame;
+        if (!capture.read(frame)) {
+            throw std::runtime_error("Error reading a frame of the video");
+        }
+        cv::cvtColor(frame, frame, cv::COLOR_BGR2RGB);
+        const size_t rowBytes = 3 * static_cast<size_t>(frame.cols);
+        for (int r = 0; r < frame.rows; ++r) {
+            std::memcpy(pixels + r * pitch, frame.ptr<uint8_t>(r), rowBytes);
+        }
+    }
+
+private:
+    cv::VideoCapture capture;
+};
+
+/**
+ * Frames compared with the ones of the original video, read again from the file.
+ */
+class PSNRFrameSink : public sp::jpeg::FrameSink {
+public:
+    explicit PSNRFrameSink(const std::string& path): capture(path) {}
+
+    void writeFrame(const uint8_t* pixels, const size_t pitch) override {
+        cv::Mat frame;
+        if (!capture.read(frame)) {
+            throw std::runtime_error("Error reading a frame of the original video");
+        }
+        cv::cvtColor(frame, frame, cv::COLOR_BGR2RGB);
+        double squaredError = 0.0;
+        const size_t rowBytes = 3 * static_cast<size_t>(frame.cols);
+        for (int r = 0; r < frame.rows; ++r) {
+            const uint8_t* original = frame.ptr<uint8_t>(r);
+            for (size_t c = 0; c < rowBytes; ++c) {
+                const double error = static_cast<double>(original[c]) - pixels[r * pitch + c];
+                squaredError += error * error;
+            }
+        }
+        const double mse = squaredError / static_cast<double>(rowBytes * frame.rows);
+        sum += mse == 0.0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+        ++count;
+    }
+
+    [[nodiscard]] double getMeanPSNR() const {
+        return count > 0 ? sum / static_cast<double>(count) : 0.0;
+    }
+
+private:
+    cv::VideoCapture capture;
+    double sum = 0.0;
+    size_t count = 0;
+};
+
+int main() {
+    const std::string input = "examples/resources/cats-resize.mp4";
+    struct stat info;
+    if (stat("examples/output", &info) != 0 || !(info.st_mode & S_IFDIR)) {
+        std::cerr << "Output folder does not exist. Creating it..." << std::endl;
+        mkdir("examples/output", 0755);
+    }
+
+    cv::VideoCapture probe(input);
+    if (!probe.isOpened()) {
+        std::cerr << "Error opening video file." << std::endl;
+        return -1;
+    }
+    const auto width = static_cast<size_t>(probe.get(cv::CAP_PROP_FRAME_WIDTH));
+    const auto height = static_cast<size_t>(probe.get(cv::CAP_PROP_FRAME_HEIGHT));
+    // CAP_PROP_FRAME_COUNT is only an estimate (from the duration, for mp4): the frames are counted by decoding them
+    size_t frames = 0;
+    while (frames < MAX_FRAMES && probe.grab()) {
+        ++frames;
+    }
+    probe.release();
+    if (frames == 0) {
+        std::cerr << "The video has no frames." << std::endl;
+        return -1;
+    }
+    printf("Video: %zux%zu, %zu frames.\n", width, height, frames);
+
+    const std::pair<sp::jpeg::VideoCodec, std::string> codecs[] = {
+        {sp::jpeg::VideoCodec::MJPEG, "mjpeg"},
+        {sp::jpeg::VideoCodec::DCT3D, "dct3d"}
+    };
+    for (const auto& codec : codecs) {
+        try {
+            sp::jpeg::VideoOptions options;
+            options.codec = codec.first;
+            options.quality = 75;
+            const sp::jpeg::VideoEncoder encoder(width, height, 3, options);
+
+            /**
+             * 1. Encode the frames, a window at a time
+             */
+            std::ostringstream path;
+            path << "examples/output/video-"
+                 << sp::utils::timestamp::createReadableTimestamp("%Y%m%d_%H%M%S")
+                 << "." << codec.second;
+            CaptureFrameSource source(input);
+            if (!source.isOpened()) {
+                std::cerr << "Error opening video file." << std::endl;
+                return -1;
+            }
+            auto start = std::chrono::high_resolution_clock::now();
+            {
+                std::ofstream output(path.str(), std::ios::binary);
+                encoder.encode(source, frames, output);
+            }
+            std::chrono::duration<double> encoding = std::chrono::high_resolution_clock::now() - start;
+
+            /**
+             * 2. Decode the stream and compare the frames with the original ones
+             */
+            const sp::jpeg::VideoDecoder decoder(path.str());
+            PSNRFrameSink sink(input);
+            start = std::chrono::high_resolution_clock::now();
+            decoder.decode(sink);
+            std::chrono::duration<double> decoding = std::chrono::high_resolution_clock::now() - start;
+
+            struct stat file;
+            stat(path.str().c_str(), &file);
+            printf(
+                "%s: %s, %.1f KiB (%.2f bpp), window of %zu frames, encoding %.2f s, decoding %.2f s, PSNR %.2f dB\n",
+                codec.second.c_str(), path.str().c_str(), file.st_size / 1024.0,
+                8.0 * file.st_size / static_cast<double>(width * height * frames), encoder.getWindowFrames(),
+                encoding.count(), decoding.count(), sink.getMeanPSNR()
+            );
+        } catch (const std::exception& e) {
+            std::cerr << codec.second << ": " << e.what() << std::endl;
+            return -1;
+        }
+    }
+}
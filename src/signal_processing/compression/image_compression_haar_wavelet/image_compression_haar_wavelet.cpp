@@ -1,9 +1,11 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <climits>
 #include <cmath>
 
 #include "compression/image_compression_haar_wavelet/image_compression_haar_wavelet.hpp"
+#include "utils/mapped_file.hpp"
 
 namespace sp::hwt {
     // Compresses the input image matrix using Haar wavelet transform and thresholding
@@ -90,44 +92,40 @@ namespace sp::hwt {
     // Loads a matrix from a binary file and reconstructs the image data with scaling
     std::vector<std::vector<double>> ImgWLComp::load_img_from_binary(const std::string& compressed_image_path){
 
-        // Open the file in binary mode to read
-        std::ifstream file(compressed_image_path, std::ios::binary);
-
-        if (!file) {
-            std::cerr << "Errore nell'apertura del file!" << std::endl;
-            throw std::runtime_error("Error opening binary file!");
+        // Map the file (or read it at once), then decode it from memory with bounds-checked reads
+        const utils::io::MappedFile file(compressed_image_path);
+        utils::io::ByteCursor cursor(file.data(), file.size());
+
+        // Read the matrix size, and check it before allocating: the matrix is not empty (save_as_binary
+        // reads the size from the first row) and every row has at least one byte
+        const auto rows = cursor.read<size_t>();
+        const auto cols = cursor.read<size_t>();
+        if (rows == 0 || cols == 0 || rows > cursor.remaining() || cols > static_cast<size_t>(INT_MAX)) {
+            std::cerr << "Error: invalid matrix size in the binary file" << std::endl;
+            throw std::runtime_error("Error: invalid matrix size in the binary file");
         }
 
-        // Read the matrix size
-        size_t rows, cols, zigzagdim;
-        file.read(reinterpret_cast<char*>(&rows), sizeof(rows));
-        file.read(reinterpret_cast<char*>(&cols), sizeof(cols));
-
-        // Read matrix elements and store them in img_matrix
+        // Read matrix elements and store them in img_matrix (scaled back by 2)
         /*normal rle*/
         std::vector<std::vector<double>> img_matrix(rows, std::vector<double>(cols, 0));
 
-        for (int r=0; r < rows; ++r) {
-            for (int c=0; c < cols; ++c) {
-
-                int8_t value;
-                file.read(reinterpret_cast<char*>(&value), sizeof(value));
-                img_matrix[r][c] = static_cast<double>(value);
+        for (size_t r = 0; r < rows; ++r) {
+            std::vector<double>& row = img_matrix[r];
+            for (int c = 0; c < static_cast<int>(cols); ++c) {
+                const auto value = cursor.read<int8_t>();
+                row[c] = 2.0 * value;
 
                 if(value == 0){
-                    file.read(reinterpret_cast<char*>(&c), sizeof(c));
+                    // a run of zeros: the column of its last element
+                    const int last = cursor.read<int>();
+                    if (last < c || last >= static_cast<int>(cols)) {
+                        throw std::runtime_error("Error: corrupted run of zeros in the binary file");
+                    }
+                    c = last;
                 }
             }
         }
 
-        file.close();
-
-        for(int i = 0; i < rows; i++){
-            for(int j = 0; j < cols; j++){
-                img_matrix[i][j] *= 2;
-            }
-        }
-
         return img_matrix;
     }
 
@@ -1,6 +1,7 @@
 #ifndef IMAGE_COMPRESSION_HAAR_WAVELET_HPP
 #define IMAGE_COMPRESSION_HAAR_WAVELET_HPP
 
+#include <string>
 #include <vector>
 
 namespace sp::hwt {
@@ -0,0 +1,396 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <climits>
+#include <cstring>
+#include <dirent.h>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <omp.h>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <thread>
+
+#include "stb/stb_image.h"
+
+#include "compression/jpeg_image_compression/batch/batch_compressor.hpp"
+#include "compression/jpeg_image_compression/batch/bounded_queue.hpp"
+#include "compression/jpeg_image_compression/color_image/color_image.hpp"
+#include "compression/jpeg_image_compression/plane/plane.hpp"
+#include "compression/jpeg_image_compression/quantization/quantization.hpp"
+#include "utils/mapped_file.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * An image between the decode and the compression stages: the pixels decoded by stb_image.
+     */
+    struct DecodedImage {
+        size_t job = 0;
+        Plane<uint8_t> pixels;
+        int channels = 0;
+    };
+
+    /**
+     * An image between the compression and the write stages: the bytes of its .jpg file.
+     */
+    struct CodedImage {
+        size_t job = 0;
+        std::vector<uint8_t> jpeg;
+    };
+
+    static double elapsedSeconds(const std::chrono::steady_clock::time_point& start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /**
+     * Function that tells whether the extension of a file is one of the formats decoded by stb_image.
+     */
+    static bool isImageFile(const std::string& name) {
+        const size_t dot = name.rfind('.');
+        if (dot == std::string::npos) {
+            return false;
+        }
+        std::string extension = name.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](const unsigned char c) {
+            return static_cast<char>(std::tolower(c));
+        });
+        static const char* const EXTENSIONS[] = {"png", "jpg", "jpeg", "bmp", "tga", "gif", "pgm", "ppm", "pnm"};
+        for (const char* candidate : EXTENSIONS) {
+            if (extension == candidate) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Function that gets the identity of an existing file or directory (device and inode).
+     *
+     * @return: an empty string if the file does not exist.
+     */
+    static std::string getFileIdentity(const std::string& path) {
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) {
+            return "";
+        }
+        return std::to_string(info.st_dev) + ":" + std::to_string(info.st_ino);
+    }
+
+    /**
+     * Function that gets the keys of a path, equal for two paths of the same file: its name in the identity
+     * of its directory (also for a file that does not exist yet), and the identity of the file if it exists
+     * (for the links).
+     */
+    static std::vector<std::string> getFileKeys(const std::string& path) {
+        const size_t slash = path.rfind('/');
+        const std::string directory = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+        const std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+        const std::string directoryIdentity = getFileIdentity(directory);
+
+        std::vector<std::string> keys;
+        keys.push_back(directoryIdentity.empty() ? "path " + path : "name " + directoryIdentity + "/" + name);
+        const std::string identity = getFileIdentity(path);
+        if (!identity.empty()) {
+            keys.push_back("file " + identity);
+        }
+        return keys;
+    }
+
+    /**
+     * Function that finds the jobs whose output cannot be written concurrently with the others: an output that is
+     * an input of the batch (it would be truncated while a decoder reads its mapping), or the output of an earlier job
+     * (two writers would write the same file).
+     *
+     * @param jobs: the jobs of the batch.
+     * @return: for every job, the reason of the conflict, or an empty string.
+     */
+    static std::vector<std::string> findOutputConflicts(const std::vector<BatchJob>& jobs) {
+        std::map<std::string, size_t> inputs;
+        for (size_t job = 0; job < jobs.size(); ++job) {
+            for (const std::string& key : getFileKeys(jobs[job].input)) {
+                inputs.emplace(key, job);
+            }
+        }
+
+        std::vector<std::string> conflicts(jobs.size());
+        std::map<std::string, size_t> outputs;
+        for (size_t job = 0; job < jobs.size(); ++job) {
+            const std::vector<std::string> keys = getFileKeys(jobs[job].output);
+            for (const std::string& key : keys) {
+                const auto input = inputs.find(key);
+                const auto output = outputs.find(key);
+                if (input != inputs.end()) {
+                    conflicts[job] = "the output " + jobs[job].output + " is the input " + jobs[input->second].input +
+                                     " of the batch";
+                } else if (output != outputs.end()) {
+                    conflicts[job] = "the output " + jobs[job].output + " is also the output of " +
+                                     jobs[output->second].input;
+                }
+                if (!conflicts[job].empty()) {
+                    break;
+                }
+            }
+            if (conflicts[job].empty()) {
+                for (const std::string& key : keys) {
+                    outputs.emplace(key, job);
+                }
+            }
+        }
+        return conflicts;
+    }
+
+    // #################### CONSTRUCTORS ####################
+
+    BatchCompressor::BatchCompressor(const BatchOptions& options): options(options) {
+        if (this->options.compressionThreads == 0) {
+            this->options.compressionThreads = static_cast<size_t>(std::max(1, omp_get_max_threads()));
+        }
+        if (this->options.decodeThreads == 0 || this->options.writeThreads == 0 || this->options.queueCapacity == 0) {
+            throw std::invalid_argument(
+                "The stages of a batch need at least a thread and a queue of an image. Given: " +
+                std::to_string(this->options.decodeThreads) + " decode, " +
+                std::to_string(this->options.writeThreads) + " write threads, capacity " +
+                std::to_string(this->options.queueCapacity)
+            );
+        }
+        // the table of the quality is cached for the workers, and validates it
+        getQuantizationTable(this->options.quality);
+    }
+
+    // #################### PUBLIC ####################
+
+    const BatchOptions& BatchCompressor::getOptions() const {
+        return this->options;
+    }
+
+    BatchReport BatchCompressor::run(const std::string& inputDirectory, const std::string& outputDirectory) const {
+        return run(listBatchJobs(inputDirectory, outputDirectory));
+    }
+
+    BatchReport BatchCompressor::run(const std::vector<BatchJob>& jobs) const {
+        const auto start = std::chrono::steady_clock::now();
+        BatchReport report;
+        report.images = jobs.size();
+
+        BoundedQueue<DecodedImage> decoded(this->options.queueCapacity);
+        BoundedQueue<CodedImage> coded(this->options.queueCapacity);
+        std::mutex mutex;  // guards the report
+        std::atomic<size_t> nextJob(0);
+        std::atomic<size_t> busyCompressors(0);
+        std::atomic<size_t> activeDecoders(this->options.decodeThreads);
+        std::atomic<size_t> activeCompressors(this->options.compressionThreads);
+        const size_t maxThreads = static_cast<size_t>(std::max(1, omp_get_max_threads()));
+
+        const auto fail = [&](const size_t job, const std::string& message) {
+            std::lock_guard<std::mutex> lock(mutex);
+            report.errors.push_back(jobs[job].input + ": " + message);
+        };
+        const auto account = [&](StageStatistics& stage, const size_t bytes, const double seconds) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++stage.items;
+            stage.bytes += bytes;
+            stage.busySeconds += seconds;
+        };
+
+        // the jobs that would write an input, or the output of an earlier job, are not run
+        const std::vector<std::string> conflicts = findOutputConflicts(jobs);
+        for (size_t job = 0; job < jobs.size(); ++job) {
+            if (!conflicts[job].empty()) {
+                fail(job, conflicts[job]);
+            }
+        }
+
+        // decode: the files are taken in order and decoded from their mapped bytes
+        const auto decodeStage = [&]() {
+            for (size_t job = nextJob++; job < jobs.size(); job = nextJob++) {
+                if (!conflicts[job].empty()) {
+                    continue;
+                }
+                const auto begin = std::chrono::steady_clock::now();
+                DecodedImage image;
+                image.job = job;
+                try {
+                    const utils::io::MappedFile file(jobs[job].input);
+                    if (file.size() > static_cast<size_t>(INT_MAX)) {
+                        throw std::runtime_error("the file is too large for stb_image");
+                    }
+                    const int length = static_cast<int>(file.size());
+                    int width, height, channels;
+                    if (stbi_info_from_memory(file.data(), length, &width, &height, &channels) == 0) {
+                        throw std::runtime_error(stbi_failure_reason());
+                    }
+                    // gray and gray + alpha as grayscale, the others as RGB
+                    image.channels = channels <= 2 ? 1 : 3;
+                    unsigned char* data = stbi_load_from_memory(
+                        file.data(), length, &width, &height, &channels, image.channels
+                    );
+                    if (data == nullptr) {
+                        throw std::runtime_error(stbi_failure_reason());
+                    }
+                    const size_t cols = static_cast<size_t>(width) * image.channels;
+                    image.pixels = Plane<uint8_t>(data, height, cols, cols, stbi_image_free);
+                } catch (const std::exception& e) {
+                    fail(job, e.what());
+                    continue;
+                }
+                account(report.decode, image.pixels.getRows() * image.pixels.getCols(), elapsedSeconds(begin));
+                decoded.push(std::move(image));
+            }
+            if (--activeDecoders == 0) {
+                decoded.close();
+            }
+        };
+
+        // compress: one image per thread, with the intra-image parallelism when the queue is short
+        const auto compressStage = [&]() {
+            DecodedImage image;
+            while (decoded.pop(image)) {
+                const auto begin = std::chrono::steady_clock::now();
+                const size_t busy = ++busyCompressors;
+                const bool parallel = decoded.size() < this->options.compressionThreads;
+                omp_set_num_threads(parallel ? static_cast<int>(std::max<size_t>(1, maxThreads / busy)) : 1);
+
+                CodedImage file;
+                file.job = image.job;
+                try {
+                    file.jpeg = encodeJPEG(
+                        image.pixels,
+                        image.channels,
+                        this->options.subsampling,
+                        this->options.method,
+                        this->options.optimizeHuffman,
+                        this->options.restartRows,
+                        this->options.quality
+                    );
+                } catch (const std::exception& e) {
+                    --busyCompressors;
+                    fail(image.job, e.what());
+                    continue;
+                }
+                --busyCompressors;
+                image.pixels = Plane<uint8_t>();  // release the pixels before waiting on the queue
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    report.parallelImages += parallel ? 1 : 0;
+                }
+                account(report.compress, file.jpeg.size(), elapsedSeconds(begin));
+                coded.push(std::move(file));
+            }
+            if (--activeCompressors == 0) {
+                coded.close();
+            }
+        };
+
+        // write: the files are saved as soon as they are coded
+        const auto writeStage = [&]() {
+            CodedImage file;
+            while (coded.pop(file)) {
+                const auto begin = std::chrono::steady_clock::now();
+                std::ofstream output(jobs[file.job].output, std::ios::binary);
+                output.write(reinterpret_cast<const char*>(file.jpeg.data()), static_cast<std::streamsize>(file.jpeg.size()));
+                output.close();
+                if (!output) {
+                    fail(file.job, "could not write " + jobs[file.job].output);
+                    continue;
+                }
+                account(report.write, file.jpeg.size(), elapsedSeconds(begin));
+            }
+        };
+
+        std::vector<std::thread> threads;
+        const auto launch = [&](const size_t count, const std::function<void()>& stage) {
+            for (size_t i = 0; i < count; ++i) {
+                threads.emplace_back(stage);
+            }
+        };
+        launch(this->options.writeThreads, writeStage);
+        launch(this->options.compressionThreads, compressStage);
+        launch(this->options.decodeThreads, decodeStage);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        report.wallSeconds = elapsedSeconds(start);
+        return report;
+    }
+
+    void BatchReport::print(std::ostream& stream, const BatchOptions& options) const {
+        const std::ios::fmtflags flags = stream.flags();
+        const std::streamsize precision = stream.precision();
+        stream << std::fixed << std::setprecision(2);
+        stream << "Batch: " << this->images << " images, " << this->errors.size() << " failed, "
+               << this->parallelImages << " compressed with intra-image threads, " << this->wallSeconds << " s" << std::endl;
+
+        const auto printStage = [&](const char* name, const StageStatistics& stage, const size_t threads) {
+            const double wall = this->wallSeconds > 0.0 ? this->wallSeconds : 1.0;
+            stream << "  " << std::left << std::setw(9) << name << std::right
+                   << std::setw(8) << stage.items << " images "
+                   << std::setw(10) << static_cast<double>(stage.bytes) / 1e6 << " MB "
+                   << std::setw(9) << stage.items / wall << " images/s "
+                   << std::setw(9) << static_cast<double>(stage.bytes) / 1e6 / wall << " MB/s "
+                   << std::setw(7) << 100.0 * stage.busySeconds / (wall * threads) << " % busy ("
+                   << threads << " threads)" << std::endl;
+        };
+        printStage("decode", this->decode, options.decodeThreads);
+        printStage("compress", this->compress, options.compressionThreads);
+        printStage("write", this->write, options.writeThreads);
+
+        for (const std::string& error : this->errors) {
+            stream << "  error: " << error << std::endl;
+        }
+        stream.flags(flags);
+        stream.precision(precision);
+    }
+
+    // #################### FUNCTIONS ####################
+
+    std::vector<BatchJob> listBatchJobs(const std::string& inputDirectory, const std::string& outputDirectory) {
+        DIR* directory = opendir(inputDirectory.c_str());
+        if (directory == nullptr) {
+            throw std::runtime_error("Error: could not open the directory " + inputDirectory);
+        }
+        std::vector<std::string> names;
+        for (const dirent* entry = readdir(directory); entry != nullptr; entry = readdir(directory)) {
+            const std::string name = entry->d_name;
+            if (isImageFile(name)) {
+                names.push_back(name);
+            }
+        }
+        closedir(directory);
+        std::sort(names.begin(), names.end());
+
+        const auto join = [](const std::string& directory, const std::string& name) {
+            return directory.empty() || directory.back() == '/' ? directory + name : directory + "/" + name;
+        };
+
+        // the .jpg file of the same name, unless the name is shared by another image (a.png and a.bmp)
+        // or it is an image of the directory itself (a.jpg, when the output directory is the input one)
+        const std::string inputIdentity = getFileIdentity(inputDirectory.empty() ? "." : inputDirectory);
+        const bool sameDirectory = !inputIdentity.empty() &&
+                                   inputIdentity == getFileIdentity(outputDirectory.empty() ? "." : outputDirectory);
+        std::map<std::string, size_t> stems;
+        for (const std::string& name : names) {
+            ++stems[name.substr(0, name.rfind('.')) + ".jpg"];
+        }
+
+        std::vector<BatchJob> jobs;
+        jobs.reserve(names.size());
+        for (const std::string& name : names) {
+            std::string output = name.substr(0, name.rfind('.')) + ".jpg";
+            if (stems[output] > 1 || (sameDirectory && std::binary_search(names.begin(), names.end(), output))) {
+                output = name + ".jpg";
+            }
+            BatchJob job;
+            job.input = join(inputDirectory, name);
+            job.output = join(outputDirectory, output);
+            jobs.push_back(job);
+        }
+        return jobs;
+    }
+}
@@ -0,0 +1,191 @@
+#ifndef JPEG_BATCH_COMPRESSOR_HPP
+#define JPEG_BATCH_COMPRESSOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "compression/jpeg_image_compression/chroma_subsampling.hpp"
+#include "compression/jpeg_image_compression/dct_method.hpp"
+#include "compression/jpeg_image_compression/quantization/quantization.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * An image of a batch: the file to decode (PNG or any format of stb_image) and the .jpg file to write.
+     */
+    struct BatchJob {
+        std::string input;
+        std::string output;
+    };
+
+    /**
+     * Parameters of a BatchCompressor: the threads of every stage of the pipeline and the coding of the files.
+     */
+    struct BatchOptions {
+        /**
+         * Number of threads that read and decode the input files.
+         */
+        size_t decodeThreads = 2;
+        /**
+         * Number of threads that compress the images (0 for the number of OpenMP threads).
+         */
+        size_t compressionThreads = 0;
+        /**
+         * Number of threads that write the .jpg files.
+         */
+        size_t writeThreads = 1;
+        /**
+         * Maximum number of images waiting between two stages (decoded pixels, then coded files):
+         * it bounds the memory of the pipeline to about 2 * queueCapacity images.
+         */
+        size_t queueCapacity = 8;
+        /**
+         * The quality, from 1 to 100 (see getQuantizationTable).
+         */
+        int quality = DEFAULT_QUALITY;
+        /**
+         * Resolution of the chroma of the color images.
+         */
+        ChromaSubsampling subsampling = ChromaSubsampling::YUV420;
+        /**
+         * Arithmetic of the DCT and of the quantization.
+         */
+        DCTMethod method = DCTMethod::FLOAT;
+        /**
+         * True for the optimized Huffman tables, false for the standard ones.
+         */
+        bool optimizeHuffman = false;
+        /**
+         * Number of rows of MCUs of each restart segment (0 for one segment).
+         */
+        size_t restartRows = 1;
+    };
+
+    /**
+     * Counters of a stage of the pipeline, summed over its threads.
+     */
+    struct StageStatistics {
+        /**
+         * Number of images processed by the stage.
+         */
+        size_t items = 0;
+        /**
+         * Bytes produced by the stage: the decoded pixels, the coded files, the written files.
+         */
+        size_t bytes = 0;
+        /**
+         * Time spent processing the images (without the waits on the queues), in seconds.
+         */
+        double busySeconds = 0.0;
+    };
+
+    /**
+     * Result of a batch: the counters of the stages and the images that failed.
+     */
+    struct BatchReport {
+        /**
+         * Number of images of the batch.
+         */
+        size_t images = 0;
+        /**
+         * Number of images compressed with the intra-image parallel paths (the queue of the decoded
+         * images was shorter than the number of compression threads).
+         */
+        size_t parallelImages = 0;
+        StageStatistics decode;
+        StageStatistics compress;
+        StageStatistics write;
+        /**
+         * Duration of the batch, in seconds.
+         */
+        double wallSeconds = 0.0;
+        /**
+         * The images that failed, as "path: message" (the others are written anyway).
+         */
+        std::vector<std::string> errors;
+
+        /**
+         * Function that prints the counters of every stage: images, bytes, busy time, throughput
+         * over the duration of the batch and utilization of the threads of the stage.
+         *
+         * @param stream: the output stream.
+         * @param options: the options of the batch (the threads of the stages).
+         */
+        void print(std::ostream& stream, const BatchOptions& options) const;
+    };
+
+    /**
+     * Compressor of many images to baseline JFIF files, as a pipeline of three stages connected by
+     * bounded queues (see BoundedQueue): the decode threads read the files (mapped, see MappedFile)
+     * and decode them with stb_image, the compression threads code the .jpg files in memory, and the
+     * write threads save them. The stages overlap, so the I/O and the decoding of the next images
+     * are hidden behind the compression of the current ones.
+     *
+     * Every compression thread codes one image at a time. The encoders are parallelized with OpenMP
+     * inside the image too, which pays off only when there are idle cores: before each image, a thread
+     * uses its share of the OpenMP threads if the queue of the decoded images is shorter than the number
+     * of compression threads (e.g. at the end of the batch, or with slow decoding), one thread otherwise.
+     *
+     * The images with 1 or 2 channels are coded as grayscale files, the others as YCbCr ones (see encodeJPEG).
+     */
+    class BatchCompressor {
+    public:
+        /**
+         * Constructor of a compressor.
+         *
+         * @param options: the threads of the stages and the coding of the files.
+         * @throws std::invalid_argument if a stage has no threads, the capacity of the queues is 0 or
+         *                               the quality is not in [1, 100].
+         */
+        explicit BatchCompressor(const BatchOptions& options = BatchOptions());
+
+        /**
+         * Function that compresses the images of a batch. The errors of an image (unreadable file, failed
+         * write, ...) do not stop the batch: they are collected in the report.
+         * A job whose output is an input of the batch, or the output of an earlier job, is not run and is reported
+         * as an error (the paths are compared by the name in the device and inode of their directory and, for the existing files,
+         * by their own device and inode).
+         *
+         * @param jobs: the input and output files.
+         * @return: the counters of the stages and the errors.
+         */
+        BatchReport run(const std::vector<BatchJob>& jobs) const;
+
+        /**
+         * Function that compresses the images of a directory (see listBatchJobs and run).
+         *
+         * @param inputDirectory: the directory of the images.
+         * @param outputDirectory: the existing directory of the .jpg files.
+         * @return: the counters of the stages and the errors.
+         * @throws std::runtime_error if the input directory cannot be read.
+         */
+        BatchReport run(const std::string& inputDirectory, const std::string& outputDirectory) const;
+
+        /**
+         * Get the options of the compressor.
+         * @return The options.
+         */
+        [[nodiscard]] const BatchOptions& getOptions() const;
+
+    private:
+        BatchOptions options;
+    };
+
+    /**
+     * Function that lists the images of a directory (PNG, JPEG, BMP, TGA, GIF and PNM files, by extension,
+     * not recursively), sorted by name, each with the .jpg file of the same name in the output directory.
+     * The source extension is kept (a.png.jpg) when the name is shared by several images (a.png and a.bmp),
+     * or when the output directory is the input one and the .jpg file is an image of the batch (a.jpg).
+     *
+     * @param inputDirectory: the directory of the images.
+     * @param outputDirectory: the directory of the .jpg files.
+     * @return: the jobs of the images.
+     * @throws std::runtime_error if the input directory cannot be read.
+     */
+    std::vector<BatchJob> listBatchJobs(const std::string& inputDirectory, const std::string& outputDirectory);
+}
+
+#endif //JPEG_BATCH_COMPRESSOR_HPP
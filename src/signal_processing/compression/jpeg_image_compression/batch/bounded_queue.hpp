@@ -0,0 +1,99 @@
+#ifndef JPEG_BOUNDED_QUEUE_HPP
+#define JPEG_BOUNDED_QUEUE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace sp::jpeg
+{
+    /**
+     * Blocking FIFO queue with a maximum number of items, between the stages of a pipeline: a producer
+     * waits while the queue is full (so a fast stage cannot fill the memory ahead of a slow one), a consumer
+     * waits while it is empty. When the producers are done, close lets the consumers drain it and stop.
+     *
+     * @tparam T: the type of the items (movable).
+     */
+    template <typename T>
+    class BoundedQueue {
+    public:
+        /**
+         * Constructor of an empty queue.
+         *
+         * @param capacity: the maximum number of items.
+         * @throws std::invalid_argument if the capacity is 0.
+         */
+        explicit BoundedQueue(const size_t capacity): capacity(capacity) {
+            if (capacity == 0) {
+                throw std::invalid_argument("The capacity of a queue must be positive");
+            }
+        }
+
+        /**
+         * Add an item at the end of the queue, waiting while it is full.
+         *
+         * @param item: the item (moved).
+         * @return: false if the queue is closed (the item is dropped), true otherwise.
+         */
+        bool push(T item) {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->notFull.wait(lock, [this]() { return this->closed || this->items.size() < this->capacity; });
+            if (this->closed) {
+                return false;
+            }
+            this->items.push_back(std::move(item));
+            this->notEmpty.notify_one();
+            return true;
+        }
+
+        /**
+         * Remove the first item of the queue, waiting while it is empty and open.
+         *
+         * @param item: the item (output).
+         * @return: false if the queue is closed and empty, true otherwise.
+         */
+        bool pop(T& item) {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->notEmpty.wait(lock, [this]() { return this->closed || !this->items.empty(); });
+            if (this->items.empty()) {
+                return false;
+            }
+            item = std::move(this->items.front());
+            this->items.pop_front();
+            this->notFull.notify_one();
+            return true;
+        }
+
+        /**
+         * Close the queue: the waiting producers and consumers are woken up, the items left can still be popped.
+         */
+        void close() {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->closed = true;
+            this->notFull.notify_all();
+            this->notEmpty.notify_all();
+        }
+
+        /**
+         * Get the number of items in the queue.
+         * @return The number of items (it may change as soon as it is returned).
+         */
+        [[nodiscard]] size_t size() const {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            return this->items.size();
+        }
+
+    private:
+        const size_t capacity;
+        std::deque<T> items;
+        bool closed = false;
+        mutable std::mutex mutex;
+        std::condition_variable notFull;
+        std::condition_variable notEmpty;
+    };
+}
+
+#endif //JPEG_BOUNDED_QUEUE_HPP
@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <stdexcept>
+#include <utility>
+
+#include "compression/jpeg_image_compression/block_coder/block_coder.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Reserved int16 value that introduces a run (count, value).
+     */
+    constexpr int16_t RUN_MARKER = -1;
+
+    /**
+     * Append an int16 to the output, in the byte order of the machine (as written by std::ofstream::write).
+     */
+    static uint8_t* writeInt16(uint8_t* output, const int16_t value) {
+        std::memcpy(output, &value, sizeof(value));
+        return output + sizeof(value);
+    }
+
+    size_t encodeBlock(const int16_t* coefficients, uint8_t* output) {
+        uint8_t* cursor = output;
+        size_t k = 0;
+        while (k < dct::algo::DCT_BLOCK_AREA) {
+            const int16_t value = coefficients[ZIGZAG_ORDER[k]];
+            size_t count = 1;
+            while (k + count < dct::algo::DCT_BLOCK_AREA && coefficients[ZIGZAG_ORDER[k + count]] == value) {
+                ++count;
+            }
+            const bool fitsInt8 = value >= INT8_MIN && value <= INT8_MAX;
+            if (fitsInt8 && (count > 1 || value == RUN_MARKER)) {
+                // Write the reserved value and then #repetitions and value
+                cursor = writeInt16(cursor, RUN_MARKER);
+                cursor = writeInt16(cursor, static_cast<int16_t>(count));
+                *cursor++ = static_cast<uint8_t>(static_cast<int8_t>(value));
+            } else {
+                // Write only the values and ignore repetitions (never -1 here)
+                for (size_t i = 0; i < count; ++i) {
+                    cursor = writeInt16(cursor, value);
+                }
+            }
+            k += count;
+        }
+        return static_cast<size_t>(cursor - output);
+    }
+
+    size_t decodeBlock(const uint8_t* input, const size_t size, int16_t* coefficients) {
+        size_t position = 0;
+        size_t k = 0;
+        const auto readInt16 = [&]() {
+            if (position + sizeof(int16_t) > size) {
+                throw std::runtime_error("Error: the compressed binary data is truncated");
+            }
+            int16_t value;
+            std::memcpy(&value, input + position, sizeof(value));
+            position += sizeof(value);
+            return value;
+        };
+
+        int16_t scanned[dct::algo::DCT_BLOCK_AREA];
+        while (k < dct::algo::DCT_BLOCK_AREA) {
+            const int16_t v = readInt16();
+            if (v != RUN_MARKER) {
+                // v is not a reserved value => it is a value with no contiguous repetitions
+                scanned[k++] = v;
+                continue;
+            }
+            // we have found a reserved value => the next two values are (#repetitions, value)
+            const int16_t count = readInt16();
+            if (position + 1 > size) {
+                throw std::runtime_error("Error: the compressed binary data is truncated");
+            }
+            const auto value = static_cast<int8_t>(input[position++]);
+            if (count < 1 || k + static_cast<size_t>(count) > dct::algo::DCT_BLOCK_AREA) {
+                throw std::runtime_error(
+                    "Error: invalid run of " + std::to_string(count) + " values in the compressed binary data"
+                );
+            }
+            std::fill_n(scanned + k, count, value);
+            k += count;
+        }
+        utils::zigzag::inverseScanBlock<dct::algo::DCT_BLOCK_SIZE>(scanned, coefficients);
+        return position;
+    }
+
+    size_t skipBlock(const uint8_t* input, const size_t size) {
+        size_t position = 0;
+        size_t k = 0;
+        while (k < dct::algo::DCT_BLOCK_AREA) {
+            if (position + sizeof(int16_t) > size) {
+                throw std::runtime_error("Error: the compressed binary data is truncated");
+            }
+            int16_t v;
+            std::memcpy(&v, input + position, sizeof(v));
+            position += sizeof(v);
+            if (v != RUN_MARKER) {
+                ++k;
+                continue;
+            }
+            // (#repetitions, value): int16 + int8
+            if (position + sizeof(int16_t) + 1 > size) {
+                throw std::runtime_error("Error: the compressed binary data is truncated");
+            }
+            int16_t count;
+            std::memcpy(&count, input + position, sizeof(count));
+            position += sizeof(count) + 1;
+            if (count < 1 || k + static_cast<size_t>(count) > dct::algo::DCT_BLOCK_AREA) {
+                throw std::runtime_error(
+                    "Error: invalid run of " + std::to_string(count) + " values in the compressed binary data"
+                );
+            }
+            k += count;
+        }
+        return position;
+    }
+
+    void writeCompressedBinaryHeader(
+        const size_t rows,
+        const size_t cols,
+        const double* quantization,
+        std::vector<uint8_t>& binary
+    ) {
+        const uint32_t version = COMPRESSED_BINARY_VERSION;
+        const int header[3] = {static_cast<int>(rows), static_cast<int>(cols), dct::algo::DCT_BLOCK_SIZE};
+        const auto* versionBytes = reinterpret_cast<const uint8_t*>(&version);
+        const auto* headerBytes = reinterpret_cast<const uint8_t*>(header);
+        const auto* quantizationBytes = reinterpret_cast<const uint8_t*>(quantization);
+        binary.insert(binary.end(), COMPRESSED_BINARY_MAGIC, COMPRESSED_BINARY_MAGIC + sizeof(COMPRESSED_BINARY_MAGIC));
+        binary.insert(binary.end(), versionBytes, versionBytes + sizeof(version));
+        binary.insert(binary.end(), headerBytes, headerBytes + sizeof(header));
+        binary.insert(binary.end(), quantizationBytes, quantizationBytes + dct::algo::DCT_BLOCK_AREA * sizeof(double));
+    }
+
+    CompressedBinaryHeader readCompressedBinaryHeader(const uint8_t* binary, const size_t size) {
+        CompressedBinaryHeader result;
+        size_t position = 0;
+        const bool versioned = size >= sizeof(COMPRESSED_BINARY_MAGIC) &&
+            std::memcmp(binary, COMPRESSED_BINARY_MAGIC, sizeof(COMPRESSED_BINARY_MAGIC)) == 0;
+        if (versioned) {
+            if (size < QUANTIZED_BINARY_HEADER_SIZE) {
+                throw std::runtime_error("Error: the compressed binary file is truncated");
+            }
+            uint32_t version;
+            std::memcpy(&version, binary + sizeof(COMPRESSED_BINARY_MAGIC), sizeof(version));
+            if (version != COMPRESSED_BINARY_VERSION) {
+                throw std::runtime_error(
+                    "Error: unsupported version " + std::to_string(version) + " of the compressed binary file"
+                );
+            }
+            position = sizeof(COMPRESSED_BINARY_MAGIC) + sizeof(version);
+        } else if (size < COMPRESSED_BINARY_HEADER_SIZE) {
+            throw std::runtime_error("Error: the compressed binary file is truncated");
+        }
+
+        int header[3];
+        std::memcpy(header, binary + position, sizeof(header));
+        position += sizeof(header);
+        const int submatrixSize = header[2];
+        if (submatrixSize != dct::algo::DCT_BLOCK_SIZE) {
+            throw std::runtime_error(
+                "Error: the compressed binary file cannot be decompressed using jpeg (submatrix size != 8)"
+            );
+        }
+        if (header[0] <= 0 || header[1] <= 0 || header[0] % submatrixSize != 0 || header[1] % submatrixSize != 0) {
+            throw std::runtime_error("Error: invalid image sizes in the compressed binary file");
+        }
+        result.rows = static_cast<size_t>(header[0]);
+        result.cols = static_cast<size_t>(header[1]);
+
+        // version 1: the quantization matrix follows the sizes
+        if (versioned) {
+            result.quantization.resize(dct::algo::DCT_BLOCK_AREA);
+            std::memcpy(result.quantization.data(), binary + position, dct::algo::DCT_BLOCK_AREA * sizeof(double));
+            position += dct::algo::DCT_BLOCK_AREA * sizeof(double);
+            for (const double value : result.quantization) {
+                if (!(value > 0.0)) {
+                    throw std::runtime_error("Error: invalid quantization matrix in the compressed binary file");
+                }
+            }
+        }
+        result.size = position;
+        return result;
+    }
+
+    /**
+     * Magic of the index appended to a compressed binary file.
+     */
+    constexpr uint8_t BLOCK_INDEX_MAGIC[4] = {'S', 'P', 'B', 'I'};
+
+    BlockIndex buildBlockIndex(const uint8_t* binary, const size_t size, const size_t checkpointBlocks) {
+        const CompressedBinaryHeader header = readCompressedBinaryHeader(binary, size);
+
+        BlockIndex index;
+        index.blockRows = header.rows / dct::algo::DCT_BLOCK_SIZE;
+        index.blockCols = header.cols / dct::algo::DCT_BLOCK_SIZE;
+        index.checkpointBlocks = checkpointBlocks == 0 ? index.blockCols : std::min(checkpointBlocks, index.blockCols);
+        index.offsets.reserve(index.blockRows * index.getCheckpointsPerRow() + 1);
+
+        size_t position = header.size;
+        for (size_t r = 0; r < index.blockRows; ++r) {
+            for (size_t c = 0; c < index.blockCols; ++c) {
+                if (c % index.checkpointBlocks == 0) {
+                    index.offsets.push_back(position);
+                }
+                position += skipBlock(binary + position, size - position);
+            }
+        }
+        index.offsets.push_back(position);
+        return index;
+    }
+
+    /**
+     * Append an uint64 to the output, in the byte order of the machine.
+     */
+    static void appendUint64(std::vector<uint8_t>& output, const uint64_t value) {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+        output.insert(output.end(), bytes, bytes + sizeof(value));
+    }
+
+    void appendBlockIndex(const BlockIndex& index, std::vector<uint8_t>& binary) {
+        const uint64_t indexOffset = binary.size();
+        binary.reserve(binary.size() + (index.offsets.size() + 2) * sizeof(uint64_t) + sizeof(BLOCK_INDEX_MAGIC));
+        appendUint64(binary, index.checkpointBlocks);
+        for (const uint64_t offset : index.offsets) {
+            appendUint64(binary, offset);
+        }
+        appendUint64(binary, indexOffset);
+        binary.insert(binary.end(), BLOCK_INDEX_MAGIC, BLOCK_INDEX_MAGIC + sizeof(BLOCK_INDEX_MAGIC));
+    }
+
+    bool readBlockIndex(const uint8_t* binary, const size_t size, BlockIndex& index) {
+        const CompressedBinaryHeader header = readCompressedBinaryHeader(binary, size);
+
+        // The magic alone does not mark an index: the coded blocks of a file without index may end with its
+        // bytes. The trailer is an index only if it is consistent with the file, otherwise the file is decoded
+        // linearly (the blocks are read from the header, so the trailing bytes are ignored).
+        constexpr size_t trailerSize = sizeof(uint64_t) + sizeof(BLOCK_INDEX_MAGIC);
+        if (size < header.size + sizeof(uint64_t) + trailerSize ||
+            std::memcmp(binary + size - sizeof(BLOCK_INDEX_MAGIC), BLOCK_INDEX_MAGIC, sizeof(BLOCK_INDEX_MAGIC)) != 0) {
+            return false;
+        }
+        uint64_t indexOffset;
+        std::memcpy(&indexOffset, binary + size - trailerSize, sizeof(indexOffset));
+
+        const size_t blockRows = header.rows / dct::algo::DCT_BLOCK_SIZE;
+        const size_t blockCols = header.cols / dct::algo::DCT_BLOCK_SIZE;
+        // (indexOffset comes from the file: no sums with it, a huge value would wrap around)
+        if (indexOffset < header.size || indexOffset > size - trailerSize - sizeof(uint64_t)) {
+            return false;
+        }
+        uint64_t checkpointBlocks;
+        std::memcpy(&checkpointBlocks, binary + indexOffset, sizeof(checkpointBlocks));
+        if (checkpointBlocks == 0 || checkpointBlocks > blockCols) {
+            return false;
+        }
+
+        // the offsets fill the index up to the trailer, they are increasing, the first one is the first block
+        // and the last one is the end of the blocks (the beginning of the index)
+        BlockIndex candidate;
+        candidate.blockRows = blockRows;
+        candidate.blockCols = blockCols;
+        candidate.checkpointBlocks = checkpointBlocks;
+        const size_t numOffsets = blockRows * candidate.getCheckpointsPerRow() + 1;
+        if ((size - trailerSize - indexOffset) / sizeof(uint64_t) != numOffsets + 1 ||
+            (size - trailerSize - indexOffset) % sizeof(uint64_t) != 0) {
+            return false;
+        }
+        candidate.offsets.resize(numOffsets);
+        std::memcpy(candidate.offsets.data(), binary + indexOffset + sizeof(uint64_t), numOffsets * sizeof(uint64_t));
+        if (candidate.offsets.front() != header.size || candidate.offsets.back() != indexOffset) {
+            return false;
+        }
+        uint64_t previous = header.size;
+        for (const uint64_t offset : candidate.offsets) {
+            if (offset < previous) {
+                return false;
+            }
+            previous = offset;
+        }
+        index = std::move(candidate);
+        return true;
+    }
+}
@@ -0,0 +1,200 @@
+#ifndef BLOCK_CODER_HPP
+#define BLOCK_CODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "transforms/discrete_cosine_transform/algorithms/dct_8x8.hpp"
+#include "utils/zigzag_scan.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Zigzag order of an 8x8 block: ZIGZAG_ORDER[k] is the row-major index of the k-th scanned coefficient
+     * (the compile-time table of utils::zigzag, the same traversal of utils::zigzag::ZigZagScan).
+     */
+    constexpr const uint16_t* ZIGZAG_ORDER = utils::zigzag::ZIGZAG_8X8.order;
+
+    /**
+     * Upper bound of the bytes written by encodeBlock for one block (64 escaped runs of 5 bytes).
+     */
+    constexpr size_t MAX_ENCODED_BLOCK_SIZE = 5 * dct::algo::DCT_BLOCK_AREA;
+
+    /**
+     * Function that zigzag-scans and run-length encodes a block of quantized coefficients,
+     * in the format of the compressed binary files (see CompressedImage::save_as_compressed_binary):
+     *  - a value without contiguous repetitions is written as an int16;
+     *  - a run of count > 1 equal values is written as the reserved int16 -1, the int16 count and the value as int8.
+     * A single -1 is written as a run of count 1 (it would be read as the reserved value), and runs of values
+     * that do not fit in an int8 are written value by value.
+     *
+     * The block is scanned through ZIGZAG_ORDER in place of the intermediate vectors, so it stays in L1
+     * (or in registers), and the runs are written as they are found: on the quantized blocks this single pass
+     * is faster than a zigzag copy followed by RLECompressor::compress.
+     *
+     * @param coefficients: the 64 quantized coefficients, row-major.
+     * @param output: buffer of at least MAX_ENCODED_BLOCK_SIZE bytes.
+     * @return: the number of bytes written.
+     */
+    size_t encodeBlock(const int16_t* coefficients, uint8_t* output);
+
+    /**
+     * Function that decodes a block written by encodeBlock (run-length decoding and inverse zigzag scan).
+     *
+     * @param input: pointer to the encoded block.
+     * @param size: number of available bytes from input.
+     * @param coefficients: the 64 quantized coefficients, row-major (output).
+     * @return: the number of bytes read.
+     * @throws std::runtime_error if the data is truncated or a run overflows the block.
+     */
+    size_t decodeBlock(const uint8_t* input, size_t size, int16_t* coefficients);
+
+    /**
+     * Function that gets the size of a block written by encodeBlock without decoding its coefficients.
+     *
+     * @param input: pointer to the encoded block.
+     * @param size: number of available bytes from input.
+     * @return: the number of bytes of the block.
+     * @throws std::runtime_error if the data is truncated or a run overflows the block.
+     */
+    size_t skipBlock(const uint8_t* input, size_t size);
+
+    /**
+     * Size of the header of a compressed binary file of version 0: rows, cols and submatrix size (int each).
+     * These files do not carry their quantization matrix, their blocks were quantized with the one of
+     * makeQuantizationMatrix (quality 50).
+     */
+    constexpr size_t COMPRESSED_BINARY_HEADER_SIZE = 3 * sizeof(int);
+
+    /**
+     * Magic of the compressed binary files of version 1 and later, at the beginning of the header.
+     * Its first byte is odd, so it is never the first byte of the rows (a multiple of 8) of a file of version 0.
+     */
+    constexpr uint8_t COMPRESSED_BINARY_MAGIC[4] = {'S', 'P', 'J', 'B'};
+
+    /**
+     * Version of the compressed binary files written by writeCompressedBinaryHeader.
+     */
+    constexpr uint32_t COMPRESSED_BINARY_VERSION = 1;
+
+    /**
+     * Size of the header of a compressed binary file of version 1: the magic, the version (uint32), rows, cols
+     * and submatrix size (int each), then the 64 entries of the quantization matrix (double each, row-major).
+     */
+    constexpr size_t QUANTIZED_BINARY_HEADER_SIZE =
+        sizeof(COMPRESSED_BINARY_MAGIC) + sizeof(uint32_t) + COMPRESSED_BINARY_HEADER_SIZE +
+        dct::algo::DCT_BLOCK_AREA * sizeof(double);
+
+    /**
+     * Header of a compressed binary file.
+     */
+    struct CompressedBinaryHeader {
+        /**
+         * Number of rows and of columns of the image (multiples of 8).
+         */
+        size_t rows;
+        size_t cols;
+        /**
+         * Number of bytes of the header: the offset of the first block.
+         */
+        size_t size;
+        /**
+         * The quantization matrix of the blocks, row-major (empty for a file of version 0).
+         */
+        std::vector<double> quantization;
+    };
+
+    /**
+     * Function that writes the header of a compressed binary file of the current version, with the quantization
+     * matrix of its blocks, at the end of the output.
+     *
+     * @param rows: number of rows of the image (a multiple of 8).
+     * @param cols: number of columns of the image (a multiple of 8).
+     * @param quantization: the 64 entries of the quantization matrix, row-major.
+     * @param binary: the bytes of the file (updated).
+     */
+    void writeCompressedBinaryHeader(size_t rows, size_t cols, const double* quantization, std::vector<uint8_t>& binary);
+
+    /**
+     * Function that reads the header of a compressed binary file, of version 0 (without magic) or 1.
+     *
+     * @param binary: the bytes of the file.
+     * @param size: number of bytes.
+     * @return: the sizes of the image, the size of the header and the quantization matrix of the file.
+     * @throws std::runtime_error if the header is truncated, the version is not supported,
+     *                            the submatrix size is not 8 or the sizes are not valid.
+     */
+    CompressedBinaryHeader readCompressedBinaryHeader(const uint8_t* binary, size_t size);
+
+    /**
+     * Index of the blocks of a compressed binary file, for the random access to a region of the image.
+     *
+     * The blocks are coded one after the other in raster order, with variable sizes: a checkpoint is the
+     * file offset of a block, taken every checkpointBlocks blocks of each row of blocks (the first block of
+     * every row is a checkpoint). A block is reached by decoding at most checkpointBlocks - 1 blocks from its
+     * checkpoint; the DC coefficients are stored as they are (no prediction), so there is no other state.
+     *
+     * The index can be appended to the file (see appendBlockIndex): it follows the blocks, so the readers
+     * that decode the blocks sequentially ignore it.
+     */
+    struct BlockIndex {
+        /**
+         * Number of rows and of columns of blocks of the image.
+         */
+        size_t blockRows;
+        size_t blockCols;
+        /**
+         * Number of blocks between two consecutive checkpoints of a row of blocks.
+         */
+        size_t checkpointBlocks;
+        /**
+         * The file offsets of the checkpoints, row by row (getCheckpointsPerRow each), then the end of the blocks.
+         */
+        std::vector<uint64_t> offsets;
+
+        /**
+         * Get the number of checkpoints of each row of blocks.
+         * @return ceil(blockCols / checkpointBlocks).
+         */
+        [[nodiscard]] size_t getCheckpointsPerRow() const {
+            return (blockCols + checkpointBlocks - 1) / checkpointBlocks;
+        }
+    };
+
+    /**
+     * Function that builds the index of a compressed binary file by a scan of its blocks (see skipBlock).
+     *
+     * @param binary: the bytes of the file.
+     * @param size: number of bytes.
+     * @param checkpointBlocks: number of blocks between two checkpoints of a row (0 for one checkpoint per row).
+     * @return: the index.
+     * @throws std::runtime_error if the file is corrupted.
+     */
+    BlockIndex buildBlockIndex(const uint8_t* binary, size_t size, size_t checkpointBlocks = 0);
+
+    /**
+     * Function that appends an index at the end of a compressed binary file: the number of blocks between
+     * two checkpoints and the offsets (uint64 each), then the offset of the index (uint64) and the magic "SPBI".
+     *
+     * @param index: the index of the blocks of the file.
+     * @param binary: the bytes of the file (updated).
+     */
+    void appendBlockIndex(const BlockIndex& index, std::vector<uint8_t>& binary);
+
+    /**
+     * Function that reads the index appended to a compressed binary file by appendBlockIndex.
+     * A trailer that ends with the magic but is not consistent with the file (offsets out of order, not starting
+     * at the first block or not ending at the index) is not an index: the coded blocks of a file without index
+     * may end with the bytes of the magic, and such a file is decoded linearly.
+     *
+     * @param binary: the bytes of the file.
+     * @param size: number of bytes.
+     * @param index: the index (output, unchanged if the file has no index).
+     * @return: true if the file has a valid index, false otherwise.
+     * @throws std::runtime_error if the header is corrupted.
+     */
+    bool readBlockIndex(const uint8_t* binary, size_t size, BlockIndex& index);
+}
+
+#endif //BLOCK_CODER_HPP
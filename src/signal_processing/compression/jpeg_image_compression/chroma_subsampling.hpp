@@ -0,0 +1,26 @@
+#ifndef JPEG_CHROMA_SUBSAMPLING_HPP
+#define JPEG_CHROMA_SUBSAMPLING_HPP
+
+namespace sp::jpeg
+{
+    /**
+     * Resolution of the chroma components (Cb, Cr) of a color JPEG image, relative to the luma (Y).
+     */
+    enum class ChromaSubsampling {
+        /**
+         * Full-resolution chroma: MCUs of 8x8 pixels with one block per component.
+         */
+        YUV444,
+        /**
+         * Chroma halved horizontally: MCUs of 16x8 pixels with 2 luma blocks and one block per chroma.
+         */
+        YUV422,
+        /**
+         * Chroma halved horizontally and vertically (default of most encoders): MCUs of 16x16 pixels
+         * with 4 luma blocks and one block per chroma, half of the blocks of 4:4:4.
+         */
+        YUV420
+    };
+}
+
+#endif //JPEG_CHROMA_SUBSAMPLING_HPP
@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <cstring>
+#include <omp.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "compression/jpeg_image_compression/color/color_conversion.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Fixed-point precision of the conversion coefficients (16 fractional bits, as libjpeg).
+     */
+    constexpr int SCALE_BITS = 16;
+    constexpr int32_t ONE_HALF = 1 << (SCALE_BITS - 1);
+    constexpr int32_t CENTER = 128 << SCALE_BITS;
+
+    static inline uint8_t clampToByte(const int32_t value) {
+        return static_cast<uint8_t>(value < 0 ? 0 : value > 255 ? 255 : value);
+    }
+
+    static void checkFactors(const int horizontal, const int vertical) {
+        if (horizontal < 1 || horizontal > 4 || vertical < 1 || vertical > 4) {
+            throw std::invalid_argument(
+                "The chroma sampling factors must be in [1, 4]. Given: " + std::to_string(horizontal) + "x" +
+                std::to_string(vertical)
+            );
+        }
+    }
+
+    void rgbToYCbCr(const uint8_t* rgb, const size_t count, uint8_t* y, uint8_t* cb, uint8_t* cr) {
+        #pragma omp simd
+        for (size_t i = 0; i < count; ++i) {
+            const int32_t r = rgb[3 * i];
+            const int32_t g = rgb[3 * i + 1];
+            const int32_t b = rgb[3 * i + 2];
+            // 0.299, 0.587, 0.114 / -0.16874, -0.33126, 0.5 / 0.5, -0.41869, -0.08131 (times 2^16),
+            // the chroma rounded with ONE_HALF - 1 so that the results never exceed 255
+            y[i] = static_cast<uint8_t>((19595 * r + 38470 * g + 7471 * b + ONE_HALF) >> SCALE_BITS);
+            cb[i] = static_cast<uint8_t>((-11059 * r - 21709 * g + 32768 * b + CENTER + ONE_HALF - 1) >> SCALE_BITS);
+            cr[i] = static_cast<uint8_t>((32768 * r - 27439 * g - 5329 * b + CENTER + ONE_HALF - 1) >> SCALE_BITS);
+        }
+    }
+
+    /**
+     * Convert a row, with a compile-time upsampling factor (so the index of the chroma is a shift
+     * or a constant division, and the loop is vectorized).
+     */
+    template <int HORIZONTAL>
+    static void convertRow(
+        const uint8_t* y, const uint8_t* cb, const uint8_t* cr, const size_t count, uint8_t* rgb
+    ) {
+        #pragma omp simd
+        for (size_t i = 0; i < count; ++i) {
+            const int32_t luma = y[i];
+            const int32_t blue = cb[i / HORIZONTAL] - 128;
+            const int32_t red = cr[i / HORIZONTAL] - 128;
+            // 1.402, -0.34414, -0.71414, 1.772 (times 2^16)
+            rgb[3 * i] = clampToByte(luma + ((91881 * red + ONE_HALF) >> SCALE_BITS));
+            rgb[3 * i + 1] = clampToByte(luma + ((-22554 * blue - 46802 * red + ONE_HALF) >> SCALE_BITS));
+            rgb[3 * i + 2] = clampToByte(luma + ((116130 * blue + ONE_HALF) >> SCALE_BITS));
+        }
+    }
+
+    void yCbCrToRgb(
+        const uint8_t* y, const uint8_t* cb, const uint8_t* cr, const size_t count, const int horizontal, uint8_t* rgb
+    ) {
+        switch (horizontal) {
+            case 1: convertRow<1>(y, cb, cr, count, rgb); break;
+            case 2: convertRow<2>(y, cb, cr, count, rgb); break;
+            case 3: convertRow<3>(y, cb, cr, count, rgb); break;
+            case 4: convertRow<4>(y, cb, cr, count, rgb); break;
+            default: checkFactors(horizontal, 1);
+        }
+    }
+
+    void convertAndDownsample(
+        const Plane<uint8_t>& rgb,
+        const size_t width,
+        const size_t height,
+        const int horizontal,
+        const int vertical,
+        Plane<uint8_t>& y,
+        Plane<uint8_t>& cb,
+        Plane<uint8_t>& cr
+    ) {
+        checkFactors(horizontal, vertical);
+        const size_t rows = y.getRows();
+        const size_t cols = y.getCols();
+        if (width == 0 || height == 0 || rgb.getRows() < height || rgb.getCols() < 3 * width ||
+            rows < height || cols < width || rows % vertical != 0 || cols % horizontal != 0 ||
+            cb.getRows() != rows / vertical || cb.getCols() != cols / horizontal ||
+            cr.getRows() != cb.getRows() || cr.getCols() != cb.getCols()) {
+            throw std::invalid_argument(
+                "Invalid planes for a " + std::to_string(width) + "x" + std::to_string(height) + " image. Given: " +
+                std::to_string(cols) + "x" + std::to_string(rows) + " luma, " + std::to_string(cb.getCols()) +
+                "x" + std::to_string(cb.getRows()) + " chroma"
+            );
+        }
+        const size_t chromaRows = cb.getRows();
+        const size_t chromaCols = cb.getCols();
+        const int area = horizontal * vertical;
+
+        #pragma omp parallel if(!omp_in_parallel())
+        {
+            // per-thread full-resolution chroma rows (vertical rows of Cb, then of Cr)
+            std::vector<uint8_t> buffer(2 * vertical * cols);
+
+            #pragma omp for schedule(static)
+            for (size_t r = 0; r < chromaRows; ++r) {
+                for (int v = 0; v < vertical; ++v) {
+                    // the rows below the image replicate its last row
+                    const size_t row = r * vertical + v;
+                    uint8_t* luma = y.row(row);
+                    uint8_t* blue = buffer.data() + v * cols;
+                    uint8_t* red = buffer.data() + (vertical + v) * cols;
+                    rgbToYCbCr(rgb.row(std::min(row, height - 1)), width, luma, blue, red);
+                    // the columns on the right of the image replicate its last column
+                    std::fill(luma + width, luma + cols, luma[width - 1]);
+                    std::fill(blue + width, blue + cols, blue[width - 1]);
+                    std::fill(red + width, red + cols, red[width - 1]);
+                }
+
+                // box filter: average of the horizontal x vertical values (rounded)
+                uint8_t* blue = cb.row(r);
+                uint8_t* red = cr.row(r);
+                if (area == 1) {
+                    std::memcpy(blue, buffer.data(), chromaCols);
+                    std::memcpy(red, buffer.data() + cols, chromaCols);
+                    continue;
+                }
+                for (size_t c = 0; c < chromaCols; ++c) {
+                    int blueSum = area / 2;
+                    int redSum = area / 2;
+                    for (int v = 0; v < vertical; ++v) {
+                        const uint8_t* blueRow = buffer.data() + v * cols + c * horizontal;
+                        const uint8_t* redRow = buffer.data() + (vertical + v) * cols + c * horizontal;
+                        for (int h = 0; h < horizontal; ++h) {
+                            blueSum += blueRow[h];
+                            redSum += redRow[h];
+                        }
+                    }
+                    blue[c] = static_cast<uint8_t>(blueSum / area);
+                    red[c] = static_cast<uint8_t>(redSum / area);
+                }
+            }
+        }
+    }
+
+    void upsampleAndConvert(
+        const Plane<uint8_t>& y,
+        const Plane<uint8_t>& cb,
+        const Plane<uint8_t>& cr,
+        const int horizontal,
+        const int vertical,
+        Plane<uint8_t>& rgb
+    ) {
+        checkFactors(horizontal, vertical);
+        const size_t height = rgb.getRows();
+        const size_t width = rgb.getCols() / 3;
+        if (y.getRows() < height || y.getCols() < width ||
+            cb.getRows() * vertical < height || cb.getCols() * horizontal < width ||
+            cr.getRows() != cb.getRows() || cr.getCols() != cb.getCols()) {
+            throw std::invalid_argument(
+                "Invalid planes for a " + std::to_string(width) + "x" + std::to_string(height) + " image. Given: " +
+                std::to_string(y.getCols()) + "x" + std::to_string(y.getRows()) + " luma, " +
+                std::to_string(cb.getCols()) + "x" + std::to_string(cb.getRows()) + " chroma"
+            );
+        }
+
+        #pragma omp parallel for schedule(static) if(!omp_in_parallel())
+        for (size_t r = 0; r < height; ++r) {
+            yCbCrToRgb(y.row(r), cb.row(r / vertical), cr.row(r / vertical), width, horizontal, rgb.row(r));
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef JPEG_COLOR_CONVERSION_HPP
+#define JPEG_COLOR_CONVERSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "compression/jpeg_image_compression/plane/plane.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Function that converts interleaved RGB pixels to the Y, Cb and Cr planes of JFIF
+     * (ITU-R BT.601 full range), in 16-bit fixed point as libjpeg; the loop is branch-free and vectorized.
+     *
+     * @param rgb: the interleaved pixels (3 bytes per pixel).
+     * @param count: number of pixels.
+     * @param y: the luma values (output).
+     * @param cb: the blue-difference chroma values (output).
+     * @param cr: the red-difference chroma values (output).
+     */
+    void rgbToYCbCr(const uint8_t* rgb, size_t count, uint8_t* y, uint8_t* cb, uint8_t* cr);
+
+    /**
+     * Function that converts a row of Y, Cb and Cr values to interleaved RGB pixels, upsampling the chroma
+     * in the same pass (each chroma value is used by horizontal consecutive pixels).
+     *
+     * @param y: the luma values (count values).
+     * @param cb: the blue-difference chroma values (count / horizontal values, rounded up).
+     * @param cr: the red-difference chroma values (count / horizontal values, rounded up).
+     * @param count: number of pixels.
+     * @param horizontal: the horizontal upsampling factor of the chroma (1 to 4).
+     * @param rgb: the interleaved pixels (output, 3 bytes per pixel).
+     */
+    void yCbCrToRgb(const uint8_t* y, const uint8_t* cb, const uint8_t* cr, size_t count, int horizontal, uint8_t* rgb);
+
+    /**
+     * Function that converts an RGB image to the planes of a color JPEG image: the luma at full resolution,
+     * the chroma downsampled by horizontal x vertical (box filter), all of them padded by replicating the
+     * last column and row of the image (padding with the edge values compresses better than zeros).
+     *
+     * The rows of the chroma are processed concurrently: every thread converts the vertical rows of RGB
+     * of a chroma row into the luma plane and into its own full-resolution chroma buffers, then averages them.
+     *
+     * @param rgb: the interleaved pixels of the image (height rows of 3 * width bytes).
+     * @param width: width of the image, in pixels.
+     * @param height: height of the image, in pixels.
+     * @param horizontal: horizontal downsampling factor of the chroma (1 to 4).
+     * @param vertical: vertical downsampling factor of the chroma (1 to 4).
+     * @param y: the luma plane (at least height x width, sizes multiple of vertical and horizontal).
+     * @param cb: the Cb plane (the sizes of y divided by vertical and horizontal).
+     * @param cr: the Cr plane (the sizes of cb).
+     * @throws std::invalid_argument if the sizes of the planes are not valid.
+     */
+    void convertAndDownsample(
+        const Plane<uint8_t>& rgb,
+        size_t width,
+        size_t height,
+        int horizontal,
+        int vertical,
+        Plane<uint8_t>& y,
+        Plane<uint8_t>& cb,
+        Plane<uint8_t>& cr
+    );
+
+    /**
+     * Function that converts the planes of a color JPEG image to RGB, with the upsampling of the chroma
+     * fused in the color conversion (see yCbCrToRgb); the rows are processed concurrently.
+     *
+     * @param y: the luma plane.
+     * @param cb: the Cb plane (downsampled by horizontal x vertical).
+     * @param cr: the Cr plane (the sizes of cb).
+     * @param horizontal: horizontal upsampling factor of the chroma (1 to 4).
+     * @param vertical: vertical upsampling factor of the chroma (1 to 4).
+     * @param rgb: the interleaved pixels (output): its rows and columns / 3 are the sizes of the image.
+     * @throws std::invalid_argument if the sizes of the planes are not valid.
+     */
+    void upsampleAndConvert(
+        const Plane<uint8_t>& y,
+        const Plane<uint8_t>& cb,
+        const Plane<uint8_t>& cr,
+        int horizontal,
+        int vertical,
+        Plane<uint8_t>& rgb
+    );
+}
+
+#endif //JPEG_COLOR_CONVERSION_HPP
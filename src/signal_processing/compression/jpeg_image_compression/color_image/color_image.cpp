@@ -0,0 +1,329 @@
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <cstring>
+
+#include "stb/stb_image.h"
+#include "stb/stb_image_write.h"
+
+#include "compression/jpeg_image_compression/color_image/color_image.hpp"
+#include "compression/jpeg_image_compression/color/color_conversion.hpp"
+#include "compression/jpeg_image_compression/compressed_image/compressed_image.hpp"
+#include "compression/jpeg_image_compression/image/image.hpp"
+#include "compression/jpeg_image_compression/jfif/jfif.hpp"
+#include "compression/jpeg_image_compression/quantization/quantization.hpp"
+#include "compression/jpeg_image_compression/rate_control/rate_control.hpp"
+#include "compression/jpeg_image_compression/scaled_decoding/scaled_decoding.hpp"
+#include "utils/mapped_file.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Function that gets the downsampling factors of the chroma.
+     */
+    static void getSamplingFactors(const ChromaSubsampling subsampling, int& horizontal, int& vertical) {
+        switch (subsampling) {
+            case ChromaSubsampling::YUV444: horizontal = 1; vertical = 1; break;
+            case ChromaSubsampling::YUV422: horizontal = 2; vertical = 1; break;
+            default: horizontal = 2; vertical = 2; break;
+        }
+    }
+
+    // #################### CONSTRUCTORS ####################
+
+    ColorImage::ColorImage(Plane<uint8_t> pixels): pixels(std::move(pixels)) {
+        if (this->pixels.getCols() % 3 != 0) {
+            throw std::invalid_argument(
+                "The columns of a RGB plane must be a multiple of 3. Given: " + std::to_string(this->pixels.getCols())
+            );
+        }
+    }
+
+    ColorImage::ColorImage(
+        const std::string& image_path,
+        const int option,
+        const DCTMethod method,
+        const size_t scale
+    ) {
+        checkDecodeScale(scale);
+        if (option == 1) {
+            if (scale != 1) {
+                throw std::invalid_argument("Error: only JPEG files can be decoded at a reduced scale");
+            }
+            this->pixels = load_from_png(image_path);
+        } else if (option == 2) {
+            this->pixels = load_from_jpeg(image_path, method, scale);
+        } else {
+            throw std::runtime_error(
+                "Error: invalid option in ColorImage constructor. "
+                "Acceptable ones are only option=1 for \"load image from a PNG file\", "
+                "or option=2 for \"load image from a JPEG file\""
+            );
+        }
+    }
+
+    // #################### PUBLIC ####################
+
+    size_t ColorImage::getWidth() const {
+        return this->pixels.getCols() / 3;
+    }
+
+    size_t ColorImage::getHeight() const {
+        return this->pixels.getRows();
+    }
+
+    void ColorImage::save_as_png(const std::string& path) {
+        if (this->pixels.empty()) {
+            throw std::invalid_argument("Error: image matrix is empty, cannot save to png.");
+        }
+
+        const int rows = static_cast<int>(getHeight());
+        const int cols = static_cast<int>(getWidth());
+        const int stride = static_cast<int>(this->pixels.getPitch());
+        if (stbi_write_png(path.c_str(), cols, rows, 3, this->pixels.data(), stride) == 0) {
+            std::cerr << "Error: Could not save color image" << std::endl;
+            throw std::runtime_error("Error: Could not save color image");
+        }
+
+        std::cout << "Image written successfully in a png file!" << std::endl;
+    }
+
+    std::vector<uint8_t> ColorImage::to_jpeg(
+        const ChromaSubsampling subsampling,
+        const DCTMethod method,
+        const bool optimizeHuffman,
+        const size_t restartRows,
+        const int quality
+    ) const {
+        Plane<uint8_t> planes[3];
+        JFIFImage image = make_components(subsampling, restartRows, planes);
+
+        // every component is compressed with its quantization matrix (luminance or chrominance)
+        for (size_t i = 0; i < 3; ++i) {
+            const double* quantization = getQuantizationTable(quality, i > 0).quantization;
+            image.components[i].coefficients = Image(std::move(planes[i])).compress(method, quantization).compressed;
+            std::memcpy(image.components[i].quantization, quantization, sizeof(image.components[i].quantization));
+        }
+        return writeJFIF(image, optimizeHuffman);
+    }
+
+    std::vector<uint8_t> ColorImage::to_jpeg_with_size(
+        const size_t targetBytes,
+        const ChromaSubsampling subsampling,
+        const bool optimizeHuffman,
+        const size_t restartRows,
+        int* quality
+    ) const {
+        Plane<uint8_t> planes[3];
+        JFIFImage image = make_components(subsampling, restartRows, planes);
+        return RateController(std::move(image), planes).compress(targetBytes, optimizeHuffman, quality);
+    }
+
+    void ColorImage::save_as_jpeg(
+        const std::string& path,
+        const ChromaSubsampling subsampling,
+        const DCTMethod method,
+        const bool optimizeHuffman,
+        const size_t restartRows,
+        const int quality
+    ) const {
+        const std::vector<uint8_t> jpeg = to_jpeg(subsampling, method, optimizeHuffman, restartRows, quality);
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            std::cerr << "Error opening JPEG file!" << std::endl;
+            throw std::runtime_error("Error opening JPEG file!");
+        }
+        file.write(reinterpret_cast<const char*>(jpeg.data()), static_cast<std::streamsize>(jpeg.size()));
+        file.close();
+
+        std::cout << "Color image written successfully in a JPEG file!" << std::endl;
+    }
+
+    // #################### PRIVATE ####################
+
+    JFIFImage ColorImage::make_components(
+        const ChromaSubsampling subsampling,
+        const size_t restartRows,
+        Plane<uint8_t>* planes
+    ) const {
+        if (this->pixels.empty()) {
+            throw std::invalid_argument("Error: image matrix is empty, cannot be compressed.");
+        }
+
+        int horizontal, vertical;
+        getSamplingFactors(subsampling, horizontal, vertical);
+
+        JFIFImage image;
+        image.width = getWidth();
+        image.height = getHeight();
+        image.components.resize(3);
+        for (size_t i = 0; i < 3; ++i) {
+            image.components[i].horizontalSampling = i == 0 ? horizontal : 1;
+            image.components[i].verticalSampling = i == 0 ? vertical : 1;
+        }
+
+        // planes padded to whole MCUs: the luma at full resolution, the chroma downsampled
+        size_t rows, cols, chromaRows, chromaCols;
+        getComponentSize(image, 0, rows, cols);
+        getComponentSize(image, 1, chromaRows, chromaCols);
+        planes[0] = Plane<uint8_t>(rows, cols);
+        planes[1] = Plane<uint8_t>(chromaRows, chromaCols);
+        planes[2] = Plane<uint8_t>(chromaRows, chromaCols);
+        convertAndDownsample(
+            this->pixels, image.width, image.height, horizontal, vertical, planes[0], planes[1], planes[2]
+        );
+
+        // a chroma block per MCU: the MCUs of a row are the blocks of a row of the chroma
+        image.restartInterval = restartRows * (chromaCols / dct::algo::DCT_BLOCK_SIZE);
+        return image;
+    }
+
+    Plane<uint8_t> ColorImage::load_from_png(const std::string& image_path) {
+        int width, height, channels;
+        unsigned char* data = stbi_load(image_path.c_str(), &width, &height, &channels, 3);
+        if (data == nullptr) {
+            std::cerr << "Error: Could not load image from " << image_path << std::endl;
+            throw std::runtime_error("Error: Could not load image");
+        }
+
+        std::cout << "Image loaded: " << width << "x" << height << " with " << channels << " channels." << std::endl;
+
+        // adopt the buffer of stb_image, no copies
+        return Plane<uint8_t>(data, height, 3 * width, 3 * width, stbi_image_free);
+    }
+
+    Plane<uint8_t> ColorImage::load_from_jpeg(
+        const std::string& image_path,
+        const DCTMethod method,
+        const size_t scale
+    ) {
+        // Map the file (or read it at once), then decode it from memory
+        const utils::io::MappedFile file(image_path);
+        return decodeJPEG(file.data(), file.size(), 3, method, scale);
+    }
+
+    // #################### FUNCTIONS ####################
+
+    std::vector<uint8_t> encodeJPEG(
+        const Plane<uint8_t>& pixels,
+        const int channels,
+        const ChromaSubsampling subsampling,
+        const DCTMethod method,
+        const bool optimizeHuffman,
+        const size_t restartRows,
+        const int quality
+    ) {
+        if ((channels != 1 && channels != 3) || pixels.empty() || pixels.getCols() % channels != 0) {
+            throw std::invalid_argument(
+                "Error: the pixels must have 1 or 3 channels. Given: " + std::to_string(channels) + " channels, " +
+                std::to_string(pixels.getCols()) + " columns"
+            );
+        }
+        const size_t width = pixels.getCols() / channels;
+        const size_t height = pixels.getRows();
+        if (channels == 3) {
+            // view of the pixels, without copies (no release function)
+            const ColorImage image(Plane<uint8_t>(const_cast<uint8_t*>(pixels.data()), height, 3 * width, pixels.getPitch(), nullptr));
+            return image.to_jpeg(subsampling, method, optimizeHuffman, restartRows, quality);
+        }
+
+        // grayscale: the blocks are padded with the edge pixels, the file keeps the sizes of the image
+        constexpr size_t block = dct::algo::DCT_BLOCK_SIZE;
+        const size_t rows = (height + block - 1) / block * block;
+        const size_t cols = (width + block - 1) / block * block;
+        Plane<uint8_t> padded(rows, cols);
+        for (size_t r = 0; r < rows; ++r) {
+            const uint8_t* source = pixels.row(std::min(r, height - 1));
+            uint8_t* row = padded.row(r);
+            std::memcpy(row, source, width);
+            std::fill(row + width, row + cols, source[width - 1]);
+        }
+
+        const double* quantization = getQuantizationTable(quality).quantization;
+        JFIFImage image;
+        image.width = width;
+        image.height = height;
+        image.restartInterval = restartRows * (cols / block);
+        image.components.resize(1);
+        JFIFComponent& component = image.components[0];
+        component.coefficients = Image(std::move(padded)).compress(method, quantization).compressed;
+        std::memcpy(component.quantization, quantization, sizeof(component.quantization));
+        component.horizontalSampling = 1;
+        component.verticalSampling = 1;
+        return writeJFIF(image, optimizeHuffman);
+    }
+
+    Plane<uint8_t> decodeJPEG(
+        const uint8_t* data,
+        const size_t size,
+        const int channels,
+        const DCTMethod method,
+        const size_t scale
+    ) {
+        if (channels != 1 && channels != 3) {
+            throw std::invalid_argument("Error: the pixels must have 1 or 3 channels. Given: " + std::to_string(channels));
+        }
+        checkDecodeScale(scale);
+        JFIFImage image = readJFIF(data, size, scale);
+        const size_t numComponents = image.components.size();
+        if (numComponents != 1 && numComponents != 3) {
+            throw std::runtime_error(
+                "Error: only grayscale and YCbCr JPEG files are supported. Given: " +
+                std::to_string(numComponents) + " components"
+            );
+        }
+
+        // the chroma must have the same sampling, the luma an integer multiple of it
+        const JFIFComponent& luma = image.components[0];
+        const JFIFComponent& chroma = image.components[numComponents - 1];
+        if (numComponents == 3 && (
+            image.components[1].horizontalSampling != chroma.horizontalSampling ||
+            image.components[1].verticalSampling != chroma.verticalSampling ||
+            luma.horizontalSampling % chroma.horizontalSampling != 0 ||
+            luma.verticalSampling % chroma.verticalSampling != 0)) {
+            throw std::runtime_error("Error: unsupported sampling factors of the JPEG components");
+        }
+        const int horizontal = numComponents == 3 ? luma.horizontalSampling / chroma.horizontalSampling : 1;
+        const int vertical = numComponents == 3 ? luma.verticalSampling / chroma.verticalSampling : 1;
+
+        // dequantization and inverse DCT of every component (reduced to the corners of the blocks at 1/scale),
+        // only of the luma for grayscale pixels
+        const size_t numDecoded = channels == 1 ? 1 : numComponents;
+        Plane<uint8_t> planes[3];
+        for (size_t i = 0; i < numDecoded; ++i) {
+            JFIFComponent& component = image.components[i];
+            if (scale == 1) {
+                planes[i] = CompressedImage(std::move(component.coefficients), component.quantization)
+                    .decompress(method).pixels;
+            } else {
+                planes[i] = decompressScaled(component.coefficients, component.quantization, scale, true);
+            }
+        }
+
+        // the sizes of the image at 1/scale, rounded up
+        const size_t width = (image.width + scale - 1) / scale;
+        const size_t height = (image.height + scale - 1) / scale;
+        if (channels == 1) {
+            Plane<uint8_t> gray(height, width);
+            for (size_t r = 0; r < height; ++r) {
+                std::memcpy(gray.row(r), planes[0].row(r), width);
+            }
+            return gray;
+        }
+        Plane<uint8_t> rgb(height, 3 * width);
+        if (numComponents == 1) {
+            // grayscale: the luma is copied in the three channels
+            for (size_t r = 0; r < height; ++r) {
+                uint8_t* row = rgb.row(r);
+                const uint8_t* gray = planes[0].row(r);
+                for (size_t c = 0; c < width; ++c) {
+                    row[3 * c] = row[3 * c + 1] = row[3 * c + 2] = gray[c];
+                }
+            }
+        } else {
+            upsampleAndConvert(planes[0], planes[1], planes[2], horizontal, vertical, rgb);
+        }
+        return rgb;
+    }
+}
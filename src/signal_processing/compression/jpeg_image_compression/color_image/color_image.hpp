@@ -0,0 +1,221 @@
+#ifndef COLOR_IMAGE_HPP
+#define COLOR_IMAGE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "compression/jpeg_image_compression/chroma_subsampling.hpp"
+#include "compression/jpeg_image_compression/dct_method.hpp"
+#include "compression/jpeg_image_compression/jfif/jfif.hpp"
+#include "compression/jpeg_image_compression/plane/plane.hpp"
+#include "compression/jpeg_image_compression/quantization/quantization.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Color image compressed with the JPEG pipeline of the color files: conversion to YCbCr, chroma
+     * downsampling (4:4:4, 4:2:2 or 4:2:0), separate luma and chroma quantization tables, and
+     * MCU interleaving of the three components in a baseline JFIF file.
+     *
+     * Compared to three full-resolution grayscale passes, 4:2:0 codes half of the blocks
+     * (4 luma + 2 chroma blocks every 16x16 pixels instead of 12).
+     */
+    class ColorImage {
+    public:
+        /**
+         * Pixels of the image, interleaved RGB (3 bytes per pixel, so 3 * width columns), with aligned rows.
+         */
+        Plane<uint8_t> pixels;
+
+        // default constructor
+        ColorImage() = default;
+
+        /**
+         * Constructor that initializes the ColorImage object from a plane of interleaved RGB pixels (moved, no copy).
+         *
+         * @param pixels: the pixels of the image (3 * width columns).
+         * @throws std::invalid_argument if the number of columns is not a multiple of 3.
+         */
+        explicit ColorImage(Plane<uint8_t> pixels);
+
+        /**
+         * Constructor that loads the image from a file.
+         *
+         * @param image_path: path to the image file.
+         * @param option: 1 (PNG or any format of stb_image), 2 (baseline JPEG, see jfif.hpp).
+         * @param method: arithmetic of the dequantization and of the inverse DCT of a JPEG file.
+         * @param scale: denominator of the resolution of a JPEG file: 1, or 2, 4 or 8 for a reduced
+         *               decoding (floating-point, see decompressScaled), e.g. for thumbnails.
+         * @throws std::invalid_argument if the scale is not supported, or not 1 for a PNG file.
+         */
+        ColorImage(
+            const std::string& image_path,
+            int option,
+            DCTMethod method = DCTMethod::FLOAT,
+            size_t scale = 1
+        );
+
+        /**
+         * Get the width of the image.
+         * @return The width, in pixels.
+         */
+        [[nodiscard]] size_t getWidth() const;
+
+        /**
+         * Get the height of the image.
+         * @return The height, in pixels.
+         */
+        [[nodiscard]] size_t getHeight() const;
+
+        /**
+         * Function that saves the pixels of the current object as a PNG file using stb_image_write.
+         *
+         * @param path: path for the PNG file.
+         */
+        void save_as_png(const std::string& path);
+
+        /**
+         * Function that compresses the image as a baseline color JFIF (.jpg) file.
+         *
+         * The pixels are converted to YCbCr with the chroma downsampled (see convertAndDownsample), each
+         * component is compressed (DCT and quantization, the luminance table of the quality for Y and the
+         * chrominance one for Cb and Cr), then the blocks are interleaved in MCUs and Huffman-coded.
+         * The sizes of the image can be any (the MCUs are padded with the edge pixels).
+         *
+         * @param subsampling: resolution of the chroma.
+         * @param method: arithmetic of the DCT and of the quantization (floating-point or fixed-point).
+         * @param optimizeHuffman: true for the optimized Huffman tables, false for the standard ones.
+         * @param restartRows: number of rows of MCUs of each independently decodable stripe (0 for one segment).
+         * @param quality: the quality, from 1 to 100 (see getQuantizationTable).
+         * @return: the bytes of the .jpg file.
+         */
+        std::vector<uint8_t> to_jpeg(
+            ChromaSubsampling subsampling = ChromaSubsampling::YUV420,
+            DCTMethod method = DCTMethod::FLOAT,
+            bool optimizeHuffman = false,
+            size_t restartRows = 1,
+            int quality = DEFAULT_QUALITY
+        ) const;
+
+        /**
+         * Function that compresses the image as a baseline color JFIF (.jpg) file of at most targetBytes
+         * bytes, with the highest quality that fits (see RateController): the color conversion and the
+         * DCT are computed once, then every quality of the binary search is only requantized and sized.
+         *
+         * @param targetBytes: the maximum number of bytes of the file.
+         * @param subsampling: resolution of the chroma.
+         * @param optimizeHuffman: true for the optimized Huffman tables, false for the standard ones.
+         * @param restartRows: number of rows of MCUs of each independently decodable stripe (0 for one segment).
+         * @param quality: the chosen quality (output, if not null).
+         * @return: the bytes of the .jpg file (of quality 1 if the target cannot be reached).
+         */
+        std::vector<uint8_t> to_jpeg_with_size(
+            size_t targetBytes,
+            ChromaSubsampling subsampling = ChromaSubsampling::YUV420,
+            bool optimizeHuffman = false,
+            size_t restartRows = 1,
+            int* quality = nullptr
+        ) const;
+
+        /**
+         * Function that compresses the image and saves it as a baseline color JFIF (.jpg) file (see to_jpeg).
+         *
+         * @param path: .jpg file path.
+         * @param subsampling: resolution of the chroma.
+         * @param method: arithmetic of the DCT and of the quantization (floating-point or fixed-point).
+         * @param optimizeHuffman: true for the optimized Huffman tables, false for the standard ones.
+         * @param restartRows: number of rows of MCUs of each independently decodable stripe (0 for one segment).
+         * @param quality: the quality, from 1 to 100 (see getQuantizationTable).
+         */
+        void save_as_jpeg(
+            const std::string& path,
+            ChromaSubsampling subsampling = ChromaSubsampling::YUV420,
+            DCTMethod method = DCTMethod::FLOAT,
+            bool optimizeHuffman = false,
+            size_t restartRows = 1,
+            int quality = DEFAULT_QUALITY
+        ) const;
+
+    private:
+        /**
+         * Function that converts the pixels to the planes of the components (see convertAndDownsample),
+         * padded to whole MCUs, and describes the file (sizes, sampling factors and restart interval).
+         *
+         * @param subsampling: resolution of the chroma.
+         * @param restartRows: number of rows of MCUs of each restart segment (0 for one segment).
+         * @param planes: the Y, Cb and Cr planes (output).
+         * @return: the image without coefficients.
+         */
+        JFIFImage make_components(ChromaSubsampling subsampling, size_t restartRows, Plane<uint8_t>* planes) const;
+
+        /**
+         * Function that loads an image as RGB using stb_image (zero-copy).
+         *
+         * @param image_path: path to the image file.
+         * @return the plane that owns the pixels decoded by stb_image.
+         */
+        Plane<uint8_t> load_from_png(const std::string& image_path);
+
+        /**
+         * Function that loads a baseline JPEG file (grayscale or YCbCr): every component is decompressed
+         * (dequantization and inverse DCT), then the chroma is upsampled and converted to RGB in one pass.
+         * At a reduced scale, only the corners of the blocks are decoded (see readJFIF) and transformed.
+         *
+         * @param image_path: path to the .jpg file.
+         * @param method: arithmetic of the dequantization and of the inverse DCT (at full resolution).
+         * @param scale: denominator of the resolution: 1, 2, 4 or 8.
+         * @return the plane of the RGB pixels.
+         */
+        Plane<uint8_t> load_from_jpeg(const std::string& image_path, DCTMethod method, size_t scale);
+    };
+
+    /**
+     * Function that compresses interleaved pixels of any sizes as a baseline JFIF (.jpg) file: grayscale
+     * pixels as a single component (the blocks padded with the edge pixels), RGB ones as ColorImage::to_jpeg.
+     *
+     * @param pixels: the pixels (width * channels columns, referenced, not copied).
+     * @param channels: 1 (grayscale) or 3 (RGB).
+     * @param subsampling: resolution of the chroma (ignored for grayscale).
+     * @param method: arithmetic of the DCT and of the quantization (floating-point or fixed-point).
+     * @param optimizeHuffman: true for the optimized Huffman tables, false for the standard ones.
+     * @param restartRows: number of rows of MCUs of each independently decodable stripe (0 for one segment).
+     * @param quality: the quality, from 1 to 100 (see getQuantizationTable).
+     * @return: the bytes of the .jpg file.
+     * @throws std::invalid_argument if the channels or the pixels are not valid.
+     */
+    std::vector<uint8_t> encodeJPEG(
+        const Plane<uint8_t>& pixels,
+        int channels,
+        ChromaSubsampling subsampling = ChromaSubsampling::YUV420,
+        DCTMethod method = DCTMethod::FLOAT,
+        bool optimizeHuffman = false,
+        size_t restartRows = 1,
+        int quality = DEFAULT_QUALITY
+    );
+
+    /**
+     * Function that decodes a baseline JPEG file (grayscale or YCbCr) from memory into interleaved pixels:
+     * every component is decompressed (dequantization and inverse DCT), then the chroma is upsampled and
+     * converted to RGB in one pass. The grayscale pixels of a color file are its luma (the chroma is not decoded),
+     * the RGB pixels of a grayscale file repeat it in the three channels.
+     *
+     * @param data: the bytes of the file.
+     * @param size: number of bytes.
+     * @param channels: 1 (grayscale) or 3 (RGB).
+     * @param method: arithmetic of the dequantization and of the inverse DCT (at full resolution).
+     * @param scale: denominator of the resolution: 1, or 2, 4 or 8 (see readJFIF).
+     * @return the plane of the pixels (width * channels columns).
+     * @throws std::invalid_argument if the channels or the scale are not supported.
+     * @throws std::runtime_error if the file is corrupted or not supported.
+     */
+    Plane<uint8_t> decodeJPEG(
+        const uint8_t* data,
+        size_t size,
+        int channels,
+        DCTMethod method = DCTMethod::FLOAT,
+        size_t scale = 1
+    );
+}
+
+#endif //COLOR_IMAGE_HPP
@@ -2,18 +2,100 @@
 #include <fstream>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <exception>
+#include <omp.h>
 
 #include "compression/jpeg_image_compression/compressed_image/compressed_image.hpp"
 #include "compression/jpeg_image_compression/image/image.hpp"
-#include "transforms/discrete_cosine_transform/base_discrete_cosine_transform.hpp"
-#include "transforms/discrete_cosine_transform/inverse_discrete_cosine_transform/inverse_discrete_cosine_transform.hpp"
-#include "utils/rle_compressor.hpp"
-#include "utils/zigzag_scan.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_8x8.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_batch.hpp"
+#include "compression/jpeg_image_compression/block_coder/block_coder.hpp"
+#include "compression/jpeg_image_compression/jfif/jfif.hpp"
+#include "compression/jpeg_image_compression/quantization/quantization.hpp"
+#include "compression/jpeg_image_compression/scaled_decoding/scaled_decoding.hpp"
 
 namespace sp::jpeg
 {
+    /**
+     * Function that clamps a decoded value to a pixel, between 0 and 255.
+     */
+    static uint8_t clampToPixel(const long value) {
+        return static_cast<uint8_t>(value < 0 ? 0 : value > 255 ? 255 : value);
+    }
+
+    /**
+     * Decode the rows of blocks of a rectangle of a compressed binary file, each one from the checkpoint
+     * of the index before its first block; the rows are decoded concurrently.
+     *
+     * @param binary: the bytes of the file.
+     * @param index: the index of its blocks.
+     * @param firstRow: the first row of blocks.
+     * @param firstCol: the first column of blocks.
+     * @param coefficients: the plane of the coefficients of the blocks (its sizes give the number of blocks, output).
+     */
+    static void decodeIndexedBlocks(
+        const uint8_t* binary,
+        const BlockIndex& index,
+        const size_t firstRow,
+        const size_t firstCol,
+        Plane<int16_t>& coefficients
+    ) {
+        constexpr size_t submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        const size_t numRows = coefficients.getRows() / submatrixSize;
+        const size_t numCols = coefficients.getCols() / submatrixSize;
+        const size_t end = index.offsets.back();
+        const size_t checkpointsPerRow = index.getCheckpointsPerRow();
+        std::exception_ptr error;
+
+        #pragma omp parallel for schedule(dynamic) if(numRows > 1 && !omp_in_parallel())
+        for (size_t i = 0; i < numRows; ++i) {
+            try {
+                // seek to the checkpoint before the first block, then skip the blocks up to it
+                const size_t row = firstRow + i;
+                size_t position = index.offsets[row * checkpointsPerRow + firstCol / index.checkpointBlocks];
+                for (size_t b = 0; b < firstCol % index.checkpointBlocks; ++b) {
+                    position += skipBlock(binary + position, end - position);
+                }
+
+                alignas(64) int16_t block[dct::algo::DCT_BLOCK_AREA];
+                for (size_t b = 0; b < numCols; ++b) {
+                    position += decodeBlock(binary + position, end - position, block);
+                    for (size_t k = 0; k < submatrixSize; ++k) {
+                        std::memcpy(
+                            coefficients.row(i * submatrixSize + k) + b * submatrixSize,
+                            block + k * submatrixSize,
+                            submatrixSize * sizeof(int16_t)
+                        );
+                    }
+                }
+            } catch (...) {
+                #pragma omp critical
+                error = std::current_exception();
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
     // #################### CONSTRUCTORS ####################
-    CompressedImage::CompressedImage(std::vector<std::vector<double>> inputMatrix): compressed(inputMatrix) {}
+    CompressedImage::CompressedImage(const std::vector<std::vector<double>>& inputMatrix) {
+        const size_t rows = inputMatrix.size();
+        const size_t cols = rows > 0 ? inputMatrix[0].size() : 0;
+        this->compressed = Plane<int16_t>(rows, cols);
+        for (size_t r = 0; r < rows; ++r) {
+            int16_t* row = this->compressed.row(r);
+            for (size_t c = 0; c < cols; ++c) {
+                row[c] = static_cast<int16_t>(std::lround(inputMatrix[r][c]));
+            }
+        }
+    }
+
+    CompressedImage::CompressedImage(Plane<int16_t> coefficients): compressed(std::move(coefficients)) {}
+
+    CompressedImage::CompressedImage(Plane<int16_t> coefficients, const double* quantization):
+        compressed(std::move(coefficients)), quantization(quantization, quantization + dct::algo::DCT_BLOCK_AREA) {}
 
     CompressedImage::CompressedImage(const std::string& compressed_image_path, const int option) {
         if (option == 1){
@@ -22,11 +104,19 @@ namespace sp::jpeg
         else if (option == 2){
             this->compressed = load_from_compressed_binary(compressed_image_path);
         }
+        else if (option == 3){
+            load_from_jpeg(compressed_image_path);
+        }
+        else if (option == 4){
+            open_compressed_binary(compressed_image_path);
+        }
         else {
             throw std::runtime_error(
                 "Error: invalid option in ImageJPEG constructor. "
                 "Acceptable ones are only option=1 for \"load compressed image from a binary file\", "
-                "or option=2 for \"load compressed image form a compressed binary file (zigzag+rle)\""
+                "option=2 for \"load compressed image form a compressed binary file (zigzag+rle)\", "
+                "option=3 for \"load compressed image from a JPEG file\", "
+                "or option=4 for \"map a compressed binary file for the decompression of regions\""
             );
         }
     }
@@ -48,8 +138,8 @@ namespace sp::jpeg
         }
 
         // Write matrix size at the beginning of the binary file (rows, cols)
-        size_t rows = this->compressed.size();
-        size_t cols = this->compressed[0].size();
+        size_t rows = this->compressed.getRows();
+        size_t cols = this->compressed.getCols();
 
         // reinterpret_cast<char*> --> to interpret each double as an array of byte
         file.write(reinterpret_cast<char*>(&rows), sizeof(rows));
@@ -59,7 +149,7 @@ namespace sp::jpeg
         for (int r=0; r<rows; ++r) {
             for (int c=0; c<cols; ++c) {
                 // since img_matrix[r][c] stays in a range of -128 e 127
-                auto value = static_cast<int8_t>(this->compressed[r][c]);
+                auto value = static_cast<int8_t>(this->compressed(r, c));
                 file.write(reinterpret_cast<char*>(&value), sizeof(value));
             }
         }
@@ -69,62 +159,116 @@ namespace sp::jpeg
         std::cout << "Compressed image written successfully in a binary file!" << std::endl;
     }
 
-    const void CompressedImage::save_as_compressed_binary(const std::string& path){
+    void CompressedImage::save_as_compressed_binary(
+        const std::string& path,
+        const bool blockIndex,
+        const size_t checkpointBlocks
+    ){
         if (this->compressed.empty()) {
             throw std::invalid_argument("Error: there is no compressed image to save as binary file.");
         }
 
-        int submatrixSize = 8;
+        constexpr int submatrixSize = dct::algo::DCT_BLOCK_SIZE;
 
         std::ofstream file(path, std::ios::binary);
 
-        int rows = this->compressed.size();
-        int cols = this->compressed[0].size();
-        file.write(reinterpret_cast<char*>(&rows), sizeof(rows));
-        file.write(reinterpret_cast<char*>(&cols), sizeof(cols));
-        file.write(reinterpret_cast<char*>(&submatrixSize), sizeof(submatrixSize));
+        int rows = this->compressed.getRows();
+        int cols = this->compressed.getCols();
+        if (rows % submatrixSize != 0 || cols % submatrixSize != 0) {
+            throw std::runtime_error("Error: the compressed image sizes are not multiple of 8");
+        }
 
+        // Header with the quantization matrix (the decoder needs it), then zigzag scan and RLE
+        // each block into one buffer, written at once
+        double quantization[dct::algo::DCT_BLOCK_AREA];
+        get_quantization(quantization);
+        std::vector<uint8_t> binary;
+        writeCompressedBinaryHeader(rows, cols, quantization, binary);
+
+        alignas(64) int16_t coefficients[dct::algo::DCT_BLOCK_AREA];
+        uint8_t encoded[MAX_ENCODED_BLOCK_SIZE];
         for (int r = 0; r < rows; r += submatrixSize) {
             for (int c = 0; c < cols; c += submatrixSize) {
-                // Create a copy of the submatrix and copy inside it the correspondin value of img_matrix
-                std::vector<std::vector<double>> submatrix(submatrixSize, std::vector<double>(submatrixSize));
                 for (int i = 0; i < submatrixSize; ++i)
                     for (int j = 0; j < submatrixSize; ++j)
-                        submatrix[i][j] = this->compressed[r+i][c+j];
-                // Apply zigzag scan to the submatrix
-                std::vector<double> zzVector = utils::zigzag::ZigZagScan::scan(submatrix);
-                //save the submatrix in the binary file (using rle compression)
-                save_compressed_submatrix(file, zzVector);
+                        coefficients[i * submatrixSize + j] = this->compressed(r+i, c+j);
+                const size_t size = encodeBlock(coefficients, encoded);
+                binary.insert(binary.end(), encoded, encoded + size);
             }
         }
+        if (blockIndex) {
+            appendBlockIndex(buildBlockIndex(binary.data(), binary.size(), checkpointBlocks), binary);
+        }
 
+        file.write(reinterpret_cast<const char*>(binary.data()), static_cast<std::streamsize>(binary.size()));
         file.close();
 
         std::cout << "Image matrix written successfully in a binary file using zigzag scan & rle compression!" << std::endl;
     }
 
-    Image CompressedImage::decompress(){
+    std::vector<uint8_t> CompressedImage::to_jpeg(const bool optimizeHuffman, const size_t restartRows) const {
+        if (this->compressed.empty()) {
+            throw std::invalid_argument("Error: there is no compressed image to save as JPEG file.");
+        }
+
+        // a single component, viewing the coefficients without copying them (no release function)
+        const size_t rows = this->compressed.getRows();
+        const size_t cols = this->compressed.getCols();
+        JFIFImage image;
+        image.width = this->width > 0 ? this->width : cols;
+        image.height = this->height > 0 ? this->height : rows;
+        image.restartInterval = restartRows * (cols / dct::algo::DCT_BLOCK_SIZE);
+        image.components.resize(1);
+        JFIFComponent& component = image.components[0];
+        component.coefficients = Plane<int16_t>(
+            const_cast<int16_t*>(this->compressed.data()), rows, cols, this->compressed.getPitch(), nullptr
+        );
+        get_quantization(component.quantization);
+        component.horizontalSampling = 1;
+        component.verticalSampling = 1;
+        return writeJFIF(image, optimizeHuffman);
+    }
+
+    void CompressedImage::save_as_jpeg(const std::string& path, const bool optimizeHuffman, const size_t restartRows) {
+        const std::vector<uint8_t> jpeg = to_jpeg(optimizeHuffman, restartRows);
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            std::cerr << "Error opening JPEG file!" << std::endl;
+            throw std::runtime_error("Error opening JPEG file!");
+        }
+        file.write(reinterpret_cast<const char*>(jpeg.data()), static_cast<std::streamsize>(jpeg.size()));
+        file.close();
+
+        std::cout << "Compressed image written successfully in a JPEG file!" << std::endl;
+    }
+
+    std::vector<std::vector<double>> CompressedImage::to_matrix() const {
+        const size_t rows = this->compressed.getRows();
+        const size_t cols = this->compressed.getCols();
+        std::vector<std::vector<double>> matrix(rows, std::vector<double>(cols));
+        for (size_t r = 0; r < rows; ++r) {
+            const int16_t* row = this->compressed.row(r);
+            for (size_t c = 0; c < cols; ++c) {
+                matrix[r][c] = row[c];
+            }
+        }
+        return matrix;
+    }
+
+    Image CompressedImage::decompress(const DCTMethod method){
         if(this->compressed.empty()){
             throw std::invalid_argument("Error: there is no compresed image to decompress.");
         }
-        const size_t rows = this->compressed.size();
-        const size_t cols = this->compressed[0].size();
-        auto decompressed = std::vector<std::vector<double>>(rows, std::vector<double>(cols));
-
-        // Create the constant matrix Q (quantization matrix) --> is a 8x8
-        std::vector<std::vector<double>> Q = {
-            { 16, 11, 10, 16, 24, 40, 51, 61},
-            { 12, 12, 14, 19, 26, 58, 60, 55},
-            { 14, 13, 16, 24, 40, 57, 69, 56},
-            { 14, 17, 22, 29, 51, 87, 80, 62},
-            { 18, 22, 37, 56, 68, 109, 103, 7},
-            { 24, 35, 55, 64, 81, 104, 113, 92},
-            { 49, 64, 78, 87, 103, 121, 120, 101},
-            { 72, 92, 95, 98, 112, 100, 103, 99}
-        };
+        const size_t rows = this->compressed.getRows();
+        const size_t cols = this->compressed.getCols();
+        Plane<uint8_t> decompressed(rows, cols);
+
+        double quantization[dct::algo::DCT_BLOCK_AREA];
+        get_quantization(quantization);
 
         // Split up the image into blocks of 8 × 8 pixels
-        const int submatrixSize = 8;
+        constexpr int submatrixSize = dct::algo::DCT_BLOCK_SIZE;
         // sanity check if the image_data size are multiple of submatrixSize
         if (rows % submatrixSize != 0 || cols % submatrixSize != 0) {
             std::cerr << "Error: the image is not decompressible since its sizes are not multiple of "
@@ -132,199 +276,294 @@ namespace sp::jpeg
             throw std::runtime_error("Error: the image is not decompressible since its sizes are not multiple of 8");
         }
 
-        #pragma omp parallel for
-        for (size_t r = 0; r < rows; r += submatrixSize) {
-            for (size_t c = 0; c < cols; c += submatrixSize) {
-                jpeg_decompression(r, c, submatrixSize, decompressed, Q);
+        if (method == DCTMethod::FLOAT) {
+            // Fold the multiplication by Q into the pre-scale of the 8x8 inverse DCT
+            alignas(64) double dequantizationScale[dct::algo::DCT_BLOCK_AREA];
+            dct::algo::makeIDCT8x8DequantizationScale(quantization, dequantizationScale);
+
+            // one parallel region over the rows of blocks; the batched IDCT of each row runs in the calling thread
+            #pragma omp parallel if(!omp_in_parallel())
+            {
+                // per-thread buffer of a row of blocks, reused for all the rows of the thread
+                std::vector<double> blocks(submatrixSize * cols);
+
+                #pragma omp for
+                for (size_t r = 0; r < rows; r += submatrixSize) {
+                    jpeg_decompression(r, decompressed, dequantizationScale, blocks.data());
+                }
+            }
+        } else {
+            // Fixed-point pipeline: integer dequantization and integer inverse DCT
+            const dct::algo::IntegerQuantizer quantizer(
+                quantization,
+                method == DCTMethod::IFAST ? dct::algo::IntegerDCTMethod::IFAST : dct::algo::IntegerDCTMethod::ISLOW
+            );
+
+            #pragma omp parallel for if(!omp_in_parallel())
+            for (size_t r = 0; r < rows; r += submatrixSize) {
+                for (size_t c = 0; c < cols; c += submatrixSize) {
+                    jpeg_decompression_integer(r, c, decompressed, quantizer);
+                }
             }
         }
 
-        Image image = Image(decompressed);
+        // drop the padding of the blocks at the borders (JPEG files with sizes not multiple of 8)
+        if (this->width > 0 && this->height > 0) {
+            decompressed.crop(this->height, this->width);
+        }
+
+        Image image = Image(std::move(decompressed));
         return image;
     }
 
+    Image CompressedImage::decompress_scaled(const size_t scale) {
+        checkDecodeScale(scale);
+        if (scale == 1) {
+            return decompress(DCTMethod::FLOAT);
+        }
+        if (this->compressed.empty()) {
+            throw std::invalid_argument("Error: there is no compressed image to decompress.");
+        }
+
+        double quantization[dct::algo::DCT_BLOCK_AREA];
+        get_quantization(quantization);
+        Plane<uint8_t> decompressed = decompressScaled(this->compressed, quantization, scale, false);
+
+        // drop the padding of the blocks at the borders, at the reduced resolution
+        if (this->width > 0 && this->height > 0) {
+            decompressed.crop((this->height + scale - 1) / scale, (this->width + scale - 1) / scale);
+        }
+        return Image(std::move(decompressed));
+    }
+
+    Image CompressedImage::decompress_region(
+        const size_t x,
+        const size_t y,
+        const size_t width,
+        const size_t height,
+        const DCTMethod method
+    ) {
+        constexpr size_t submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        const bool mapped = this->source != nullptr;
+        if (!mapped && this->compressed.empty()) {
+            throw std::invalid_argument("Error: there is no compressed image to decompress.");
+        }
+
+        // sizes of the image: the blocks, without the padding of a JPEG file
+        const size_t rows = mapped ? this->index.blockRows * submatrixSize : this->compressed.getRows();
+        const size_t cols = mapped ? this->index.blockCols * submatrixSize : this->compressed.getCols();
+        const size_t imageHeight = this->height > 0 ? this->height : rows;
+        const size_t imageWidth = this->width > 0 ? this->width : cols;
+        if (width == 0 || height == 0 || x >= imageWidth || y >= imageHeight ||
+            width > imageWidth - x || height > imageHeight - y) {
+            throw std::invalid_argument(
+                "Error: invalid region " + std::to_string(width) + "x" + std::to_string(height) + " at (" +
+                std::to_string(x) + ", " + std::to_string(y) + ") of a " + std::to_string(imageWidth) + "x" +
+                std::to_string(imageHeight) + " image"
+            );
+        }
+
+        // the blocks that intersect the rectangle
+        const size_t firstRow = y / submatrixSize;
+        const size_t firstCol = x / submatrixSize;
+        const size_t numRows = (y + height - 1) / submatrixSize - firstRow + 1;
+        const size_t numCols = (x + width - 1) / submatrixSize - firstCol + 1;
+        Plane<int16_t> coefficients(numRows * submatrixSize, numCols * submatrixSize);
+        if (mapped) {
+            decodeIndexedBlocks(this->source->data(), this->index, firstRow, firstCol, coefficients);
+        } else {
+            for (size_t r = 0; r < coefficients.getRows(); ++r) {
+                std::memcpy(
+                    coefficients.row(r),
+                    this->compressed.row(firstRow * submatrixSize + r) + firstCol * submatrixSize,
+                    coefficients.getCols() * sizeof(int16_t)
+                );
+            }
+        }
+
+        double quantization[dct::algo::DCT_BLOCK_AREA];
+        get_quantization(quantization);
+        const Plane<uint8_t> blocks = CompressedImage(std::move(coefficients), quantization).decompress(method).pixels;
+
+        // the rectangle in the decompressed blocks
+        Plane<uint8_t> pixels(height, width);
+        const size_t top = y - firstRow * submatrixSize;
+        const size_t left = x - firstCol * submatrixSize;
+        for (size_t r = 0; r < height; ++r) {
+            std::memcpy(pixels.row(r), blocks.row(top + r) + left, width);
+        }
+        return Image(std::move(pixels));
+    }
+
     // #################### PRIVATE ####################
 
+    void CompressedImage::get_quantization(double* quantization) const {
+        if (this->quantization.empty()) {
+            makeQuantizationMatrix(quantization);
+        } else {
+            std::memcpy(quantization, this->quantization.data(), dct::algo::DCT_BLOCK_AREA * sizeof(double));
+        }
+    }
+
     void CompressedImage::jpeg_decompression(
+        const int r,
+        Plane<uint8_t>& decompressed,
+        const double* dequantizationScale,
+        double* blocks
+    ){
+        constexpr int submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        const size_t cols = this->compressed.getCols();
+        const size_t numBlocks = cols / submatrixSize;
+
+        // 1. Copy the row of blocks into the buffer, one contiguous block after the other
+        for (size_t b = 0; b < numBlocks; ++b) {
+            double* block = blocks + b * dct::algo::DCT_BLOCK_AREA;
+            const size_t c = b * submatrixSize;
+            for (int i = 0; i < submatrixSize; ++i) {
+                for (int j = 0; j < submatrixSize; ++j) {
+                    block[i * submatrixSize + j] = this->compressed(r+i, c+j);
+                }
+            }
+        }
+
+        // 2. Multiply each value by the corresponding element in Q (folded in the IDCT pre-scale)
+        //    and take the 2-dimensional idct of all the blocks.
+        dct::algo::computeIDCT8x8Batch(blocks, numBlocks, dequantizationScale, true);
+
+        // 3. Copy the decompressed blocks into the original image
+        for (size_t b = 0; b < numBlocks; ++b) {
+            const double* block = blocks + b * dct::algo::DCT_BLOCK_AREA;
+            const size_t c = b * submatrixSize;
+            for (int i = 0; i < submatrixSize; ++i){
+                for (int j = 0; j < submatrixSize; ++j){
+                    // 4. Add 128 from each entry, so that the entries are now again integers between 0 and 255 (clamped).
+                    decompressed(r+i, c+j) = clampToPixel(std::lround(block[i * submatrixSize + j]) + 128);
+                }
+            }
+        }
+    }
+
+    void CompressedImage::jpeg_decompression_integer(
         const int r,
         const int c,
-        const int submatrixSize,
-        std::vector<std::vector<double>>& decompressed,
-        std::vector<std::vector<double>>& Q
+        Plane<uint8_t>& decompressed,
+        const dct::algo::IntegerQuantizer& quantizer
     ){
-        // 1. Create a copy of the submatrix in which the value is moltiplied by the corresponding element in Q
-        std::vector<std::vector<double>> submatrix(submatrixSize, std::vector<double>(submatrixSize));
+        constexpr int submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+
+        // 1. Create a copy of the submatrix (on the stack)
+        alignas(64) int16_t coefficients[dct::algo::DCT_BLOCK_AREA];
         for (int i = 0; i < submatrixSize; ++i) {
             for (int j = 0; j < submatrixSize; ++j) {
-                submatrix[i][j] = std::round(this->compressed[r+i][c+j] * Q[i][j]);
+                coefficients[i * submatrixSize + j] = this->compressed(r+i, c+j);
             }
         }
 
-        // 2. Take the 2-dimensional idct of the block.
-        auto idct_solver = dct::solver::InverseDiscreteCosineTransform();
-        const dct::solver::ComputationMode cm = dct::solver::ComputationMode::OPENMP;
-        idct_solver.compute(submatrix, cm);
+        // 2. Multiply each value by the corresponding element in Q (integer multiplication)
+        alignas(64) int32_t block[dct::algo::DCT_BLOCK_AREA];
+        quantizer.dequantize(coefficients, block);
 
-        // 3. Copy the decompressed submatrix into the original image
+        // 3. Take the fixed-point 2-dimensional idct of the block (already rounded).
+        dct::algo::computeIDCT8x8Integer(block, quantizer.getMethod());
+
+        // 4. Copy the decompressed submatrix into the original image
         for (int i = 0; i < submatrixSize; ++i){
             for (int j = 0; j < submatrixSize; ++j){
-                // 4. Add 128 from each entry, so that the entries are now again integers between 0 and 255.
-                decompressed[r+i][c+j] = round(submatrix[i][j]) + 128.0;
+                // 5. Add 128 from each entry, so that the entries are now again integers between 0 and 255 (clamped).
+                decompressed(r+i, c+j) = clampToPixel(block[i * submatrixSize + j] + 128);
             }
         }
     }
 
-    const void CompressedImage::save_compressed_submatrix(std::ofstream& file, const std::vector<double>& zzVector) {
-        std::vector<std::pair<int, int>> rleVector = utils::rle::RLECompressor::compress(zzVector);
-        /*
-        uint8_t rle_size = rle.size();
-        file.write(reinterpret_cast<const char*>(&rle_size), sizeof(uint8_t));*/
-
-        for (auto it = rleVector.begin(); it != rleVector.end(); ++it) {
-            const int repetitions = it->first;
-            const int value = it->second;
-            int16_t count = static_cast<int16_t>(repetitions);
-            if (count == 1) {
-                //Write only the value and ignore repetitions
-                int16_t val = static_cast<int16_t>(value);
-                file.write(reinterpret_cast<const char*>(&val), sizeof(val));
-            } else {
-                //Write a reserved value and then write #repetitions and value
-                uint8_t val = static_cast<uint8_t>(value);
-                int16_t mark = static_cast<int16_t>(-1);
-                file.write(reinterpret_cast<const char*>(&mark), sizeof(mark));
-                file.write(reinterpret_cast<const char*>(&count), sizeof(count));
-                file.write(reinterpret_cast<const char*>(&val), sizeof(val));
-            }
+    void CompressedImage::open_compressed_binary(const std::string& path) {
+        auto file = std::make_shared<const utils::io::MappedFile>(path);
+        this->quantization = readCompressedBinaryHeader(file->data(), file->size()).quantization;
+        // a file without index is scanned once (the blocks are skipped, not decoded)
+        if (!readBlockIndex(file->data(), file->size(), this->index)) {
+            this->index = buildBlockIndex(file->data(), file->size());
         }
-
-        /* different version in which the couple (count, value) are always written completly
-        for (const auto& [repetitions, value] : rleVector) {
-            int16_t count = static_cast<int16_t>(repetitions);
-            uint8_t val = static_cast<uint8_t>(value);
-            file.write(reinterpret_cast<const char*>(&count), sizeof(int16_t));
-            file.write(reinterpret_cast<const char*>(&val), sizeof(uint8_t));
-        */
+        this->source = std::move(file);
     }
 
-    const std::vector<std::vector<double>> CompressedImage::load_from_binary(const std::string& path){
-        // Open the file in binary mode to read
-        std::ifstream file(path, std::ios::binary);
-
-        if (!file) {
-            std::cerr << "Error during opening .bin file" << std::endl;
-            throw std::runtime_error("Error during opening .bin file");
-        }
+    Plane<int16_t> CompressedImage::load_from_binary(const std::string& path){
+        // Map the file (or read it at once), then decode it from memory
+        const utils::io::MappedFile file(path);
+        utils::io::ByteCursor cursor(file.data(), file.size());
 
         // Read the matrix size
-        size_t rows, cols;
-        file.read(reinterpret_cast<char*>(&rows), sizeof(rows));
-        file.read(reinterpret_cast<char*>(&cols), sizeof(cols));
+        const auto rows = cursor.read<size_t>();
+        const auto cols = cursor.read<size_t>();
+        if (cols != 0 && rows > cursor.remaining() / cols) {
+            throw std::runtime_error("Error: the binary file is truncated");
+        }
 
         // Create an empty matrix with the previous size
-        std::vector<std::vector<double>> img_matrix(rows, std::vector<double>(cols));
-
-        // Read matrix elements and store them in img_matrix
-        for (int r=0; r < rows; ++r) {
-            for (int c=0; c < cols; ++c) {
-                int8_t value;
-                file.read(reinterpret_cast<char*>(&value), sizeof(value));
-                img_matrix[r][c] = static_cast<double>(value);
+        Plane<int16_t> img_matrix(rows, cols);
+
+        // Widen the int8 elements of each row into img_matrix
+        for (size_t r = 0; r < rows; ++r) {
+            const auto* values = reinterpret_cast<const int8_t*>(cursor.take(cols));
+            int16_t* row = img_matrix.row(r);
+            #pragma omp simd
+            for (size_t c = 0; c < cols; ++c) {
+                row[c] = values[c];
             }
         }
 
-        file.close();
-
         return img_matrix;
     }
 
-    const std::vector<std::vector<double>> CompressedImage::load_from_compressed_binary(const std::string& path){
-        std::ifstream file(path, std::ios::binary);
+    Plane<int16_t> CompressedImage::load_from_compressed_binary(const std::string& path){
+        // Map the file (or read it at once), then decode it from memory
+        const utils::io::MappedFile file(path);
+        const uint8_t* binary = file.data();
 
-        // Reads the image dimensions and the submatrix size (must be 8x8).
-        int rows, cols, submatrixSize;
-        file.read(reinterpret_cast<char*>(&rows), sizeof(rows));
-        file.read(reinterpret_cast<char*>(&cols), sizeof(cols));
-        file.read(reinterpret_cast<char*>(&submatrixSize), sizeof(submatrixSize));
+        // Reads the image dimensions and the quantization matrix, and checks the submatrix size (must be 8x8).
+        CompressedBinaryHeader header = readCompressedBinaryHeader(binary, file.size());
+        const size_t rows = header.rows;
+        const size_t cols = header.cols;
+        this->quantization = std::move(header.quantization);
 
-        if (submatrixSize != 8) {
-            throw std::runtime_error(
-                "Error: the compressed binary file cannot be decompressed using jpeg (submatrix size != 8)"
-            );
-        }
+        Plane<int16_t> img_matrix(rows, cols);
 
-        std::vector<std::vector<double>> img_matrix(rows, std::vector<double>(cols));
+        // With an index, the rows of blocks are decoded concurrently from their offsets
+        BlockIndex index;
+        if (readBlockIndex(binary, file.size(), index)) {
+            decodeIndexedBlocks(binary, index, 0, 0, img_matrix);
+            return img_matrix;
+        }
 
-        // For each 8x8 block, reads the compressed data,
-        // decodes it (inverse zig-zag scan), and places it into the final image matrix.
-        for (int r = 0; r < rows; r += submatrixSize) {
-            for (int c = 0; c < cols; c += submatrixSize) {
-                std::vector<double>  zzVector = load_compressed_submatrix(file, submatrixSize*submatrixSize);
-                std::vector<std::vector<double>> submatrix = utils::zigzag::ZigZagScan::inverse_scan(
-                    zzVector, submatrixSize, submatrixSize
-                );
-                for (int i = 0; i < submatrixSize; ++i)
-                    for (int j = 0; j < submatrixSize; ++j)
-                        img_matrix[r+i][c+j] = submatrix[i][j];
+        // For each 8x8 block, decodes the compressed data (RLE + inverse zig-zag scan)
+        // and places it into the final image matrix.
+        constexpr size_t submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        size_t position = header.size;
+        alignas(64) int16_t coefficients[dct::algo::DCT_BLOCK_AREA];
+        for (size_t r = 0; r < rows; r += submatrixSize) {
+            for (size_t c = 0; c < cols; c += submatrixSize) {
+                position += decodeBlock(binary + position, file.size() - position, coefficients);
+                for (size_t i = 0; i < submatrixSize; ++i) {
+                    std::memcpy(img_matrix.row(r + i) + c, coefficients + i * submatrixSize, submatrixSize * sizeof(int16_t));
+                }
             }
         }
 
-        file.close();
-
         return img_matrix;
     }
 
-    const std::vector<double> CompressedImage::load_compressed_submatrix(std::ifstream& file, const int vectorSize) {
-        std::vector<std::pair<int, int>> zzVector;
-        int i = 0;
-
-        // Reads values sequentially until we fill zzVector
-        while(i < vectorSize) {
-            int16_t v;
-            file.read(reinterpret_cast<char*>(&v), sizeof(int16_t));
-
-            if (v != -1){
-                // v is not a reserved value => it is a value with no contiguous repetitions
-                zzVector.emplace_back(static_cast<long>(1), static_cast<int>(v));
-                i++;
-            } else {
-                // we have found a reserved value => the next two value are (#repetitions, value)
-                int16_t count;
-                int8_t val;
-                file.read(reinterpret_cast<char*>(&count), sizeof(count));
-                file.read(reinterpret_cast<char*>(&val), sizeof(val));
-                zzVector.emplace_back(static_cast<long>(count), static_cast<int>(val));
-                i += count+1; //i = i + #repetitions + 1
-            }
-        }
-
-        return utils::rle::RLECompressor::decompress(zzVector);
-
-        /* Version that read always value as couple (#repetitions, value)
-        while(i < vectorSize){
-            int8_t z;
-            int16_t v;
-            file.read(reinterpret_cast<char*>(&z), sizeof(int8_t));
-            file.read(reinterpret_cast<char*>(&v), sizeof(int16_t));
-            zzVector.emplace_back(static_cast<int>(z), static_cast<double>(v));
-            i += z+1; //i = i + #zeros + 1
-        }
-
-        return RLECompressor::decompress(zzVector);
-
-        //1st version
-        uint8_t rle_size;
-        file.read(reinterpret_cast<char*>(&rle_size), sizeof(uint8_t));
-
-        std::vector<std::pair<int, int>> zz_submatrix;
-        for (int i = 0; i < rle_size; ++i) {
-            int8_t z;
-            int16_t v;
-            file.read(reinterpret_cast<char*>(&z), sizeof(int8_t));
-            file.read(reinterpret_cast<char*>(&v), sizeof(int16_t));
-            rle[i] = {z, v};
+    void CompressedImage::load_from_jpeg(const std::string& path){
+        // Map the file (or read it at once), then decode it from memory
+        const utils::io::MappedFile file(path);
+        JFIFImage image = readJFIF(file.data(), file.size());
+        if (image.components.size() != 1) {
+            throw std::runtime_error(
+                "Error: the JPEG file has " + std::to_string(image.components.size()) +
+                " components, load color images with ColorImage"
+            );
         }
-
-        return RLECompressor::decompress(dc, rle);*/
+        JFIFComponent& component = image.components[0];
+        this->compressed = std::move(component.coefficients);
+        this->quantization.assign(component.quantization, component.quantization + dct::algo::DCT_BLOCK_AREA);
+        this->width = image.width;
+        this->height = image.height;
     }
 }
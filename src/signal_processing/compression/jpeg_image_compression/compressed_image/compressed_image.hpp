@@ -1,30 +1,55 @@
 #ifndef COMPRESSED_IMAGE_HPP
 #define COMPRESSED_IMAGE_HPP
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "compression/jpeg_image_compression/block_coder/block_coder.hpp"
+#include "compression/jpeg_image_compression/dct_method.hpp"
+#include "compression/jpeg_image_compression/plane/plane.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_8x8_integer.hpp"
+#include "utils/mapped_file.hpp"
+
 namespace sp::jpeg
 {
     class Image; //forward declaration
 
     class CompressedImage {
     public:
-        std::vector<std::vector<double>> compressed;    //compressed image matrix
+        Plane<int16_t> compressed;    //compressed image matrix (quantized coefficients, planar)
 
         // default constructor
         CompressedImage() = default;
         /**
          * Constructor that initializes the CompressedImage object from a given matrix by copying it.
+         * The values are rounded to 16-bit integers.
+         *
+         * @param inputMatrix: 2D vector containing the quantized coefficients.
+         */
+        explicit CompressedImage(const std::vector<std::vector<double>>& inputMatrix);
+
+        /**
+         * Constructor that initializes the CompressedImage object from a plane of coefficients (moved, no copy).
          *
-         * @param inputMatrix: 2D vector containing pixel values.
+         * @param coefficients: the quantized coefficients.
          */
-        explicit CompressedImage(std::vector<std::vector<double>> inputMatrix);
+        explicit CompressedImage(Plane<int16_t> coefficients);
 
         /**
-         * Constructor that loads the compressed image from a file .bin
+         * Constructor that initializes the CompressedImage object from a plane of coefficients (moved, no copy)
+         * quantized with the given matrix (e.g. the one of the chroma of a color image).
+         *
+         * @param coefficients: the quantized coefficients.
+         * @param quantization: the 64 entries of the quantization matrix, row-major (copied).
+         */
+        CompressedImage(Plane<int16_t> coefficients, const double* quantization);
+
+        /**
+         * Constructor that loads the compressed image from a file .bin or .jpg
          * @param compressed_image_path:  path to binary file;
-         * @param option: 1 (raw binary), 2 (compressed binary).
+         * @param option: 1 (raw binary), 2 (compressed binary), 3 (baseline grayscale JPEG, see jfif.hpp),
+         *                4 (compressed binary memory-mapped for decompress_region, without loading the coefficients).
          */
         CompressedImage(const std::string& compressed_image_path, int option);
 
@@ -37,75 +62,192 @@ namespace sp::jpeg
 
         /**
          * Function that saves compressed as a compressed binary file (with zigzag + RLE).
+         * The header carries the quantization matrix (see writeCompressedBinaryHeader), so the file is decoded
+         * with the matrix of the encoder whatever the quality.
+         * Every block is encoded by encodeBlock (see block_coder.hpp) into one buffer, written at once.
+         * With blockIndex, the offsets of the blocks are appended (see BlockIndex), for decompress_region.
          *
          * @param path: compressed binary file path.
+         * @param blockIndex: true to append the index of the blocks.
+         * @param checkpointBlocks: number of blocks between two checkpoints of a row of the index (0 for one per row).
+         */
+        void save_as_compressed_binary(
+            const std::string& path,
+            bool blockIndex = false,
+            size_t checkpointBlocks = 0
+        );
+
+        /**
+         * Function that encodes the quantized coefficients as a baseline JFIF (.jpg) file, readable by any
+         * JPEG decoder: the Huffman entropy coding replaces the zigzag + RLE of the compressed binary file.
+         *
+         * The image is split into stripes of restartRows rows of blocks, coded as independent restart
+         * segments: they are encoded concurrently, and decoded concurrently when the file is loaded.
+         *
+         * @param optimizeHuffman: true for the Huffman tables optimized for this image (smaller file,
+         *                         two passes), false for the standard ones of the JPEG specification.
+         * @param restartRows: number of rows of blocks of each stripe (0 for a single segment, decoded serially).
+         * @return: the bytes of the .jpg file.
          */
-        const void save_as_compressed_binary(const std::string& path);
+        std::vector<uint8_t> to_jpeg(bool optimizeHuffman = false, size_t restartRows = 1) const;
+
+        /**
+         * Function that saves compressed as a baseline JFIF (.jpg) file (see to_jpeg).
+         *
+         * @param path: .jpg file path.
+         * @param optimizeHuffman: true for the optimized Huffman tables, false for the standard ones.
+         * @param restartRows: number of rows of blocks of each stripe (0 for a single segment).
+         */
+        void save_as_jpeg(const std::string& path, bool optimizeHuffman = false, size_t restartRows = 1);
+
+        /**
+         * Function that copies the quantized coefficients into a matrix of doubles (one vector per row).
+         *
+         * @return: the matrix of the coefficients.
+         */
+        std::vector<std::vector<double>> to_matrix() const;
 
         /**
          * Function that implements the jpeg decompression algorithm on compressed image matrix.
          *
+         * @param method: arithmetic of the dequantization and of the inverse DCT (floating-point or fixed-point).
          * @return: decompressed image.
          */
-        Image decompress();
+        Image decompress(DCTMethod method = DCTMethod::FLOAT);
+
+        /**
+         * Function that decompresses the image at 1/scale of its resolution (e.g. for thumbnails), with
+         * the reduced inverse DCTs of decompressScaled: only the DC of every block at 1/8, the 2x2 or 4x4
+         * low-frequency coefficients at 1/4 or 1/2. The sizes are rounded up (ceil(width / scale)).
+         *
+         * @param scale: the denominator of the resolution: 1 (same as decompress), 2, 4 or 8.
+         * @return: decompressed image.
+         * @throws std::invalid_argument if the scale is not supported or there is no compressed image.
+         */
+        Image decompress_scaled(size_t scale);
+
+        /**
+         * Function that decompresses a rectangle of the image, decoding only the blocks that intersect it.
+         *
+         * For a compressed binary file opened with option 4, the file is memory-mapped and every row of
+         * blocks of the rectangle is decoded from the nearest checkpoint of the index of the file (built by
+         * a scan of the blocks when the file has none), so only that part of the file is read from the disk.
+         * The rows of blocks are decoded and transformed concurrently.
+         *
+         * @param x: column of the top-left pixel of the rectangle.
+         * @param y: row of the top-left pixel of the rectangle.
+         * @param width: number of columns of the rectangle.
+         * @param height: number of rows of the rectangle.
+         * @param method: arithmetic of the dequantization and of the inverse DCT (floating-point or fixed-point).
+         * @return: the pixels of the rectangle.
+         * @throws std::invalid_argument if the rectangle is empty or out of the image, or there is no compressed image.
+         * @throws std::runtime_error if the mapped file is corrupted.
+         */
+        Image decompress_region(
+            size_t x,
+            size_t y,
+            size_t width,
+            size_t height,
+            DCTMethod method = DCTMethod::FLOAT
+        );
 
     private:
         /**
-         * Function that decompresses a single 8x8 block using JPEG (dequantization + inverse DCT).
+         * The quantization matrix of the coefficients, row-major (empty for the one of the encoder,
+         * see makeQuantizationMatrix); a JPEG file and a compressed binary file of version 1 carry their own.
+         */
+        std::vector<double> quantization;
+        /**
+         * Width and height of the image, in pixels (0 for the sizes of compressed); a JPEG file
+         * can have sizes that are not multiple of 8, its blocks are padded.
+         */
+        size_t width = 0;
+        size_t height = 0;
+        /**
+         * The compressed binary file mapped by option 4 (shared by the copies) and the index of its blocks.
+         */
+        std::shared_ptr<const utils::io::MappedFile> source;
+        BlockIndex index;
+
+        /**
+         * Function that fills the quantization matrix of the coefficients.
+         *
+         * @param quantization: the 64 entries, row-major (output).
+         */
+        void get_quantization(double* quantization) const;
+
+        /**
+         * Function that decompresses a row of 8x8 blocks using JPEG (dequantization + inverse DCT).
          *
+         * The blocks are copied in a contiguous buffer and transformed by the batched 8x8 inverse DCT
+         * (fast AAN kernel, with the dequantization folded into its pre-scale).
          * The output is directly copy into the corresponding position of decompressed.
          *
-         * @param r: position in image_data of the first row of the current submatrix.
-         * @param c: position in image_data of the first column of the current submatrix.
-         * @param submatrixSize: block size (is a squared block).
-         * @param decompressed: decompressed image matrix.
-         * @param Q: quantization matrix.
+         * @param r: position in image_data of the first row of the current row of blocks.
+         * @param decompressed: plane of the decompressed pixels.
+         * @param dequantizationScale: the 64 pre-scale factors of the IDCT (see dct::algo::makeIDCT8x8DequantizationScale).
+         * @param blocks: buffer of 8 * cols values for the blocks (owned by the calling thread).
          */
         void jpeg_decompression(
             int r,
-            int c,
-            int submatrixSize,
-            std::vector<std::vector<double>>& decompressed,
-            std::vector<std::vector<double>>& Q
+            Plane<uint8_t>& decompressed,
+            const double* dequantizationScale,
+            double* blocks
         );
 
         /**
-         * Function that saves a vector using RLE to a binary file.
-         * The vector corresponds to zigzag scan of a submatrix.
+         * Function that decompresses a single 8x8 block using the fixed-point JPEG pipeline
+         * (integer dequantization + integer inverse DCT).
          *
-         * @param file: binary file stream.
-         * @param zzVector: zigzag-scanned vector.
+         * The output is directly copy into the corresponding position of decompressed.
+         *
+         * @param r: position in image_data of the first row of the current submatrix.
+         * @param c: position in image_data of the first column of the current submatrix.
+         * @param decompressed: plane of the decompressed pixels.
+         * @param quantizer: integer dequantization tables of the chosen fixed-point IDCT.
          */
-        const void save_compressed_submatrix(std::ofstream& file, const std::vector<double>& zzVector);
+        void jpeg_decompression_integer(
+            int r,
+            int c,
+            Plane<uint8_t>& decompressed,
+            const dct::algo::IntegerQuantizer& quantizer
+        );
 
         /**
          * Function that loads a compressed image from a binary file into a matrix (vector of vector).
          *
-         * The binary file contains the image data in a raw format.
+         * The binary file contains the image data in a raw format; it is memory-mapped (see utils::io::MappedFile)
+         * and the int8 elements are widened row by row from the mapped bytes.
          *
          * @param path: path to the binary file.
-         * @return: the matrix containing the image.
+         * @return: the plane containing the image.
          */
-        const std::vector<std::vector<double>> load_from_binary(const std::string& path);
+        Plane<int16_t> load_from_binary(const std::string& path);
 
         /**
-         * Function that loads a compressed matrix from a compressed binary file (zigzag + rle).
+         * Function that loads a compressed matrix from a compressed binary file (zigzag + rle), with its
+         * quantization matrix. The file is memory-mapped and every block is decoded by decodeBlock (see block_coder.hpp) from the
+         * mapped bytes; with an index (see BlockIndex), the rows of blocks are decoded concurrently.
          *
          * @param path: the path to the compressed binary file.
-         * @return: the matrix containing the image.
+         * @return: the plane containing the image.
          */
-        const std::vector<std::vector<double>> load_from_compressed_binary(const std::string& path);
+        Plane<int16_t> load_from_compressed_binary(const std::string& path);
 
         /**
-         * Function that loads a submatrix from the compressed binary file stream.
+         * Function that maps a compressed binary file, reads its quantization matrix and reads (or builds)
+         * the index of its blocks.
          *
-         * It returns a vector of size vectorSize, containing the zigzag scan of the submatrix.
+         * @param path: the path to the compressed binary file.
+         */
+        void open_compressed_binary(const std::string& path);
+
+        /**
+         * Function that loads a baseline grayscale JPEG file, with its quantization matrix and sizes.
          *
-         * @param file: reference to the input binary file stream.
-         * @param vectorSize: number of elements to read in the file.
-         * @return: the vector containing the zigzag scan of the submatrix.
+         * @param path: the path to the .jpg file.
          */
-        const std::vector<double> load_compressed_submatrix(std::ifstream& file, int vectorSize);
+        void load_from_jpeg(const std::string& path);
     };
 }
 
@@ -0,0 +1,26 @@
+#ifndef JPEG_DCT_METHOD_HPP
+#define JPEG_DCT_METHOD_HPP
+
+namespace sp::jpeg
+{
+    /**
+     * Arithmetic used by the DCT and the quantization of the JPEG encoder and decoder.
+     */
+    enum class DCTMethod {
+        /**
+         * Floating-point AAN DCT, quantization folded in its scaling (default, most accurate).
+         */
+        FLOAT,
+        /**
+         * Fixed-point accurate DCT (32-bit integers) with reciprocal-multiply quantization.
+         */
+        ISLOW,
+        /**
+         * Fixed-point fast DCT (32-bit integers) with reciprocal-multiply quantization;
+         * less accurate with fine quantization.
+         */
+        IFAST
+    };
+}
+
+#endif //JPEG_DCT_METHOD_HPP
@@ -0,0 +1,476 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "compression/jpeg_image_compression/huffman/huffman.hpp"
+#include "compression/jpeg_image_compression/block_coder/block_coder.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Build a table from the number of codes of each length and the symbols.
+     */
+    static HuffmanTable makeTable(const uint8_t* bits, const uint8_t* values, const size_t numValues) {
+        HuffmanTable table;
+        table.bits[0] = 0;
+        std::memcpy(table.bits + 1, bits, 16);
+        table.values.assign(values, values + numValues);
+        return table;
+    }
+
+    HuffmanTable standardLuminanceDCTable() {
+        const uint8_t bits[16] = {0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+        const uint8_t values[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+        return makeTable(bits, values, 12);
+    }
+
+    HuffmanTable standardLuminanceACTable() {
+        const uint8_t bits[16] = {0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d};
+        const uint8_t values[162] = {
+            0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+            0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0,
+            0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28,
+            0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+            0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+            0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+            0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+            0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5,
+            0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+            0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+            0xf9, 0xfa
+        };
+        return makeTable(bits, values, 162);
+    }
+
+    HuffmanTable standardChrominanceDCTable() {
+        const uint8_t bits[16] = {0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0};
+        const uint8_t values[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+        return makeTable(bits, values, 12);
+    }
+
+    HuffmanTable standardChrominanceACTable() {
+        const uint8_t bits[16] = {0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77};
+        const uint8_t values[162] = {
+            0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+            0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0,
+            0x15, 0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26,
+            0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+            0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+            0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+            0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5,
+            0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3,
+            0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda,
+            0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+            0xf9, 0xfa
+        };
+        return makeTable(bits, values, 162);
+    }
+
+    HuffmanTable buildOptimalHuffmanTable(const uint32_t* frequencies) {
+        // ITU T.81, Figure K.1: 256 symbols plus a reserved one (frequency 1), so no code is all 1-bits
+        constexpr int SYMBOLS = 257;
+        uint64_t freq[SYMBOLS];
+        int codeSize[SYMBOLS];
+        int others[SYMBOLS];
+        for (int i = 0; i < 256; ++i) {
+            freq[i] = frequencies[i];
+        }
+        freq[256] = 1;
+        std::fill(codeSize, codeSize + SYMBOLS, 0);
+        std::fill(others, others + SYMBOLS, -1);
+
+        while (true) {
+            // the two least frequent trees (v1 the least, with the largest index on ties)
+            int v1 = -1, v2 = -1;
+            for (int i = 0; i < SYMBOLS; ++i) {
+                if (freq[i] != 0 && (v1 < 0 || freq[i] <= freq[v1])) {
+                    v1 = i;
+                }
+            }
+            for (int i = 0; i < SYMBOLS; ++i) {
+                if (freq[i] != 0 && i != v1 && (v2 < 0 || freq[i] <= freq[v2])) {
+                    v2 = i;
+                }
+            }
+            if (v2 < 0) {
+                break;
+            }
+            // merge v2 into v1
+            freq[v1] += freq[v2];
+            freq[v2] = 0;
+            ++codeSize[v1];
+            while (others[v1] >= 0) {
+                v1 = others[v1];
+                ++codeSize[v1];
+            }
+            others[v1] = v2;
+            ++codeSize[v2];
+            while (others[v2] >= 0) {
+                v2 = others[v2];
+                ++codeSize[v2];
+            }
+        }
+
+        // Figure K.2: number of codes of each length (up to 32), then Figure K.3: limit them to 16 bits
+        int bits[33] = {0};
+        for (int i = 0; i < SYMBOLS; ++i) {
+            if (codeSize[i] > 0) {
+                ++bits[codeSize[i]];
+            }
+        }
+        for (int i = 32; i > 16; --i) {
+            while (bits[i] > 0) {
+                int j = i - 2;
+                while (bits[j] == 0) {
+                    --j;
+                }
+                bits[i] -= 2;
+                bits[i - 1] += 1;
+                bits[j + 1] += 2;
+                bits[j] -= 1;
+            }
+        }
+        // remove the reserved symbol (one of the longest codes)
+        int longest = 16;
+        while (bits[longest] == 0) {
+            --longest;
+        }
+        --bits[longest];
+
+        // Figure K.4: the symbols by increasing code size (then by value)
+        HuffmanTable table;
+        table.bits[0] = 0;
+        for (int l = 1; l <= 16; ++l) {
+            table.bits[l] = static_cast<uint8_t>(bits[l]);
+        }
+        for (int size = 1; size <= 32; ++size) {
+            for (int i = 0; i < 256; ++i) {
+                if (codeSize[i] == size) {
+                    table.values.push_back(static_cast<uint8_t>(i));
+                }
+            }
+        }
+        // a table without symbols still needs one code
+        if (table.values.empty()) {
+            table.bits[1] = 1;
+            table.values.push_back(0);
+        }
+        return table;
+    }
+
+    /**
+     * Generate the canonical codes of a table (ITU T.81, Annex C) and validate it.
+     *
+     * @param table: the Huffman table.
+     * @param lengths: the length of each code (output, one per symbol of the table).
+     * @param codes: the codes (output, one per symbol of the table).
+     */
+    static void generateCodes(const HuffmanTable& table, std::vector<int>& lengths, std::vector<uint32_t>& codes) {
+        size_t total = 0;
+        for (int l = 1; l <= 16; ++l) {
+            total += table.bits[l];
+        }
+        if (total != table.values.size() || total == 0 || total > 256) {
+            throw std::invalid_argument(
+                "Invalid Huffman table: " + std::to_string(total) + " code lengths for " +
+                std::to_string(table.values.size()) + " symbols"
+            );
+        }
+        uint32_t code = 0;
+        for (int l = 1; l <= 16; ++l) {
+            for (int i = 0; i < table.bits[l]; ++i) {
+                lengths.push_back(l);
+                codes.push_back(code++);
+            }
+            if (code > (1u << l)) {
+                throw std::invalid_argument("Invalid Huffman table: too many codes of length " + std::to_string(l));
+            }
+            code <<= 1;
+        }
+    }
+
+    uint64_t countHuffmanBits(const uint32_t* frequencies, const HuffmanTable& table) {
+        std::vector<int> lengths;
+        std::vector<uint32_t> codes;
+        generateCodes(table, lengths, codes);
+        int length[256] = {0};
+        for (size_t i = 0; i < table.values.size(); ++i) {
+            length[table.values[i]] = lengths[i];
+        }
+        uint64_t bits = 0;
+        for (int symbol = 0; symbol < 256; ++symbol) {
+            if (frequencies[symbol] == 0) {
+                continue;
+            }
+            if (length[symbol] == 0) {
+                throw std::runtime_error("Error: the Huffman table has no code for the symbol " + std::to_string(symbol));
+            }
+            bits += static_cast<uint64_t>(frequencies[symbol]) * (length[symbol] + (symbol & 0x0F));
+        }
+        return bits;
+    }
+
+    HuffmanEncoder::HuffmanEncoder(const HuffmanTable& table) {
+        std::fill(this->code, this->code + 256, 0u);
+        std::fill(this->length, this->length + 256, static_cast<uint8_t>(0));
+        std::vector<int> lengths;
+        std::vector<uint32_t> codes;
+        generateCodes(table, lengths, codes);
+        for (size_t i = 0; i < table.values.size(); ++i) {
+            this->code[table.values[i]] = codes[i];
+            this->length[table.values[i]] = static_cast<uint8_t>(lengths[i]);
+        }
+    }
+
+    void HuffmanEncoder::write(BitWriter& writer, const uint8_t symbol) const {
+        if (this->length[symbol] == 0) {
+            throw std::runtime_error("Error: the Huffman table has no code for the symbol " + std::to_string(symbol));
+        }
+        writer.write(this->code[symbol], this->length[symbol]);
+    }
+
+    HuffmanDecoder::HuffmanDecoder(const HuffmanTable& table) : values(table.values) {
+        std::vector<int> lengths;
+        std::vector<uint32_t> codes;
+        generateCodes(table, lengths, codes);
+
+        std::fill(this->lookup, this->lookup + (1 << LOOKAHEAD), static_cast<uint16_t>(0));
+        std::fill(this->maxCode, this->maxCode + 18, -1);
+        std::fill(this->valueOffset, this->valueOffset + 17, 0);
+        size_t k = 0;
+        for (int l = 1; l <= 16; ++l) {
+            if (table.bits[l] == 0) {
+                continue;
+            }
+            this->valueOffset[l] = static_cast<int32_t>(k) - static_cast<int32_t>(codes[k]);
+            k += table.bits[l];
+            this->maxCode[l] = static_cast<int32_t>(codes[k - 1]);
+        }
+        // sentinel: every sequence of 17 bits is longer than the longest code
+        this->maxCode[17] = 0x7FFFFFFF;
+
+        for (size_t i = 0; i < codes.size(); ++i) {
+            if (lengths[i] > LOOKAHEAD) {
+                break;
+            }
+            // all the LOOKAHEAD-bit prefixes starting with the code
+            const int unused = LOOKAHEAD - lengths[i];
+            const uint32_t first = codes[i] << unused;
+            for (uint32_t fill = 0; fill < (1u << unused); ++fill) {
+                this->lookup[first | fill] = static_cast<uint16_t>((lengths[i] << 8) | this->values[i]);
+            }
+        }
+    }
+
+    uint8_t HuffmanDecoder::read(BitReader& reader) const {
+        const uint16_t entry = this->lookup[reader.peek(LOOKAHEAD)];
+        if (entry != 0) {
+            reader.skip(entry >> 8);
+            return static_cast<uint8_t>(entry & 0xFF);
+        }
+        // codes longer than LOOKAHEAD bits
+        int l = LOOKAHEAD + 1;
+        int32_t code = static_cast<int32_t>(reader.peek(l));
+        while (l <= 16 && code > this->maxCode[l]) {
+            ++l;
+            code = static_cast<int32_t>(reader.peek(l));
+        }
+        if (l > 16) {
+            throw std::runtime_error("Error: corrupted JPEG data (invalid Huffman code)");
+        }
+        reader.skip(l);
+        return this->values[this->valueOffset[l] + code];
+    }
+
+    /**
+     * Number of bits of the magnitude of a value (the JPEG "size" category).
+     */
+    static int magnitudeSize(int value) {
+        if (value < 0) {
+            value = -value;
+        }
+        int size = 0;
+        while (value != 0) {
+            ++size;
+            value >>= 1;
+        }
+        return size;
+    }
+
+    /**
+     * Write a value of the given size category: positive values as they are,
+     * negative ones as value - 1 (one's complement of the magnitude).
+     */
+    static void writeMagnitude(BitWriter& writer, const int value, const int size) {
+        if (size > 0) {
+            writer.write(static_cast<uint32_t>(value < 0 ? value - 1 : value), size);
+        }
+    }
+
+    /**
+     * Read a value of the given size category (ITU T.81, EXTEND procedure).
+     */
+    static int readMagnitude(BitReader& reader, const int size) {
+        if (size == 0) {
+            return 0;
+        }
+        const int bits = static_cast<int>(reader.read(size));
+        return bits < (1 << (size - 1)) ? bits - (1 << size) + 1 : bits;
+    }
+
+    void encodeBlockHuffman(
+        const int16_t* coefficients,
+        int& previousDC,
+        const HuffmanEncoder& dc,
+        const HuffmanEncoder& ac,
+        BitWriter& writer
+    ) {
+        // DC: difference from the previous block
+        const int difference = coefficients[0] - previousDC;
+        previousDC = coefficients[0];
+        const int dcSize = magnitudeSize(difference);
+        if (dcSize > 11) {
+            throw std::runtime_error("Error: DC difference out of the baseline JPEG range");
+        }
+        dc.write(writer, static_cast<uint8_t>(dcSize));
+        writeMagnitude(writer, difference, dcSize);
+
+        // AC: (run of zeros, size) symbols in zigzag order
+        int run = 0;
+        for (size_t k = 1; k < dct::algo::DCT_BLOCK_AREA; ++k) {
+            const int value = coefficients[ZIGZAG_ORDER[k]];
+            if (value == 0) {
+                ++run;
+                continue;
+            }
+            while (run > 15) {
+                ac.write(writer, 0xF0);    // ZRL: 16 zeros
+                run -= 16;
+            }
+            const int acSize = magnitudeSize(value);
+            if (acSize > 10) {
+                throw std::runtime_error("Error: AC coefficient out of the baseline JPEG range");
+            }
+            ac.write(writer, static_cast<uint8_t>((run << 4) | acSize));
+            writeMagnitude(writer, value, acSize);
+            run = 0;
+        }
+        if (run > 0) {
+            ac.write(writer, 0x00);    // EOB
+        }
+    }
+
+    void countBlockSymbols(
+        const int16_t* coefficients,
+        int& previousDC,
+        uint32_t* dcFrequencies,
+        uint32_t* acFrequencies
+    ) {
+        const int difference = coefficients[0] - previousDC;
+        previousDC = coefficients[0];
+        ++dcFrequencies[std::min(magnitudeSize(difference), 11)];
+
+        int run = 0;
+        for (size_t k = 1; k < dct::algo::DCT_BLOCK_AREA; ++k) {
+            const int value = coefficients[ZIGZAG_ORDER[k]];
+            if (value == 0) {
+                ++run;
+                continue;
+            }
+            while (run > 15) {
+                ++acFrequencies[0xF0];
+                run -= 16;
+            }
+            ++acFrequencies[(run << 4) | std::min(magnitudeSize(value), 10)];
+            run = 0;
+        }
+        if (run > 0) {
+            ++acFrequencies[0x00];
+        }
+    }
+
+    void decodeBlockHuffman(
+        BitReader& reader,
+        int& previousDC,
+        const HuffmanDecoder& dc,
+        const HuffmanDecoder& ac,
+        int16_t* coefficients
+    ) {
+        std::fill(coefficients, coefficients + dct::algo::DCT_BLOCK_AREA, static_cast<int16_t>(0));
+
+        const int dcSize = dc.read(reader);
+        if (dcSize > 11) {
+            throw std::runtime_error("Error: corrupted JPEG data (invalid DC size)");
+        }
+        previousDC += readMagnitude(reader, dcSize);
+        coefficients[0] = static_cast<int16_t>(previousDC);
+
+        size_t k = 1;
+        while (k < dct::algo::DCT_BLOCK_AREA) {
+            const uint8_t symbol = ac.read(reader);
+            const int run = symbol >> 4;
+            const int size = symbol & 0x0F;
+            if (size == 0) {
+                if (run != 15) {
+                    break;    // EOB
+                }
+                k += 16;      // ZRL
+                continue;
+            }
+            k += run;
+            if (k >= dct::algo::DCT_BLOCK_AREA) {
+                throw std::runtime_error("Error: corrupted JPEG data (AC run out of the block)");
+            }
+            coefficients[ZIGZAG_ORDER[k++]] = static_cast<int16_t>(readMagnitude(reader, size));
+        }
+    }
+
+    void decodeBlockHuffmanScaled(
+        BitReader& reader,
+        int& previousDC,
+        const HuffmanDecoder& dc,
+        const HuffmanDecoder& ac,
+        const int size,
+        int16_t* coefficients
+    ) {
+        constexpr int submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        if (size < 1 || size > submatrixSize) {
+            throw std::invalid_argument("The size of the decoded corner must be in [1, 8]. Given: " + std::to_string(size));
+        }
+        std::fill(coefficients, coefficients + size * size, static_cast<int16_t>(0));
+
+        const int dcSize = dc.read(reader);
+        if (dcSize > 11) {
+            throw std::runtime_error("Error: corrupted JPEG data (invalid DC size)");
+        }
+        previousDC += readMagnitude(reader, dcSize);
+        coefficients[0] = static_cast<int16_t>(previousDC);
+
+        size_t k = 1;
+        while (k < dct::algo::DCT_BLOCK_AREA) {
+            const uint8_t symbol = ac.read(reader);
+            const int run = symbol >> 4;
+            const int acSize = symbol & 0x0F;
+            if (acSize == 0) {
+                if (run != 15) {
+                    break;    // EOB
+                }
+                k += 16;      // ZRL
+                continue;
+            }
+            k += run;
+            if (k >= dct::algo::DCT_BLOCK_AREA) {
+                throw std::runtime_error("Error: corrupted JPEG data (AC run out of the block)");
+            }
+            const int index = ZIGZAG_ORDER[k++];
+            const int row = index / submatrixSize;
+            const int col = index % submatrixSize;
+            if (row < size && col < size) {
+                coefficients[row * size + col] = static_cast<int16_t>(readMagnitude(reader, acSize));
+            } else {
+                reader.read(acSize);    // not used by the reduced inverse DCT: skip the magnitude bits
+            }
+        }
+    }
+}
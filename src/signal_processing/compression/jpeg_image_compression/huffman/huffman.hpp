@@ -0,0 +1,377 @@
+#ifndef JPEG_HUFFMAN_HPP
+#define JPEG_HUFFMAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sp::jpeg
+{
+    /**
+     * Huffman table in the form stored in a JPEG DHT segment (ITU T.81, Annex C).
+     */
+    struct HuffmanTable {
+        /**
+         * bits[l] is the number of codes of length l, 1 <= l <= 16 (bits[0] is unused).
+         */
+        uint8_t bits[17];
+        /**
+         * The symbols, in order of increasing code length.
+         */
+        std::vector<uint8_t> values;
+    };
+
+    /**
+     * Standard luminance DC table (ITU T.81, Table K.3).
+     */
+    HuffmanTable standardLuminanceDCTable();
+
+    /**
+     * Standard luminance AC table (ITU T.81, Table K.5).
+     */
+    HuffmanTable standardLuminanceACTable();
+
+    /**
+     * Standard chrominance DC table (ITU T.81, Table K.4).
+     */
+    HuffmanTable standardChrominanceDCTable();
+
+    /**
+     * Standard chrominance AC table (ITU T.81, Table K.6).
+     */
+    HuffmanTable standardChrominanceACTable();
+
+    /**
+     * Function that builds the optimal Huffman table (code lengths limited to 16 bits) for the given
+     * symbol frequencies, following ITU T.81, Annex K.2.
+     *
+     * @param frequencies: the 256 symbol frequencies.
+     * @return: the table (at least one code, even if no symbol was counted).
+     */
+    HuffmanTable buildOptimalHuffmanTable(const uint32_t* frequencies);
+
+    /**
+     * Function that computes the number of bits of the symbols counted by countBlockSymbols once coded
+     * with a table: every symbol takes its code and the magnitude bits that follow it (their number is
+     * the low nibble of the symbol, for DC and AC). The stuffing bytes are not included.
+     *
+     * @param frequencies: the 256 symbol frequencies.
+     * @param table: the Huffman table.
+     * @return: the number of bits.
+     * @throws std::runtime_error if a counted symbol has no code in the table.
+     */
+    uint64_t countHuffmanBits(const uint32_t* frequencies, const HuffmanTable& table);
+
+    /**
+     * Appends bits to a JPEG entropy-coded segment, with the 0xFF byte stuffing.
+     */
+    class BitWriter {
+    public:
+        /**
+         * @param output: the vector where the bytes are appended.
+         */
+        explicit BitWriter(std::vector<uint8_t>& output) : output(output), accumulator(0), count(0) {}
+
+        /**
+         * Append the lowest length bits of code, most significant first.
+         *
+         * @param code: the bits.
+         * @param length: number of bits (at most 24).
+         */
+        void write(const uint32_t code, const int length) {
+            this->accumulator = (this->accumulator << length) | (code & ((1u << length) - 1));
+            this->count += length;
+            while (this->count >= 8) {
+                this->count -= 8;
+                const auto byte = static_cast<uint8_t>(this->accumulator >> this->count);
+                this->output.push_back(byte);
+                if (byte == 0xFF) {
+                    this->output.push_back(0x00);
+                }
+            }
+        }
+
+        /**
+         * Pad the last byte with 1-bits (as required before a marker).
+         */
+        void flush() {
+            if (this->count > 0) {
+                this->write(0x7F, 8 - this->count);
+            }
+            this->accumulator = 0;
+        }
+
+    private:
+        /**
+         * The output bytes.
+         */
+        std::vector<uint8_t>& output;
+        /**
+         * The pending bits (the lowest count ones).
+         */
+        uint64_t accumulator;
+        /**
+         * Number of pending bits.
+         */
+        int count;
+    };
+
+    /**
+     * Reads bits from a JPEG entropy-coded segment, removing the byte stuffing.
+     *
+     * When a marker is reached the reader stops and returns zero bits (as libjpeg does), so a corrupted
+     * or truncated segment never reads out of bounds.
+     */
+    class BitReader {
+    public:
+        /**
+         * @param data: pointer to the first byte of the entropy-coded segment.
+         * @param size: number of available bytes.
+         */
+        BitReader(const uint8_t* data, const size_t size) :
+            data(data), size(size), position(0), accumulator(0), count(0), marker(0) {}
+
+        /**
+         * Get the next bits without consuming them.
+         *
+         * @param length: number of bits (at most 25).
+         * @return: the bits, the first one as the most significant.
+         */
+        uint32_t peek(const int length) {
+            this->fill(length);
+            return static_cast<uint32_t>(this->accumulator >> (this->count - length)) & ((1u << length) - 1);
+        }
+
+        /**
+         * Consume bits.
+         *
+         * @param length: number of bits (at most peeked ones).
+         */
+        void skip(const int length) {
+            this->count -= length;
+        }
+
+        /**
+         * Read bits.
+         *
+         * @param length: number of bits (at most 25).
+         * @return: the bits, the first one as the most significant.
+         */
+        uint32_t read(const int length) {
+            const uint32_t bits = this->peek(length);
+            this->skip(length);
+            return bits;
+        }
+
+        /**
+         * Discard the pending bits and the marker found (if any), e.g. at a restart marker.
+         *
+         * @return: the marker found (0 if none).
+         */
+        uint8_t takeMarker() {
+            const uint8_t found = this->marker;
+            this->accumulator = 0;
+            this->count = 0;
+            this->marker = 0;
+            return found;
+        }
+
+        /**
+         * Get the position of the next unread byte.
+         * @return The number of bytes consumed from data (the marker bytes included, if reached).
+         */
+        [[nodiscard]] size_t getPosition() const {
+            return position;
+        }
+
+    private:
+        const uint8_t* data;
+        size_t size;
+        size_t position;
+        uint64_t accumulator;
+        int count;
+        /**
+         * The marker that stopped the reading (0 if none).
+         */
+        uint8_t marker;
+
+        /**
+         * Load bytes until at least length bits are pending.
+         */
+        void fill(const int length) {
+            while (this->count < length) {
+                uint8_t byte = 0;
+                if (this->marker == 0 && this->position < this->size) {
+                    byte = this->data[this->position++];
+                    if (byte == 0xFF) {
+                        // skip fill bytes, then 0x00 is a stuffed 0xFF, anything else a marker
+                        while (this->position < this->size && this->data[this->position] == 0xFF) {
+                            ++this->position;
+                        }
+                        const uint8_t next = this->position < this->size ? this->data[this->position++] : 0xD9;
+                        if (next != 0x00) {
+                            this->marker = next;
+                            byte = 0;
+                        }
+                    }
+                }
+                this->accumulator = (this->accumulator << 8) | byte;
+                this->count += 8;
+            }
+        }
+    };
+
+    /**
+     * Huffman encoder: code and length of every symbol of a table.
+     */
+    class HuffmanEncoder {
+    public:
+        /**
+         * @param table: the Huffman table.
+         * @throws std::invalid_argument if the table is not valid.
+         */
+        explicit HuffmanEncoder(const HuffmanTable& table);
+
+        /**
+         * Write the code of a symbol.
+         *
+         * @param writer: the bit writer.
+         * @param symbol: the symbol.
+         * @throws std::runtime_error if the symbol has no code in the table.
+         */
+        void write(BitWriter& writer, uint8_t symbol) const;
+
+    private:
+        /**
+         * The codes of the symbols.
+         */
+        uint32_t code[256];
+        /**
+         * The code lengths of the symbols (0 if the symbol has no code).
+         */
+        uint8_t length[256];
+    };
+
+    /**
+     * Table-driven Huffman decoder: the codes up to LOOKAHEAD bits are decoded by a single lookup,
+     * the longer ones by the canonical-code limits (ITU T.81, Annex F.2.2.3).
+     */
+    class HuffmanDecoder {
+    public:
+        /**
+         * Number of bits of the lookup table.
+         */
+        static constexpr int LOOKAHEAD = 9;
+
+        /**
+         * @param table: the Huffman table.
+         * @throws std::invalid_argument if the table is not valid.
+         */
+        explicit HuffmanDecoder(const HuffmanTable& table);
+
+        /**
+         * Read a symbol.
+         *
+         * @param reader: the bit reader.
+         * @return: the symbol.
+         * @throws std::runtime_error if the bits are not a code of the table.
+         */
+        uint8_t read(BitReader& reader) const;
+
+    private:
+        /**
+         * For every LOOKAHEAD-bit prefix: (length << 8) | symbol, or 0 if the code is longer.
+         */
+        uint16_t lookup[1 << LOOKAHEAD];
+        /**
+         * Largest code of each length (-1 if none).
+         */
+        int32_t maxCode[18];
+        /**
+         * Index in values of the first code of each length, minus that code.
+         */
+        int32_t valueOffset[17];
+        /**
+         * The symbols, in order of increasing code length.
+         */
+        std::vector<uint8_t> values;
+    };
+
+    /**
+     * Function that entropy-codes a block of quantized coefficients with the baseline JPEG Huffman coding:
+     * the DC difference from the previous block as (size, bits), the AC coefficients in zigzag order as
+     * (run, size) symbols and bits, with ZRL (16 zeros) and EOB symbols.
+     *
+     * @param coefficients: the 64 quantized coefficients, row-major.
+     * @param previousDC: the DC of the previous block of the component (updated).
+     * @param dc: the DC Huffman encoder.
+     * @param ac: the AC Huffman encoder.
+     * @param writer: the bit writer.
+     * @throws std::runtime_error if a coefficient is out of the baseline range.
+     */
+    void encodeBlockHuffman(
+        const int16_t* coefficients,
+        int& previousDC,
+        const HuffmanEncoder& dc,
+        const HuffmanEncoder& ac,
+        BitWriter& writer
+    );
+
+    /**
+     * Function that counts the Huffman symbols of a block (first pass of the optimized tables).
+     *
+     * @param coefficients: the 64 quantized coefficients, row-major.
+     * @param previousDC: the DC of the previous block of the component (updated).
+     * @param dcFrequencies: the 256 DC symbol frequencies (updated).
+     * @param acFrequencies: the 256 AC symbol frequencies (updated).
+     */
+    void countBlockSymbols(
+        const int16_t* coefficients,
+        int& previousDC,
+        uint32_t* dcFrequencies,
+        uint32_t* acFrequencies
+    );
+
+    /**
+     * Function that decodes a block coded by encodeBlockHuffman.
+     *
+     * @param reader: the bit reader.
+     * @param previousDC: the DC of the previous block of the component (updated).
+     * @param dc: the DC Huffman decoder.
+     * @param ac: the AC Huffman decoder.
+     * @param coefficients: the 64 quantized coefficients, row-major (output).
+     * @throws std::runtime_error if the data is corrupted.
+     */
+    void decodeBlockHuffman(
+        BitReader& reader,
+        int& previousDC,
+        const HuffmanDecoder& dc,
+        const HuffmanDecoder& ac,
+        int16_t* coefficients
+    );
+
+    /**
+     * Function that decodes a block coded by encodeBlockHuffman keeping only its size x size
+     * low-frequency coefficients (the ones used by a reduced inverse DCT, see decompressScaled):
+     * the other AC symbols are read to advance the bitstream, but their values are not stored.
+     *
+     * @param reader: the bit reader.
+     * @param previousDC: the DC of the previous block of the component (updated).
+     * @param dc: the DC Huffman decoder.
+     * @param ac: the AC Huffman decoder.
+     * @param size: the side of the kept corner of the block (1 for the DC only, up to 8).
+     * @param coefficients: the size * size quantized coefficients, row-major (output).
+     * @throws std::invalid_argument if the size is not in [1, 8].
+     * @throws std::runtime_error if the data is corrupted.
+     */
+    void decodeBlockHuffmanScaled(
+        BitReader& reader,
+        int& previousDC,
+        const HuffmanDecoder& dc,
+        const HuffmanDecoder& ac,
+        int size,
+        int16_t* coefficients
+    );
+}
+
+#endif //JPEG_HUFFMAN_HPP
@@ -1,6 +1,8 @@
 #include <iostream>
 #include <fstream>
 #include <cmath>
+#include <cstring>
+#include <omp.h>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb/stb_image.h"
@@ -9,39 +11,86 @@
 
 #include "compression/jpeg_image_compression/image/image.hpp"
 #include "compression/jpeg_image_compression/compressed_image/compressed_image.hpp"
-#include "transforms/discrete_cosine_transform/discrete_cosine_transform/discrete_cosine_transform.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_8x8.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_batch.hpp"
+#include "compression/jpeg_image_compression/block_coder/block_coder.hpp"
+#include "compression/jpeg_image_compression/quantization/quantization.hpp"
+#include "compression/jpeg_image_compression/jfif/jfif.hpp"
+#include "compression/jpeg_image_compression/rate_control/rate_control.hpp"
 
 namespace sp::jpeg
 {
+    /**
+     * Function that checks that the sizes of the image are multiple of the block size (8).
+     *
+     * @param rows: number of rows of the image.
+     * @param cols: number of columns of the image.
+     */
+    static void checkBlockSizes(const size_t rows, const size_t cols) {
+        constexpr size_t submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        // sanity check if the image_data size are multiple of submatrixSize
+        if(rows % submatrixSize != 0 || cols % submatrixSize != 0) {
+            std::cerr << "Error: the image is not compressible since its sizes are not multiple of "
+                      << submatrixSize << std::endl;
+            throw std::runtime_error("Error: the image is not compressible since its sizes are not multiple of 8");
+        }
+    }
+
     // #################### CONSTRUCTORS ####################
 
-    Image::Image(std::vector<std::vector<double>> inputMatrix): img_matrix(inputMatrix) {}
+    Image::Image(const std::vector<std::vector<double>>& inputMatrix) {
+        const size_t rows = inputMatrix.size();
+        const size_t cols = rows > 0 ? inputMatrix[0].size() : 0;
+        this->pixels = Plane<uint8_t>(rows, cols);
+        for (size_t r = 0; r < rows; ++r) {
+            uint8_t* row = this->pixels.row(r);
+            for (size_t c = 0; c < cols; ++c) {
+                row[c] = static_cast<uint8_t>(std::lround(std::min(255.0, std::max(0.0, inputMatrix[r][c]))));
+            }
+        }
+    }
+
+    Image::Image(Plane<uint8_t> pixels): pixels(std::move(pixels)) {}
+
+    Image::Image(unsigned char* data, const int width, const int height, const int channels) {
+        if (channels == 1) {
+            // adopt the buffer of stb_image, no copies
+            this->pixels = Plane<uint8_t>(data, height, width, width, stbi_image_free);
+            return;
+        }
+        if (channels < 3) {
+            stbi_image_free(data);
+            throw std::runtime_error("Unsupported number of channels: " + std::to_string(channels));
+        }
+        this->pixels = Plane<uint8_t>(height, width);
+        for (int r = 0; r < height; ++r) {
+            const unsigned char* source = data + static_cast<size_t>(r) * width * channels;
+            uint8_t* row = this->pixels.row(r);
+            for (int c = 0; c < width; ++c) {
+                const unsigned char* pixel = source + c * channels;
+                row[c] = static_cast<uint8_t>(0.299 * pixel[0] + 0.587 * pixel[1] + 0.114 * pixel[2]);
+            }
+        }
+        stbi_image_free(data);
+    }
 
     Image::Image(const char* image_path){
-        this->img_matrix = load_from_png(image_path);
+        this->pixels = load_from_png(image_path);
     }
 
     // #################### PUBLIC ####################
 
     const void Image::save_as_png(const std::string path){
-        if(this->img_matrix.empty()){
+        if(this->pixels.empty()){
             throw std::invalid_argument("Error: image matrix is empty, cannot save to png.");
         }
 
-        const size_t rows = this->img_matrix.size();
-        const size_t cols = this->img_matrix[0].size();
+        const int rows = static_cast<int>(this->pixels.getRows());
+        const int cols = static_cast<int>(this->pixels.getCols());
+        const int stride = static_cast<int>(this->pixels.getPitch());
 
-        // Convert the image into grayscale (pixel values between 0,255) and store it as 1D vector
-        std::vector<unsigned char> image_data(rows * cols);
-
-        for (int r = 0; r < rows; ++r) {
-            for (int c = 0; c < cols; ++c) {
-                // clamp value between 0,255
-                image_data[r * cols + c] = std::min(255.0, std::max(0.0, this->img_matrix[r][c]));
-            }
-        }
-        // Save the image using stb_image_write
-        if (stbi_write_png(path.c_str(), cols, rows, 1, image_data.data(), cols) == 0) {
+        // Save the image using stb_image_write (the pixels are already grayscale values between 0,255)
+        if (stbi_write_png(path.c_str(), cols, rows, 1, this->pixels.data(), stride) == 0) {
             std::cerr << "Error: Could not save grayscale image" << std::endl;
             throw std::runtime_error("Error: Could not save grayscale image");
         }
@@ -49,82 +98,335 @@ namespace sp::jpeg
         std::cout << "Image written successfully in a png file!" << std::endl;
     }
 
-    CompressedImage Image::compress(){
-        if (this->img_matrix.empty()) {
-            throw std::invalid_argument("Error: image matrix is empty, cannot be compressed.");
+    std::vector<std::vector<double>> Image::to_matrix() const {
+        const size_t rows = this->pixels.getRows();
+        const size_t cols = this->pixels.getCols();
+        std::vector<std::vector<double>> matrix(rows, std::vector<double>(cols));
+        for (size_t r = 0; r < rows; ++r) {
+            const uint8_t* row = this->pixels.row(r);
+            for (size_t c = 0; c < cols; ++c) {
+                matrix[r][c] = row[c];
+            }
         }
+        return matrix;
+    }
 
-        const size_t rows = this->img_matrix.size();
-        const size_t cols = this->img_matrix[0].size();
-        auto compressed = std::vector<std::vector<double>>(rows, std::vector<double>(cols));
+    CompressedImage Image::compress(const DCTMethod method){
+        double quantization[dct::algo::DCT_BLOCK_AREA];
+        makeQuantizationMatrix(quantization);
+        return compress(method, quantization);
+    }
 
-        // Create the constant matrix Q (quantization matrix) --> is a 8x8
-        std::vector<std::vector<double>> Q = {
-            { 16, 11, 10, 16, 24, 40, 51, 61},
-            { 12, 12, 14, 19, 26, 58, 60, 55},
-            { 14, 13, 16, 24, 40, 57, 69, 56},
-            { 14, 17, 22, 29, 51, 87, 80, 62},
-            { 18, 22, 37, 56, 68, 109, 103, 7},
-            { 24, 35, 55, 64, 81, 104, 113, 92},
-            { 49, 64, 78, 87, 103, 121, 120, 101},
-            { 72, 92, 95, 98, 112, 100, 103, 99}
-        };
+    CompressedImage Image::compress(const DCTMethod method, const int quality){
+        return compress(method, getQuantizationTable(quality).quantization);
+    }
 
-        // Split up the image into blocks of 8 × 8 pixels
-        int submatrixSize = 8;
-        // sanity check if the image_data size are multiple of submatrixSize
-        if(rows % submatrixSize != 0 || cols % submatrixSize != 0) {
-            std::cerr << "Error: the image is not compressible since its sizes are not multiple of "
-                      << submatrixSize << std::endl;
-            throw std::runtime_error("Error: the image is not compressible since its sizes are not multiple of 8");
+    CompressedImage Image::compress(const DCTMethod method, const double* quantization){
+        if (this->pixels.empty()) {
+            throw std::invalid_argument("Error: image matrix is empty, cannot be compressed.");
         }
 
-        #pragma omp parallel for
-        for (int r = 0; r < rows; r += submatrixSize) {
-            for (int c = 0; c < cols; c += submatrixSize) {
-                jpeg_compression(r, c, submatrixSize, compressed, Q);
+        const size_t rows = this->pixels.getRows();
+        const size_t cols = this->pixels.getCols();
+        Plane<int16_t> compressed(rows, cols);
+
+        // Split up the image into blocks of 8 × 8 pixels
+        constexpr int submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        checkBlockSizes(rows, cols);
+
+        if (method == DCTMethod::FLOAT) {
+            // Fold the division by Q into the post-scale of the 8x8 DCT
+            alignas(64) double quantizationScale[dct::algo::DCT_BLOCK_AREA];
+            dct::algo::makeDCT8x8QuantizationScale(quantization, quantizationScale);
+
+            // one parallel region over the rows of blocks; the batched DCT of each row runs in the calling thread
+            #pragma omp parallel if(!omp_in_parallel())
+            {
+                // per-thread buffer of a row of blocks, reused for all the rows of the thread
+                std::vector<double> blocks(submatrixSize * cols);
+
+                #pragma omp for
+                for (size_t r = 0; r < rows; r += submatrixSize) {
+                    jpeg_compression(r, compressed, quantizationScale, blocks.data());
+                }
+            }
+        } else {
+            // Fixed-point pipeline: integer DCT and reciprocal-multiply quantization
+            const dct::algo::IntegerQuantizer quantizer(
+                quantization,
+                method == DCTMethod::IFAST ? dct::algo::IntegerDCTMethod::IFAST : dct::algo::IntegerDCTMethod::ISLOW
+            );
+
+            #pragma omp parallel for if(!omp_in_parallel())
+            for (size_t r = 0; r < rows; r += submatrixSize) {
+                for (size_t c = 0; c < cols; c += submatrixSize) {
+                    jpeg_compression_integer(r, c, compressed, quantizer);
+                }
             }
         }
 
-        CompressedImage compressedImage = CompressedImage(compressed);
+        CompressedImage compressedImage = CompressedImage(std::move(compressed), quantization);
         return compressedImage;
     }
 
+    std::vector<uint8_t> Image::compress_to_binary(
+        const DCTMethod method,
+        const bool blockIndex,
+        const size_t checkpointBlocks
+    ){
+        if (this->pixels.empty()) {
+            throw std::invalid_argument("Error: image matrix is empty, cannot be compressed.");
+        }
+
+        const size_t rows = this->pixels.getRows();
+        const size_t cols = this->pixels.getCols();
+
+        double quantization[dct::algo::DCT_BLOCK_AREA];
+        makeQuantizationMatrix(quantization);
+
+        constexpr int submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        checkBlockSizes(rows, cols);
+        const size_t blockRows = rows / submatrixSize;
+
+        // one output buffer per thread, each for a contiguous range of rows of blocks (concatenated in order)
+        const int maxThreads = omp_in_parallel() ? 1 : omp_get_max_threads();
+        std::vector<std::vector<uint8_t>> chunks(maxThreads);
+
+        alignas(64) double quantizationScale[dct::algo::DCT_BLOCK_AREA];
+        dct::algo::makeDCT8x8QuantizationScale(quantization, quantizationScale);
+        const dct::algo::IntegerQuantizer quantizer(
+            quantization,
+            method == DCTMethod::IFAST ? dct::algo::IntegerDCTMethod::IFAST : dct::algo::IntegerDCTMethod::ISLOW
+        );
+
+        #pragma omp parallel num_threads(maxThreads) if(maxThreads > 1)
+        {
+            const size_t thread = omp_get_thread_num();
+            const size_t numThreads = omp_get_num_threads();
+            const size_t begin = blockRows * thread / numThreads;
+            const size_t end = blockRows * (thread + 1) / numThreads;
+
+            // per-thread buffers, reused for all the rows of blocks of the thread
+            std::vector<uint8_t>& output = chunks[thread];
+            std::vector<double> blocks(submatrixSize * cols);
+
+            for (size_t b = begin; b < end; ++b) {
+                if (method == DCTMethod::FLOAT) {
+                    encode_block_row(b * submatrixSize, quantizationScale, blocks.data(), output);
+                } else {
+                    encode_block_row_integer(b * submatrixSize, quantizer, output);
+                }
+            }
+        }
+
+        // header of the compressed binary file (sizes and quantization matrix), then the chunks
+        std::vector<uint8_t> binary;
+        writeCompressedBinaryHeader(rows, cols, quantization, binary);
+        size_t size = binary.size();
+        for (const auto& chunk : chunks) {
+            size += chunk.size();
+        }
+        binary.reserve(size);
+        for (const auto& chunk : chunks) {
+            binary.insert(binary.end(), chunk.begin(), chunk.end());
+        }
+        if (blockIndex) {
+            appendBlockIndex(buildBlockIndex(binary.data(), binary.size(), checkpointBlocks), binary);
+        }
+        return binary;
+    }
+
+    void Image::save_as_compressed_binary(
+        const std::string& path,
+        const DCTMethod method,
+        const bool blockIndex,
+        const size_t checkpointBlocks
+    ){
+        const std::vector<uint8_t> binary = compress_to_binary(method, blockIndex, checkpointBlocks);
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            std::cerr << "Error opening binary file!" << std::endl;
+            throw std::runtime_error("Error opening binary file!");
+        }
+        file.write(reinterpret_cast<const char*>(binary.data()), static_cast<std::streamsize>(binary.size()));
+        file.close();
+
+        std::cout << "Image compressed and written successfully in a binary file using zigzag scan & rle compression!"
+                  << std::endl;
+    }
+
+    void Image::save_as_jpeg(
+        const std::string& path,
+        const DCTMethod method,
+        const bool optimizeHuffman,
+        const size_t restartRows,
+        const int quality
+    ){
+        compress(method, quality).save_as_jpeg(path, optimizeHuffman, restartRows);
+    }
+
+    std::vector<uint8_t> Image::to_jpeg_with_size(
+        const size_t targetBytes,
+        const bool optimizeHuffman,
+        const size_t restartRows,
+        int* quality
+    ){
+        if (this->pixels.empty()) {
+            throw std::invalid_argument("Error: image matrix is empty, cannot be compressed.");
+        }
+        const size_t rows = this->pixels.getRows();
+        const size_t cols = this->pixels.getCols();
+        checkBlockSizes(rows, cols);
+
+        JFIFImage image;
+        image.width = cols;
+        image.height = rows;
+        image.restartInterval = restartRows * (cols / dct::algo::DCT_BLOCK_SIZE);
+        image.components.resize(1);
+        image.components[0].horizontalSampling = 1;
+        image.components[0].verticalSampling = 1;
+        return RateController(std::move(image), &this->pixels).compress(targetBytes, optimizeHuffman, quality);
+    }
+
     // #################### PRIVATE ####################
 
     void Image::jpeg_compression(
+        const int r,
+        Plane<int16_t>& compressed,
+        const double* quantizationScale,
+        double* blocks
+    ) {
+        constexpr int submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        const size_t cols = this->pixels.getCols();
+        const size_t numBlocks = cols / submatrixSize;
+
+        // 1. Copy the row of blocks into the buffer, one contiguous block after the other
+        for (size_t b = 0; b < numBlocks; ++b) {
+            double* block = blocks + b * dct::algo::DCT_BLOCK_AREA;
+            const size_t c = b * submatrixSize;
+            for (int i=0; i<submatrixSize; ++i){
+                for (int j=0; j<submatrixSize; ++j){
+                    // 2. Subtract 128 from each entry, so that the entries are now integers between -128 and 127.
+                    block[i * submatrixSize + j] = this->pixels(r+i, c+j) - 128.0;
+                }
+            }
+        }
+
+        // 3. Take the 2-dimensional discrete cosine transform (dct) of all the blocks,
+        // 4. and divide the blocks elementwise by the quantization matrix Q (folded in the DCT post-scale)
+        dct::algo::computeDCT8x8Batch(blocks, numBlocks, quantizationScale, true);
+
+        // 5. Round each entry to the nearest integer and save the result in the big matrix of the image
+        for (size_t b = 0; b < numBlocks; ++b) {
+            const double* block = blocks + b * dct::algo::DCT_BLOCK_AREA;
+            const size_t c = b * submatrixSize;
+            for (int i=0; i<submatrixSize; ++i){
+                for (int j=0; j<submatrixSize; ++j){
+                    compressed(r+i, c+j) = static_cast<int16_t>(std::lround(block[i * submatrixSize + j]));
+                }
+            }
+        }
+    }
+
+    void Image::jpeg_compression_integer(
         const int r,
         const int c,
-        const int submatrixSize,
-        std::vector<std::vector<double>>& compressed,
-        std::vector<std::vector<double>>& Q
+        Plane<int16_t>& compressed,
+        const dct::algo::IntegerQuantizer& quantizer
     ) {
-        // 1. Create a copy of the submatrix
-        std::vector<std::vector<double>> submatrix(submatrixSize, std::vector<double>(submatrixSize));
+        constexpr int submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+
+        // 1. Create a copy of the submatrix (on the stack)
+        alignas(64) int32_t block[dct::algo::DCT_BLOCK_AREA];
         for (int i=0; i<submatrixSize; ++i){
             for (int j=0; j<submatrixSize; ++j){
                 // 2. Subtract 128 from each entry, so that the entries are now integers between -128 and 127.
-                submatrix[i][j] = this->img_matrix[r+i][c+j] - 128.0;
+                block[i * submatrixSize + j] = static_cast<int32_t>(this->pixels(r+i, c+j)) - 128;
             }
         }
 
-        // 3. Take the 2-dimensional discrete cosine transform (dct) of the block.
-        dct::solver::DiscreteCosineTransform dct_solver = dct::solver::DiscreteCosineTransform();
-        const dct::solver::ComputationMode cm = dct::solver::ComputationMode::OPENMP;
-        dct_solver.compute(submatrix, cm);
+        // 3. Take the fixed-point 2-dimensional discrete cosine transform (dct) of the block.
+        dct::algo::computeDCT8x8Integer(block, quantizer.getMethod());
 
-        // 4. Divide the block elementwise by a constant matrix Q known as a quantization matrix,
-        //    and then round each entry to the nearest integer
+        // 4. Divide the block elementwise by Q and round (integer reciprocal multiplication)
+        alignas(64) int16_t coefficients[dct::algo::DCT_BLOCK_AREA];
+        quantizer.quantize(block, coefficients);
+
+        // 5. Save the result in the big matrix of the image
         for (int i=0; i<submatrixSize; ++i){
             for (int j=0; j<submatrixSize; ++j){
-                // 5. Save the result in the big matrix of the image
-                compressed[r+i][c+j] = std::round(submatrix[i][j] / Q[i][j]);
+                compressed(r+i, c+j) = coefficients[i * submatrixSize + j];
+            }
+        }
+    }
+
+    void Image::encode_block_row(
+        const int r,
+        const double* quantizationScale,
+        double* blocks,
+        std::vector<uint8_t>& output
+    ) {
+        constexpr int submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        const size_t cols = this->pixels.getCols();
+        const size_t numBlocks = cols / submatrixSize;
+
+        // 1. Copy the row of blocks into the buffer and subtract 128 from each entry
+        for (size_t b = 0; b < numBlocks; ++b) {
+            double* block = blocks + b * dct::algo::DCT_BLOCK_AREA;
+            const size_t c = b * submatrixSize;
+            for (int i=0; i<submatrixSize; ++i){
+                for (int j=0; j<submatrixSize; ++j){
+                    block[i * submatrixSize + j] = this->pixels(r+i, c+j) - 128.0;
+                }
+            }
+        }
+
+        // 2. Take the 2-dimensional dct of all the blocks, divided by Q (folded in the DCT post-scale)
+        dct::algo::computeDCT8x8Batch(blocks, numBlocks, quantizationScale, false);
+
+        // 3. Round each block, then zigzag scan and RLE it while it is still in cache
+        alignas(64) int16_t coefficients[dct::algo::DCT_BLOCK_AREA];
+        uint8_t encoded[MAX_ENCODED_BLOCK_SIZE];
+        for (size_t b = 0; b < numBlocks; ++b) {
+            const double* block = blocks + b * dct::algo::DCT_BLOCK_AREA;
+            for (size_t k = 0; k < dct::algo::DCT_BLOCK_AREA; ++k) {
+                coefficients[k] = static_cast<int16_t>(std::lround(block[k]));
             }
+            const size_t size = encodeBlock(coefficients, encoded);
+            output.insert(output.end(), encoded, encoded + size);
         }
     }
 
-    const std::vector<std::vector<double>> Image::load_from_png(const char* image_path){
-        // Load the image using stb_image
+    void Image::encode_block_row_integer(
+        const int r,
+        const dct::algo::IntegerQuantizer& quantizer,
+        std::vector<uint8_t>& output
+    ) {
+        constexpr int submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        const size_t cols = this->pixels.getCols();
+
+        alignas(64) int32_t block[dct::algo::DCT_BLOCK_AREA];
+        alignas(64) int16_t coefficients[dct::algo::DCT_BLOCK_AREA];
+        uint8_t encoded[MAX_ENCODED_BLOCK_SIZE];
+        for (size_t c = 0; c < cols; c += submatrixSize) {
+            // 1. Copy the block (on the stack) and subtract 128 from each entry
+            for (int i=0; i<submatrixSize; ++i){
+                for (int j=0; j<submatrixSize; ++j){
+                    block[i * submatrixSize + j] = static_cast<int32_t>(this->pixels(r+i, c+j)) - 128;
+                }
+            }
+            // 2. Fixed-point dct and quantization
+            dct::algo::computeDCT8x8Integer(block, quantizer.getMethod());
+            quantizer.quantize(block, coefficients);
+            // 3. Zigzag scan and RLE
+            const size_t size = encodeBlock(coefficients, encoded);
+            output.insert(output.end(), encoded, encoded + size);
+        }
+    }
+
+    Plane<uint8_t> Image::load_from_png(const char* image_path){
+        // Load the image using stb_image (converted to 1 channel, greyscale)
         int width, height, channels;
         unsigned char* image_data = stbi_load(image_path, &width, &height, &channels, 1);
 
@@ -135,18 +437,7 @@ namespace sp::jpeg
 
         std::cout << "Image loaded: " << width << "x" << height << " with " << channels << " channels." << std::endl;
 
-        // Create the vector of vector of double that represent the image data
-        std::vector<std::vector<double>> image_matrix(height, std::vector<double>(width));
-
-        for (int r = 0; r < height; ++r){
-            for (int c = 0; c < width; ++c){
-                int index = (r*width + c) * 1; // *1 => 1 channel (Greyscale), *3 => channels (RGB)
-                image_matrix[r][c] = image_data[index]; // (- 128) --> point 2 of jpc compression
-            }
-        }
-
-        stbi_image_free(image_data); // Free the image data after loading it into the matrix
-
-        return image_matrix;
+        // The plane takes ownership of the stb buffer (freed with stbi_image_free), no copies
+        return Plane<uint8_t>(image_data, height, width, width, stbi_image_free);
     }
 }
@@ -1,9 +1,15 @@
 #ifndef IMAGE_HPP
 #define IMAGE_HPP
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
+#include "compression/jpeg_image_compression/dct_method.hpp"
+#include "compression/jpeg_image_compression/plane/plane.hpp"
+#include "compression/jpeg_image_compression/quantization/quantization.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_8x8_integer.hpp"
+
 namespace sp::jpeg
 {
     class CompressedImage;
@@ -11,19 +17,39 @@ namespace sp::jpeg
     class Image {
     public:
         /**
-         * Input matrix (original image) is a 2D vector of doubles.
+         * Pixels of the (grayscale) image, 8 bits per pixel, in a planar buffer with aligned rows.
          */
-        std::vector<std::vector<double>> img_matrix;
+        Plane<uint8_t> pixels;
 
         // default constructor
         Image() = default;
 
         /**
          * Constructor that initializes the Image object from a given matrix by copying it.
+         * The values are rounded and clamped to [0, 255].
          *
          * @param inputMatrix: 2D vector containing pixel values.
          */
-        explicit Image(std::vector<std::vector<double>> inputMatrix);
+        explicit Image(const std::vector<std::vector<double>>& inputMatrix);
+
+        /**
+         * Constructor that initializes the Image object from a plane of pixels (moved, no copy).
+         *
+         * @param pixels: the pixels of the image.
+         */
+        explicit Image(Plane<uint8_t> pixels);
+
+        /**
+         * Constructor that takes ownership of an image buffer returned by img::loadImage (or stbi_load).
+         * A grayscale buffer is adopted without copies; the channels of an RGB(A) buffer are converted
+         * to grayscale and the buffer is freed.
+         *
+         * @param data: the interleaved pixels (released with stbi_image_free).
+         * @param width: width of the image.
+         * @param height: height of the image.
+         * @param channels: number of channels of the image (1, 3 or 4).
+         */
+        Image(unsigned char* data, int width, int height, int channels);
 
         /**
          * Constructor that loads a PNG file into the variable image of Image object.
@@ -33,46 +59,196 @@ namespace sp::jpeg
         explicit Image(const char* image_path);
 
         /**
-         * Function that saves the image matrix of the current object as a PNG file using stb_image_write.
+         * Function that saves the pixels of the current object as a PNG file using stb_image_write
+         * (directly from the plane, without conversions).
          *
          * @path: path for the PNG file.
          */
         const void save_as_png(std::string path);
 
+        /**
+         * Function that copies the pixels into a matrix of doubles (one vector per row).
+         *
+         * @return: the matrix of the pixel values.
+         */
+        std::vector<std::vector<double>> to_matrix() const;
+
         /**
          * Function that implements the JPEG compression algorithm on the full image matrix.
          *
+         * @param method: arithmetic of the DCT and of the quantization (floating-point or fixed-point).
          * @return: compressed image.
          */
-        CompressedImage compress();
+        CompressedImage compress(DCTMethod method = DCTMethod::FLOAT);
+
+        /**
+         * Function that implements the JPEG compression algorithm on the full image matrix with the given
+         * quantization matrix (e.g. the one of the chroma of a color image), stored in the result.
+         *
+         * @param method: arithmetic of the DCT and of the quantization (floating-point or fixed-point).
+         * @param quantization: the 64 entries of the quantization matrix, row-major.
+         * @return: compressed image.
+         */
+        CompressedImage compress(DCTMethod method, const double* quantization);
+
+        /**
+         * Function that implements the JPEG compression algorithm on the full image matrix with the
+         * quantization matrix of a quality (IJG scaling, see getQuantizationTable), stored in the result.
+         *
+         * @param method: arithmetic of the DCT and of the quantization (floating-point or fixed-point).
+         * @param quality: the quality, from 1 (smallest files) to 100 (best images); 50 is the standard matrix.
+         * @return: compressed image.
+         */
+        CompressedImage compress(DCTMethod method, int quality);
+
+        /**
+         * Function that implements the JPEG compression algorithm and the entropy coding (zigzag + RLE)
+         * in a single pass, producing the content of a compressed binary file.
+         *
+         * Each 8x8 block goes from the pixels to the encoded bytes (level shift, DCT, quantization, zigzag
+         * and RLE) while it is in cache, without the intermediate matrix of compress.
+         * Every thread encodes a contiguous range of rows of blocks into its own buffer,
+         * then the buffers are concatenated in order. The result is the same of
+         * compress(method).save_as_compressed_binary(path, blockIndex, checkpointBlocks).
+         *
+         * @param method: arithmetic of the DCT and of the quantization (floating-point or fixed-point).
+         * @param blockIndex: true to append the index of the blocks (see BlockIndex).
+         * @param checkpointBlocks: number of blocks between two checkpoints of a row of the index (0 for one per row).
+         * @return: the bytes of the compressed binary file.
+         */
+        std::vector<uint8_t> compress_to_binary(
+            DCTMethod method = DCTMethod::FLOAT,
+            bool blockIndex = false,
+            size_t checkpointBlocks = 0
+        );
+
+        /**
+         * Function that compresses the image and saves it as a compressed binary file (with zigzag + RLE),
+         * using the single-pass encoder (see compress_to_binary).
+         *
+         * @param path: compressed binary file path.
+         * @param method: arithmetic of the DCT and of the quantization (floating-point or fixed-point).
+         * @param blockIndex: true to append the index of the blocks (see BlockIndex).
+         * @param checkpointBlocks: number of blocks between two checkpoints of a row of the index (0 for one per row).
+         */
+        void save_as_compressed_binary(
+            const std::string& path,
+            DCTMethod method = DCTMethod::FLOAT,
+            bool blockIndex = false,
+            size_t checkpointBlocks = 0
+        );
+
+        /**
+         * Function that compresses the image and saves it as a baseline JFIF (.jpg) file,
+         * readable by any JPEG decoder (see CompressedImage::to_jpeg).
+         *
+         * @param path: .jpg file path.
+         * @param method: arithmetic of the DCT and of the quantization (floating-point or fixed-point).
+         * @param optimizeHuffman: true for the optimized Huffman tables, false for the standard ones.
+         * @param restartRows: number of rows of blocks of each independently decodable stripe (0 for one segment).
+         * @param quality: the quality, from 1 to 100 (see getQuantizationTable).
+         */
+        void save_as_jpeg(
+            const std::string& path,
+            DCTMethod method = DCTMethod::FLOAT,
+            bool optimizeHuffman = false,
+            size_t restartRows = 1,
+            int quality = DEFAULT_QUALITY
+        );
+
+        /**
+         * Function that compresses the image as a baseline JFIF (.jpg) file of at most targetBytes bytes,
+         * with the highest quality that fits (see RateController): the DCT is computed once, then every
+         * quality of the binary search is only requantized and sized.
+         *
+         * @param targetBytes: the maximum number of bytes of the file.
+         * @param optimizeHuffman: true for the optimized Huffman tables, false for the standard ones.
+         * @param restartRows: number of rows of blocks of each independently decodable stripe (0 for one segment).
+         * @param quality: the chosen quality (output, if not null).
+         * @return: the bytes of the .jpg file (of quality 1 if the target cannot be reached).
+         */
+        std::vector<uint8_t> to_jpeg_with_size(
+            size_t targetBytes,
+            bool optimizeHuffman = false,
+            size_t restartRows = 1,
+            int* quality = nullptr
+        );
 
     private:
         /**
-         * Function that compresses a single 8x8 block using JPEG (DCT + quantization).
+         * Function that compresses a row of 8x8 blocks using JPEG (DCT + quantization).
+         *
+         * The blocks are copied in a contiguous buffer and transformed by the batched 8x8 DCT
+         * (fast AAN kernel, with the quantization folded into its post-scale).
+         * The output is directly saved into the corresponding position of compressed.
+         *
+         * @param r: position in image of the first row of the current row of blocks.
+         * @param compressed: plane of the quantized coefficients.
+         * @param quantizationScale: the 64 post-scale factors of the DCT (see dct::algo::makeDCT8x8QuantizationScale).
+         * @param blocks: buffer of 8 * cols values for the blocks (owned by the calling thread).
+         */
+        void jpeg_compression(
+            int r,
+            Plane<int16_t>& compressed,
+            const double* quantizationScale,
+            double* blocks
+        );
+
+        /**
+         * Function that compresses a single 8x8 block using the fixed-point JPEG pipeline
+         * (integer DCT + reciprocal-multiply quantization).
          *
          * The output is directly saved into the corresponding position of compressed.
          *
          * @param r: position in image of the first row of the current submatrix.
          * @param c: position in image of the first column of the current submatrix.
-         * @param submatrixSize: block size (is a squared block).
-         * @param compressed: compressed image matrix.
-         * @param Q: quantization matrix.
+         * @param compressed: plane of the quantized coefficients.
+         * @param quantizer: integer quantization tables of the chosen fixed-point DCT.
          */
-        void jpeg_compression(
+        void jpeg_compression_integer(
             int r,
             int c,
-            int submatrixSize,
-            std::vector<std::vector<double>>& compressed,
-            std::vector<std::vector<double>>& Q
+            Plane<int16_t>& compressed,
+            const dct::algo::IntegerQuantizer& quantizer
+        );
+
+        /**
+         * Function that compresses and encodes a row of 8x8 blocks (level shift, batched DCT with the
+         * quantization folded into its post-scale, rounding, zigzag and RLE).
+         *
+         * @param r: position in image of the first row of the current row of blocks.
+         * @param quantizationScale: the 64 post-scale factors of the DCT (see dct::algo::makeDCT8x8QuantizationScale).
+         * @param blocks: buffer of 8 * cols values for the blocks (owned by the calling thread).
+         * @param output: buffer where the encoded blocks are appended (owned by the calling thread).
+         */
+        void encode_block_row(
+            int r,
+            const double* quantizationScale,
+            double* blocks,
+            std::vector<uint8_t>& output
+        );
+
+        /**
+         * Function that compresses and encodes a row of 8x8 blocks using the fixed-point JPEG pipeline
+         * (integer DCT, reciprocal-multiply quantization, zigzag and RLE).
+         *
+         * @param r: position in image of the first row of the current row of blocks.
+         * @param quantizer: integer quantization tables of the chosen fixed-point DCT.
+         * @param output: buffer where the encoded blocks are appended (owned by the calling thread).
+         */
+        void encode_block_row_integer(
+            int r,
+            const dct::algo::IntegerQuantizer& quantizer,
+            std::vector<uint8_t>& output
         );
 
         /**
-         * Function that loads an image from a PNG file into a matrix using stb_image.
+         * Function that loads an image from a PNG file into a plane using stb_image (zero-copy).
          *
          * @param image_path: path to the PNG file.
-         * @return 2D vector containing pixel values.
+         * @return the plane that owns the pixels decoded by stb_image.
          */
-        const std::vector<std::vector<double>> load_from_png(const char* image_path);
+        Plane<uint8_t> load_from_png(const char* image_path);
     };
 }
 
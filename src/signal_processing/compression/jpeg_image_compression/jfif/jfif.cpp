@@ -0,0 +1,894 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <omp.h>
+#include <stdexcept>
+#include <string>
+
+#include "compression/jpeg_image_compression/jfif/jfif.hpp"
+#include "compression/jpeg_image_compression/block_coder/block_coder.hpp"
+#include "compression/jpeg_image_compression/huffman/huffman.hpp"
+#include "compression/jpeg_image_compression/scaled_decoding/scaled_decoding.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * JPEG markers (ITU T.81, Table B.1).
+     */
+    constexpr uint8_t SOI = 0xD8;
+    constexpr uint8_t EOI = 0xD9;
+    constexpr uint8_t SOF0 = 0xC0;
+    constexpr uint8_t SOF1 = 0xC1;
+    constexpr uint8_t DHT = 0xC4;
+    constexpr uint8_t DAC = 0xCC;
+    constexpr uint8_t RST0 = 0xD0;
+    constexpr uint8_t RST7 = 0xD7;
+    constexpr uint8_t SOS = 0xDA;
+    constexpr uint8_t DQT = 0xDB;
+    constexpr uint8_t DRI = 0xDD;
+    constexpr uint8_t APP0 = 0xE0;
+
+    /**
+     * Maximum number of components of a frame handled here (Y, Cb, Cr and an optional fourth one).
+     */
+    constexpr size_t MAX_COMPONENTS = 4;
+
+    /**
+     * Geometry of the MCUs (minimum coded units) of a scan and of its restart segments.
+     */
+    struct MCULayout {
+        /**
+         * Number of MCUs in a row of MCUs.
+         */
+        size_t mcusPerRow;
+        /**
+         * Number of MCUs of the scan.
+         */
+        size_t numMCUs;
+        /**
+         * Number of blocks of each component in a MCU, horizontally and vertically.
+         */
+        int blocksH[MAX_COMPONENTS];
+        int blocksV[MAX_COMPONENTS];
+        /**
+         * Number of components.
+         */
+        size_t numComponents;
+        /**
+         * Number of MCUs of each restart segment, and number of segments.
+         */
+        size_t interval;
+        size_t numSegments;
+    };
+
+    static MCULayout makeLayout(const JFIFImage& image) {
+        constexpr size_t submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        MCULayout layout;
+        layout.numComponents = image.components.size();
+        if (layout.numComponents == 1) {
+            // non-interleaved scan: one block per MCU, in raster order
+            size_t rows, cols;
+            getComponentSize(image, 0, rows, cols);
+            layout.mcusPerRow = cols / submatrixSize;
+            layout.numMCUs = layout.mcusPerRow * (rows / submatrixSize);
+            layout.blocksH[0] = 1;
+            layout.blocksV[0] = 1;
+        } else {
+            int maxH = 1, maxV = 1;
+            for (size_t i = 0; i < layout.numComponents; ++i) {
+                maxH = std::max(maxH, image.components[i].horizontalSampling);
+                maxV = std::max(maxV, image.components[i].verticalSampling);
+                layout.blocksH[i] = image.components[i].horizontalSampling;
+                layout.blocksV[i] = image.components[i].verticalSampling;
+            }
+            layout.mcusPerRow = (image.width + submatrixSize * maxH - 1) / (submatrixSize * maxH);
+            layout.numMCUs = layout.mcusPerRow * ((image.height + submatrixSize * maxV - 1) / (submatrixSize * maxV));
+        }
+        layout.interval = image.restartInterval > 0 ? image.restartInterval : layout.numMCUs;
+        layout.numSegments = (layout.numMCUs + layout.interval - 1) / layout.interval;
+        return layout;
+    }
+
+    /**
+     * Call function(component, row, column) for every block of a MCU, in the order of the bitstream
+     * (component by component, H x V blocks of each one in raster order).
+     */
+    template <typename Function>
+    static void forEachBlock(const MCULayout& layout, const size_t mcu, Function function) {
+        constexpr size_t submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        const size_t mcuRow = mcu / layout.mcusPerRow;
+        const size_t mcuCol = mcu % layout.mcusPerRow;
+        for (size_t i = 0; i < layout.numComponents; ++i) {
+            for (int v = 0; v < layout.blocksV[i]; ++v) {
+                for (int h = 0; h < layout.blocksH[i]; ++h) {
+                    function(
+                        i,
+                        (mcuRow * layout.blocksV[i] + v) * submatrixSize,
+                        (mcuCol * layout.blocksH[i] + h) * submatrixSize
+                    );
+                }
+            }
+        }
+    }
+
+    /**
+     * Copy the block at (r, c) of a plane of coefficients into a contiguous block.
+     */
+    static void loadBlock(const Plane<int16_t>& coefficients, const size_t r, const size_t c, int16_t* block) {
+        constexpr size_t submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        for (size_t i = 0; i < submatrixSize; ++i) {
+            std::memcpy(block + i * submatrixSize, coefficients.row(r + i) + c, submatrixSize * sizeof(int16_t));
+        }
+    }
+
+    /**
+     * Copy a contiguous block into the block at (r, c) of a plane of coefficients.
+     */
+    static void storeBlock(const int16_t* block, const size_t r, const size_t c, Plane<int16_t>& coefficients) {
+        constexpr size_t submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        for (size_t i = 0; i < submatrixSize; ++i) {
+            std::memcpy(coefficients.row(r + i) + c, block + i * submatrixSize, submatrixSize * sizeof(int16_t));
+        }
+    }
+
+    void getComponentSize(const JFIFImage& image, const size_t component, size_t& rows, size_t& cols) {
+        constexpr size_t submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        if (component >= image.components.size()) {
+            throw std::invalid_argument(
+                "Invalid component. Given: " + std::to_string(component) + " of " +
+                std::to_string(image.components.size())
+            );
+        }
+        int maxH = 1, maxV = 1;
+        for (const JFIFComponent& c : image.components) {
+            if (c.horizontalSampling < 1 || c.horizontalSampling > 4 || c.verticalSampling < 1 || c.verticalSampling > 4) {
+                throw std::invalid_argument(
+                    "The sampling factors must be in [1, 4]. Given: " + std::to_string(c.horizontalSampling) +
+                    "x" + std::to_string(c.verticalSampling)
+                );
+            }
+            maxH = std::max(maxH, c.horizontalSampling);
+            maxV = std::max(maxV, c.verticalSampling);
+        }
+        if (image.components.size() == 1) {
+            rows = (image.height + submatrixSize - 1) / submatrixSize * submatrixSize;
+            cols = (image.width + submatrixSize - 1) / submatrixSize * submatrixSize;
+        } else {
+            const JFIFComponent& c = image.components[component];
+            rows = (image.height + submatrixSize * maxV - 1) / (submatrixSize * maxV) * c.verticalSampling * submatrixSize;
+            cols = (image.width + submatrixSize * maxH - 1) / (submatrixSize * maxH) * c.horizontalSampling * submatrixSize;
+        }
+    }
+
+    // #################### WRITER ####################
+
+    static void writeUint16(std::vector<uint8_t>& output, const size_t value) {
+        output.push_back(static_cast<uint8_t>(value >> 8));
+        output.push_back(static_cast<uint8_t>(value & 0xFF));
+    }
+
+    static void writeMarker(std::vector<uint8_t>& output, const uint8_t marker) {
+        output.push_back(0xFF);
+        output.push_back(marker);
+    }
+
+    /**
+     * Write a DQT segment with one table (8-bit precision if possible).
+     *
+     * @param quantization: the 64 entries of the matrix, row-major.
+     * @param id: the table destination (0-3).
+     * @return: true if the table needs 16-bit precision (an entry above 255), which baseline frames do not allow.
+     */
+    static bool writeQuantizationTable(std::vector<uint8_t>& output, const double* quantization, const int id) {
+        uint16_t table[dct::algo::DCT_BLOCK_AREA];
+        bool wide = false;
+        for (size_t k = 0; k < dct::algo::DCT_BLOCK_AREA; ++k) {
+            const double value = std::round(quantization[ZIGZAG_ORDER[k]]);
+            if (value < 1.0 || value > 65535.0) {
+                throw std::invalid_argument(
+                    "The quantization matrix entries must be in [1, 65535]. Given: " + std::to_string(value)
+                );
+            }
+            table[k] = static_cast<uint16_t>(value);
+            wide = wide || table[k] > 255;
+        }
+        writeMarker(output, DQT);
+        writeUint16(output, 2 + 1 + dct::algo::DCT_BLOCK_AREA * (wide ? 2 : 1));
+        output.push_back(static_cast<uint8_t>((wide ? 0x10 : 0x00) | id));
+        for (size_t k = 0; k < dct::algo::DCT_BLOCK_AREA; ++k) {
+            if (wide) {
+                writeUint16(output, table[k]);
+            } else {
+                output.push_back(static_cast<uint8_t>(table[k]));
+            }
+        }
+        return wide;
+    }
+
+    /**
+     * Write a DHT segment with one table.
+     *
+     * @param tableClass: 0 for DC, 1 for AC.
+     * @param id: the table destination (0-3).
+     */
+    static void writeHuffmanTable(
+        std::vector<uint8_t>& output, const HuffmanTable& table, const int tableClass, const int id
+    ) {
+        writeMarker(output, DHT);
+        writeUint16(output, 2 + 1 + 16 + table.values.size());
+        output.push_back(static_cast<uint8_t>((tableClass << 4) | id));
+        output.insert(output.end(), table.bits + 1, table.bits + 17);
+        output.insert(output.end(), table.values.begin(), table.values.end());
+    }
+
+    /**
+     * Check the components, the sizes and the restart interval of an image to write
+     * (and the sizes of its planes of coefficients, with checkCoefficients).
+     */
+    static void checkImage(const JFIFImage& image, const bool checkCoefficients) {
+        const size_t numComponents = image.components.size();
+        if (numComponents == 0 || numComponents > MAX_COMPONENTS) {
+            throw std::invalid_argument(
+                "A JPEG image must have 1 to 4 components. Given: " + std::to_string(numComponents)
+            );
+        }
+        if (image.width == 0 || image.height == 0 || image.width > 65535 || image.height > 65535) {
+            throw std::invalid_argument(
+                "Invalid JPEG sizes. Given: " + std::to_string(image.width) + "x" + std::to_string(image.height)
+            );
+        }
+        if (image.restartInterval > 65535) {
+            throw std::invalid_argument(
+                "The restart interval must be at most 65535 MCUs. Given: " + std::to_string(image.restartInterval)
+            );
+        }
+        int blocksPerMCU = 0;
+        for (size_t i = 0; i < numComponents; ++i) {
+            const JFIFComponent& component = image.components[i];
+            size_t rows, cols;
+            getComponentSize(image, i, rows, cols);
+            if (checkCoefficients &&
+                (component.coefficients.getRows() != rows || component.coefficients.getCols() != cols)) {
+                throw std::invalid_argument(
+                    "Invalid sizes of the component " + std::to_string(i) + ". Given: " +
+                    std::to_string(component.coefficients.getCols()) + "x" +
+                    std::to_string(component.coefficients.getRows()) + " coefficients, expected " +
+                    std::to_string(cols) + "x" + std::to_string(rows)
+                );
+            }
+            blocksPerMCU += component.horizontalSampling * component.verticalSampling;
+        }
+        if (numComponents > 1 && blocksPerMCU > 10) {
+            throw std::invalid_argument(
+                "A MCU can have at most 10 blocks. Given: " + std::to_string(blocksPerMCU)
+            );
+        }
+    }
+
+    /**
+     * Tables of the components: the luma (first component) uses the Huffman tables 0, the chroma the
+     * tables 1; the quantization tables are shared by the components with the same matrix.
+     */
+    struct TableIds {
+        int huffman[MAX_COMPONENTS];
+        int quantization[MAX_COMPONENTS];
+        int numHuffmanTables;
+        int numQuantizationTables;
+    };
+
+    static TableIds assignTables(const JFIFImage& image) {
+        const size_t numComponents = image.components.size();
+        TableIds ids;
+        ids.numQuantizationTables = 0;
+        for (size_t i = 0; i < numComponents; ++i) {
+            ids.huffman[i] = i == 0 ? 0 : 1;
+            ids.quantization[i] = -1;
+            for (size_t j = 0; j < i && ids.quantization[i] < 0; ++j) {
+                if (std::equal(
+                    image.components[i].quantization, image.components[i].quantization + dct::algo::DCT_BLOCK_AREA,
+                    image.components[j].quantization
+                )) {
+                    ids.quantization[i] = ids.quantization[j];
+                }
+            }
+            if (ids.quantization[i] < 0) {
+                ids.quantization[i] = ids.numQuantizationTables++;
+            }
+        }
+        ids.numHuffmanTables = numComponents > 1 ? 2 : 1;
+        return ids;
+    }
+
+    /**
+     * Frequencies of the Huffman symbols of the tables DC 0, AC 0, DC 1 and AC 1.
+     */
+    constexpr size_t FREQUENCIES = 4 * 256;
+
+    /**
+     * Count the Huffman symbols of all the blocks (the first pass of the optimized tables), the segments
+     * distributed among maxThreads threads with per-thread frequencies, summed at the end.
+     *
+     * @param frequencies: the FREQUENCIES counters (output).
+     */
+    static void countSymbols(
+        const JFIFImage& image, const MCULayout& layout, const TableIds& ids, const int maxThreads, uint32_t* frequencies
+    ) {
+        std::vector<uint32_t> threadFrequencies(static_cast<size_t>(maxThreads) * FREQUENCIES, 0);
+
+        #pragma omp parallel num_threads(maxThreads) if(maxThreads > 1)
+        {
+            uint32_t* counters = threadFrequencies.data() + omp_get_thread_num() * FREQUENCIES;
+            alignas(64) int16_t block[dct::algo::DCT_BLOCK_AREA];
+
+            #pragma omp for schedule(static)
+            for (size_t s = 0; s < layout.numSegments; ++s) {
+                int previousDC[MAX_COMPONENTS] = {0, 0, 0, 0};
+                const size_t last = std::min(layout.numMCUs, (s + 1) * layout.interval);
+                for (size_t mcu = s * layout.interval; mcu < last; ++mcu) {
+                    forEachBlock(layout, mcu, [&](const size_t i, const size_t r, const size_t c) {
+                        uint32_t* dcFrequencies = counters + ids.huffman[i] * 512;
+                        loadBlock(image.components[i].coefficients, r, c, block);
+                        countBlockSymbols(block, previousDC[i], dcFrequencies, dcFrequencies + 256);
+                    });
+                }
+            }
+        }
+        std::copy(threadFrequencies.begin(), threadFrequencies.begin() + FREQUENCIES, frequencies);
+        for (int t = 1; t < maxThreads; ++t) {
+            for (size_t k = 0; k < FREQUENCIES; ++k) {
+                frequencies[k] += threadFrequencies[t * FREQUENCIES + k];
+            }
+        }
+    }
+
+    /**
+     * Huffman tables: optimal ones from the frequencies of the symbols, or the standard ones.
+     */
+    static void makeHuffmanTables(
+        const bool optimizeHuffman,
+        const uint32_t* frequencies,
+        const TableIds& ids,
+        HuffmanTable* dcTables,
+        HuffmanTable* acTables
+    ) {
+        if (optimizeHuffman) {
+            for (int id = 0; id < ids.numHuffmanTables; ++id) {
+                dcTables[id] = buildOptimalHuffmanTable(frequencies + id * 512);
+                acTables[id] = buildOptimalHuffmanTable(frequencies + id * 512 + 256);
+            }
+        } else {
+            dcTables[0] = standardLuminanceDCTable();
+            acTables[0] = standardLuminanceACTable();
+            dcTables[1] = standardChrominanceDCTable();
+            acTables[1] = standardChrominanceACTable();
+        }
+    }
+
+    /**
+     * Write the headers of the file, from SOI to the SOS segment.
+     */
+    static void writeHeaders(
+        std::vector<uint8_t>& output,
+        const JFIFImage& image,
+        const TableIds& ids,
+        const HuffmanTable* dcTables,
+        const HuffmanTable* acTables
+    ) {
+        const size_t numComponents = image.components.size();
+
+        // SOI and APP0 (JFIF 1.01, no density, no thumbnail)
+        writeMarker(output, SOI);
+        writeMarker(output, APP0);
+        writeUint16(output, 16);
+        const uint8_t jfif[] = {'J', 'F', 'I', 'F', 0, 1, 1, 0, 0, 1, 0, 1, 0, 0};
+        output.insert(output.end(), jfif, jfif + sizeof(jfif));
+
+        // DQT, in zigzag order
+        bool wide = false;
+        for (int id = 0; id < ids.numQuantizationTables; ++id) {
+            const size_t first = std::find(ids.quantization, ids.quantization + numComponents, id) - ids.quantization;
+            wide = writeQuantizationTable(output, image.components[first].quantization, id) || wide;
+        }
+
+        // SOF0 (SOF1 if a table has 16-bit entries): 8-bit precision, components with ids 1, 2, ...
+        writeMarker(output, wide ? SOF1 : SOF0);
+        writeUint16(output, 2 + 6 + 3 * numComponents);
+        output.push_back(8);
+        writeUint16(output, image.height);
+        writeUint16(output, image.width);
+        output.push_back(static_cast<uint8_t>(numComponents));
+        for (size_t i = 0; i < numComponents; ++i) {
+            output.push_back(static_cast<uint8_t>(i + 1));
+            output.push_back(static_cast<uint8_t>(
+                (image.components[i].horizontalSampling << 4) | image.components[i].verticalSampling
+            ));
+            output.push_back(static_cast<uint8_t>(ids.quantization[i]));
+        }
+
+        // DHT: DC and AC tables
+        for (int id = 0; id < ids.numHuffmanTables; ++id) {
+            writeHuffmanTable(output, dcTables[id], 0, id);
+            writeHuffmanTable(output, acTables[id], 1, id);
+        }
+
+        // DRI: number of MCUs between two restart markers
+        if (image.restartInterval > 0) {
+            writeMarker(output, DRI);
+            writeUint16(output, 4);
+            writeUint16(output, image.restartInterval);
+        }
+
+        // SOS: all the components, full spectral range
+        writeMarker(output, SOS);
+        writeUint16(output, 2 + 1 + 2 * numComponents + 3);
+        output.push_back(static_cast<uint8_t>(numComponents));
+        for (size_t i = 0; i < numComponents; ++i) {
+            output.push_back(static_cast<uint8_t>(i + 1));
+            output.push_back(static_cast<uint8_t>((ids.huffman[i] << 4) | ids.huffman[i]));
+        }
+        output.push_back(0);
+        output.push_back(63);
+        output.push_back(0);
+    }
+
+    /**
+     * Code the MCUs [first, last) as an entropy-coded segment (DC predictions from 0, byte-aligned, without marker).
+     *
+     * @param dc: the DC encoders, indexed by the Huffman table ids.
+     * @param ac: the AC encoders, indexed by the Huffman table ids.
+     */
+    static void encodeSegment(
+        const JFIFImage& image,
+        const MCULayout& layout,
+        const TableIds& ids,
+        const HuffmanEncoder* dc,
+        const HuffmanEncoder* ac,
+        const size_t first,
+        const size_t last,
+        std::vector<uint8_t>& output
+    ) {
+        BitWriter writer(output);
+        alignas(64) int16_t block[dct::algo::DCT_BLOCK_AREA];
+        int previousDC[MAX_COMPONENTS] = {0, 0, 0, 0};
+        for (size_t mcu = first; mcu < last; ++mcu) {
+            forEachBlock(layout, mcu, [&](const size_t i, const size_t r, const size_t c) {
+                loadBlock(image.components[i].coefficients, r, c, block);
+                encodeBlockHuffman(block, previousDC[i], dc[ids.huffman[i]], ac[ids.huffman[i]], writer);
+            });
+        }
+        writer.flush();
+    }
+
+    std::vector<uint8_t> writeJFIF(const JFIFImage& image, const bool optimizeHuffman) {
+        checkImage(image, true);
+        const TableIds ids = assignTables(image);
+        const MCULayout layout = makeLayout(image);
+        const int maxThreads = omp_in_parallel() || layout.numSegments < 2 ? 1 : omp_get_max_threads();
+
+        // Huffman tables: standard ones, or optimal ones from the frequencies of the symbols
+        HuffmanTable dcTables[2], acTables[2];
+        std::vector<uint32_t> frequencies(FREQUENCIES, 0);
+        if (optimizeHuffman) {
+            countSymbols(image, layout, ids, maxThreads, frequencies.data());
+        }
+        makeHuffmanTables(optimizeHuffman, frequencies.data(), ids, dcTables, acTables);
+
+        size_t numCoefficients = 0;
+        for (const JFIFComponent& component : image.components) {
+            numCoefficients += component.coefficients.getRows() * component.coefficients.getCols();
+        }
+        std::vector<uint8_t> output;
+        output.reserve(1024 + numCoefficients / 4);
+        writeHeaders(output, image, ids, dcTables, acTables);
+
+        // entropy-coded segments: each thread codes a contiguous range of segments into its own buffer
+        // (the first thread directly after the headers); every segment starts with the DC predictions 0
+        // and ends byte-aligned, followed by its RSTn marker (but the last one)
+        std::vector<HuffmanEncoder> dc, ac;
+        for (int id = 0; id < ids.numHuffmanTables; ++id) {
+            dc.emplace_back(dcTables[id]);
+            ac.emplace_back(acTables[id]);
+        }
+        std::vector<std::vector<uint8_t>> chunks(maxThreads);
+        std::exception_ptr error;
+
+        #pragma omp parallel num_threads(maxThreads) if(maxThreads > 1)
+        {
+            const size_t thread = omp_get_thread_num();
+            const size_t numThreads = omp_get_num_threads();
+            const size_t begin = layout.numSegments * thread / numThreads;
+            const size_t end = layout.numSegments * (thread + 1) / numThreads;
+
+            std::vector<uint8_t>& chunk = thread == 0 ? output : chunks[thread];
+            try {
+                for (size_t s = begin; s < end; ++s) {
+                    const size_t last = std::min(layout.numMCUs, (s + 1) * layout.interval);
+                    encodeSegment(image, layout, ids, dc.data(), ac.data(), s * layout.interval, last, chunk);
+                    if (s + 1 < layout.numSegments) {
+                        writeMarker(chunk, static_cast<uint8_t>(RST0 + s % 8));
+                    }
+                }
+            } catch (...) {
+                #pragma omp critical
+                error = std::current_exception();
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+
+        for (int t = 1; t < maxThreads; ++t) {
+            output.insert(output.end(), chunks[t].begin(), chunks[t].end());
+        }
+        writeMarker(output, EOI);
+        return output;
+    }
+
+    std::vector<uint8_t> writeJFIFHeaders(const JFIFImage& image) {
+        checkImage(image, false);
+        const TableIds ids = assignTables(image);
+        HuffmanTable dcTables[2], acTables[2];
+        makeHuffmanTables(false, nullptr, ids, dcTables, acTables);
+        std::vector<uint8_t> output;
+        writeHeaders(output, image, ids, dcTables, acTables);
+        return output;
+    }
+
+    void writeJFIFSegment(const JFIFImage& stripe, std::vector<uint8_t>& output) {
+        checkImage(stripe, true);
+        const TableIds ids = assignTables(stripe);
+        const MCULayout layout = makeLayout(stripe);
+        const HuffmanEncoder dc[2] = {HuffmanEncoder(standardLuminanceDCTable()), HuffmanEncoder(standardChrominanceDCTable())};
+        const HuffmanEncoder ac[2] = {HuffmanEncoder(standardLuminanceACTable()), HuffmanEncoder(standardChrominanceACTable())};
+        encodeSegment(stripe, layout, ids, dc, ac, 0, layout.numMCUs, output);
+    }
+
+    size_t estimateJFIFSize(const JFIFImage& image, const bool optimizeHuffman) {
+        checkImage(image, true);
+        const TableIds ids = assignTables(image);
+        const MCULayout layout = makeLayout(image);
+        const int maxThreads = omp_in_parallel() || layout.numSegments < 2 ? 1 : omp_get_max_threads();
+
+        // the symbols are counted as for the optimized tables, then sized with the chosen tables
+        HuffmanTable dcTables[2], acTables[2];
+        std::vector<uint32_t> frequencies(FREQUENCIES, 0);
+        countSymbols(image, layout, ids, maxThreads, frequencies.data());
+        makeHuffmanTables(optimizeHuffman, frequencies.data(), ids, dcTables, acTables);
+
+        std::vector<uint8_t> headers;
+        writeHeaders(headers, image, ids, dcTables, acTables);
+        uint64_t bits = 0;
+        for (int id = 0; id < ids.numHuffmanTables; ++id) {
+            bits += countHuffmanBits(frequencies.data() + id * 512, dcTables[id]);
+            bits += countHuffmanBits(frequencies.data() + id * 512 + 256, acTables[id]);
+        }
+
+        // every segment is padded to a byte (4 bits on average) and followed by its RSTn marker (but the last one)
+        const size_t scan = static_cast<size_t>((bits + 4 * layout.numSegments + 7) / 8);
+        return headers.size() + scan + 2 * (layout.numSegments - 1) + 2;
+    }
+
+    // #################### READER ####################
+
+    /**
+     * Cursor over the bytes of the file, with bounds checks.
+     */
+    class SegmentReader {
+    public:
+        SegmentReader(const uint8_t* data, const size_t size) : data(data), size(size), position(0) {}
+
+        uint8_t readByte() {
+            this->require(1);
+            return this->data[this->position++];
+        }
+
+        size_t readUint16() {
+            this->require(2);
+            const size_t value = (static_cast<size_t>(this->data[this->position]) << 8) | this->data[this->position + 1];
+            this->position += 2;
+            return value;
+        }
+
+        void skip(const size_t count) {
+            this->require(count);
+            this->position += count;
+        }
+
+        void require(const size_t count) const {
+            if (this->position + count > this->size) {
+                throw std::runtime_error("Error: the JPEG file is truncated");
+            }
+        }
+
+        const uint8_t* data;
+        size_t size;
+        size_t position;
+    };
+
+    std::vector<size_t> findRestartSegments(const uint8_t* scan, const size_t size, const size_t numSegments) {
+        std::vector<size_t> offsets;
+        offsets.reserve(numSegments + 1);
+        offsets.push_back(0);
+
+        // the entropy-coded data never contains 0xFF followed by anything but 0x00 (stuffing),
+        // so the segment boundaries are found by a scan of the bytes, without decoding
+        size_t position = 0;
+        while (offsets.size() < numSegments) {
+            const void* found = std::memchr(scan + position, 0xFF, size - position);
+            if (found == nullptr) {
+                break;
+            }
+            position = static_cast<const uint8_t*>(found) - scan + 1;
+            while (position < size && scan[position] == 0xFF) {
+                ++position;
+            }
+            if (position >= size) {
+                break;
+            }
+            const uint8_t marker = scan[position++];
+            if (marker >= RST0 && marker <= RST7) {
+                if (marker != RST0 + (offsets.size() - 1) % 8) {
+                    throw std::runtime_error("Error: corrupted JPEG file (restart markers out of order)");
+                }
+                offsets.push_back(position);
+            } else if (marker != 0x00) {
+                break;
+            }
+        }
+        if (offsets.size() != numSegments) {
+            throw std::runtime_error(
+                "Error: corrupted JPEG file (" + std::to_string(offsets.size()) + " restart segments, expected " +
+                std::to_string(numSegments) + ")"
+            );
+        }
+        offsets.push_back(size);
+        return offsets;
+    }
+
+    size_t readJFIFHeaders(const uint8_t* data, const size_t size, JFIFHeaders& headers) {
+        SegmentReader reader(data, size);
+        if (reader.readByte() != 0xFF || reader.readByte() != SOI) {
+            throw std::runtime_error("Error: not a JPEG file (missing SOI marker)");
+        }
+
+        JFIFImage& image = headers.image;
+        image.components.clear();
+        image.width = 0;
+        image.height = 0;
+        image.restartInterval = 0;
+        uint16_t quantizationTables[4][dct::algo::DCT_BLOCK_AREA];
+        bool hasQuantizationTable[4] = {false, false, false, false};
+        HuffmanTable huffmanTables[2][4];
+        bool hasHuffmanTable[2][4] = {{false, false, false, false}, {false, false, false, false}};
+        int componentIds[MAX_COMPONENTS];
+        int quantizationIds[MAX_COMPONENTS];
+        int dcIds[MAX_COMPONENTS];
+        int acIds[MAX_COMPONENTS];
+
+        while (true) {
+            // next marker (skipping the fill bytes)
+            if (reader.readByte() != 0xFF) {
+                throw std::runtime_error("Error: corrupted JPEG file (marker expected)");
+            }
+            uint8_t marker = reader.readByte();
+            while (marker == 0xFF) {
+                marker = reader.readByte();
+            }
+            if (marker == EOI) {
+                throw std::runtime_error("Error: the JPEG file has no scan");
+            }
+
+            const size_t length = reader.readUint16();
+            if (length < 2) {
+                throw std::runtime_error("Error: corrupted JPEG file (invalid segment length)");
+            }
+            reader.require(length - 2);
+            const size_t end = reader.position + length - 2;
+
+            if (marker == SOF0 || marker == SOF1) {
+                if (reader.readByte() != 8) {
+                    throw std::runtime_error("Error: only 8-bit JPEG files are supported");
+                }
+                image.height = reader.readUint16();
+                image.width = reader.readUint16();
+                const uint8_t numComponents = reader.readByte();
+                if (numComponents == 0 || numComponents > MAX_COMPONENTS) {
+                    throw std::runtime_error(
+                        "Error: JPEG files with " + std::to_string(numComponents) + " components are not supported"
+                    );
+                }
+                if (image.height == 0 || image.width == 0) {
+                    throw std::runtime_error("Error: JPEG files without sizes (DNL) are not supported");
+                }
+                image.components.resize(numComponents);
+                for (size_t i = 0; i < numComponents; ++i) {
+                    componentIds[i] = reader.readByte();
+                    const uint8_t sampling = reader.readByte();
+                    image.components[i].horizontalSampling = sampling >> 4;
+                    image.components[i].verticalSampling = sampling & 0x0F;
+                    quantizationIds[i] = reader.readByte() & 0x03;
+                    if (sampling >> 4 < 1 || sampling >> 4 > 4 || (sampling & 0x0F) < 1 || (sampling & 0x0F) > 4) {
+                        throw std::runtime_error("Error: corrupted JPEG file (invalid sampling factors)");
+                    }
+                }
+            } else if ((marker >= 0xC2 && marker <= 0xCF) && marker != DHT && marker != DAC && marker != 0xC8) {
+                throw std::runtime_error("Error: only baseline JPEG files are supported (progressive or arithmetic coding)");
+            } else if (marker == DQT) {
+                while (reader.position < end) {
+                    const uint8_t info = reader.readByte();
+                    const bool wide = (info >> 4) != 0;
+                    const int id = info & 0x03;
+                    for (size_t k = 0; k < dct::algo::DCT_BLOCK_AREA; ++k) {
+                        quantizationTables[id][k] = static_cast<uint16_t>(wide ? reader.readUint16() : reader.readByte());
+                    }
+                    hasQuantizationTable[id] = true;
+                }
+            } else if (marker == DHT) {
+                while (reader.position < end) {
+                    const uint8_t info = reader.readByte();
+                    const int tableClass = (info >> 4) & 0x01;
+                    const int id = info & 0x03;
+                    HuffmanTable& table = huffmanTables[tableClass][id];
+                    table.bits[0] = 0;
+                    size_t total = 0;
+                    for (int l = 1; l <= 16; ++l) {
+                        table.bits[l] = reader.readByte();
+                        total += table.bits[l];
+                    }
+                    reader.require(total);
+                    table.values.assign(data + reader.position, data + reader.position + total);
+                    reader.skip(total);
+                    hasHuffmanTable[tableClass][id] = true;
+                }
+            } else if (marker == DRI) {
+                image.restartInterval = reader.readUint16();
+            } else if (marker == SOS) {
+                if (image.components.empty()) {
+                    throw std::runtime_error("Error: corrupted JPEG file (scan before the frame header)");
+                }
+                if (reader.readByte() != image.components.size()) {
+                    throw std::runtime_error("Error: only JPEG files with all the components in one scan are supported");
+                }
+                for (size_t i = 0; i < image.components.size(); ++i) {
+                    if (reader.readByte() != componentIds[i]) {
+                        throw std::runtime_error("Error: corrupted JPEG file (unknown scan component)");
+                    }
+                    const uint8_t tables = reader.readByte();
+                    dcIds[i] = (tables >> 4) & 0x03;
+                    acIds[i] = tables & 0x03;
+                    if (!hasQuantizationTable[quantizationIds[i]] || !hasHuffmanTable[0][dcIds[i]] ||
+                        !hasHuffmanTable[1][acIds[i]]) {
+                        throw std::runtime_error("Error: corrupted JPEG file (missing quantization or Huffman table)");
+                    }
+                }
+                const uint8_t spectralStart = reader.readByte();
+                const uint8_t spectralEnd = reader.readByte();
+                const uint8_t approximation = reader.readByte();
+                if (spectralStart != 0 || spectralEnd != 63 || approximation != 0) {
+                    throw std::runtime_error("Error: only baseline JPEG files are supported (spectral selection)");
+                }
+                reader.position = end;
+                break;
+            }
+            // APPn, COM and the other segments are skipped
+            reader.position = end;
+        }
+
+        // quantization matrices (row-major) and Huffman tables of the components
+        const size_t numComponents = image.components.size();
+        headers.dcTables.clear();
+        headers.acTables.clear();
+        for (size_t i = 0; i < numComponents; ++i) {
+            JFIFComponent& component = image.components[i];
+            for (size_t k = 0; k < dct::algo::DCT_BLOCK_AREA; ++k) {
+                component.quantization[ZIGZAG_ORDER[k]] = quantizationTables[quantizationIds[i]][k];
+            }
+            headers.dcTables.push_back(huffmanTables[0][dcIds[i]]);
+            headers.acTables.push_back(huffmanTables[1][acIds[i]]);
+        }
+        return reader.position;
+    }
+
+    /**
+     * Decode the MCUs [first, last) of an entropy-coded segment (DC predictions from 0).
+     *
+     * @param dc: the DC decoders of the components.
+     * @param ac: the AC decoders of the components.
+     */
+    static void decodeSegment(
+        BitReader& bits,
+        const MCULayout& layout,
+        const HuffmanDecoder* dc,
+        const HuffmanDecoder* ac,
+        const size_t first,
+        const size_t last,
+        JFIFImage& image,
+        const size_t scale = 1
+    ) {
+        alignas(64) int16_t block[dct::algo::DCT_BLOCK_AREA];
+        int previousDC[MAX_COMPONENTS] = {0, 0, 0, 0};
+        if (scale == 1) {
+            for (size_t mcu = first; mcu < last; ++mcu) {
+                forEachBlock(layout, mcu, [&](const size_t i, const size_t r, const size_t c) {
+                    decodeBlockHuffman(bits, previousDC[i], dc[i], ac[i], block);
+                    storeBlock(block, r, c, image.components[i].coefficients);
+                });
+            }
+            return;
+        }
+
+        // only the low-frequency corner of each block, stored at 1/scale of its position
+        const int size = static_cast<int>(dct::algo::DCT_BLOCK_SIZE / scale);
+        for (size_t mcu = first; mcu < last; ++mcu) {
+            forEachBlock(layout, mcu, [&](const size_t i, const size_t r, const size_t c) {
+                decodeBlockHuffmanScaled(bits, previousDC[i], dc[i], ac[i], size, block);
+                Plane<int16_t>& coefficients = image.components[i].coefficients;
+                for (int k = 0; k < size; ++k) {
+                    std::memcpy(coefficients.row(r / scale + k) + c / scale, block + k * size, size * sizeof(int16_t));
+                }
+            });
+        }
+    }
+
+    void decodeJFIFSegment(
+        const uint8_t* data,
+        const size_t size,
+        const std::vector<HuffmanDecoder>& dc,
+        const std::vector<HuffmanDecoder>& ac,
+        JFIFImage& stripe
+    ) {
+        if (dc.size() != stripe.components.size() || ac.size() != stripe.components.size()) {
+            throw std::invalid_argument(
+                "One DC and one AC decoder per component are needed. Given: " + std::to_string(dc.size()) +
+                " and " + std::to_string(ac.size()) + " for " + std::to_string(stripe.components.size())
+            );
+        }
+        const MCULayout layout = makeLayout(stripe);
+        BitReader bits(data, size);
+        decodeSegment(bits, layout, dc.data(), ac.data(), 0, layout.numMCUs, stripe);
+    }
+
+    JFIFImage readJFIF(const uint8_t* data, const size_t size, const size_t scale) {
+        checkDecodeScale(scale);
+        JFIFHeaders headers;
+        const size_t scanOffset = readJFIFHeaders(data, size, headers);
+        JFIFImage& image = headers.image;
+
+        // planes of the components
+        const size_t numComponents = image.components.size();
+        std::vector<HuffmanDecoder> dc, ac;
+        for (size_t i = 0; i < numComponents; ++i) {
+            size_t rows, cols;
+            getComponentSize(image, i, rows, cols);
+            image.components[i].coefficients = Plane<int16_t>(rows / scale, cols / scale);
+            dc.emplace_back(headers.dcTables[i]);
+            ac.emplace_back(headers.acTables[i]);
+        }
+
+        // entropy-coded MCUs: with restart markers, the segments are located by a scan of the bytes
+        // and decoded concurrently
+        const uint8_t* scan = data + scanOffset;
+        const size_t scanSize = size - scanOffset;
+        const MCULayout layout = makeLayout(image);
+        const std::vector<size_t> offsets = layout.numSegments > 1 ?
+            findRestartSegments(scan, scanSize, layout.numSegments) : std::vector<size_t>{0, scanSize};
+        std::exception_ptr error;
+
+        #pragma omp parallel for schedule(static) if(layout.numSegments > 1 && !omp_in_parallel())
+        for (size_t s = 0; s < layout.numSegments; ++s) {
+            try {
+                BitReader bits(scan + offsets[s], offsets[s + 1] - offsets[s]);
+                const size_t last = std::min(layout.numMCUs, (s + 1) * layout.interval);
+                decodeSegment(bits, layout, dc.data(), ac.data(), s * layout.interval, last, image, scale);
+            } catch (...) {
+                #pragma omp critical
+                error = std::current_exception();
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(headers.image);
+    }
+}
@@ -0,0 +1,224 @@
+#ifndef JPEG_JFIF_HPP
+#define JPEG_JFIF_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "compression/jpeg_image_compression/huffman/huffman.hpp"
+#include "compression/jpeg_image_compression/plane/plane.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_8x8.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * A component (channel) of a JPEG image: Y for grayscale images, Y, Cb and Cr for color ones.
+     */
+    struct JFIFComponent {
+        /**
+         * The quantized DCT coefficients of the blocks of the component, in the same layout of
+         * CompressedImage::compressed; the sizes are padded to whole MCUs (see getComponentSize).
+         */
+        Plane<int16_t> coefficients;
+        /**
+         * The quantization matrix of the coefficients, row-major.
+         */
+        double quantization[dct::algo::DCT_BLOCK_AREA];
+        /**
+         * Horizontal sampling factor (1-4): 2 for the luma of a 4:2:0 or 4:2:2 image, 1 for its chroma.
+         */
+        int horizontalSampling;
+        /**
+         * Vertical sampling factor (1-4): 2 for the luma of a 4:2:0 image, 1 for its chroma.
+         */
+        int verticalSampling;
+    };
+
+    /**
+     * Content of a baseline (sequential, Huffman-coded, 8-bit) JPEG file with a single scan.
+     */
+    struct JFIFImage {
+        /**
+         * The components of the image (1 to 4), the first one is the luma.
+         */
+        std::vector<JFIFComponent> components;
+        /**
+         * Width of the image, in pixels.
+         */
+        size_t width;
+        /**
+         * Height of the image, in pixels.
+         */
+        size_t height;
+        /**
+         * Number of MCUs of each restart segment (0 if the file has no restart markers).
+         */
+        size_t restartInterval;
+    };
+
+    /**
+     * Headers of a JPEG file, up to its scan: the image (without coefficients) and the Huffman tables.
+     */
+    struct JFIFHeaders {
+        /**
+         * The sizes, the restart interval, and the sampling factors and quantization matrices of the components.
+         */
+        JFIFImage image;
+        /**
+         * The DC Huffman table of each component.
+         */
+        std::vector<HuffmanTable> dcTables;
+        /**
+         * The AC Huffman table of each component.
+         */
+        std::vector<HuffmanTable> acTables;
+    };
+
+    /**
+     * Function that computes the sizes of the plane of coefficients of a component.
+     *
+     * A single component is coded block by block, so its plane covers the image rounded up to
+     * multiples of 8. Several components are interleaved in MCUs (minimum coded units) of
+     * 8 * maxH x 8 * maxV pixels, with H x V blocks of each component, so every plane covers
+     * a whole number of MCUs: e.g. for 4:2:0 the luma has 16x16 pixels and each chroma 8x8 per MCU.
+     *
+     * @param image: the image (sizes and sampling factors of the components).
+     * @param component: the index of the component.
+     * @param rows: number of rows of the plane (output).
+     * @param cols: number of columns of the plane (output).
+     * @throws std::invalid_argument if a sampling factor is not in [1, 4].
+     */
+    void getComponentSize(const JFIFImage& image, size_t component, size_t& rows, size_t& cols);
+
+    /**
+     * Function that writes the quantized coefficients of an image as a baseline JFIF (.jpg) file:
+     * SOI, APP0 (JFIF 1.01), DQT, SOF0, DHT, (DRI), SOS, the Huffman-coded MCUs and EOI.
+     * A quantization table with entries above 255 needs a 16-bit DQT, which baseline decoders reject
+     * in a SOF0 frame: the frame is then declared as SOF1 (extended sequential, same Huffman coding).
+     *
+     * The first component uses the quantization and Huffman tables 0, the others the tables 1
+     * (equal quantization matrices share the same table). With optimizeHuffman, a first pass counts
+     * the symbols and the DHT carries the optimal tables (ITU T.81, Annex K.2), which makes the file
+     * smaller; otherwise the standard luminance and chrominance tables of Annex K are used.
+     *
+     * With a restart interval, the MCUs are coded in independent segments of restartInterval MCUs
+     * (DC prediction reset, byte-aligned, separated by the RST0-RST7 markers and declared by a DRI segment).
+     * The segments are coded concurrently (per-thread buffers, concatenated in order) and readJFIF
+     * decodes them concurrently too. An interval of a whole number of rows of MCUs makes every
+     * segment a horizontal stripe of the image.
+     *
+     * @param image: the components, the sizes (at most 65535) and the restart interval (at most 65535).
+     * @param optimizeHuffman: true for the optimal Huffman tables, false for the standard ones.
+     * @return: the bytes of the file.
+     * @throws std::invalid_argument if the sizes, the components or the restart interval are not valid.
+     * @throws std::runtime_error if a coefficient is out of the baseline range.
+     */
+    std::vector<uint8_t> writeJFIF(const JFIFImage& image, bool optimizeHuffman);
+
+    /**
+     * Function that writes the headers of a baseline JFIF file, from SOI to SOS, with the standard Huffman
+     * tables (see writeJFIF): the first part of a file coded stripe by stripe (see writeJFIFSegment),
+     * without the coefficients of the whole image.
+     *
+     * @param image: the sizes, the restart interval and the components (their coefficients are ignored).
+     * @return: the bytes of the headers.
+     * @throws std::invalid_argument if the sizes, the components or the restart interval are not valid.
+     */
+    std::vector<uint8_t> writeJFIFHeaders(const JFIFImage& image);
+
+    /**
+     * Function that codes a horizontal stripe of an image as one entropy-coded segment, with the standard
+     * Huffman tables of writeJFIFHeaders (DC predictions from 0, byte-aligned, without the RSTn marker).
+     *
+     * The stripe is an image of whole rows of MCUs with the width of the file (its height is the number of
+     * rows of pixels of the stripe): a file whose restart interval is a row of MCUs is its headers, then
+     * the segments of its stripes of 8 * maxV rows separated by the RSTn markers, then EOI.
+     *
+     * @param stripe: the coefficients of the stripe.
+     * @param output: the buffer where the coded bytes are appended.
+     * @throws std::invalid_argument if the sizes or the components are not valid.
+     * @throws std::runtime_error if a coefficient is out of the baseline range.
+     */
+    void writeJFIFSegment(const JFIFImage& stripe, std::vector<uint8_t>& output);
+
+    /**
+     * Function that estimates the size of the file written by writeJFIF without coding it: the Huffman
+     * symbols are only counted (see countHuffmanBits), so the cost is about the one of the first pass
+     * of the optimized tables. The headers are exact; the stuffed 0x00 bytes (after every 0xFF of the
+     * coded data) are not counted and the padding of the segments is averaged, so the file is usually
+     * a few bytes per thousand larger.
+     *
+     * @param image: the components, the sizes and the restart interval (as for writeJFIF).
+     * @param optimizeHuffman: true for the optimal Huffman tables, false for the standard ones.
+     * @return: the estimated number of bytes of the file.
+     * @throws std::invalid_argument if the sizes, the components or the restart interval are not valid.
+     */
+    size_t estimateJFIFSize(const JFIFImage& image, bool optimizeHuffman);
+
+    /**
+     * Function that builds the index of the restart segments of an entropy-coded scan: the bytes are
+     * searched for the RSTn markers (the coded data never contains them, thanks to the 0xFF stuffing),
+     * so the segments can be decoded independently without decoding the previous ones.
+     *
+     * @param scan: pointer to the first byte of the entropy-coded data (after the SOS segment).
+     * @param size: number of bytes up to the end of the file.
+     * @param numSegments: the expected number of segments.
+     * @return: numSegments + 1 offsets from scan: the start of every segment, then size.
+     * @throws std::runtime_error if the markers are missing or out of order.
+     */
+    std::vector<size_t> findRestartSegments(const uint8_t* scan, size_t size, size_t numSegments);
+
+    /**
+     * Function that reads a baseline JPEG file (written by writeJFIF or by other encoders) with all its
+     * components in a single scan, decoding the Huffman-coded MCUs into quantized coefficients.
+     *
+     * With restart markers (DRI), the segments are located by findRestartSegments and decoded concurrently.
+     * The APPn and COM segments are skipped. Progressive, arithmetic-coded, 12-bit and multi-scan
+     * files are not supported.
+     *
+     * With a scale of 2, 4 or 8 (for decompressScaled), only the (8 / scale) x (8 / scale) low-frequency
+     * coefficients of each block are stored: every plane has 1/scale of the rows and of the columns of
+     * getComponentSize, and the other AC coefficients are decoded from the bitstream but never written.
+     *
+     * @param data: the bytes of the file.
+     * @param size: number of bytes.
+     * @param scale: 1 for the whole blocks, 2, 4 or 8 for their corners.
+     * @return: the components, the sizes of the image and the restart interval.
+     * @throws std::invalid_argument if the scale is not supported.
+     * @throws std::runtime_error if the file is corrupted or not supported.
+     */
+    JFIFImage readJFIF(const uint8_t* data, size_t size, size_t scale = 1);
+
+    /**
+     * Function that reads the headers of a baseline JPEG file, up to its SOS segment (see readJFIF).
+     *
+     * @param data: the bytes of the file (at least up to the end of the SOS segment).
+     * @param size: number of bytes.
+     * @param headers: the image without coefficients and the Huffman tables of its components (output).
+     * @return: the offset of the entropy-coded data, after the SOS segment.
+     * @throws std::runtime_error if the headers are corrupted, truncated or not supported.
+     */
+    size_t readJFIFHeaders(const uint8_t* data, size_t size, JFIFHeaders& headers);
+
+    /**
+     * Function that decodes an entropy-coded segment into the coefficients of a stripe of whole rows
+     * of MCUs (the inverse of writeJFIFSegment).
+     *
+     * @param data: pointer to the first byte of the segment.
+     * @param size: number of bytes of the segment.
+     * @param dc: the DC decoder of each component.
+     * @param ac: the AC decoder of each component.
+     * @param stripe: the stripe, with the planes of coefficients allocated (output).
+     * @throws std::invalid_argument if the number of decoders is not valid.
+     * @throws std::runtime_error if the segment is corrupted.
+     */
+    void decodeJFIFSegment(
+        const uint8_t* data,
+        size_t size,
+        const std::vector<HuffmanDecoder>& dc,
+        const std::vector<HuffmanDecoder>& ac,
+        JFIFImage& stripe
+    );
+}
+
+#endif //JPEG_JFIF_HPP
@@ -0,0 +1,269 @@
+#ifndef JPEG_PLANE_HPP
+#define JPEG_PLANE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace sp::jpeg
+{
+    /**
+     * Contiguous planar storage of a 2D array (a channel of an image, or its quantized coefficients).
+     *
+     * Element (r, c) is data()[r * getPitch() + c]. The planes allocated by the library have a pitch
+     * rounded up to 64 bytes and a 64-byte aligned first row, so every row starts on a cache line
+     * and can be fed to SIMD kernels directly. A plane can also adopt an existing buffer (zero-copy),
+     * e.g. the one returned by stb_image or img::loadImage, with its own pitch and release function.
+     *
+     * Copies are deep (the copy is always aligned); moves transfer the buffer.
+     *
+     * @tparam T The element type (uint8_t for pixels, int16_t for quantized coefficients).
+     */
+    template <typename T>
+    class Plane {
+    public:
+        /**
+         * Alignment, in bytes, of the first row and of the pitch of the allocated planes.
+         */
+        static constexpr size_t ALIGNMENT = 64;
+
+        /**
+         * Function that releases an adopted buffer (e.g. stbi_image_free or std::free).
+         */
+        typedef void (*Release)(void*);
+
+        /**
+         * Create an empty plane.
+         */
+        Plane() : rows(0), cols(0), pitch(0), pixels(nullptr), buffer(nullptr), release(nullptr) {}
+
+        /**
+         * Create a plane of zeros with an aligned pitch.
+         *
+         * @param rows: number of rows.
+         * @param cols: number of columns.
+         */
+        Plane(const size_t rows, const size_t cols) : Plane() {
+            this->allocate(rows, cols);
+        }
+
+        /**
+         * Adopt an existing buffer without copying it; the plane releases it when destroyed.
+         *
+         * @param data: pointer to the element (0, 0).
+         * @param rows: number of rows.
+         * @param cols: number of columns.
+         * @param pitch: distance, in elements, between two consecutive rows (at least cols).
+         * @param release: function that frees data (nullptr if the buffer is not owned).
+         * @throws std::invalid_argument if the pitch is smaller than the number of columns.
+         */
+        Plane(T* data, const size_t rows, const size_t cols, const size_t pitch, const Release release) :
+            rows(rows), cols(cols), pitch(pitch), pixels(data), buffer(data), release(release) {
+            if (pitch < cols) {
+                throw std::invalid_argument(
+                    "Invalid plane layout. Given: pitch " + std::to_string(pitch) + " for " +
+                    std::to_string(cols) + " columns"
+                );
+            }
+        }
+
+        Plane(const Plane& other) : Plane() {
+            this->copyFrom(other);
+        }
+
+        Plane(Plane&& other) noexcept : Plane() {
+            this->swap(other);
+        }
+
+        Plane& operator=(const Plane& other) {
+            if (this != &other) {
+                Plane copy(other);
+                this->swap(copy);
+            }
+            return *this;
+        }
+
+        Plane& operator=(Plane&& other) noexcept {
+            this->swap(other);
+            return *this;
+        }
+
+        ~Plane() {
+            if (this->release != nullptr) {
+                this->release(this->buffer);
+            }
+        }
+
+        /**
+         * Get the number of rows.
+         * @return The number of rows.
+         */
+        [[nodiscard]] size_t getRows() const {
+            return rows;
+        }
+
+        /**
+         * Get the number of columns.
+         * @return The number of columns.
+         */
+        [[nodiscard]] size_t getCols() const {
+            return cols;
+        }
+
+        /**
+         * Get the distance between two consecutive rows.
+         * @return The pitch, in elements.
+         */
+        [[nodiscard]] size_t getPitch() const {
+            return pitch;
+        }
+
+        /**
+         * Check whether the plane has no elements.
+         * @return True if the plane is empty.
+         */
+        [[nodiscard]] bool empty() const {
+            return rows == 0 || cols == 0;
+        }
+
+        /**
+         * Get the pointer to the element (0, 0).
+         */
+        T* data() {
+            return pixels;
+        }
+
+        const T* data() const {
+            return pixels;
+        }
+
+        /**
+         * Get the pointer to the first element of a row.
+         *
+         * @param r: the row.
+         */
+        T* row(const size_t r) {
+            return pixels + r * pitch;
+        }
+
+        const T* row(const size_t r) const {
+            return pixels + r * pitch;
+        }
+
+        T& operator()(const size_t r, const size_t c) {
+            return pixels[r * pitch + c];
+        }
+
+        const T& operator()(const size_t r, const size_t c) const {
+            return pixels[r * pitch + c];
+        }
+
+        /**
+         * Shrink the logical size of the plane, keeping the buffer and the pitch (no copy),
+         * e.g. to drop the padding of the blocks at the right and bottom borders.
+         *
+         * @param rows: the new number of rows (at most getRows()).
+         * @param cols: the new number of columns (at most getCols()).
+         * @throws std::invalid_argument if the new size is larger than the current one.
+         */
+        void crop(const size_t rows, const size_t cols) {
+            if (rows > this->rows || cols > this->cols) {
+                throw std::invalid_argument(
+                    "Invalid crop. Given: " + std::to_string(rows) + "x" + std::to_string(cols) +
+                    " for a plane of " + std::to_string(this->rows) + "x" + std::to_string(this->cols)
+                );
+            }
+            this->rows = rows;
+            this->cols = cols;
+        }
+
+        /**
+         * Compute the pitch of an allocated plane: cols rounded up to a multiple of 64 bytes.
+         *
+         * @param cols: number of columns.
+         * @return The pitch, in elements.
+         */
+        static size_t alignedPitch(const size_t cols) {
+            constexpr size_t elements = ALIGNMENT / sizeof(T);
+            return (cols + elements - 1) / elements * elements;
+        }
+
+    private:
+        /**
+         * Number of rows.
+         */
+        size_t rows;
+        /**
+         * Number of columns.
+         */
+        size_t cols;
+        /**
+         * Distance, in elements, between two consecutive rows.
+         */
+        size_t pitch;
+        /**
+         * Pointer to the element (0, 0).
+         */
+        T* pixels;
+        /**
+         * The owned buffer (passed to release).
+         */
+        void* buffer;
+        /**
+         * Function that frees the buffer (nullptr if not owned).
+         */
+        Release release;
+
+        /**
+         * Allocate a plane of zeros with an aligned first row and pitch (the plane must be empty).
+         */
+        void allocate(const size_t rows, const size_t cols) {
+            const size_t pitch = alignedPitch(cols);
+            const size_t bytes = rows * pitch * sizeof(T);
+            if (bytes == 0) {
+                return;
+            }
+            // over-allocate and align by hand (std::aligned_alloc is not available in C++11)
+            void* buffer = std::calloc(bytes + ALIGNMENT, 1);
+            if (buffer == nullptr) {
+                throw std::bad_alloc();
+            }
+            const uintptr_t address = reinterpret_cast<uintptr_t>(buffer);
+            this->pixels = reinterpret_cast<T*>((address + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT);
+            this->buffer = buffer;
+            this->release = std::free;
+            this->rows = rows;
+            this->cols = cols;
+            this->pitch = pitch;
+        }
+
+        /**
+         * Deep copy of another plane into this (empty) plane.
+         */
+        void copyFrom(const Plane& other) {
+            if (other.empty()) {
+                return;
+            }
+            this->allocate(other.rows, other.cols);
+            for (size_t r = 0; r < other.rows; ++r) {
+                std::memcpy(this->row(r), other.row(r), other.cols * sizeof(T));
+            }
+        }
+
+        void swap(Plane& other) noexcept {
+            std::swap(this->rows, other.rows);
+            std::swap(this->cols, other.cols);
+            std::swap(this->pitch, other.pitch);
+            std::swap(this->pixels, other.pixels);
+            std::swap(this->buffer, other.buffer);
+            std::swap(this->release, other.release);
+        }
+    };
+}
+
+#endif //JPEG_PLANE_HPP
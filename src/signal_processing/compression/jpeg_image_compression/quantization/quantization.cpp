@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "compression/jpeg_image_compression/quantization/quantization.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Luminance quantization matrix (ITU T.81, Table K.1).
+     */
+    static const double LUMINANCE[dct::algo::DCT_BLOCK_AREA] = {
+        16, 11, 10, 16, 24, 40, 51, 61,
+        12, 12, 14, 19, 26, 58, 60, 55,
+        14, 13, 16, 24, 40, 57, 69, 56,
+        14, 17, 22, 29, 51, 87, 80, 62,
+        18, 22, 37, 56, 68, 109, 103, 77,
+        24, 35, 55, 64, 81, 104, 113, 92,
+        49, 64, 78, 87, 103, 121, 120, 101,
+        72, 92, 95, 98, 112, 100, 103, 99
+    };
+
+    /**
+     * Chrominance quantization matrix (ITU T.81, Table K.2).
+     */
+    static const double CHROMINANCE[dct::algo::DCT_BLOCK_AREA] = {
+        17, 18, 24, 47, 99, 99, 99, 99,
+        18, 21, 26, 66, 99, 99, 99, 99,
+        24, 26, 56, 99, 99, 99, 99, 99,
+        47, 66, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99
+    };
+
+    constexpr int MAX_QUALITY = 100;
+
+    /**
+     * Scale a matrix for a quality (IJG formula, integer arithmetic as libjpeg).
+     */
+    static void scaleTable(const double* base, const int quality, QuantizationTable& table) {
+        const long scale = quality < 50 ? 5000 / quality : 200 - 2 * quality;
+        for (size_t k = 0; k < dct::algo::DCT_BLOCK_AREA; ++k) {
+            const long value = (static_cast<long>(base[k]) * scale + 50) / 100;
+            table.quantization[k] = static_cast<double>(std::min(255L, std::max(1L, value)));
+            table.reciprocal[k] = 1.0 / table.quantization[k];
+        }
+    }
+
+    /**
+     * The luminance tables of the qualities 1 to 100, then the chrominance ones.
+     */
+    static std::vector<QuantizationTable> makeTables() {
+        std::vector<QuantizationTable> tables(2 * MAX_QUALITY);
+        for (int quality = 1; quality <= MAX_QUALITY; ++quality) {
+            scaleTable(LUMINANCE, quality, tables[quality - 1]);
+            scaleTable(CHROMINANCE, quality, tables[MAX_QUALITY + quality - 1]);
+        }
+        return tables;
+    }
+
+    const QuantizationTable& getQuantizationTable(const int quality, const bool chrominance) {
+        if (quality < 1 || quality > MAX_QUALITY) {
+            throw std::invalid_argument("The quality must be in [1, 100]. Given: " + std::to_string(quality));
+        }
+        static const std::vector<QuantizationTable> tables = makeTables();
+        return tables[(chrominance ? MAX_QUALITY : 0) + quality - 1];
+    }
+
+    void makeQuantizationMatrix(double* quantization, const int quality) {
+        std::memcpy(quantization, getQuantizationTable(quality, false).quantization, sizeof(LUMINANCE));
+    }
+
+    void makeChrominanceQuantizationMatrix(double* quantization, const int quality) {
+        std::memcpy(quantization, getQuantizationTable(quality, true).quantization, sizeof(CHROMINANCE));
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef JPEG_QUANTIZATION_HPP
+#define JPEG_QUANTIZATION_HPP
+
+#include "transforms/discrete_cosine_transform/algorithms/dct_8x8.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Default quality of the encoder: the tables of ITU T.81, Annex K, unscaled.
+     */
+    constexpr int DEFAULT_QUALITY = 50;
+
+    /**
+     * A quantization matrix scaled for a quality, with the reciprocals of its entries
+     * (the quantization multiplies by them instead of dividing).
+     */
+    struct QuantizationTable {
+        /**
+         * The 64 entries of the matrix, row-major, integers in [1, 255] (baseline).
+         */
+        double quantization[dct::algo::DCT_BLOCK_AREA];
+        /**
+         * The 64 values 1 / quantization[k].
+         */
+        double reciprocal[dct::algo::DCT_BLOCK_AREA];
+    };
+
+    /**
+     * Function that gets the quantization table of a quality with the IJG (libjpeg) scaling: the standard
+     * matrix is multiplied by 5000 / quality % below 50 and by (200 - 2 * quality) % from 50 on,
+     * rounded and clamped to [1, 255]. Quality 50 gives the standard matrix, 100 a matrix of ones.
+     *
+     * The tables of all the qualities are computed once, on the first call (thread-safe).
+     *
+     * @param quality: the quality, from 1 (smallest files) to 100 (best images).
+     * @param chrominance: true for the chrominance matrix (Cb, Cr), false for the luminance one.
+     * @return: the scaled matrix and its reciprocals.
+     * @throws std::invalid_argument if the quality is not in [1, 100].
+     */
+    const QuantizationTable& getQuantizationTable(int quality, bool chrominance = false);
+
+    /**
+     * Function that fills the constant matrix Q (quantization matrix, 8x8) used by the encoder, row-major
+     * (ITU T.81, Table K.1, scaled for the quality, see getQuantizationTable).
+     *
+     * @param quantization: the 64 entries of Q (output).
+     * @param quality: the quality, from 1 to 100.
+     */
+    void makeQuantizationMatrix(double* quantization, int quality = DEFAULT_QUALITY);
+
+    /**
+     * Function that fills the quantization matrix of the chroma components (Cb, Cr) of a color image,
+     * row-major (ITU T.81, Table K.2, scaled for the quality, see getQuantizationTable).
+     *
+     * @param quantization: the 64 entries of the matrix (output).
+     * @param quality: the quality, from 1 to 100.
+     */
+    void makeChrominanceQuantizationMatrix(double* quantization, int quality = DEFAULT_QUALITY);
+}
+
+#endif //JPEG_QUANTIZATION_HPP
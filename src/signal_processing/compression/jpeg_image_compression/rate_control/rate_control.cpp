@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <cstring>
+#include <omp.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "compression/jpeg_image_compression/rate_control/rate_control.hpp"
+#include "compression/jpeg_image_compression/quantization/quantization.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_8x8.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_batch.hpp"
+
+namespace sp::jpeg
+{
+    RateController::RateController(JFIFImage image, const Plane<uint8_t>* planes): image(std::move(image)) {
+        constexpr size_t submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+
+        // post-scale of the DCT without quantization (the orthonormal coefficients)
+        double ones[dct::algo::DCT_BLOCK_AREA];
+        std::fill(ones, ones + dct::algo::DCT_BLOCK_AREA, 1.0);
+        alignas(64) double scale[dct::algo::DCT_BLOCK_AREA];
+        dct::algo::makeDCT8x8QuantizationScale(ones, scale);
+
+        for (size_t i = 0; i < this->image.components.size(); ++i) {
+            size_t rows, cols;
+            getComponentSize(this->image, i, rows, cols);
+            if (planes[i].getRows() != rows || planes[i].getCols() != cols) {
+                throw std::invalid_argument(
+                    "Invalid sizes of the component " + std::to_string(i) + ". Given: " +
+                    std::to_string(planes[i].getCols()) + "x" + std::to_string(planes[i].getRows()) +
+                    ", expected " + std::to_string(cols) + "x" + std::to_string(rows)
+                );
+            }
+            this->image.components[i].coefficients = Plane<int16_t>(rows, cols);
+            this->coefficients.emplace_back(rows, cols);
+            Plane<float>& dct = this->coefficients.back();
+            const Plane<uint8_t>& samples = planes[i];
+            const size_t numBlocks = cols / submatrixSize;
+
+            #pragma omp parallel if(!omp_in_parallel())
+            {
+                // per-thread buffer of a row of blocks (level-shifted samples, then coefficients)
+                std::vector<double> blocks(submatrixSize * cols);
+
+                #pragma omp for schedule(static)
+                for (size_t r = 0; r < rows; r += submatrixSize) {
+                    for (size_t b = 0; b < numBlocks; ++b) {
+                        double* block = blocks.data() + b * dct::algo::DCT_BLOCK_AREA;
+                        for (size_t y = 0; y < submatrixSize; ++y) {
+                            const uint8_t* row = samples.row(r + y) + b * submatrixSize;
+                            for (size_t x = 0; x < submatrixSize; ++x) {
+                                block[y * submatrixSize + x] = row[x] - 128.0;
+                            }
+                        }
+                    }
+                    dct::algo::computeDCT8x8Batch(blocks.data(), numBlocks, scale, false);
+                    for (size_t b = 0; b < numBlocks; ++b) {
+                        const double* block = blocks.data() + b * dct::algo::DCT_BLOCK_AREA;
+                        for (size_t y = 0; y < submatrixSize; ++y) {
+                            float* row = dct.row(r + y) + b * submatrixSize;
+                            for (size_t x = 0; x < submatrixSize; ++x) {
+                                row[x] = static_cast<float>(block[y * submatrixSize + x]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    const JFIFImage& RateController::quantize(const int quality) {
+        if (quality == this->quality) {
+            return this->image;
+        }
+        constexpr size_t submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        for (size_t i = 0; i < this->image.components.size(); ++i) {
+            const QuantizationTable& table = getQuantizationTable(quality, i > 0);
+            JFIFComponent& component = this->image.components[i];
+            std::memcpy(component.quantization, table.quantization, sizeof(table.quantization));
+
+            const Plane<float>& dct = this->coefficients[i];
+            const size_t rows = dct.getRows();
+            const size_t cols = dct.getCols();
+
+            #pragma omp parallel for schedule(static) if(!omp_in_parallel())
+            for (size_t r = 0; r < rows; ++r) {
+                // the reciprocals of the row of the table, repeated for every block of the row
+                float reciprocal[submatrixSize];
+                for (size_t x = 0; x < submatrixSize; ++x) {
+                    reciprocal[x] = static_cast<float>(table.reciprocal[(r % submatrixSize) * submatrixSize + x]);
+                }
+                const float* input = dct.row(r);
+                int16_t* output = component.coefficients.row(r);
+                for (size_t c = 0; c < cols; c += submatrixSize) {
+                    #pragma omp simd
+                    for (size_t x = 0; x < submatrixSize; ++x) {
+                        // rounded half away from zero, as std::lround (branch-free, vectorized)
+                        const float value = input[c + x] * reciprocal[x];
+                        output[c + x] = static_cast<int16_t>(
+                            static_cast<int32_t>(value + (value < 0.0f ? -0.5f : 0.5f))
+                        );
+                    }
+                }
+            }
+        }
+        this->quality = quality;
+        return this->image;
+    }
+
+    size_t RateController::estimateSize(const int quality, const bool optimizeHuffman) {
+        return estimateJFIFSize(quantize(quality), optimizeHuffman);
+    }
+
+    int RateController::findQuality(const size_t targetBytes, const bool optimizeHuffman) {
+        int best = 1;
+        int low = 1, high = 100;
+        while (low <= high) {
+            const int middle = (low + high) / 2;
+            if (estimateSize(middle, optimizeHuffman) <= targetBytes) {
+                best = middle;
+                low = middle + 1;
+            } else {
+                high = middle - 1;
+            }
+        }
+        return best;
+    }
+
+    std::vector<uint8_t> RateController::compress(const size_t targetBytes, const bool optimizeHuffman, int* quality) {
+        int chosen = findQuality(targetBytes, optimizeHuffman);
+        std::vector<uint8_t> jpeg = writeJFIF(quantize(chosen), optimizeHuffman);
+        // the estimate ignores the stuffing bytes: step down until the file fits
+        while (jpeg.size() > targetBytes && chosen > 1) {
+            --chosen;
+            jpeg = writeJFIF(quantize(chosen), optimizeHuffman);
+        }
+        if (quality != nullptr) {
+            *quality = chosen;
+        }
+        return jpeg;
+    }
+}
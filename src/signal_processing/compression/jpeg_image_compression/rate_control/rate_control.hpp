@@ -0,0 +1,89 @@
+#ifndef JPEG_RATE_CONTROL_HPP
+#define JPEG_RATE_CONTROL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "compression/jpeg_image_compression/jfif/jfif.hpp"
+#include "compression/jpeg_image_compression/plane/plane.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Rate control of the JPEG encoder: finds the highest quality (see getQuantizationTable) whose
+     * file fits in a target number of bytes.
+     *
+     * The DCT of the components is computed once, without quantization. Every quality tried by the
+     * binary search only requantizes the coefficients (a multiplication by the reciprocals of its table)
+     * and sizes them with estimateJFIFSize, without coding them; only the chosen quality is coded.
+     * The first component is quantized with the luminance table, the others with the chrominance one.
+     */
+    class RateController {
+    public:
+        /**
+         * Constructor that computes the DCT (floating-point, see dct::algo::computeDCT8x8Batch) of the components.
+         *
+         * @param image: the sizes, the sampling factors of the components and the restart interval of the
+         *               file (the coefficients and the quantization matrices are ignored).
+         * @param planes: the samples of the components, one plane per component with the sizes of getComponentSize.
+         * @throws std::invalid_argument if the sizes of a plane are not valid.
+         */
+        RateController(JFIFImage image, const Plane<uint8_t>* planes);
+
+        /**
+         * Function that quantizes the coefficients with the tables of a quality.
+         *
+         * @param quality: the quality, from 1 to 100.
+         * @return: the image with the quantized coefficients and the quantization matrices (valid until the next call).
+         * @throws std::invalid_argument if the quality is not in [1, 100].
+         */
+        const JFIFImage& quantize(int quality);
+
+        /**
+         * Function that estimates the size of the file of a quality (see estimateJFIFSize).
+         *
+         * @param quality: the quality, from 1 to 100.
+         * @param optimizeHuffman: true for the optimal Huffman tables, false for the standard ones.
+         * @return: the estimated number of bytes.
+         */
+        size_t estimateSize(int quality, bool optimizeHuffman);
+
+        /**
+         * Function that finds the highest quality whose estimated size is at most targetBytes
+         * (binary search, 7 estimates). The size decreases with the quality, but for a few bytes.
+         *
+         * @param targetBytes: the maximum number of bytes of the file.
+         * @param optimizeHuffman: true for the optimal Huffman tables, false for the standard ones.
+         * @return: the quality (1 if no quality fits).
+         */
+        int findQuality(size_t targetBytes, bool optimizeHuffman);
+
+        /**
+         * Function that codes the file of the highest quality that fits in targetBytes: the quality of
+         * findQuality, lowered while the coded file (with its stuffing bytes) is larger than the target.
+         *
+         * @param targetBytes: the maximum number of bytes of the file.
+         * @param optimizeHuffman: true for the optimal Huffman tables, false for the standard ones.
+         * @param quality: the chosen quality (output, if not null).
+         * @return: the bytes of the .jpg file (the file of quality 1, larger than the target, if no quality fits).
+         */
+        std::vector<uint8_t> compress(size_t targetBytes, bool optimizeHuffman, int* quality = nullptr);
+
+    private:
+        /**
+         * The image, with the coefficients of the last quantized quality.
+         */
+        JFIFImage image;
+        /**
+         * The DCT coefficients of the components, before the quantization (same layout of the coefficients).
+         */
+        std::vector<Plane<float>> coefficients;
+        /**
+         * The last quantized quality (0 if none).
+         */
+        int quality = 0;
+    };
+}
+
+#endif //JPEG_RATE_CONTROL_HPP
@@ -0,0 +1,141 @@
+#include <cmath>
+#include <omp.h>
+#include <stdexcept>
+#include <string>
+
+#include "compression/jpeg_image_compression/scaled_decoding/scaled_decoding.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_8x8.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Function that clamps a decoded value to a pixel, between 0 and 255.
+     */
+    static uint8_t clampToPixel(const long value) {
+        return static_cast<uint8_t>(value < 0 ? 0 : value > 255 ? 255 : value);
+    }
+
+    /**
+     * Reduced N x N inverse DCT of the corner of a block (N = 1, 2 or 4, so the loops are unrolled):
+     * the rows of the dequantized coefficients, then the columns, by the N-point orthonormal basis.
+     *
+     * @param coefficients: the top-left coefficient of the block, with rows of stride values.
+     * @param dequantization: the N * N dequantization factors (rescaled to the N-point DCT).
+     * @param basis: basis[m * N + k], the k-th cosine of the N-point inverse DCT at the sample m.
+     * @param pixels: the top-left pixel of the N x N output, with rows of pitch values.
+     */
+    template <int N>
+    static void inverseScaledBlock(
+        const int16_t* coefficients,
+        const size_t stride,
+        const double* dequantization,
+        const double* basis,
+        uint8_t* pixels,
+        const size_t pitch
+    ) {
+        double rows[N * N];
+        for (int u = 0; u < N; ++u) {
+            double values[N];
+            for (int v = 0; v < N; ++v) {
+                values[v] = coefficients[u * stride + v] * dequantization[u * N + v];
+            }
+            for (int n = 0; n < N; ++n) {
+                double sum = 0.0;
+                for (int v = 0; v < N; ++v) {
+                    sum += values[v] * basis[n * N + v];
+                }
+                rows[u * N + n] = sum;
+            }
+        }
+        for (int m = 0; m < N; ++m) {
+            for (int n = 0; n < N; ++n) {
+                double sum = 0.0;
+                for (int u = 0; u < N; ++u) {
+                    sum += basis[m * N + u] * rows[u * N + n];
+                }
+                pixels[m * pitch + n] = clampToPixel(std::lround(sum) + 128);
+            }
+        }
+    }
+
+    /**
+     * Decode all the blocks of a plane with the N x N inverse DCT.
+     *
+     * @param blockSize: the side of a block in the plane of coefficients (8, or N for the reduced planes).
+     */
+    template <int N>
+    static void decompressBlocks(
+        const Plane<int16_t>& coefficients,
+        const size_t blockSize,
+        const double* quantization,
+        Plane<uint8_t>& pixels
+    ) {
+        constexpr int submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        // N-point orthonormal basis: c_k * sqrt(2 / N) * cos((2m + 1) k pi / 2N), c_0 = 1 / sqrt(2)
+        double basis[N * N];
+        for (int m = 0; m < N; ++m) {
+            for (int k = 0; k < N; ++k) {
+                const double c = k == 0 ? std::sqrt(0.5) : 1.0;
+                basis[m * N + k] = c * std::sqrt(2.0 / N) * std::cos((2 * m + 1) * k * M_PI / (2 * N));
+            }
+        }
+        // the 8-point coefficients are sqrt(8 / N) times the N-point ones of the averaged samples, per dimension
+        double dequantization[N * N];
+        for (int u = 0; u < N; ++u) {
+            for (int v = 0; v < N; ++v) {
+                dequantization[u * N + v] = quantization[u * submatrixSize + v] * N / submatrixSize;
+            }
+        }
+
+        const size_t blockRows = coefficients.getRows() / blockSize;
+        const size_t blockCols = coefficients.getCols() / blockSize;
+        const size_t stride = coefficients.getPitch();
+        const size_t pitch = pixels.getPitch();
+
+        #pragma omp parallel for schedule(static) if(!omp_in_parallel())
+        for (size_t br = 0; br < blockRows; ++br) {
+            const int16_t* row = coefficients.row(br * blockSize);
+            uint8_t* output = pixels.row(br * N);
+            for (size_t bc = 0; bc < blockCols; ++bc) {
+                inverseScaledBlock<N>(row + bc * blockSize, stride, dequantization, basis, output + bc * N, pitch);
+            }
+        }
+    }
+
+    void checkDecodeScale(const size_t scale) {
+        if (scale != 1 && scale != 2 && scale != 4 && scale != 8) {
+            throw std::invalid_argument("The scale of the decoding must be 1, 2, 4 or 8. Given: " + std::to_string(scale));
+        }
+    }
+
+    Plane<uint8_t> decompressScaled(
+        const Plane<int16_t>& coefficients,
+        const double* quantization,
+        const size_t scale,
+        const bool reduced
+    ) {
+        constexpr size_t submatrixSize = dct::algo::DCT_BLOCK_SIZE;
+        checkDecodeScale(scale);
+        if (scale == 1) {
+            throw std::invalid_argument("The full resolution is decoded by CompressedImage::decompress");
+        }
+        const size_t size = submatrixSize / scale;
+        const size_t blockSize = reduced ? size : submatrixSize;
+        const size_t rows = coefficients.getRows();
+        const size_t cols = coefficients.getCols();
+        if (rows == 0 || cols == 0 || rows % blockSize != 0 || cols % blockSize != 0) {
+            throw std::invalid_argument(
+                "The sizes of the coefficients must be multiple of " + std::to_string(blockSize) + ". Given: " +
+                std::to_string(cols) + "x" + std::to_string(rows)
+            );
+        }
+
+        Plane<uint8_t> pixels(rows / blockSize * size, cols / blockSize * size);
+        switch (size) {
+            case 1: decompressBlocks<1>(coefficients, blockSize, quantization, pixels); break;
+            case 2: decompressBlocks<2>(coefficients, blockSize, quantization, pixels); break;
+            default: decompressBlocks<4>(coefficients, blockSize, quantization, pixels); break;
+        }
+        return pixels;
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef JPEG_SCALED_DECODING_HPP
+#define JPEG_SCALED_DECODING_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "compression/jpeg_image_compression/plane/plane.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Function that checks the denominator of a scaled decoding: 1 (full resolution), 2, 4 or 8.
+     *
+     * @param scale: the denominator of the resolution.
+     * @throws std::invalid_argument if the scale is not supported.
+     */
+    void checkDecodeScale(size_t scale);
+
+    /**
+     * Function that decodes the quantized coefficients of a component at 1/scale of its resolution,
+     * one (8 / scale) x (8 / scale) block of pixels per 8x8 block of coefficients (e.g. for thumbnails).
+     *
+     * Only the (8 / scale) x (8 / scale) low-frequency coefficients of each block are used: they are
+     * dequantized, rescaled by (8 / scale) / 8 (from the 8-point to the (8 / scale)-point orthonormal DCT)
+     * and transformed by a reduced (8 / scale)-point inverse DCT, which gives about the average of each
+     * scale x scale square of pixels. At 1/8 there is no inverse DCT: every pixel is DC * Q[0] / 8 + 128.
+     * The arithmetic is floating-point.
+     *
+     * @param coefficients: the quantized coefficients, as 8x8 blocks (reduced = false) or as the
+     *                      (8 / scale) x (8 / scale) corners of the blocks (reduced = true, see readJFIF).
+     * @param quantization: the 64 entries of the quantization matrix, row-major.
+     * @param scale: the denominator of the resolution: 2, 4 or 8.
+     * @param reduced: true if the plane stores only the corners of the blocks.
+     * @return: the rows / scale x cols / scale pixels (of the 8x8 blocks, not cropped to the image).
+     * @throws std::invalid_argument if the scale or the sizes of the plane are not valid.
+     */
+    Plane<uint8_t> decompressScaled(
+        const Plane<int16_t>& coefficients,
+        const double* quantization,
+        size_t scale,
+        bool reduced
+    );
+}
+
+#endif //JPEG_SCALED_DECODING_HPP
@@ -0,0 +1,112 @@
+#ifndef JPEG_BAND_PIPELINE_HPP
+#define JPEG_BAND_PIPELINE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <omp.h>
+
+namespace sp::jpeg
+{
+    /**
+     * Number of slots (band buffers) of each stage of runBandPipeline.
+     *
+     * @return: 2 * the number of bands processed at once.
+     */
+    inline size_t getPipelineSlots() {
+        return 2 * static_cast<size_t>(omp_in_parallel() ? 1 : omp_get_max_threads());
+    }
+
+    /**
+     * Function that runs the three stages of a streaming codec over a sequence of bands, overlapped:
+     * while a thread reads the next group of bands and another one writes the previous group, all the
+     * threads process the current group (one band each, dynamic schedule). Step s reads the group s,
+     * processes the group s - 1 and writes the group s - 2, then all the threads wait at a barrier.
+     *
+     * A group has as many bands as threads, and every stage uses its band b through the slot
+     * b % getPipelineSlots(): the slots of the groups in flight never overlap, so the memory is bounded
+     * by getPipelineSlots() buffers of each stage, whatever the number of bands.
+     * The reads (and the writes) are sequential, in the order of the bands.
+     *
+     * @param numBands: the number of bands.
+     * @param read: function(band, slot) that reads a band (sequential).
+     * @param process: function(band, slot) that processes a band (concurrent).
+     * @param write: function(band, slot) that writes a band (sequential).
+     * @throws the first exception of a stage, after the pipeline is stopped.
+     */
+    template <typename Read, typename Process, typename Write>
+    void runBandPipeline(const size_t numBands, Read read, Process process, Write write) {
+        const int maxThreads = omp_in_parallel() ? 1 : omp_get_max_threads();
+        const size_t group = static_cast<size_t>(maxThreads);
+        const size_t slots = 2 * group;
+        const size_t numGroups = (numBands + group - 1) / group;
+        std::exception_ptr error;
+        bool failed = false;
+
+        #pragma omp parallel num_threads(maxThreads) if(maxThreads > 1)
+        {
+            for (size_t step = 0; step < numGroups + 2; ++step) {
+                #pragma omp single nowait
+                {
+                    const size_t end = std::min(numBands, (step + 1) * group);
+                    try {
+                        for (size_t band = step * group; band < end; ++band) {
+                            read(band, band % slots);
+                        }
+                    } catch (...) {
+                        #pragma omp critical
+                        {
+                            error = std::current_exception();
+                            failed = true;
+                        }
+                    }
+                }
+
+                #pragma omp single nowait
+                if (step >= 2) {
+                    const size_t end = std::min(numBands, (step - 1) * group);
+                    try {
+                        for (size_t band = (step - 2) * group; band < end; ++band) {
+                            write(band, band % slots);
+                        }
+                    } catch (...) {
+                        #pragma omp critical
+                        {
+                            error = std::current_exception();
+                            failed = true;
+                        }
+                    }
+                }
+
+                if (step >= 1 && step <= numGroups) {
+                    const size_t end = std::min(numBands, step * group);
+                    #pragma omp for schedule(dynamic) nowait
+                    for (size_t band = (step - 1) * group; band < end; ++band) {
+                        try {
+                            process(band, band % slots);
+                        } catch (...) {
+                            #pragma omp critical
+                            {
+                                error = std::current_exception();
+                                failed = true;
+                            }
+                        }
+                    }
+                }
+
+                // all the threads see the same flag between the two barriers, and stop together
+                #pragma omp barrier
+                const bool stop = failed;
+                #pragma omp barrier
+                if (stop) {
+                    break;
+                }
+            }
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+#endif //JPEG_BAND_PIPELINE_HPP
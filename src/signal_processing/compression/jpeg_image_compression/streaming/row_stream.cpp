@@ -0,0 +1,130 @@
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "compression/jpeg_image_compression/streaming/row_stream.hpp"
+
+namespace sp::jpeg
+{
+    // #################### PLANES ####################
+
+    PlaneRowSource::PlaneRowSource(const Plane<uint8_t>& plane): plane(plane) {}
+
+    void PlaneRowSource::readRows(uint8_t* rows, const size_t pitch, const size_t count) {
+        if (this->position + count > this->plane.getRows()) {
+            throw std::runtime_error(
+                "Error: cannot read " + std::to_string(count) + " rows after row " + std::to_string(this->position) +
+                " of " + std::to_string(this->plane.getRows())
+            );
+        }
+        for (size_t r = 0; r < count; ++r) {
+            std::memcpy(rows + r * pitch, this->plane.row(this->position + r), this->plane.getCols());
+        }
+        this->position += count;
+    }
+
+    PlaneRowSink::PlaneRowSink(Plane<uint8_t>& plane): plane(plane) {}
+
+    void PlaneRowSink::writeRows(const uint8_t* rows, const size_t pitch, const size_t count) {
+        if (this->position + count > this->plane.getRows()) {
+            throw std::runtime_error(
+                "Error: cannot write " + std::to_string(count) + " rows after row " + std::to_string(this->position) +
+                " of " + std::to_string(this->plane.getRows())
+            );
+        }
+        for (size_t r = 0; r < count; ++r) {
+            std::memcpy(this->plane.row(this->position + r), rows + r * pitch, this->plane.getCols());
+        }
+        this->position += count;
+    }
+
+    // #################### PNM ####################
+
+    /**
+     * Read a decimal field of a PNM header, skipping the whitespace and the comments.
+     */
+    static size_t readHeaderField(std::ifstream& file) {
+        int c = file.get();
+        while (c == '#' || std::isspace(c)) {
+            if (c == '#') {
+                while (c != '\n' && c != EOF) {
+                    c = file.get();
+                }
+            }
+            c = file.get();
+        }
+        if (!std::isdigit(c)) {
+            throw std::runtime_error("Error: corrupted PNM header");
+        }
+        size_t value = 0;
+        while (std::isdigit(c)) {
+            value = 10 * value + (c - '0');
+            c = file.get();
+        }
+        // a single whitespace separates the last field from the samples
+        if (!std::isspace(c)) {
+            throw std::runtime_error("Error: corrupted PNM header");
+        }
+        return value;
+    }
+
+    PNMReader::PNMReader(const std::string& path): file(path, std::ios::binary) {
+        if (!this->file) {
+            throw std::runtime_error("Error: could not open " + path);
+        }
+        char magic[2] = {0, 0};
+        this->file.read(magic, 2);
+        if (magic[0] != 'P' || (magic[1] != '5' && magic[1] != '6')) {
+            throw std::runtime_error("Error: " + path + " is not a binary PGM or PPM file");
+        }
+        this->channels = magic[1] == '5' ? 1 : 3;
+        this->width = readHeaderField(this->file);
+        this->height = readHeaderField(this->file);
+        if (readHeaderField(this->file) != 255 || this->width == 0 || this->height == 0) {
+            throw std::runtime_error("Error: only PGM and PPM files with 8-bit samples are supported");
+        }
+    }
+
+    size_t PNMReader::getWidth() const {
+        return this->width;
+    }
+
+    size_t PNMReader::getHeight() const {
+        return this->height;
+    }
+
+    int PNMReader::getChannels() const {
+        return this->channels;
+    }
+
+    void PNMReader::readRows(uint8_t* rows, const size_t pitch, const size_t count) {
+        const size_t rowBytes = this->width * this->channels;
+        for (size_t r = 0; r < count; ++r) {
+            this->file.read(reinterpret_cast<char*>(rows + r * pitch), static_cast<std::streamsize>(rowBytes));
+        }
+        if (!this->file) {
+            throw std::runtime_error("Error: the PNM file is truncated");
+        }
+    }
+
+    PNMWriter::PNMWriter(const std::string& path, const size_t width, const size_t height, const int channels):
+        file(path, std::ios::binary), rowBytes(width * channels) {
+        if (channels != 1 && channels != 3) {
+            throw std::invalid_argument("A PNM file has 1 or 3 channels. Given: " + std::to_string(channels));
+        }
+        if (!this->file) {
+            throw std::runtime_error("Error: could not create " + path);
+        }
+        this->file << (channels == 1 ? "P5" : "P6") << "\n" << width << " " << height << "\n255\n";
+    }
+
+    void PNMWriter::writeRows(const uint8_t* rows, const size_t pitch, const size_t count) {
+        for (size_t r = 0; r < count; ++r) {
+            this->file.write(reinterpret_cast<const char*>(rows + r * pitch), static_cast<std::streamsize>(this->rowBytes));
+        }
+        if (!this->file) {
+            throw std::runtime_error("Error: could not write the PNM file");
+        }
+    }
+}
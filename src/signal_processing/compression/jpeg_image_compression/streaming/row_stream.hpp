@@ -0,0 +1,139 @@
+#ifndef JPEG_ROW_STREAM_HPP
+#define JPEG_ROW_STREAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "compression/jpeg_image_compression/plane/plane.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Sequential source of the rows of an image (interleaved samples, channels bytes per pixel), from the top:
+     * the streaming encoder pulls a band of rows at a time, so the image is never whole in memory.
+     */
+    class RowSource {
+    public:
+        virtual ~RowSource() = default;
+
+        /**
+         * Function that reads the next rows of the image.
+         *
+         * @param rows: pointer to the first row (output).
+         * @param pitch: distance in bytes between two rows.
+         * @param count: number of rows.
+         * @throws std::runtime_error if the rows cannot be read.
+         */
+        virtual void readRows(uint8_t* rows, size_t pitch, size_t count) = 0;
+    };
+
+    /**
+     * Sequential destination of the rows of an image (interleaved samples, channels bytes per pixel), from the top.
+     */
+    class RowSink {
+    public:
+        virtual ~RowSink() = default;
+
+        /**
+         * Function that writes the next rows of the image.
+         *
+         * @param rows: pointer to the first row.
+         * @param pitch: distance in bytes between two rows.
+         * @param count: number of rows.
+         * @throws std::runtime_error if the rows cannot be written.
+         */
+        virtual void writeRows(const uint8_t* rows, size_t pitch, size_t count) = 0;
+    };
+
+    /**
+     * Rows of a plane in memory.
+     */
+    class PlaneRowSource : public RowSource {
+    public:
+        /**
+         * @param plane: the samples of the image (referenced, not copied).
+         */
+        explicit PlaneRowSource(const Plane<uint8_t>& plane);
+
+        void readRows(uint8_t* rows, size_t pitch, size_t count) override;
+
+    private:
+        const Plane<uint8_t>& plane;
+        size_t position = 0;
+    };
+
+    /**
+     * Rows written into a plane in memory.
+     */
+    class PlaneRowSink : public RowSink {
+    public:
+        /**
+         * @param plane: the plane of the image, with its final sizes (referenced, not copied).
+         */
+        explicit PlaneRowSink(Plane<uint8_t>& plane);
+
+        void writeRows(const uint8_t* rows, size_t pitch, size_t count) override;
+
+    private:
+        Plane<uint8_t>& plane;
+        size_t position = 0;
+    };
+
+    /**
+     * Rows of a binary PGM (P5, grayscale) or PPM (P6, RGB) file with 8-bit samples: the raw rows follow a
+     * short text header, so they can be read a band at a time from images of any size.
+     */
+    class PNMReader : public RowSource {
+    public:
+        /**
+         * Constructor that opens the file and reads its header.
+         *
+         * @param path: path to the .pgm or .ppm file.
+         * @throws std::runtime_error if the file cannot be opened or is not a binary 8-bit PGM or PPM.
+         */
+        explicit PNMReader(const std::string& path);
+
+        [[nodiscard]] size_t getWidth() const;
+        [[nodiscard]] size_t getHeight() const;
+        /**
+         * @return: 1 for PGM, 3 for PPM.
+         */
+        [[nodiscard]] int getChannels() const;
+
+        void readRows(uint8_t* rows, size_t pitch, size_t count) override;
+
+    private:
+        std::ifstream file;
+        size_t width = 0;
+        size_t height = 0;
+        int channels = 0;
+    };
+
+    /**
+     * Rows written as a binary PGM (P5, 1 channel) or PPM (P6, 3 channels) file.
+     */
+    class PNMWriter : public RowSink {
+    public:
+        /**
+         * Constructor that creates the file and writes its header.
+         *
+         * @param path: path to the .pgm or .ppm file.
+         * @param width: width of the image, in pixels.
+         * @param height: height of the image, in pixels.
+         * @param channels: 1 (PGM) or 3 (PPM).
+         * @throws std::invalid_argument if the number of channels is not valid.
+         * @throws std::runtime_error if the file cannot be created.
+         */
+        PNMWriter(const std::string& path, size_t width, size_t height, int channels);
+
+        void writeRows(const uint8_t* rows, size_t pitch, size_t count) override;
+
+    private:
+        std::ofstream file;
+        size_t rowBytes;
+    };
+}
+
+#endif //JPEG_ROW_STREAM_HPP
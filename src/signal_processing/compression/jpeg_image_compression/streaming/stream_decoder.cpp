@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "compression/jpeg_image_compression/streaming/stream_decoder.hpp"
+#include "compression/jpeg_image_compression/color/color_conversion.hpp"
+#include "compression/jpeg_image_compression/compressed_image/compressed_image.hpp"
+#include "compression/jpeg_image_compression/image/image.hpp"
+#include "compression/jpeg_image_compression/streaming/band_pipeline.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * JPEG markers (ITU T.81, Table B.1).
+     */
+    constexpr uint8_t SOI = 0xD8;
+    constexpr uint8_t RST0 = 0xD0;
+    constexpr uint8_t RST7 = 0xD7;
+    constexpr uint8_t SOS = 0xDA;
+
+    StreamDecoder::StreamDecoder(std::istream& input): input(input) {
+        // the segments of the headers are copied up to SOS, then parsed by readJFIFHeaders
+        std::vector<uint8_t> headers;
+        std::streambuf* buffer = input.rdbuf();
+        const auto next = [&]() {
+            const int c = buffer->sbumpc();
+            if (c == std::char_traits<char>::eof()) {
+                throw std::runtime_error("Error: the JPEG stream is truncated");
+            }
+            headers.push_back(static_cast<uint8_t>(c));
+            return static_cast<uint8_t>(c);
+        };
+        if (next() != 0xFF || next() != SOI) {
+            throw std::runtime_error("Error: not a JPEG file (missing SOI marker)");
+        }
+        while (true) {
+            if (next() != 0xFF) {
+                throw std::runtime_error("Error: corrupted JPEG file (marker expected)");
+            }
+            uint8_t marker = next();
+            while (marker == 0xFF) {
+                marker = next();
+            }
+            const size_t length = static_cast<size_t>(next()) << 8 | next();
+            if (length < 2) {
+                throw std::runtime_error("Error: corrupted JPEG file (invalid segment length)");
+            }
+            for (size_t i = 2; i < length; ++i) {
+                next();
+            }
+            if (marker == SOS) {
+                break;
+            }
+        }
+
+        JFIFHeaders parsed;
+        readJFIFHeaders(headers.data(), headers.size(), parsed);
+        this->image = std::move(parsed.image);
+        const size_t numComponents = this->image.components.size();
+        if (numComponents != 1 && numComponents != 3) {
+            throw std::runtime_error(
+                "Error: only grayscale and YCbCr JPEG files are supported. Given: " +
+                std::to_string(numComponents) + " components"
+            );
+        }
+        const JFIFComponent& luma = this->image.components[0];
+        const JFIFComponent& chroma = this->image.components[numComponents - 1];
+        if (numComponents == 3 && (
+            this->image.components[1].horizontalSampling != chroma.horizontalSampling ||
+            this->image.components[1].verticalSampling != chroma.verticalSampling ||
+            luma.horizontalSampling % chroma.horizontalSampling != 0 ||
+            luma.verticalSampling % chroma.verticalSampling != 0)) {
+            throw std::runtime_error("Error: unsupported sampling factors of the JPEG components");
+        }
+        for (size_t i = 0; i < numComponents; ++i) {
+            this->dc.emplace_back(parsed.dcTables[i]);
+            this->ac.emplace_back(parsed.acTables[i]);
+        }
+
+        // a band per restart segment, made of whole rows of MCUs
+        const size_t mcuRows = numComponents == 1 ? dct::algo::DCT_BLOCK_SIZE :
+            dct::algo::DCT_BLOCK_SIZE * luma.verticalSampling;
+        size_t rows, cols;
+        getComponentSize(this->image, numComponents - 1, rows, cols);
+        const size_t mcusPerRow = numComponents == 1 ? cols / dct::algo::DCT_BLOCK_SIZE :
+            cols / (dct::algo::DCT_BLOCK_SIZE * chroma.horizontalSampling);
+        if (this->image.restartInterval == 0) {
+            this->bandRows = this->image.height;
+        } else if (this->image.restartInterval % mcusPerRow == 0) {
+            this->bandRows = this->image.restartInterval / mcusPerRow * mcuRows;
+        } else {
+            throw std::runtime_error(
+                "Error: the streaming decoder needs restart segments of whole rows of MCUs. Given: " +
+                std::to_string(this->image.restartInterval) + " MCUs, " + std::to_string(mcusPerRow) + " per row"
+            );
+        }
+    }
+
+    size_t StreamDecoder::getWidth() const {
+        return this->image.width;
+    }
+
+    size_t StreamDecoder::getHeight() const {
+        return this->image.height;
+    }
+
+    int StreamDecoder::getChannels() const {
+        return static_cast<int>(this->image.components.size());
+    }
+
+    size_t StreamDecoder::getBandRows() const {
+        return this->bandRows;
+    }
+
+    void StreamDecoder::decode(RowSink& sink, const DCTMethod method) {
+        const size_t numBands = (this->image.height + this->bandRows - 1) / this->bandRows;
+        const size_t slots = getPipelineSlots();
+        std::vector<std::vector<uint8_t>> segments(slots);
+        std::vector<Plane<uint8_t>> pixels(slots);
+        const size_t rowBytes = this->image.width * this->image.components.size();
+
+        runBandPipeline(
+            numBands,
+            [&](const size_t, const size_t slot) {
+                read_segment(segments[slot]);
+            },
+            [&](const size_t band, const size_t slot) {
+                const size_t numRows = std::min(this->bandRows, this->image.height - band * this->bandRows);
+                if (pixels[slot].empty()) {
+                    pixels[slot] = Plane<uint8_t>(this->bandRows, rowBytes);
+                }
+                decode_band(segments[slot], numRows, method, pixels[slot]);
+            },
+            [&](const size_t band, const size_t slot) {
+                const size_t numRows = std::min(this->bandRows, this->image.height - band * this->bandRows);
+                sink.writeRows(pixels[slot].data(), pixels[slot].getPitch(), numRows);
+            }
+        );
+    }
+
+    void StreamDecoder::read_segment(std::vector<uint8_t>& segment) {
+        segment.clear();
+        std::streambuf* buffer = this->input.rdbuf();
+        constexpr int eof = std::char_traits<char>::eof();
+        while (true) {
+            int c = buffer->sbumpc();
+            if (c == eof) {
+                throw std::runtime_error("Error: the JPEG stream is truncated");
+            }
+            if (c != 0xFF) {
+                segment.push_back(static_cast<uint8_t>(c));
+                continue;
+            }
+            // 0xFF: stuffing (0x00), fill bytes, or the marker that ends the segment
+            do {
+                c = buffer->sbumpc();
+            } while (c == 0xFF);
+            if (c == eof) {
+                throw std::runtime_error("Error: the JPEG stream is truncated");
+            }
+            if (c == 0x00) {
+                segment.push_back(0xFF);
+                segment.push_back(0x00);
+                continue;
+            }
+            if (c >= RST0 && c <= RST7) {
+                return;
+            }
+            // EOI or another marker: the end of the scan, left for the BitReader as a marker
+            segment.push_back(0xFF);
+            segment.push_back(static_cast<uint8_t>(c));
+            return;
+        }
+    }
+
+    void StreamDecoder::decode_band(
+        const std::vector<uint8_t>& segment, const size_t numRows, const DCTMethod method, Plane<uint8_t>& rows
+    ) const {
+        const size_t numComponents = this->image.components.size();
+        JFIFImage stripe;
+        stripe.width = this->image.width;
+        stripe.height = numRows;
+        stripe.restartInterval = 0;
+        stripe.components.resize(numComponents);
+        for (size_t i = 0; i < numComponents; ++i) {
+            const JFIFComponent& component = this->image.components[i];
+            stripe.components[i].horizontalSampling = component.horizontalSampling;
+            stripe.components[i].verticalSampling = component.verticalSampling;
+        }
+        for (size_t i = 0; i < numComponents; ++i) {
+            size_t planeRows, planeCols;
+            getComponentSize(stripe, i, planeRows, planeCols);
+            stripe.components[i].coefficients = Plane<int16_t>(planeRows, planeCols);
+        }
+        decodeJFIFSegment(segment.data(), segment.size(), this->dc, this->ac, stripe);
+
+        // dequantization and inverse DCT of every component
+        Plane<uint8_t> planes[3];
+        for (size_t i = 0; i < numComponents; ++i) {
+            planes[i] = CompressedImage(std::move(stripe.components[i].coefficients), this->image.components[i].quantization)
+                .decompress(method).pixels;
+        }
+
+        // the rows of the band, cropped to the image
+        if (numComponents == 1) {
+            for (size_t r = 0; r < numRows; ++r) {
+                std::memcpy(rows.row(r), planes[0].row(r), stripe.width);
+            }
+        } else {
+            const JFIFComponent& luma = this->image.components[0];
+            const JFIFComponent& chroma = this->image.components[2];
+            Plane<uint8_t> view(rows.data(), numRows, 3 * stripe.width, rows.getPitch(), nullptr);
+            upsampleAndConvert(
+                planes[0], planes[1], planes[2],
+                luma.horizontalSampling / chroma.horizontalSampling, luma.verticalSampling / chroma.verticalSampling,
+                view
+            );
+        }
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef JPEG_STREAM_DECODER_HPP
+#define JPEG_STREAM_DECODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <vector>
+
+#include "compression/jpeg_image_compression/dct_method.hpp"
+#include "compression/jpeg_image_compression/huffman/huffman.hpp"
+#include "compression/jpeg_image_compression/jfif/jfif.hpp"
+#include "compression/jpeg_image_compression/streaming/row_stream.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Streaming JPEG decoder, the counterpart of StreamEncoder: the restart segments are read from the
+     * stream one at a time, and every one is decoded into a band of rows (grayscale or RGB) pushed to a
+     * RowSink, so the memory is bounded by a few bands (see runBandPipeline).
+     *
+     * The reads, the decoding of the bands (concurrent) and the writes are overlapped in a pipeline.
+     * A band is a restart segment, so the restart interval of the file must be a whole number of rows of
+     * MCUs (as the files of StreamEncoder, and of to_jpeg with restartRows > 0); a file without restart
+     * markers is decoded as a single band.
+     */
+    class StreamDecoder {
+    public:
+        /**
+         * Constructor that reads the headers of the file, up to the scan.
+         *
+         * @param input: the binary stream of the .jpg file (referenced, read by decode).
+         * @throws std::runtime_error if the headers are corrupted or not supported.
+         */
+        explicit StreamDecoder(std::istream& input);
+
+        /**
+         * Get the width of the image.
+         * @return The width, in pixels.
+         */
+        [[nodiscard]] size_t getWidth() const;
+
+        /**
+         * Get the height of the image.
+         * @return The height, in pixels.
+         */
+        [[nodiscard]] size_t getHeight() const;
+
+        /**
+         * Get the number of channels of the rows.
+         * @return: 1 for a grayscale file, 3 (RGB) for a YCbCr one.
+         */
+        [[nodiscard]] int getChannels() const;
+
+        /**
+         * Get the number of rows of a band (but the last one).
+         * @return: the rows of the MCUs of a restart segment.
+         */
+        [[nodiscard]] size_t getBandRows() const;
+
+        /**
+         * Function that decodes the scan and writes all the rows of the image to the sink.
+         *
+         * @param sink: the destination of the rows (width * channels bytes each).
+         * @param method: arithmetic of the dequantization and of the inverse DCT.
+         * @throws std::runtime_error if the file is corrupted or the rows cannot be written.
+         */
+        void decode(RowSink& sink, DCTMethod method = DCTMethod::FLOAT);
+
+    private:
+        std::istream& input;
+        /**
+         * The headers of the file (without coefficients) and the Huffman decoders of the components.
+         */
+        JFIFImage image;
+        std::vector<HuffmanDecoder> dc;
+        std::vector<HuffmanDecoder> ac;
+        size_t bandRows = 0;
+
+        /**
+         * Function that reads the next entropy-coded segment, up to its RSTn (or EOI) marker, excluded.
+         *
+         * @param segment: the bytes of the segment (output).
+         * @throws std::runtime_error if the stream ends before the marker.
+         */
+        void read_segment(std::vector<uint8_t>& segment);
+
+        /**
+         * Function that decodes a segment into the rows of its band.
+         *
+         * @param segment: the bytes of the segment.
+         * @param numRows: the number of rows of the band.
+         * @param method: arithmetic of the dequantization and of the inverse DCT.
+         * @param rows: the rows of the band (output).
+         */
+        void decode_band(const std::vector<uint8_t>& segment, size_t numRows, DCTMethod method, Plane<uint8_t>& rows) const;
+    };
+}
+
+#endif //JPEG_STREAM_DECODER_HPP
@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "compression/jpeg_image_compression/streaming/stream_encoder.hpp"
+#include "compression/jpeg_image_compression/color/color_conversion.hpp"
+#include "compression/jpeg_image_compression/compressed_image/compressed_image.hpp"
+#include "compression/jpeg_image_compression/image/image.hpp"
+#include "compression/jpeg_image_compression/streaming/band_pipeline.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * RST0, the first restart marker (ITU T.81, Table B.1).
+     */
+    constexpr uint8_t RST0 = 0xD0;
+
+    StreamEncoder::StreamEncoder(
+        const size_t width,
+        const size_t height,
+        const int channels,
+        const ChromaSubsampling subsampling,
+        const int quality,
+        const DCTMethod method
+    ): channels(channels), horizontal(1), vertical(1), method(method) {
+        if (channels != 1 && channels != 3) {
+            throw std::invalid_argument("The rows must have 1 or 3 channels. Given: " + std::to_string(channels));
+        }
+        if (channels == 3) {
+            if (subsampling == ChromaSubsampling::YUV422) {
+                this->horizontal = 2;
+            } else if (subsampling == ChromaSubsampling::YUV420) {
+                this->horizontal = 2;
+                this->vertical = 2;
+            }
+        }
+
+        this->image.width = width;
+        this->image.height = height;
+        this->image.components.resize(channels);
+        for (int i = 0; i < channels; ++i) {
+            JFIFComponent& component = this->image.components[i];
+            component.horizontalSampling = i == 0 ? this->horizontal : 1;
+            component.verticalSampling = i == 0 ? this->vertical : 1;
+            const QuantizationTable& table = getQuantizationTable(quality, i > 0);
+            std::memcpy(component.quantization, table.quantization, sizeof(component.quantization));
+        }
+
+        // a restart segment per row of MCUs (a chroma block per MCU, or a block for grayscale)
+        size_t rows, cols;
+        getComponentSize(this->image, channels - 1, rows, cols);
+        this->image.restartInterval = cols / dct::algo::DCT_BLOCK_SIZE;
+    }
+
+    size_t StreamEncoder::getBandRows() const {
+        return dct::algo::DCT_BLOCK_SIZE * this->vertical;
+    }
+
+    void StreamEncoder::encode(RowSource& source, std::ostream& output) const {
+        const std::vector<uint8_t> headers = writeJFIFHeaders(this->image);
+        output.write(reinterpret_cast<const char*>(headers.data()), static_cast<std::streamsize>(headers.size()));
+
+        const size_t bandRows = getBandRows();
+        const size_t numBands = (this->image.height + bandRows - 1) / bandRows;
+        const size_t slots = getPipelineSlots();
+        std::vector<Plane<uint8_t>> pixels(slots);
+        std::vector<std::vector<uint8_t>> segments(slots);
+
+        runBandPipeline(
+            numBands,
+            [&](const size_t band, const size_t slot) {
+                if (pixels[slot].empty()) {
+                    pixels[slot] = Plane<uint8_t>(bandRows, this->image.width * this->channels);
+                }
+                const size_t numRows = std::min(bandRows, this->image.height - band * bandRows);
+                source.readRows(pixels[slot].data(), pixels[slot].getPitch(), numRows);
+            },
+            [&](const size_t band, const size_t slot) {
+                const size_t numRows = std::min(bandRows, this->image.height - band * bandRows);
+                segments[slot].clear();
+                compress_band(pixels[slot], numRows, segments[slot]);
+                if (band + 1 < numBands) {
+                    segments[slot].push_back(0xFF);
+                    segments[slot].push_back(static_cast<uint8_t>(RST0 + band % 8));
+                }
+            },
+            [&](const size_t, const size_t slot) {
+                output.write(
+                    reinterpret_cast<const char*>(segments[slot].data()), static_cast<std::streamsize>(segments[slot].size())
+                );
+                if (!output) {
+                    throw std::runtime_error("Error: could not write the JPEG stream");
+                }
+            }
+        );
+
+        const uint8_t eoi[2] = {0xFF, 0xD9};
+        output.write(reinterpret_cast<const char*>(eoi), 2);
+        if (!output) {
+            throw std::runtime_error("Error: could not write the JPEG stream");
+        }
+    }
+
+    void StreamEncoder::compress_band(
+        const Plane<uint8_t>& rows, const size_t numRows, std::vector<uint8_t>& output
+    ) const {
+        // the band is a stripe of the image: one row of MCUs with the same components
+        JFIFImage stripe;
+        stripe.width = this->image.width;
+        stripe.height = numRows;
+        stripe.restartInterval = 0;
+        stripe.components.resize(this->channels);
+        for (int i = 0; i < this->channels; ++i) {
+            const JFIFComponent& component = this->image.components[i];
+            stripe.components[i].horizontalSampling = component.horizontalSampling;
+            stripe.components[i].verticalSampling = component.verticalSampling;
+            std::memcpy(stripe.components[i].quantization, component.quantization, sizeof(component.quantization));
+        }
+        Plane<uint8_t> planes[3];
+        for (int i = 0; i < this->channels; ++i) {
+            size_t planeRows, planeCols;
+            getComponentSize(stripe, i, planeRows, planeCols);
+            planes[i] = Plane<uint8_t>(planeRows, planeCols);
+        }
+
+        if (this->channels == 3) {
+            convertAndDownsample(
+                rows, stripe.width, numRows, this->horizontal, this->vertical, planes[0], planes[1], planes[2]
+            );
+        } else {
+            // the padding replicates the last column and row of the image
+            const size_t cols = planes[0].getCols();
+            for (size_t r = 0; r < planes[0].getRows(); ++r) {
+                uint8_t* row = planes[0].row(r);
+                std::memcpy(row, rows.row(std::min(r, numRows - 1)), stripe.width);
+                std::fill(row + stripe.width, row + cols, row[stripe.width - 1]);
+            }
+        }
+
+        for (int i = 0; i < this->channels; ++i) {
+            JFIFComponent& component = stripe.components[i];
+            component.coefficients = Image(std::move(planes[i])).compress(this->method, component.quantization).compressed;
+        }
+        writeJFIFSegment(stripe, output);
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef JPEG_STREAM_ENCODER_HPP
+#define JPEG_STREAM_ENCODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "compression/jpeg_image_compression/chroma_subsampling.hpp"
+#include "compression/jpeg_image_compression/dct_method.hpp"
+#include "compression/jpeg_image_compression/jfif/jfif.hpp"
+#include "compression/jpeg_image_compression/quantization/quantization.hpp"
+#include "compression/jpeg_image_compression/streaming/row_stream.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Streaming JPEG encoder for images larger than memory: the rows are pulled from a RowSource one band
+     * (a row of MCUs: 8 rows, 16 for 4:2:0) at a time, every band is compressed on its own and appended
+     * to the file as a restart segment, so the memory is bounded by a few bands (see runBandPipeline).
+     *
+     * The reads, the compression of the bands (concurrent) and the writes are overlapped in a pipeline.
+     * The file is a baseline JFIF file with the standard Huffman tables (the optimized ones would need
+     * the whole image) and a restart interval of one row of MCUs, so it can be decoded a band at a time
+     * by StreamDecoder, and concurrently by readJFIF.
+     */
+    class StreamEncoder {
+    public:
+        /**
+         * Constructor that describes the file.
+         *
+         * @param width: width of the image, in pixels (at most 65535).
+         * @param height: height of the image, in pixels (at most 65535).
+         * @param channels: 1 (grayscale rows) or 3 (RGB rows, coded as YCbCr).
+         * @param subsampling: resolution of the chroma (ignored for grayscale).
+         * @param quality: the quality, from 1 to 100 (see getQuantizationTable).
+         * @param method: arithmetic of the DCT and of the quantization (floating-point or fixed-point).
+         * @throws std::invalid_argument if the sizes, the channels or the quality are not valid.
+         */
+        StreamEncoder(
+            size_t width,
+            size_t height,
+            int channels,
+            ChromaSubsampling subsampling = ChromaSubsampling::YUV420,
+            int quality = DEFAULT_QUALITY,
+            DCTMethod method = DCTMethod::FLOAT
+        );
+
+        /**
+         * Get the number of rows of a band.
+         * @return: 8 * the vertical sampling factor of the luma.
+         */
+        [[nodiscard]] size_t getBandRows() const;
+
+        /**
+         * Function that reads all the rows of the source and writes the .jpg file to the output.
+         *
+         * @param source: the rows of the image (width * channels bytes each).
+         * @param output: the binary stream of the file.
+         * @throws std::runtime_error if the rows cannot be read or the file cannot be written.
+         */
+        void encode(RowSource& source, std::ostream& output) const;
+
+    private:
+        /**
+         * The headers of the file: sizes, components and restart interval (without coefficients).
+         */
+        JFIFImage image;
+        int channels;
+        int horizontal;
+        int vertical;
+        DCTMethod method;
+
+        /**
+         * Function that compresses a band and codes it as an entropy-coded segment.
+         *
+         * @param rows: the rows of the band (the last band can have fewer rows).
+         * @param numRows: the number of rows of the band.
+         * @param output: the buffer where the segment is appended.
+         */
+        void compress_band(const Plane<uint8_t>& rows, size_t numRows, std::vector<uint8_t>& output) const;
+    };
+}
+
+#endif //JPEG_STREAM_ENCODER_HPP
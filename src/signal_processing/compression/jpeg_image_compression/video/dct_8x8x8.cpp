@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cmath>
+#include <omp.h>
+#include <stdexcept>
+#include <string>
+
+#include "compression/jpeg_image_compression/video/dct_8x8x8.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_8x8.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_basis.hpp"
+
+namespace sp::jpeg
+{
+    constexpr size_t BLOCK = dct::algo::DCT_BLOCK_SIZE;
+    constexpr size_t AREA = dct::algo::DCT_BLOCK_AREA;
+    constexpr size_t DEPTH = TEMPORAL_BLOCK_SIZE;
+
+    /**
+     * Check that the planes of a temporal block have the same sizes, multiples of 8.
+     */
+    template <typename T>
+    static void checkPlanes(const Plane<T>* planes, const size_t rows, const size_t cols) {
+        for (size_t t = 0; t < DEPTH; ++t) {
+            if (planes[t].getRows() != rows || planes[t].getCols() != cols || rows % BLOCK != 0 || cols % BLOCK != 0) {
+                throw std::invalid_argument(
+                    "The planes of a temporal block must have the same sizes, multiples of 8. Given: " +
+                    std::to_string(planes[t].getCols()) + "x" + std::to_string(planes[t].getRows()) + " and " +
+                    std::to_string(cols) + "x" + std::to_string(rows)
+                );
+            }
+        }
+    }
+
+    void makeTemporalQuantization(const double* quantization, const size_t frequency, double* output) {
+        if (frequency >= DEPTH) {
+            throw std::invalid_argument(
+                "The temporal frequency must be in [0, 7]. Given: " + std::to_string(frequency)
+            );
+        }
+        const double scale = std::sqrt(static_cast<double>(DEPTH)) * static_cast<double>(2 + frequency) / 2.0;
+        for (size_t k = 0; k < AREA; ++k) {
+            output[k] = std::min(
+                MAX_TEMPORAL_QUANTIZATION, std::max(MIN_TEMPORAL_QUANTIZATION, std::round(quantization[k] * scale))
+            );
+        }
+    }
+
+    void compressTemporalBlock(
+        const Plane<uint8_t>* frames,
+        const double* const* quantization,
+        Plane<int16_t>* coefficients
+    ) {
+        const size_t rows = frames[0].getRows();
+        const size_t cols = frames[0].getCols();
+        checkPlanes(frames, rows, cols);
+        checkPlanes(coefficients, rows, cols);
+
+        // C[k][n], row-major: the temporal DCT-II is X[k] = sum_n C[k][n] x[n]
+        const auto basis = dct::algo::DCTBasisCache::global().get(DEPTH);
+        const double* cosines = basis->data();
+        double reciprocals[DEPTH][AREA];
+        for (size_t t = 0; t < DEPTH; ++t) {
+            for (size_t k = 0; k < AREA; ++k) {
+                reciprocals[t][k] = 1.0 / quantization[t][k];
+            }
+        }
+
+        const auto blockRows = static_cast<long>(rows / BLOCK);
+        #pragma omp parallel for schedule(static) if(!omp_in_parallel())
+        for (long br = 0; br < blockRows; ++br) {
+            double volume[DEPTH][AREA];
+            double spectrum[DEPTH][AREA];
+            const size_t r = static_cast<size_t>(br) * BLOCK;
+            for (size_t c = 0; c < cols; c += BLOCK) {
+                // 2D DCT of the block of every frame
+                for (size_t t = 0; t < DEPTH; ++t) {
+                    for (size_t i = 0; i < BLOCK; ++i) {
+                        const uint8_t* row = frames[t].row(r + i) + c;
+                        for (size_t j = 0; j < BLOCK; ++j) {
+                            volume[t][i * BLOCK + j] = static_cast<double>(row[j]) - 128.0;
+                        }
+                    }
+                    dct::algo::computeDCT8x8(volume[t]);
+                }
+
+                // 1D DCT along the time of the 64 coefficients at once, then quantization
+                for (size_t k = 0; k < DEPTH; ++k) {
+                    double* output = spectrum[k];
+                    std::fill(output, output + AREA, 0.0);
+                    for (size_t n = 0; n < DEPTH; ++n) {
+                        const double weight = cosines[k * DEPTH + n];
+                        #pragma omp simd
+                        for (size_t i = 0; i < AREA; ++i) {
+                            output[i] += weight * volume[n][i];
+                        }
+                    }
+                    for (size_t i = 0; i < BLOCK; ++i) {
+                        int16_t* row = coefficients[k].row(r + i) + c;
+                        for (size_t j = 0; j < BLOCK; ++j) {
+                            row[j] = static_cast<int16_t>(std::lround(output[i * BLOCK + j] * reciprocals[k][i * BLOCK + j]));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void decompressTemporalBlock(
+        const Plane<int16_t>* coefficients,
+        const double* const* quantization,
+        Plane<uint8_t>* frames
+    ) {
+        const size_t rows = coefficients[0].getRows();
+        const size_t cols = coefficients[0].getCols();
+        checkPlanes(coefficients, rows, cols);
+        checkPlanes(frames, rows, cols);
+
+        const auto basis = dct::algo::DCTBasisCache::global().get(DEPTH);
+        const double* cosines = basis->data();
+
+        const auto blockRows = static_cast<long>(rows / BLOCK);
+        #pragma omp parallel for schedule(static) if(!omp_in_parallel())
+        for (long br = 0; br < blockRows; ++br) {
+            double spectrum[DEPTH][AREA];
+            double volume[DEPTH][AREA];
+            const size_t r = static_cast<size_t>(br) * BLOCK;
+            for (size_t c = 0; c < cols; c += BLOCK) {
+                // dequantization
+                for (size_t k = 0; k < DEPTH; ++k) {
+                    for (size_t i = 0; i < BLOCK; ++i) {
+                        const int16_t* row = coefficients[k].row(r + i) + c;
+                        for (size_t j = 0; j < BLOCK; ++j) {
+                            spectrum[k][i * BLOCK + j] = row[j] * quantization[k][i * BLOCK + j];
+                        }
+                    }
+                }
+
+                // 1D inverse DCT along the time (x[n] = sum_k C[k][n] X[k]), then inverse 2D DCT of every frame
+                for (size_t n = 0; n < DEPTH; ++n) {
+                    double* output = volume[n];
+                    std::fill(output, output + AREA, 0.0);
+                    for (size_t k = 0; k < DEPTH; ++k) {
+                        const double weight = cosines[k * DEPTH + n];
+                        #pragma omp simd
+                        for (size_t i = 0; i < AREA; ++i) {
+                            output[i] += weight * spectrum[k][i];
+                        }
+                    }
+                    dct::algo::computeIDCT8x8(output);
+                    for (size_t i = 0; i < BLOCK; ++i) {
+                        uint8_t* row = frames[n].row(r + i) + c;
+                        for (size_t j = 0; j < BLOCK; ++j) {
+                            const double value = std::round(output[i * BLOCK + j] + 128.0);
+                            row[j] = static_cast<uint8_t>(std::min(255.0, std::max(0.0, value)));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef JPEG_DCT_8X8X8_HPP
+#define JPEG_DCT_8X8X8_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "compression/jpeg_image_compression/plane/plane.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Number of frames of a temporal block: the depth of the 8x8x8 blocks of the 3D DCT.
+     */
+    constexpr size_t TEMPORAL_BLOCK_SIZE = 8;
+
+    /**
+     * Smallest entry of a temporal quantization matrix. The orthonormal 3D DCT of 8-bit samples reaches
+     * 8 * sqrt(8) * 128 = 2896, so every coefficient, and every difference of two DC ones, stays in the
+     * 11 bits of the baseline Huffman coding.
+     */
+    constexpr double MIN_TEMPORAL_QUANTIZATION = 3.0;
+
+    /**
+     * Largest entry of a temporal quantization matrix: the tables are written as 8-bit DQT entries (Pq = 0),
+     * the only precision allowed with the 8-bit samples of a baseline frame (ITU T.81, B.2.4.1).
+     */
+    constexpr double MAX_TEMPORAL_QUANTIZATION = 255.0;
+
+    /**
+     * Function that builds the quantization matrix of a temporal frequency from a JPEG one.
+     * The orthonormal temporal DCT puts sqrt(8) times the mean of the 8 blocks in the plane 0, so the entries are
+     * scaled by sqrt(8): the static content is quantized as by MJPEG at the same quality. They are also scaled
+     * by (2 + frequency) / 2, so the coefficients of the changes between the frames (frequency > 0) are quantized
+     * more coarsely than the static content (frequency 0).
+     * The entries are rounded and clamped to [MIN_TEMPORAL_QUANTIZATION, MAX_TEMPORAL_QUANTIZATION], so every
+     * file of a temporal frequency is a baseline JFIF file.
+     *
+     * @param quantization: the 64 entries of the JPEG quantization matrix, row-major.
+     * @param frequency: the temporal frequency, from 0 to 7.
+     * @param output: the 64 entries of the matrix of the frequency (output).
+     * @throws std::invalid_argument if the frequency is not valid.
+     */
+    void makeTemporalQuantization(const double* quantization, size_t frequency, double* output);
+
+    /**
+     * Function that compresses a temporal block of frames with the 8x8x8 3D DCT: every 8x8 block of the
+     * frames, level shifted, is transformed by the fast 8x8 DCT, then the 8 blocks at the same position by
+     * an orthonormal 8-point DCT along the time; the coefficient of the temporal frequency t goes, quantized
+     * by quantization[t], to the plane t, at the position of the block. The rows of blocks are concurrent.
+     *
+     * On static footage, the energy of the 8 frames is in the plane 0, and the planes of the higher
+     * frequencies are almost all zero, so they cost a few bits each once entropy coded.
+     *
+     * @param frames: the TEMPORAL_BLOCK_SIZE planes of the frames, with the same sizes (multiples of 8).
+     * @param quantization: the quantization matrix of every temporal frequency (see makeTemporalQuantization).
+     * @param coefficients: the TEMPORAL_BLOCK_SIZE planes of the quantized coefficients, with the sizes of
+     *                      the frames (output, allocated).
+     * @throws std::invalid_argument if the sizes of the planes are not valid.
+     */
+    void compressTemporalBlock(
+        const Plane<uint8_t>* frames,
+        const double* const* quantization,
+        Plane<int16_t>* coefficients
+    );
+
+    /**
+     * Function that decompresses a temporal block of frames (the inverse of compressTemporalBlock):
+     * dequantization, inverse DCT along the time, inverse 8x8 DCT, level shift and clamping to [0, 255].
+     *
+     * @param coefficients: the TEMPORAL_BLOCK_SIZE planes of the quantized coefficients, with the same sizes.
+     * @param quantization: the quantization matrix of every temporal frequency.
+     * @param frames: the TEMPORAL_BLOCK_SIZE planes of the frames, with the sizes of the coefficients
+     *                (output, allocated).
+     * @throws std::invalid_argument if the sizes of the planes are not valid.
+     */
+    void decompressTemporalBlock(
+        const Plane<int16_t>* coefficients,
+        const double* const* quantization,
+        Plane<uint8_t>* frames
+    );
+}
+
+#endif //JPEG_DCT_8X8X8_HPP
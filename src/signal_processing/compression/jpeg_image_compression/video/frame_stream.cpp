@@ -0,0 +1,72 @@
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "compression/jpeg_image_compression/video/frame_stream.hpp"
+
+namespace sp::jpeg
+{
+    static void checkChannels(const int channels) {
+        if (channels != 1 && channels != 3) {
+            throw std::invalid_argument("The frames must have 1 or 3 channels. Given: " + std::to_string(channels));
+        }
+    }
+
+    // #################### PLANES ####################
+
+    PlaneFrameSource::PlaneFrameSource(const std::vector<Plane<uint8_t>>& frames): frames(frames) {}
+
+    void PlaneFrameSource::readFrame(uint8_t* pixels, const size_t pitch) {
+        if (this->position >= this->frames.size()) {
+            throw std::runtime_error(
+                "Error: cannot read the frame " + std::to_string(this->position) + " of " +
+                std::to_string(this->frames.size())
+            );
+        }
+        const Plane<uint8_t>& frame = this->frames[this->position++];
+        for (size_t r = 0; r < frame.getRows(); ++r) {
+            std::memcpy(pixels + r * pitch, frame.row(r), frame.getCols());
+        }
+    }
+
+    PlaneFrameSink::PlaneFrameSink(std::vector<Plane<uint8_t>>& frames, const size_t rows, const size_t cols):
+        frames(frames), rows(rows), cols(cols) {}
+
+    void PlaneFrameSink::writeFrame(const uint8_t* pixels, const size_t pitch) {
+        Plane<uint8_t> frame(this->rows, this->cols);
+        for (size_t r = 0; r < this->rows; ++r) {
+            std::memcpy(frame.row(r), pixels + r * pitch, this->cols);
+        }
+        this->frames.push_back(std::move(frame));
+    }
+
+    // #################### RAW STREAMS ####################
+
+    RawFrameReader::RawFrameReader(std::istream& stream, const size_t width, const size_t height, const int channels):
+        stream(stream), rowBytes(width * channels), height(height) {
+        checkChannels(channels);
+    }
+
+    void RawFrameReader::readFrame(uint8_t* pixels, const size_t pitch) {
+        for (size_t r = 0; r < this->height; ++r) {
+            this->stream.read(reinterpret_cast<char*>(pixels + r * pitch), static_cast<std::streamsize>(this->rowBytes));
+        }
+        if (!this->stream) {
+            throw std::runtime_error("Error: the raw video stream ended in the middle of a frame");
+        }
+    }
+
+    RawFrameWriter::RawFrameWriter(std::ostream& stream, const size_t width, const size_t height, const int channels):
+        stream(stream), rowBytes(width * channels), height(height) {
+        checkChannels(channels);
+    }
+
+    void RawFrameWriter::writeFrame(const uint8_t* pixels, const size_t pitch) {
+        for (size_t r = 0; r < this->height; ++r) {
+            this->stream.write(reinterpret_cast<const char*>(pixels + r * pitch), static_cast<std::streamsize>(this->rowBytes));
+        }
+        if (!this->stream) {
+            throw std::runtime_error("Error: could not write the raw video stream");
+        }
+    }
+}
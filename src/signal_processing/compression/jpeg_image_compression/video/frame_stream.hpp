@@ -0,0 +1,132 @@
+#ifndef JPEG_FRAME_STREAM_HPP
+#define JPEG_FRAME_STREAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "compression/jpeg_image_compression/plane/plane.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Sequential source of the frames of a video (interleaved samples, channels bytes per pixel), from the first:
+     * the video encoder pulls the frames of its window only, so the clip is never whole in memory.
+     */
+    class FrameSource {
+    public:
+        virtual ~FrameSource() = default;
+
+        /**
+         * Function that reads the next frame of the video.
+         *
+         * @param pixels: pointer to the first row of the frame (output).
+         * @param pitch: distance in bytes between two rows.
+         * @throws std::runtime_error if the frame cannot be read.
+         */
+        virtual void readFrame(uint8_t* pixels, size_t pitch) = 0;
+    };
+
+    /**
+     * Sequential destination of the frames of a video (interleaved samples, channels bytes per pixel), from the first.
+     */
+    class FrameSink {
+    public:
+        virtual ~FrameSink() = default;
+
+        /**
+         * Function that writes the next frame of the video.
+         *
+         * @param pixels: pointer to the first row of the frame.
+         * @param pitch: distance in bytes between two rows.
+         * @throws std::runtime_error if the frame cannot be written.
+         */
+        virtual void writeFrame(const uint8_t* pixels, size_t pitch) = 0;
+    };
+
+    /**
+     * Frames of planes in memory.
+     */
+    class PlaneFrameSource : public FrameSource {
+    public:
+        /**
+         * @param frames: the frames of the video, with the same sizes (referenced, not copied).
+         */
+        explicit PlaneFrameSource(const std::vector<Plane<uint8_t>>& frames);
+
+        void readFrame(uint8_t* pixels, size_t pitch) override;
+
+    private:
+        const std::vector<Plane<uint8_t>>& frames;
+        size_t position = 0;
+    };
+
+    /**
+     * Frames appended as planes in memory.
+     */
+    class PlaneFrameSink : public FrameSink {
+    public:
+        /**
+         * @param frames: the vector where the frames are appended (referenced, not copied).
+         * @param rows: number of rows of a frame.
+         * @param cols: number of columns of a frame (width * channels).
+         */
+        PlaneFrameSink(std::vector<Plane<uint8_t>>& frames, size_t rows, size_t cols);
+
+        void writeFrame(const uint8_t* pixels, size_t pitch) override;
+
+    private:
+        std::vector<Plane<uint8_t>>& frames;
+        size_t rows;
+        size_t cols;
+    };
+
+    /**
+     * Frames of a raw video stream: the rows of the frames one after another, without headers
+     * (e.g. the output of ffmpeg -f rawvideo -pix_fmt gray or rgb24).
+     */
+    class RawFrameReader : public FrameSource {
+    public:
+        /**
+         * @param stream: the binary stream of the frames (referenced).
+         * @param width: width of a frame, in pixels.
+         * @param height: height of a frame, in pixels.
+         * @param channels: 1 (gray) or 3 (RGB).
+         * @throws std::invalid_argument if the number of channels is not valid.
+         */
+        RawFrameReader(std::istream& stream, size_t width, size_t height, int channels);
+
+        void readFrame(uint8_t* pixels, size_t pitch) override;
+
+    private:
+        std::istream& stream;
+        size_t rowBytes;
+        size_t height;
+    };
+
+    /**
+     * Frames written as a raw video stream (see RawFrameReader).
+     */
+    class RawFrameWriter : public FrameSink {
+    public:
+        /**
+         * @param stream: the binary stream of the frames (referenced).
+         * @param width: width of a frame, in pixels.
+         * @param height: height of a frame, in pixels.
+         * @param channels: 1 (gray) or 3 (RGB).
+         * @throws std::invalid_argument if the number of channels is not valid.
+         */
+        RawFrameWriter(std::ostream& stream, size_t width, size_t height, int channels);
+
+        void writeFrame(const uint8_t* pixels, size_t pitch) override;
+
+    private:
+        std::ostream& stream;
+        size_t rowBytes;
+        size_t height;
+    };
+}
+
+#endif //JPEG_FRAME_STREAM_HPP
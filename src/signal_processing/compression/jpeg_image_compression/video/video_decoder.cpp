@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "compression/jpeg_image_compression/video/video_decoder.hpp"
+#include "compression/jpeg_image_compression/color/color_conversion.hpp"
+#include "compression/jpeg_image_compression/color_image/color_image.hpp"
+#include "compression/jpeg_image_compression/jfif/jfif.hpp"
+#include "compression/jpeg_image_compression/streaming/band_pipeline.hpp"
+#include "compression/jpeg_image_compression/video/dct_8x8x8.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Markers of the beginning and of the end of a JPEG file, and the first restart marker (ITU T.81, Table B.1).
+     */
+    constexpr uint8_t SOI = 0xD8;
+    constexpr uint8_t EOI = 0xD9;
+    constexpr uint8_t RST0 = 0xD0;
+
+    size_t findJPEGEnd(const uint8_t* data, const size_t size) {
+        JFIFHeaders headers;
+        size_t position = readJFIFHeaders(data, size, headers);
+        while (position + 1 < size) {
+            const auto* next = static_cast<const uint8_t*>(std::memchr(data + position, 0xFF, size - position - 1));
+            if (next == nullptr) {
+                break;
+            }
+            position = static_cast<size_t>(next - data);
+            const uint8_t marker = data[position + 1];
+            if (marker == EOI) {
+                return position + 2;
+            }
+            if (marker == 0xFF) {
+                // fill byte before a marker
+                ++position;
+            } else if (marker == 0x00 || (marker >= RST0 && marker < RST0 + 8)) {
+                // stuffed 0xFF of the coded data, or restart marker
+                position += 2;
+            } else {
+                throw std::runtime_error(
+                    "Error: unexpected marker 0xFF" + std::to_string(marker) + " in the scan of a JPEG file "
+                    "(only single-scan files are supported)"
+                );
+            }
+        }
+        throw std::runtime_error("Error: the JPEG file is truncated (EOI marker not found)");
+    }
+
+    // #################### CONSTRUCTORS ####################
+
+    VideoDecoder::VideoDecoder(const std::string& path):
+        source(std::make_shared<const utils::io::MappedFile>(path)), data(source->data()), size(source->size()) {
+        index_stream();
+    }
+
+    VideoDecoder::VideoDecoder(const uint8_t* data, const size_t size): data(data), size(size) {
+        index_stream();
+    }
+
+    // #################### PUBLIC ####################
+
+    VideoCodec VideoDecoder::getCodec() const {
+        return this->codec;
+    }
+
+    size_t VideoDecoder::getWidth() const {
+        return this->width;
+    }
+
+    size_t VideoDecoder::getHeight() const {
+        return this->height;
+    }
+
+    int VideoDecoder::getChannels() const {
+        return this->channels;
+    }
+
+    size_t VideoDecoder::getFrameCount() const {
+        return this->frameCount;
+    }
+
+    void VideoDecoder::decode(FrameSink& sink, const DCTMethod method) const {
+        const bool temporal = this->codec == VideoCodec::DCT3D;
+        const size_t depth = temporal ? TEMPORAL_BLOCK_SIZE : 1;
+        const size_t numUnits = (this->frameCount + depth - 1) / depth;
+        const size_t slots = getPipelineSlots();
+        std::vector<Plane<uint8_t>> frames(slots * depth);
+
+        runBandPipeline(
+            numUnits,
+            [](const size_t, const size_t) {
+                // the stream is in memory, the files are read by the decoding
+            },
+            [&](const size_t unit, const size_t slot) {
+                Plane<uint8_t>* window = frames.data() + slot * depth;
+                if (temporal) {
+                    for (size_t i = 0; i < depth; ++i) {
+                        if (window[i].empty()) {
+                            window[i] = Plane<uint8_t>(this->height, this->width * this->channels);
+                        }
+                    }
+                    decode_temporal_block(unit, window);
+                } else {
+                    window[0] = decode_frame(unit, method);
+                }
+            },
+            [&](const size_t unit, const size_t slot) {
+                const Plane<uint8_t>* window = frames.data() + slot * depth;
+                const size_t count = std::min(depth, this->frameCount - unit * depth);
+                for (size_t i = 0; i < count; ++i) {
+                    sink.writeFrame(window[i].data(), window[i].getPitch());
+                }
+            }
+        );
+    }
+
+    Plane<uint8_t> VideoDecoder::decode_frame(const size_t index, const DCTMethod method) const {
+        if (index >= this->frameCount) {
+            throw std::out_of_range(
+                "Error: frame " + std::to_string(index) + " of a video of " + std::to_string(this->frameCount) + " frames"
+            );
+        }
+        if (this->codec == VideoCodec::DCT3D) {
+            std::vector<Plane<uint8_t>> window(TEMPORAL_BLOCK_SIZE);
+            for (Plane<uint8_t>& frame : window) {
+                frame = Plane<uint8_t>(this->height, this->width * this->channels);
+            }
+            decode_temporal_block(index / TEMPORAL_BLOCK_SIZE, window.data());
+            return std::move(window[index % TEMPORAL_BLOCK_SIZE]);
+        }
+
+        const std::pair<size_t, size_t>& file = this->files[index];
+        Plane<uint8_t> frame = decodeJPEG(this->data + file.first, file.second, this->channels, method);
+        if (frame.getRows() != this->height || frame.getCols() != this->width * this->channels) {
+            throw std::runtime_error("Error: the frame " + std::to_string(index) + " has different sizes");
+        }
+        return frame;
+    }
+
+    // #################### PRIVATE ####################
+
+    void VideoDecoder::index_stream() {
+        if (this->size >= sizeof(VIDEO_3D_MAGIC) && std::memcmp(this->data, VIDEO_3D_MAGIC, sizeof(VIDEO_3D_MAGIC)) == 0) {
+            this->codec = VideoCodec::DCT3D;
+            utils::io::ByteCursor cursor(this->data, this->size);
+            cursor.take(sizeof(VIDEO_3D_MAGIC));
+            this->width = cursor.read<uint32_t>();
+            this->height = cursor.read<uint32_t>();
+            this->frameCount = cursor.read<uint32_t>();
+            this->channels = static_cast<int>(cursor.read<uint32_t>());
+            if (this->width == 0 || this->height == 0 || this->frameCount == 0 ||
+                (this->channels != 1 && this->channels != 3)) {
+                throw std::runtime_error("Error: corrupted header of the 3D DCT stream");
+            }
+
+            // the length-prefixed files of every temporal frequency of every temporal block
+            const size_t numFiles = (this->frameCount + TEMPORAL_BLOCK_SIZE - 1) / TEMPORAL_BLOCK_SIZE * TEMPORAL_BLOCK_SIZE;
+            this->files.reserve(numFiles);
+            for (size_t i = 0; i < numFiles; ++i) {
+                const size_t length = cursor.read<uint32_t>();
+                const size_t offset = cursor.getPosition();
+                cursor.take(length);
+                this->files.emplace_back(offset, length);
+            }
+            return;
+        }
+
+        if (this->size < 2 || this->data[0] != 0xFF || this->data[1] != SOI) {
+            throw std::runtime_error("Error: the stream is neither a MJPEG nor a 3D DCT video");
+        }
+        this->codec = VideoCodec::MJPEG;
+        for (size_t offset = 0; offset < this->size;) {
+            const size_t length = findJPEGEnd(this->data + offset, this->size - offset);
+
+            // every frame must have the sizes and the components of the first one
+            JFIFHeaders headers;
+            readJFIFHeaders(this->data + offset, length, headers);
+            const size_t numComponents = headers.image.components.size();
+            if (this->files.empty()) {
+                this->width = headers.image.width;
+                this->height = headers.image.height;
+                this->channels = numComponents == 1 ? 1 : 3;
+            } else if (headers.image.width != this->width || headers.image.height != this->height ||
+                       numComponents != static_cast<size_t>(this->channels)) {
+                throw std::runtime_error(
+                    "Error: the frame " + std::to_string(this->files.size()) + " of the MJPEG stream has different sizes"
+                );
+            }
+            this->files.emplace_back(offset, length);
+            offset += length;
+        }
+        this->frameCount = this->files.size();
+    }
+
+    void VideoDecoder::decode_temporal_block(const size_t block, Plane<uint8_t>* frames) const {
+        constexpr size_t depth = TEMPORAL_BLOCK_SIZE;
+        const auto numComponents = static_cast<size_t>(this->channels);
+
+        // the coefficients of every temporal frequency
+        std::vector<JFIFImage> images(depth);
+        for (size_t t = 0; t < depth; ++t) {
+            const std::pair<size_t, size_t>& file = this->files[block * depth + t];
+            images[t] = readJFIF(this->data + file.first, file.second);
+            if (images[t].width != this->width || images[t].height != this->height ||
+                images[t].components.size() != numComponents) {
+                throw std::runtime_error(
+                    "Error: the temporal block " + std::to_string(block) + " has different sizes or components"
+                );
+            }
+        }
+
+        // 3D inverse transform of every component
+        std::vector<Plane<uint8_t>> planes(numComponents * depth);
+        for (size_t i = 0; i < numComponents; ++i) {
+            const double* quantization[depth];
+            Plane<int16_t> coefficients[depth];
+            for (size_t t = 0; t < depth; ++t) {
+                JFIFComponent& component = images[t].components[i];
+                quantization[t] = component.quantization;
+                coefficients[t] = std::move(component.coefficients);
+                planes[i * depth + t] = Plane<uint8_t>(coefficients[t].getRows(), coefficients[t].getCols());
+            }
+            decompressTemporalBlock(coefficients, quantization, planes.data() + i * depth);
+        }
+
+        for (size_t t = 0; t < depth; ++t) {
+            if (numComponents == 3) {
+                const JFIFComponent& luma = images[0].components[0];
+                const JFIFComponent& chroma = images[0].components[1];
+                upsampleAndConvert(
+                    planes[t], planes[depth + t], planes[2 * depth + t],
+                    luma.horizontalSampling / chroma.horizontalSampling,
+                    luma.verticalSampling / chroma.verticalSampling,
+                    frames[t]
+                );
+            } else {
+                for (size_t r = 0; r < this->height; ++r) {
+                    std::memcpy(frames[t].row(r), planes[t].row(r), this->width);
+                }
+            }
+        }
+    }
+}
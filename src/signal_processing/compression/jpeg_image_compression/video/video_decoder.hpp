@@ -0,0 +1,123 @@
+#ifndef JPEG_VIDEO_DECODER_HPP
+#define JPEG_VIDEO_DECODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "compression/jpeg_image_compression/dct_method.hpp"
+#include "compression/jpeg_image_compression/plane/plane.hpp"
+#include "compression/jpeg_image_compression/video/frame_stream.hpp"
+#include "compression/jpeg_image_compression/video/video_encoder.hpp"
+#include "utils/mapped_file.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Function that finds the end of a JPEG file at the beginning of a stream of concatenated files (MJPEG):
+     * the headers are parsed up to the scan (see readJFIFHeaders), then the entropy-coded data is searched
+     * for the EOI marker (the coded data never contains it, thanks to the 0xFF stuffing).
+     *
+     * @param data: the bytes of the stream, from the SOI marker of the file.
+     * @param size: number of bytes up to the end of the stream.
+     * @return: the number of bytes of the file, up to its EOI marker.
+     * @throws std::runtime_error if the file is corrupted, truncated or has more than one scan.
+     */
+    size_t findJPEGEnd(const uint8_t* data, size_t size);
+
+    /**
+     * Video decoder of the streams of VideoEncoder: the stream is indexed once (the offsets of the files
+     * of every frame, or of every temporal block), so the frames can be decoded in order by a pipeline
+     * with the memory of a sliding window (see decode), or one at a time in any order (see decode_frame).
+     * The codec is detected from the first bytes: an MJPEG stream starts with the SOI marker of its first
+     * frame, a 3D DCT stream with VIDEO_3D_MAGIC.
+     */
+    class VideoDecoder {
+    public:
+        /**
+         * Constructor that maps the file of a video and indexes it.
+         *
+         * @param path: path to the file.
+         * @throws std::runtime_error if the file cannot be read, or it is corrupted or not supported.
+         */
+        explicit VideoDecoder(const std::string& path);
+
+        /**
+         * Constructor that indexes a video in memory.
+         *
+         * @param data: the bytes of the stream (referenced, not copied: they must outlive the decoder).
+         * @param size: number of bytes.
+         * @throws std::runtime_error if the stream is corrupted or not supported.
+         */
+        VideoDecoder(const uint8_t* data, size_t size);
+
+        [[nodiscard]] VideoCodec getCodec() const;
+        [[nodiscard]] size_t getWidth() const;
+        [[nodiscard]] size_t getHeight() const;
+        /**
+         * @return: 1 for grayscale frames, 3 for RGB ones.
+         */
+        [[nodiscard]] int getChannels() const;
+        [[nodiscard]] size_t getFrameCount() const;
+
+        /**
+         * Function that decodes all the frames and writes them to the sink, in order. The files of the frames
+         * (or of the temporal blocks) are decoded concurrently, in a pipeline that keeps getPipelineSlots()
+         * of them in memory (see runBandPipeline).
+         *
+         * @param sink: the destination of the frames (width * channels bytes per row).
+         * @param method: arithmetic of the dequantization and of the inverse DCT of the MJPEG frames.
+         * @throws std::runtime_error if a file is corrupted or the frames cannot be written.
+         */
+        void decode(FrameSink& sink, DCTMethod method = DCTMethod::FLOAT) const;
+
+        /**
+         * Function that decodes a frame: its file for MJPEG, its whole temporal block for DCT3D.
+         *
+         * @param index: the index of the frame.
+         * @param method: arithmetic of the dequantization and of the inverse DCT of the MJPEG frames.
+         * @return: the pixels of the frame (width * channels columns).
+         * @throws std::out_of_range if the index is not valid.
+         * @throws std::runtime_error if the file is corrupted.
+         */
+        Plane<uint8_t> decode_frame(size_t index, DCTMethod method = DCTMethod::FLOAT) const;
+
+    private:
+        /**
+         * The mapped file (if the decoder was built from a path).
+         */
+        std::shared_ptr<const utils::io::MappedFile> source;
+        const uint8_t* data;
+        size_t size;
+        VideoCodec codec = VideoCodec::MJPEG;
+        size_t width = 0;
+        size_t height = 0;
+        int channels = 0;
+        size_t frameCount = 0;
+        /**
+         * Offset and number of bytes of every JFIF file: one per frame for MJPEG,
+         * TEMPORAL_BLOCK_SIZE per temporal block for DCT3D (in the order of the temporal frequencies).
+         */
+        std::vector<std::pair<size_t, size_t>> files;
+
+        /**
+         * Function that detects the codec, reads the sizes and builds the index of the files.
+         */
+        void index_stream();
+
+        /**
+         * Function that decodes the frames of a temporal block: every file of a temporal frequency is decoded
+         * (see readJFIF), every component is decompressed by decompressTemporalBlock, then the chroma of every
+         * frame is upsampled and converted to RGB.
+         *
+         * @param block: the index of the temporal block.
+         * @param frames: the TEMPORAL_BLOCK_SIZE frames (output, allocated with the sizes of the video).
+         */
+        void decode_temporal_block(size_t block, Plane<uint8_t>* frames) const;
+    };
+}
+
+#endif //JPEG_VIDEO_DECODER_HPP
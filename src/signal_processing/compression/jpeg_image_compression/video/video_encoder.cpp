@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "compression/jpeg_image_compression/video/video_encoder.hpp"
+#include "compression/jpeg_image_compression/color/color_conversion.hpp"
+#include "compression/jpeg_image_compression/color_image/color_image.hpp"
+#include "compression/jpeg_image_compression/streaming/band_pipeline.hpp"
+#include "compression/jpeg_image_compression/video/dct_8x8x8.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Largest width and height of a JFIF file.
+     */
+    constexpr size_t MAX_JFIF_SIDE = 65535;
+
+    static void appendUint32(std::vector<uint8_t>& output, const size_t value) {
+        const auto field = static_cast<uint32_t>(value);
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&field);
+        output.insert(output.end(), bytes, bytes + sizeof(field));
+    }
+
+    VideoEncoder::VideoEncoder(
+        const size_t width,
+        const size_t height,
+        const int channels,
+        const VideoOptions& options
+    ): channels(channels), horizontal(1), vertical(1), options(options) {
+        if (channels != 1 && channels != 3) {
+            throw std::invalid_argument("The frames must have 1 or 3 channels. Given: " + std::to_string(channels));
+        }
+        if (width == 0 || height == 0 || width > MAX_JFIF_SIDE || height > MAX_JFIF_SIDE) {
+            throw std::invalid_argument(
+                "The sizes of the frames must be in [1, 65535]. Given: " + std::to_string(width) + "x" +
+                std::to_string(height)
+            );
+        }
+        if (channels == 3) {
+            if (options.subsampling == ChromaSubsampling::YUV422) {
+                this->horizontal = 2;
+            } else if (options.subsampling == ChromaSubsampling::YUV420) {
+                this->horizontal = 2;
+                this->vertical = 2;
+            }
+        }
+
+        this->layout.width = width;
+        this->layout.height = height;
+        this->layout.components.resize(channels);
+        for (int i = 0; i < channels; ++i) {
+            JFIFComponent& component = this->layout.components[i];
+            component.horizontalSampling = i == 0 ? this->horizontal : 1;
+            component.verticalSampling = i == 0 ? this->vertical : 1;
+            // validates the quality
+            const QuantizationTable& table = getQuantizationTable(options.quality, i > 0);
+            std::memcpy(component.quantization, table.quantization, sizeof(component.quantization));
+        }
+
+        // a chroma block per MCU, or a block for grayscale
+        size_t rows, cols;
+        getComponentSize(this->layout, channels - 1, rows, cols);
+        this->layout.restartInterval = options.restartRows * (cols / dct::algo::DCT_BLOCK_SIZE);
+    }
+
+    size_t VideoEncoder::getWindowFrames() const {
+        return getPipelineSlots() * (this->options.codec == VideoCodec::DCT3D ? TEMPORAL_BLOCK_SIZE : 1);
+    }
+
+    void VideoEncoder::encode(FrameSource& source, const size_t numFrames, std::ostream& output) const {
+        if (numFrames == 0) {
+            throw std::invalid_argument("Error: a video needs at least a frame");
+        }
+        const bool temporal = this->options.codec == VideoCodec::DCT3D;
+        if (temporal) {
+            std::vector<uint8_t> header(VIDEO_3D_MAGIC, VIDEO_3D_MAGIC + sizeof(VIDEO_3D_MAGIC));
+            appendUint32(header, this->layout.width);
+            appendUint32(header, this->layout.height);
+            appendUint32(header, numFrames);
+            appendUint32(header, this->channels);
+            output.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+        }
+
+        // the unit of the pipeline: a frame, or a temporal block
+        const size_t depth = temporal ? TEMPORAL_BLOCK_SIZE : 1;
+        const size_t numUnits = (numFrames + depth - 1) / depth;
+        const size_t slots = getPipelineSlots();
+        const size_t rowBytes = this->layout.width * this->channels;
+        std::vector<Plane<uint8_t>> frames(slots * depth);
+        std::vector<std::vector<uint8_t>> coded(slots);
+
+        runBandPipeline(
+            numUnits,
+            [&](const size_t unit, const size_t slot) {
+                Plane<uint8_t>* window = frames.data() + slot * depth;
+                const size_t count = std::min(depth, numFrames - unit * depth);
+                for (size_t i = 0; i < depth; ++i) {
+                    if (window[i].empty()) {
+                        window[i] = Plane<uint8_t>(this->layout.height, rowBytes);
+                    }
+                    if (i < count) {
+                        source.readFrame(window[i].data(), window[i].getPitch());
+                    } else {
+                        // the last temporal block repeats its last frame
+                        for (size_t r = 0; r < this->layout.height; ++r) {
+                            std::memcpy(window[i].row(r), window[count - 1].row(r), rowBytes);
+                        }
+                    }
+                }
+            },
+            [&](const size_t, const size_t slot) {
+                const Plane<uint8_t>* window = frames.data() + slot * depth;
+                if (temporal) {
+                    coded[slot].clear();
+                    compress_temporal_block(window, coded[slot]);
+                } else {
+                    coded[slot] = encodeJPEG(
+                        window[0],
+                        this->channels,
+                        this->options.subsampling,
+                        this->options.method,
+                        this->options.optimizeHuffman,
+                        this->options.restartRows,
+                        this->options.quality
+                    );
+                }
+            },
+            [&](const size_t, const size_t slot) {
+                output.write(reinterpret_cast<const char*>(coded[slot].data()), static_cast<std::streamsize>(coded[slot].size()));
+                if (!output) {
+                    throw std::runtime_error("Error: could not write the video stream");
+                }
+            }
+        );
+    }
+
+    void VideoEncoder::compress_temporal_block(const Plane<uint8_t>* frames, std::vector<uint8_t>& output) const {
+        constexpr size_t depth = TEMPORAL_BLOCK_SIZE;
+        const size_t numComponents = this->layout.components.size();
+        const size_t width = this->layout.width;
+        const size_t height = this->layout.height;
+
+        // the planes of the components of every frame, padded to whole MCUs
+        std::vector<Plane<uint8_t>> planes(numComponents * depth);
+        for (size_t i = 0; i < numComponents; ++i) {
+            size_t rows, cols;
+            getComponentSize(this->layout, i, rows, cols);
+            for (size_t t = 0; t < depth; ++t) {
+                planes[i * depth + t] = Plane<uint8_t>(rows, cols);
+            }
+        }
+        for (size_t t = 0; t < depth; ++t) {
+            if (numComponents == 3) {
+                convertAndDownsample(
+                    frames[t], width, height, this->horizontal, this->vertical,
+                    planes[t], planes[depth + t], planes[2 * depth + t]
+                );
+            } else {
+                // the padding replicates the last column and row of the frame
+                Plane<uint8_t>& plane = planes[t];
+                for (size_t r = 0; r < plane.getRows(); ++r) {
+                    uint8_t* row = plane.row(r);
+                    std::memcpy(row, frames[t].row(std::min(r, height - 1)), width);
+                    std::fill(row + width, row + plane.getCols(), row[width - 1]);
+                }
+            }
+        }
+
+        // a file per temporal frequency, with the layout of the frames
+        std::vector<JFIFImage> files(depth, this->layout);
+        for (size_t i = 0; i < numComponents; ++i) {
+            double tables[depth][dct::algo::DCT_BLOCK_AREA];
+            const double* quantization[depth];
+            Plane<int16_t> coefficients[depth];
+            for (size_t t = 0; t < depth; ++t) {
+                makeTemporalQuantization(this->layout.components[i].quantization, t, tables[t]);
+                quantization[t] = tables[t];
+                coefficients[t] = Plane<int16_t>(planes[i * depth].getRows(), planes[i * depth].getCols());
+            }
+            compressTemporalBlock(planes.data() + i * depth, quantization, coefficients);
+            for (size_t t = 0; t < depth; ++t) {
+                JFIFComponent& component = files[t].components[i];
+                component.coefficients = std::move(coefficients[t]);
+                std::memcpy(component.quantization, tables[t], sizeof(component.quantization));
+            }
+        }
+
+        for (size_t t = 0; t < depth; ++t) {
+            const std::vector<uint8_t> file = writeJFIF(files[t], this->options.optimizeHuffman);
+            appendUint32(output, file.size());
+            output.insert(output.end(), file.begin(), file.end());
+        }
+    }
+}
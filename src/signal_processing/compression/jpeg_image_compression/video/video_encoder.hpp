@@ -0,0 +1,140 @@
+#ifndef JPEG_VIDEO_ENCODER_HPP
+#define JPEG_VIDEO_ENCODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "compression/jpeg_image_compression/chroma_subsampling.hpp"
+#include "compression/jpeg_image_compression/dct_method.hpp"
+#include "compression/jpeg_image_compression/jfif/jfif.hpp"
+#include "compression/jpeg_image_compression/plane/plane.hpp"
+#include "compression/jpeg_image_compression/quantization/quantization.hpp"
+#include "compression/jpeg_image_compression/video/frame_stream.hpp"
+
+namespace sp::jpeg
+{
+    /**
+     * Coding of the frames of a video.
+     */
+    enum class VideoCodec {
+        /**
+         * Motion JPEG: every frame is a baseline JFIF file, and the stream is their concatenation
+         * (the raw MJPEG stream read by ffmpeg -f mjpeg). Every frame can be decoded on its own.
+         */
+        MJPEG,
+        /**
+         * 3D DCT: the frames are coded in temporal blocks of 8, as 8x8x8 blocks (see compressTemporalBlock).
+         * Much smaller than MJPEG on static-camera footage, whose changes between the frames are small.
+         */
+        DCT3D
+    };
+
+    /**
+     * Magic number of a 3D DCT stream, followed by the width, the height, the number of frames and the
+     * number of channels (uint32, in the byte order of the machine). Every temporal block is then coded as
+     * the 8 JFIF files of its temporal frequencies, each preceded by its number of bytes (uint32).
+     */
+    constexpr char VIDEO_3D_MAGIC[4] = {'S', 'P', '3', 'D'};
+
+    /**
+     * Number of bytes of the header of a 3D DCT stream.
+     */
+    constexpr size_t VIDEO_3D_HEADER_SIZE = sizeof(VIDEO_3D_MAGIC) + 4 * sizeof(uint32_t);
+
+    /**
+     * Parameters of a VideoEncoder.
+     */
+    struct VideoOptions {
+        /**
+         * The coding of the frames.
+         */
+        VideoCodec codec = VideoCodec::MJPEG;
+        /**
+         * The quality, from 1 to 100 (see getQuantizationTable): for DCT3D, the static content is quantized
+         * as by MJPEG at the same quality, the changes between the frames more coarsely (see makeTemporalQuantization).
+         */
+        int quality = DEFAULT_QUALITY;
+        /**
+         * Resolution of the chroma of the color frames.
+         */
+        ChromaSubsampling subsampling = ChromaSubsampling::YUV420;
+        /**
+         * Arithmetic of the DCT and of the quantization of the MJPEG frames (DCT3D is floating-point).
+         */
+        DCTMethod method = DCTMethod::FLOAT;
+        /**
+         * True for the optimized Huffman tables of every file, false for the standard ones.
+         */
+        bool optimizeHuffman = false;
+        /**
+         * Number of rows of MCUs of each restart segment of every file (0 for one segment).
+         */
+        size_t restartRows = 1;
+    };
+
+    /**
+     * Video encoder built on the JPEG block pipeline, for clips larger than memory: the frames are pulled
+     * from a FrameSource and coded in a pipeline (see runBandPipeline) whose unit is a frame for MJPEG and
+     * a temporal block of 8 frames for DCT3D. While a thread reads the next frames and another one writes
+     * the coded ones, all the threads code one unit each, so the frames are coded concurrently.
+     *
+     * The memory is bounded by the sliding window of the pipeline (see getWindowFrames), whatever the
+     * length of the clip. The frames inside a unit use the nesting-aware parallel paths, so they are
+     * serial while the pipeline runs.
+     */
+    class VideoEncoder {
+    public:
+        /**
+         * Constructor that describes the video.
+         *
+         * @param width: width of the frames, in pixels (at most 65535).
+         * @param height: height of the frames, in pixels (at most 65535).
+         * @param channels: 1 (grayscale frames) or 3 (RGB frames, coded as YCbCr).
+         * @param options: the codec and the coding of the files.
+         * @throws std::invalid_argument if the sizes, the channels or the quality are not valid.
+         */
+        VideoEncoder(size_t width, size_t height, int channels, const VideoOptions& options = VideoOptions());
+
+        /**
+         * Get the number of frames kept in memory by encode.
+         * @return: the slots of the pipeline times the frames of a unit (1 or 8).
+         */
+        [[nodiscard]] size_t getWindowFrames() const;
+
+        /**
+         * Function that reads the frames of the source and writes the coded stream to the output.
+         * The last temporal block of DCT3D is completed with copies of the last frame (not decoded).
+         *
+         * @param source: the frames of the video (width * channels bytes per row).
+         * @param numFrames: the number of frames (greater than 0).
+         * @param output: the binary stream of the video.
+         * @throws std::invalid_argument if there are no frames.
+         * @throws std::runtime_error if the frames cannot be read or the stream cannot be written.
+         */
+        void encode(FrameSource& source, size_t numFrames, std::ostream& output) const;
+
+    private:
+        /**
+         * The file of a temporal frequency, without coefficients: sizes, components and restart interval.
+         */
+        JFIFImage layout;
+        int channels;
+        int horizontal;
+        int vertical;
+        VideoOptions options;
+
+        /**
+         * Function that codes a temporal block: the frames are converted to the planes of the components
+         * (padded to whole MCUs), each component is compressed by compressTemporalBlock, and the planes of every
+         * temporal frequency are written as a JFIF file with the quantization matrices of the frequency.
+         *
+         * @param frames: the TEMPORAL_BLOCK_SIZE frames.
+         * @param output: the buffer where the length-prefixed files are appended.
+         */
+        void compress_temporal_block(const Plane<uint8_t>* frames, std::vector<uint8_t>& output) const;
+    };
+}
+
+#endif //JPEG_VIDEO_ENCODER_HPP
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "convolution/partitioned_convolution/non_uniform_partitioned_convolver.hpp"
+
+namespace sp::conv
+{
+    NonUniformPartitionedConvolver::Stage::Stage(
+        const std::vector<double>& segment,
+        const size_t stageBlockSize,
+        const size_t segmentOffset
+    ) : convolver(segment, stageBlockSize), offset(segmentOffset),
+        inputBlock(stageBlockSize, 0.0), outputBlock(stageBlockSize, 0.0) {}
+
+    NonUniformPartitionedConvolver::NonUniformPartitionedConvolver(
+        const std::vector<double>& impulseResponse,
+        const size_t blockSize,
+        const size_t maxBlockSize,
+        const size_t partitionsPerStage
+    ) : blockSize(blockSize), samplesProcessed(0), outputRingHead(0) {
+        if (impulseResponse.empty()) {
+            throw std::invalid_argument("The impulse response is empty.");
+        }
+        if (blockSize == 0 || (blockSize & (blockSize - 1)) != 0 ||
+            maxBlockSize == 0 || (maxBlockSize & (maxBlockSize - 1)) != 0) {
+            throw std::invalid_argument("The block sizes must be positive powers of 2.");
+        }
+        if (maxBlockSize < blockSize) {
+            throw std::invalid_argument(
+                "The maximum block size (" + std::to_string(maxBlockSize) +
+                ") must be greater than or equal to the block size (" + std::to_string(blockSize) + ")."
+            );
+        }
+        if (partitionsPerStage == 0) {
+            throw std::invalid_argument("The number of partitions per stage must be greater than 0.");
+        }
+
+        /**
+         * Build the stages: B, 2B, 4B, ... up to maxBlockSize.
+         * A stage of size Bs needs an offset of at least Bs - B samples;
+         * after a stage of size Bs with k >= 1 partitions, the offset grows by k * Bs,
+         * so the next stage (2 * Bs) always satisfies its constraint (offset >= 2 * Bs - B).
+         */
+        const size_t length = impulseResponse.size();
+        size_t offset = 0;
+        size_t stageBlockSize = blockSize;
+        size_t ringSize = blockSize;
+        while (offset < length) {
+            const size_t remaining = length - offset;
+            // the last stage (largest block size) takes all the remaining taps
+            const size_t segmentLength = stageBlockSize < maxBlockSize
+                ? std::min(partitionsPerStage * stageBlockSize, remaining)
+                : remaining;
+            const std::vector<double> segment(
+                impulseResponse.begin() + static_cast<std::ptrdiff_t>(offset),
+                impulseResponse.begin() + static_cast<std::ptrdiff_t>(offset + segmentLength)
+            );
+            this->stages.emplace_back(segment, stageBlockSize, offset);
+            // the stage output may be written up to B + offset samples ahead of the current block
+            ringSize = std::max(ringSize, blockSize + offset);
+
+            offset += segmentLength;
+            if (stageBlockSize < maxBlockSize) {
+                stageBlockSize <<= 1;
+            }
+        }
+        this->outputRing.assign(ringSize, 0.0);
+    }
+
+    void NonUniformPartitionedConvolver::process(const double* input, double* output) {
+        const size_t B = this->blockSize;
+        const size_t ringSize = this->outputRing.size();
+
+        for (Stage& stage : this->stages) {
+            const size_t stageBlockSize = stage.inputBlock.size();
+            // position of the current block inside the block of the stage
+            const size_t fill = this->samplesProcessed % stageBlockSize;
+            std::copy(input, input + B, stage.inputBlock.begin() + static_cast<std::ptrdiff_t>(fill));
+            if (fill + B < stageBlockSize) {
+                // the stage block is not complete yet
+                continue;
+            }
+            stage.convolver.process(stage.inputBlock.data(), stage.outputBlock.data());
+            /**
+             * The stage block started Bs - B samples before the current block,
+             * and its output belongs to the positions shifted by the offset of the segment;
+             * relative to the first sample of the current block, sample j lands at:
+             *      j + offset - (Bs - B) >= 0
+             */
+            const size_t shift = stage.offset + B - stageBlockSize;
+            for (size_t j = 0; j < stageBlockSize; ++j) {
+                this->outputRing[(this->outputRingHead + shift + j) % ringSize] += stage.outputBlock[j];
+            }
+        }
+
+        // emit the current block and clear its slots for future accumulations
+        for (size_t n = 0; n < B; ++n) {
+            double& slot = this->outputRing[(this->outputRingHead + n) % ringSize];
+            output[n] = slot;
+            slot = 0.0;
+        }
+        this->outputRingHead = (this->outputRingHead + B) % ringSize;
+        // the largest stage block size is a multiple of all the others (powers of 2)
+        this->samplesProcessed = (this->samplesProcessed + B) % this->stages.back().inputBlock.size();
+    }
+
+    void NonUniformPartitionedConvolver::process(const std::vector<double>& input, std::vector<double>& output) {
+        if (input.size() != this->blockSize || output.size() != this->blockSize) {
+            throw std::invalid_argument(
+                "Input and output sizes must match the block size. Given: " +
+                std::to_string(input.size()) + " and " + std::to_string(output.size()) +
+                ", Expected: " + std::to_string(this->blockSize)
+            );
+        }
+        this->process(input.data(), output.data());
+    }
+
+    void NonUniformPartitionedConvolver::reset() {
+        for (Stage& stage : this->stages) {
+            stage.convolver.reset();
+            std::fill(stage.inputBlock.begin(), stage.inputBlock.end(), 0.0);
+            std::fill(stage.outputBlock.begin(), stage.outputBlock.end(), 0.0);
+        }
+        std::fill(this->outputRing.begin(), this->outputRing.end(), 0.0);
+        this->outputRingHead = 0;
+        this->samplesProcessed = 0;
+    }
+}
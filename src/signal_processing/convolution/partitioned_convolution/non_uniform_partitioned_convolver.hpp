@@ -0,0 +1,140 @@
+#ifndef NON_UNIFORM_PARTITIONED_CONVOLVER_HPP
+#define NON_UNIFORM_PARTITIONED_CONVOLVER_HPP
+
+#include <vector>
+
+#include "convolution/partitioned_convolution/uniform_partitioned_convolver.hpp"
+
+namespace sp::conv
+{
+    /**
+     * Non-Uniformly Partitioned convolver.
+     *
+     * A uniformly partitioned convolver with a small block size needs many partitions for a long
+     * impulse response, and the multiply-accumulate over the frequency-domain delay line dominates the cost.
+     * This class splits the impulse response into stages with growing block sizes
+     * (B, 2B, 4B, ..., up to a maximum block size), where each stage is a UniformPartitionedConvolver:
+     *  - the head of the impulse response is handled by small partitions, so the latency stays B samples;
+     *  - the tail is handled by large partitions, which are much cheaper per sample.
+     *
+     * A stage with block size Bs can only deliver its output Bs - B samples after the input arrived,
+     * so every stage must start at an offset of the impulse response of at least Bs - B samples.
+     * Any extra offset is absorbed by writing the stage output further ahead in a shared output ring.
+     *
+     * @note The stages are computed synchronously: the call that completes a block of a large stage
+     *       is more expensive than the others. The cost of each call is still bounded, and no memory
+     *       is allocated after construction.
+     */
+    class NonUniformPartitionedConvolver {
+    public:
+        /**
+         * Create a non-uniformly partitioned convolver.
+         *
+         * @param impulseResponse The impulse response (filter taps) of the convolution.
+         * @param blockSize The number of samples processed at each call (B), i.e. the latency.
+         *                  It must be a power of 2.
+         * @param maxBlockSize The largest block size used by the tail stages.
+         *                     It must be a power of 2 greater than or equal to the block size.
+         * @param partitionsPerStage The number of partitions of every stage except the last one,
+         *                           which takes all the remaining taps.
+         * @throws std::invalid_argument if the impulse response is empty.
+         * @throws std::invalid_argument if the block sizes are not powers of 2 or maxBlockSize < blockSize.
+         * @throws std::invalid_argument if partitionsPerStage is 0.
+         */
+        NonUniformPartitionedConvolver(
+            const std::vector<double>& impulseResponse,
+            size_t blockSize,
+            size_t maxBlockSize,
+            size_t partitionsPerStage = 2
+        );
+
+        /**
+         * Convolve the next block of the input stream.
+         *
+         * Exactly getBlockSize() samples are read from input and written to output.
+         * The input and output buffers may be the same buffer (in-place processing).
+         *
+         * @param input Pointer to the next B input samples.
+         * @param output Pointer to the buffer that receives the next B output samples.
+         */
+        void process(const double* input, double* output);
+
+        /**
+         * Convolve the next block of the input stream.
+         *
+         * @param input The next B input samples.
+         * @param output The next B output samples; it must already have size B.
+         * @throws std::invalid_argument if input or output size is not equal to the block size.
+         */
+        void process(const std::vector<double>& input, std::vector<double>& output);
+
+        /**
+         * Clear the internal state of every stage, as if no sample had been processed.
+         */
+        void reset();
+
+        /**
+         * Get the block size (B), i.e. the number of samples processed at each call.
+         * @return The block size.
+         */
+        [[nodiscard]] size_t getBlockSize() const {
+            return blockSize;
+        }
+
+        /**
+         * Get the number of stages (one per block size actually used).
+         * @return The number of stages.
+         */
+        [[nodiscard]] size_t getNumStages() const {
+            return stages.size();
+        }
+
+    private:
+        /**
+         * A stage of the partitioning: a uniform convolver that handles a segment of the impulse response.
+         */
+        struct Stage {
+            /**
+             * Uniform convolver of the impulse response segment.
+             */
+            UniformPartitionedConvolver convolver;
+            /**
+             * Offset (in samples) of the segment in the impulse response.
+             */
+            size_t offset;
+            /**
+             * Input samples collected so far for the next block of this stage.
+             */
+            std::vector<double> inputBlock;
+            /**
+             * Output of the last block of this stage.
+             */
+            std::vector<double> outputBlock;
+
+            Stage(const std::vector<double>& segment, size_t stageBlockSize, size_t segmentOffset);
+        };
+
+        /**
+         * The block size (B).
+         */
+        size_t blockSize;
+        /**
+         * The stages, ordered by increasing block size.
+         */
+        std::vector<Stage> stages;
+        /**
+         * Number of samples processed so far (modulo the largest stage block size).
+         */
+        size_t samplesProcessed;
+        /**
+         * Output accumulation ring: stage outputs are added ahead of time at their absolute output position.
+         */
+        std::vector<double> outputRing;
+        /**
+         * Position in the output ring of the first sample of the current block.
+         */
+        size_t outputRingHead;
+    };
+}
+
+#endif //NON_UNIFORM_PARTITIONED_CONVOLVER_HPP
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "convolution/partitioned_convolution/uniform_partitioned_convolver.hpp"
+#include "transforms/fourier_transform/algorithms/cooley_tukey/cooley_tukey_fft.hpp"
+#include "transforms/fourier_transform/algorithms/cooley_tukey/cooley_tukey_inverse_fft.hpp"
+
+namespace sp::conv
+{
+    UniformPartitionedConvolver::UniformPartitionedConvolver(
+        const std::vector<double>& impulseResponse,
+        const size_t blockSize
+    ) : blockSize(blockSize), fftSize(2 * blockSize), numBins(blockSize + 1),
+        numPartitions(0), impulseResponseLength(impulseResponse.size()), delayLineHead(0) {
+        if (impulseResponse.empty()) {
+            throw std::invalid_argument("The impulse response is empty.");
+        }
+        if (blockSize == 0 || (blockSize & (blockSize - 1)) != 0) {
+            throw std::invalid_argument(
+                "The block size must be a positive power of 2. Given: " + std::to_string(blockSize)
+            );
+        }
+
+        // number of partitions of B taps needed to cover the impulse response (ceil division)
+        this->numPartitions = (impulseResponse.size() + blockSize - 1) / blockSize;
+
+        // allocate everything once, the processing must be allocation-free
+        this->partitionSpectra.assign(this->numPartitions * this->numBins, std::complex<double>(0.0, 0.0));
+        this->delayLine.assign(this->numPartitions * this->numBins, std::complex<double>(0.0, 0.0));
+        this->inputWindow.assign(this->fftSize, 0.0);
+        this->fftBuffer.assign(this->fftSize, std::complex<double>(0.0, 0.0));
+
+        // transform each partition (B taps followed by B zeros) and keep only the non-redundant bins,
+        // since the spectrum of a real signal is Hermitian-symmetric
+        for (size_t p = 0; p < this->numPartitions; ++p) {
+            std::fill(this->fftBuffer.begin(), this->fftBuffer.end(), std::complex<double>(0.0, 0.0));
+            const size_t first = p * blockSize;
+            const size_t last = std::min(first + blockSize, impulseResponse.size());
+            for (size_t n = first; n < last; ++n) {
+                this->fftBuffer[n - first] = impulseResponse[n];
+            }
+            fft::algo::cooley_tukey::computeFFT(this->fftBuffer);
+            std::copy(
+                this->fftBuffer.begin(),
+                this->fftBuffer.begin() + static_cast<std::ptrdiff_t>(this->numBins),
+                this->partitionSpectra.begin() + static_cast<std::ptrdiff_t>(p * this->numBins)
+            );
+        }
+    }
+
+    void UniformPartitionedConvolver::process(const double* input, double* output) {
+        const size_t B = this->blockSize;
+
+        // 1. Slide the input window: the previous block moves to the first half,
+        //    the new block is appended in the second half.
+        std::copy(this->inputWindow.begin() + static_cast<std::ptrdiff_t>(B), this->inputWindow.end(),
+                  this->inputWindow.begin());
+        std::copy(input, input + B, this->inputWindow.begin() + static_cast<std::ptrdiff_t>(B));
+
+        // 2. Transform the window and store its spectrum in the newest slot of the FDL.
+        for (size_t n = 0; n < this->fftSize; ++n) {
+            this->fftBuffer[n] = this->inputWindow[n];
+        }
+        fft::algo::cooley_tukey::computeFFT(this->fftBuffer);
+        // the ring buffer moves one slot forward (the oldest spectrum is overwritten)
+        this->delayLineHead = (this->delayLineHead + 1) % this->numPartitions;
+        std::copy(
+            this->fftBuffer.begin(),
+            this->fftBuffer.begin() + static_cast<std::ptrdiff_t>(this->numBins),
+            this->delayLine.begin() + static_cast<std::ptrdiff_t>(this->delayLineHead * this->numBins)
+        );
+
+        // 3. Multiply-accumulate: partition p is paired with the input spectrum delayed by p blocks.
+        //    The accumulator reuses the FFT buffer (only the first B + 1 bins are accumulated).
+        std::fill(this->fftBuffer.begin(), this->fftBuffer.end(), std::complex<double>(0.0, 0.0));
+        for (size_t p = 0; p < this->numPartitions; ++p) {
+            const size_t slot = (this->delayLineHead + this->numPartitions - p) % this->numPartitions;
+            const std::complex<double>* x = &this->delayLine[slot * this->numBins];
+            const std::complex<double>* h = &this->partitionSpectra[p * this->numBins];
+            for (size_t k = 0; k < this->numBins; ++k) {
+                this->fftBuffer[k] += x[k] * h[k];
+            }
+        }
+        // restore the Hermitian symmetry of the accumulated spectrum
+        for (size_t k = 1; k < B; ++k) {
+            this->fftBuffer[this->fftSize - k] = std::conj(this->fftBuffer[k]);
+        }
+
+        // 4. Back to the time domain: the first B samples are corrupted by the circular wrap-around,
+        //    the last B samples are the valid linear convolution output (overlap-save).
+        fft::algo::cooley_tukey::computeInverseFFT(this->fftBuffer);
+        for (size_t n = 0; n < B; ++n) {
+            output[n] = this->fftBuffer[B + n].real();
+        }
+    }
+
+    void UniformPartitionedConvolver::process(const std::vector<double>& input, std::vector<double>& output) {
+        if (input.size() != this->blockSize || output.size() != this->blockSize) {
+            throw std::invalid_argument(
+                "Input and output sizes must match the block size. Given: " +
+                std::to_string(input.size()) + " and " + std::to_string(output.size()) +
+                ", Expected: " + std::to_string(this->blockSize)
+            );
+        }
+        this->process(input.data(), output.data());
+    }
+
+    void UniformPartitionedConvolver::reset() {
+        std::fill(this->delayLine.begin(), this->delayLine.end(), std::complex<double>(0.0, 0.0));
+        std::fill(this->inputWindow.begin(), this->inputWindow.end(), 0.0);
+        this->delayLineHead = 0;
+    }
+}
@@ -0,0 +1,140 @@
+#ifndef UNIFORM_PARTITIONED_CONVOLVER_HPP
+#define UNIFORM_PARTITIONED_CONVOLVER_HPP
+
+#include <complex>
+#include <vector>
+
+/**
+ * Convolution module.
+ *
+ * This module provides streaming (block-based) convolution engines built on top of the FFT kernels.
+ */
+namespace sp::conv
+{
+    /**
+     * Uniformly Partitioned Overlap-Save (UPOLS) convolver.
+     *
+     * The impulse response is split into P partitions of B samples (B is the block size).
+     * Each partition is transformed once, at construction time, with a 2B-point FFT.
+     * At run time, every input block of B samples is transformed once and stored in a
+     * frequency-domain delay line (FDL) that holds the spectra of the last P input blocks.
+     * The output block is obtained by multiplying and accumulating each FDL slot with the
+     * matching partition spectrum and by transforming the sum back (overlap-save).
+     *
+     * This way, a long impulse response runs with the latency of a single block (B samples)
+     * instead of the latency of one big FFT as long as the impulse response.
+     *
+     * All the buffers are allocated in the constructor:
+     * the per-block cost is bounded (two 2B-point FFTs and P complex multiply-accumulates of B + 1 bins)
+     * and the processing is allocation-free.
+     *
+     * See also: <a href="https://en.wikipedia.org/wiki/Overlap%E2%80%93save_method">Overlap-save method</a>
+     */
+    class UniformPartitionedConvolver {
+    public:
+        /**
+         * Create a uniformly partitioned convolver.
+         *
+         * @param impulseResponse The impulse response (filter taps) of the convolution.
+         * @param blockSize The number of samples processed at each call (B).
+         *                  It must be a power of 2 because the FFT size is 2B (radix-2 Cooley-Tukey).
+         * @throws std::invalid_argument if the impulse response is empty.
+         * @throws std::invalid_argument if the block size is not a positive power of 2.
+         */
+        UniformPartitionedConvolver(const std::vector<double>& impulseResponse, size_t blockSize);
+
+        /**
+         * Convolve the next block of the input stream.
+         *
+         * Exactly getBlockSize() samples are read from input and written to output.
+         * The input and output buffers may be the same buffer (in-place processing).
+         *
+         * @param input Pointer to the next B input samples.
+         * @param output Pointer to the buffer that receives the next B output samples.
+         */
+        void process(const double* input, double* output);
+
+        /**
+         * Convolve the next block of the input stream.
+         *
+         * @param input The next B input samples.
+         * @param output The next B output samples; it must already have size B.
+         * @throws std::invalid_argument if input or output size is not equal to the block size.
+         */
+        void process(const std::vector<double>& input, std::vector<double>& output);
+
+        /**
+         * Clear the internal state (input history and frequency-domain delay line),
+         * as if no sample had been processed.
+         */
+        void reset();
+
+        /**
+         * Get the block size (B), i.e. the number of samples processed at each call.
+         * @return The block size.
+         */
+        [[nodiscard]] size_t getBlockSize() const {
+            return blockSize;
+        }
+
+        /**
+         * Get the number of partitions (P) of the impulse response.
+         * @return The number of partitions.
+         */
+        [[nodiscard]] size_t getNumPartitions() const {
+            return numPartitions;
+        }
+
+        /**
+         * Get the length of the impulse response.
+         * @return The number of taps of the impulse response.
+         */
+        [[nodiscard]] size_t getImpulseResponseLength() const {
+            return impulseResponseLength;
+        }
+
+    private:
+        /**
+         * The block size (B).
+         */
+        size_t blockSize;
+        /**
+         * The FFT size (2B).
+         */
+        size_t fftSize;
+        /**
+         * Number of non-redundant bins of the spectrum of a real signal (B + 1).
+         */
+        size_t numBins;
+        /**
+         * The number of partitions (P).
+         */
+        size_t numPartitions;
+        /**
+         * The original length of the impulse response.
+         */
+        size_t impulseResponseLength;
+        /**
+         * Spectra of the impulse response partitions, stored contiguously (P x (B + 1)).
+         */
+        std::vector<std::complex<double>> partitionSpectra;
+        /**
+         * Frequency-domain delay line: spectra of the last P input blocks (P x (B + 1)), used as a ring buffer.
+         */
+        std::vector<std::complex<double>> delayLine;
+        /**
+         * Index of the FDL slot that holds the spectrum of the most recent input block.
+         */
+        size_t delayLineHead;
+        /**
+         * Sliding input window of 2B samples (previous block + current block).
+         */
+        std::vector<double> inputWindow;
+        /**
+         * FFT work buffer (2B points), reused at each block.
+         */
+        std::vector<std::complex<double>> fftBuffer;
+    };
+}
+
+#endif //UNIFORM_PARTITIONED_CONVOLVER_HPP
@@ -3,8 +3,33 @@
 
 // compression
 #include <compression/image_compression_haar_wavelet/image_compression_haar_wavelet.hpp>
+#include <compression/jpeg_image_compression/dct_method.hpp>
+#include <compression/jpeg_image_compression/chroma_subsampling.hpp>
+#include <compression/jpeg_image_compression/plane/plane.hpp>
+#include <compression/jpeg_image_compression/block_coder/block_coder.hpp>
+#include <compression/jpeg_image_compression/quantization/quantization.hpp>
+#include <compression/jpeg_image_compression/huffman/huffman.hpp>
+#include <compression/jpeg_image_compression/jfif/jfif.hpp>
+#include <compression/jpeg_image_compression/color/color_conversion.hpp>
+#include <compression/jpeg_image_compression/rate_control/rate_control.hpp>
+#include <compression/jpeg_image_compression/streaming/row_stream.hpp>
+#include <compression/jpeg_image_compression/streaming/band_pipeline.hpp>
+#include <compression/jpeg_image_compression/streaming/stream_encoder.hpp>
+#include <compression/jpeg_image_compression/streaming/stream_decoder.hpp>
+#include <compression/jpeg_image_compression/scaled_decoding/scaled_decoding.hpp>
 #include <compression/jpeg_image_compression/compressed_image/compressed_image.hpp>
 #include <compression/jpeg_image_compression/image/image.hpp>
+#include <compression/jpeg_image_compression/color_image/color_image.hpp>
+#include <compression/jpeg_image_compression/batch/bounded_queue.hpp>
+#include <compression/jpeg_image_compression/batch/batch_compressor.hpp>
+#include <compression/jpeg_image_compression/video/frame_stream.hpp>
+#include <compression/jpeg_image_compression/video/dct_8x8x8.hpp>
+#include <compression/jpeg_image_compression/video/video_encoder.hpp>
+#include <compression/jpeg_image_compression/video/video_decoder.hpp>
+
+// convolution
+#include <convolution/partitioned_convolution/non_uniform_partitioned_convolver.hpp>
+#include <convolution/partitioned_convolution/uniform_partitioned_convolver.hpp>
 
 // handlers
 #include <handlers/config_loader/base_configuration_loader.hpp>
@@ -19,25 +44,47 @@
 
 // transforms
 #include <transforms/discrete_cosine_transform/base_discrete_cosine_transform.hpp>
+#include <transforms/discrete_cosine_transform/base_discrete_cosine_transform_nd.hpp>
 #include <transforms/discrete_cosine_transform/algorithms/dct.hpp>
 #include <transforms/discrete_cosine_transform/algorithms/dct_openmp.hpp>
 #include <transforms/discrete_cosine_transform/algorithms/idct.hpp>
 #include <transforms/discrete_cosine_transform/algorithms/idct_openmp.hpp>
+#include <transforms/discrete_cosine_transform/algorithms/dct_basis.hpp>
+#include <transforms/discrete_cosine_transform/algorithms/fast_dct.hpp>
+#include <transforms/discrete_cosine_transform/algorithms/dct_batch.hpp>
+#include <transforms/discrete_cosine_transform/algorithms/dct_nd.hpp>
+#include <transforms/discrete_cosine_transform/algorithms/dct_8x8.hpp>
+#include <transforms/discrete_cosine_transform/algorithms/dct_8x8_integer.hpp>
+#include <transforms/discrete_cosine_transform/algorithms/dct_types.hpp>
 #include <transforms/discrete_cosine_transform/discrete_cosine_transform/discrete_cosine_transform.hpp>
+#include <transforms/discrete_cosine_transform/discrete_cosine_transform/discrete_cosine_transform_nd.hpp>
 #include <transforms/discrete_cosine_transform/inverse_discrete_cosine_transform/inverse_discrete_cosine_transform.hpp>
+#include <transforms/discrete_cosine_transform/inverse_discrete_cosine_transform/inverse_discrete_cosine_transform_nd.hpp>
+#include <transforms/discrete_cosine_transform/mdct/modified_discrete_cosine_transform.hpp>
 #include <transforms/fourier_transform/base_fourier_transform.hpp>
 #include <transforms/fourier_transform/algorithms/cooley_tukey/openmp/cooley_tukey_fft_openmp.hpp>
 #include <transforms/fourier_transform/algorithms/cooley_tukey/openmp/cooley_tukey_inverse_fft_openmp.hpp>
+#include <transforms/fourier_transform/algorithms/cooley_tukey/cooley_tukey_batch.hpp>
 #include <transforms/fourier_transform/algorithms/cooley_tukey/cooley_tukey_fft.hpp>
 #include <transforms/fourier_transform/algorithms/cooley_tukey/cooley_tukey_inverse_fft.hpp>
+#include <transforms/fourier_transform/algorithms/cooley_tukey/cooley_tukey_pruned_fft.hpp>
 #include <transforms/fourier_transform/fast_fourier_transform/fast_fourier_transform.hpp>
 #include <transforms/fourier_transform/inverse_fast_fourier_transform/inverse_fast_fourier_transform.hpp>
+#include <transforms/fourier_transform/pruned_fast_fourier_transform/pruned_fast_fourier_transform.hpp>
+#include <transforms/fourier_transform/sparse_fourier_transform/sparse_fourier_transform.hpp>
 #include <transforms/haar_wavelet_transform/haar_wavelet_1d.hpp>
 #include <transforms/haar_wavelet_transform/haar_wavelet_2d.hpp>
+#include <transforms/short_time_fourier_transform/inverse_short_time_fourier_transform.hpp>
+#include <transforms/short_time_fourier_transform/multi_channel_short_time_fourier_transform.hpp>
+#include <transforms/short_time_fourier_transform/short_time_fourier_transform.hpp>
+#include <transforms/short_time_fourier_transform/window_functions.hpp>
+#include <transforms/sliding_fourier_transform/goertzel_filter_bank.hpp>
+#include <transforms/sliding_fourier_transform/sliding_discrete_fourier_transform.hpp>
 
 // utils
 #include <utils/bit_reversal.hpp>
 #include <utils/legacy_support.hpp>
+#include <utils/mapped_file.hpp>
 #include <utils/rle_compressor.hpp>
 #include <utils/timestamp.hpp>
 #include <utils/zigzag_scan.hpp>
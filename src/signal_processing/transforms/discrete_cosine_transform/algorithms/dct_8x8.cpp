@@ -0,0 +1,263 @@
+#include <array>
+#include <cmath>
+#include <utility>
+
+#include "transforms/discrete_cosine_transform/algorithms/dct_8x8.hpp"
+
+namespace sp::dct::algo {
+    /**
+     * AAN rotation constants.
+     */
+    constexpr double C4 = 0.707106781186547524;            // cos(4 * pi / 16)
+    constexpr double C6 = 0.382683432365089772;            // cos(6 * pi / 16)
+    constexpr double C2_MINUS_C6 = 0.541196100146196984;   // cos(2 * pi / 16) - cos(6 * pi / 16)
+    constexpr double C2_PLUS_C6 = 1.306562964876376527;    // cos(2 * pi / 16) + cos(6 * pi / 16)
+    constexpr double SQRT2 = 1.414213562373095049;         // 2 * cos(4 * pi / 16)
+    constexpr double TWO_C2 = 1.847759065022573512;        // 2 * cos(2 * pi / 16)
+    constexpr double TWO_C2_MINUS_C6 = 1.082392200292393968; // 2 * (cos(2 * pi / 16) - cos(6 * pi / 16))
+    constexpr double TWO_C2_PLUS_C6 = 2.613125929752753055;  // 2 * (cos(2 * pi / 16) + cos(6 * pi / 16))
+
+    /**
+     * The AAN scaling factor of the frequency k: 1 for k = 0, sqrt(2) * cos(k * pi / 16) otherwise.
+     *
+     * The AAN passes compute the orthonormal 1D DCT multiplied by sqrt(8) * aanScale(k).
+     */
+    static double aanScale(const size_t k) {
+        return k == 0 ? 1.0 : SQRT2 * std::cos(static_cast<double>(k) * M_PI / 16.0);
+    }
+
+    /**
+     * The post-scale of the orthonormal forward transform, 1 / (8 * aanScale(i) * aanScale(j)).
+     */
+    template <typename T>
+    static const std::array<T, DCT_BLOCK_AREA>& unitPostScale() {
+        static const std::array<T, DCT_BLOCK_AREA> scale = [] {
+            std::array<T, DCT_BLOCK_AREA> s{};
+            for (size_t i = 0; i < DCT_BLOCK_SIZE; ++i) {
+                for (size_t j = 0; j < DCT_BLOCK_SIZE; ++j) {
+                    s[i * DCT_BLOCK_SIZE + j] = static_cast<T>(1.0 / (8.0 * aanScale(i) * aanScale(j)));
+                }
+            }
+            return s;
+        }();
+        return scale;
+    }
+
+    /**
+     * The pre-scale of the orthonormal inverse transform, aanScale(i) * aanScale(j) / 8.
+     */
+    template <typename T>
+    static const std::array<T, DCT_BLOCK_AREA>& unitPreScale() {
+        static const std::array<T, DCT_BLOCK_AREA> scale = [] {
+            std::array<T, DCT_BLOCK_AREA> s{};
+            for (size_t i = 0; i < DCT_BLOCK_SIZE; ++i) {
+                for (size_t j = 0; j < DCT_BLOCK_SIZE; ++j) {
+                    s[i * DCT_BLOCK_SIZE + j] = static_cast<T>(aanScale(i) * aanScale(j) / 8.0);
+                }
+            }
+            return s;
+        }();
+        return scale;
+    }
+
+    /**
+     * Transpose an 8x8 block in place.
+     */
+    template <typename T>
+    static void transpose(T* block) {
+        for (size_t i = 0; i < DCT_BLOCK_SIZE; ++i) {
+            for (size_t j = i + 1; j < DCT_BLOCK_SIZE; ++j) {
+                std::swap(block[i * DCT_BLOCK_SIZE + j], block[j * DCT_BLOCK_SIZE + i]);
+            }
+        }
+    }
+
+    /**
+     * Unscaled AAN forward DCT of the 8 columns of a block (one SIMD lane per column).
+     */
+    template <typename T>
+    static void forwardColumns(T* block) {
+        #pragma omp simd
+        for (size_t j = 0; j < DCT_BLOCK_SIZE; ++j) {
+            T* d = block + j;
+            constexpr size_t S = DCT_BLOCK_SIZE;
+
+            // even part
+            const T tmp0 = d[0] + d[7 * S], tmp7 = d[0] - d[7 * S];
+            const T tmp1 = d[S] + d[6 * S], tmp6 = d[S] - d[6 * S];
+            const T tmp2 = d[2 * S] + d[5 * S], tmp5 = d[2 * S] - d[5 * S];
+            const T tmp3 = d[3 * S] + d[4 * S], tmp4 = d[3 * S] - d[4 * S];
+
+            const T tmp10 = tmp0 + tmp3, tmp13 = tmp0 - tmp3;
+            const T tmp11 = tmp1 + tmp2, tmp12 = tmp1 - tmp2;
+
+            d[0] = tmp10 + tmp11;
+            d[4 * S] = tmp10 - tmp11;
+            const T z1 = (tmp12 + tmp13) * static_cast<T>(C4);
+            d[2 * S] = tmp13 + z1;
+            d[6 * S] = tmp13 - z1;
+
+            // odd part
+            const T odd10 = tmp4 + tmp5, odd11 = tmp5 + tmp6, odd12 = tmp6 + tmp7;
+            const T z5 = (odd10 - odd12) * static_cast<T>(C6);
+            const T z2 = static_cast<T>(C2_MINUS_C6) * odd10 + z5;
+            const T z4 = static_cast<T>(C2_PLUS_C6) * odd12 + z5;
+            const T z3 = odd11 * static_cast<T>(C4);
+            const T z11 = tmp7 + z3, z13 = tmp7 - z3;
+
+            d[5 * S] = z13 + z2;
+            d[3 * S] = z13 - z2;
+            d[S] = z11 + z4;
+            d[7 * S] = z11 - z4;
+        }
+    }
+
+    /**
+     * Unscaled AAN inverse DCT of the 8 columns of a block (one SIMD lane per column).
+     */
+    template <typename T>
+    static void inverseColumns(T* block) {
+        #pragma omp simd
+        for (size_t j = 0; j < DCT_BLOCK_SIZE; ++j) {
+            T* d = block + j;
+            constexpr size_t S = DCT_BLOCK_SIZE;
+
+            // even part
+            const T tmp10 = d[0] + d[4 * S], tmp11 = d[0] - d[4 * S];
+            const T tmp13 = d[2 * S] + d[6 * S];
+            const T tmp12 = (d[2 * S] - d[6 * S]) * static_cast<T>(SQRT2) - tmp13;
+
+            const T even0 = tmp10 + tmp13, even3 = tmp10 - tmp13;
+            const T even1 = tmp11 + tmp12, even2 = tmp11 - tmp12;
+
+            // odd part
+            const T z13 = d[5 * S] + d[3 * S], z10 = d[5 * S] - d[3 * S];
+            const T z11 = d[S] + d[7 * S], z12 = d[S] - d[7 * S];
+
+            const T odd7 = z11 + z13;
+            const T odd11 = (z11 - z13) * static_cast<T>(SQRT2);
+            const T z5 = (z10 + z12) * static_cast<T>(TWO_C2);
+            const T odd10 = z5 - z12 * static_cast<T>(TWO_C2_MINUS_C6);
+            const T odd12 = z5 - z10 * static_cast<T>(TWO_C2_PLUS_C6);
+
+            const T odd6 = odd12 - odd7;
+            const T odd5 = odd11 - odd6;
+            const T odd4 = odd10 - odd5;
+
+            d[0] = even0 + odd7;
+            d[7 * S] = even0 - odd7;
+            d[S] = even1 + odd6;
+            d[6 * S] = even1 - odd6;
+            d[2 * S] = even2 + odd5;
+            d[5 * S] = even2 - odd5;
+            d[3 * S] = even3 + odd4;
+            d[4 * S] = even3 - odd4;
+        }
+    }
+
+    /**
+     * AAN forward 2D DCT followed by the post-scale.
+     */
+    template <typename T>
+    static void forward8x8(T* block, const T* postScale) {
+        forwardColumns(block);
+        transpose(block);
+        forwardColumns(block);
+        transpose(block);
+        #pragma omp simd
+        for (size_t i = 0; i < DCT_BLOCK_AREA; ++i) {
+            block[i] *= postScale[i];
+        }
+    }
+
+    /**
+     * Pre-scale followed by the AAN inverse 2D DCT.
+     */
+    template <typename T>
+    static void inverse8x8(T* block, const T* preScale) {
+        #pragma omp simd
+        for (size_t i = 0; i < DCT_BLOCK_AREA; ++i) {
+            block[i] *= preScale[i];
+        }
+        inverseColumns(block);
+        transpose(block);
+        inverseColumns(block);
+        transpose(block);
+    }
+
+    /**
+     * Build a quantization post-scale: unit post-scale divided by the quantization matrix.
+     */
+    template <typename T>
+    static void quantizationScale(const double* quantization, T* postScale) {
+        for (size_t i = 0; i < DCT_BLOCK_SIZE; ++i) {
+            for (size_t j = 0; j < DCT_BLOCK_SIZE; ++j) {
+                const size_t index = i * DCT_BLOCK_SIZE + j;
+                postScale[index] = static_cast<T>(
+                    1.0 / (8.0 * aanScale(i) * aanScale(j) * quantization[index])
+                );
+            }
+        }
+    }
+
+    /**
+     * Build a dequantization pre-scale: unit pre-scale multiplied by the quantization matrix.
+     */
+    template <typename T>
+    static void dequantizationScale(const double* quantization, T* preScale) {
+        for (size_t i = 0; i < DCT_BLOCK_SIZE; ++i) {
+            for (size_t j = 0; j < DCT_BLOCK_SIZE; ++j) {
+                const size_t index = i * DCT_BLOCK_SIZE + j;
+                preScale[index] = static_cast<T>(aanScale(i) * aanScale(j) * quantization[index] / 8.0);
+            }
+        }
+    }
+
+    void computeDCT8x8(double* block) {
+        forward8x8(block, unitPostScale<double>().data());
+    }
+
+    void computeDCT8x8(float* block) {
+        forward8x8(block, unitPostScale<float>().data());
+    }
+
+    void computeDCT8x8Scaled(double* block, const double* postScale) {
+        forward8x8(block, postScale);
+    }
+
+    void computeDCT8x8Scaled(float* block, const float* postScale) {
+        forward8x8(block, postScale);
+    }
+
+    void computeIDCT8x8(double* block) {
+        inverse8x8(block, unitPreScale<double>().data());
+    }
+
+    void computeIDCT8x8(float* block) {
+        inverse8x8(block, unitPreScale<float>().data());
+    }
+
+    void computeIDCT8x8Scaled(double* block, const double* preScale) {
+        inverse8x8(block, preScale);
+    }
+
+    void computeIDCT8x8Scaled(float* block, const float* preScale) {
+        inverse8x8(block, preScale);
+    }
+
+    void makeDCT8x8QuantizationScale(const double* quantization, double* postScale) {
+        quantizationScale(quantization, postScale);
+    }
+
+    void makeDCT8x8QuantizationScale(const double* quantization, float* postScale) {
+        quantizationScale(quantization, postScale);
+    }
+
+    void makeIDCT8x8DequantizationScale(const double* quantization, double* preScale) {
+        dequantizationScale(quantization, preScale);
+    }
+
+    void makeIDCT8x8DequantizationScale(const double* quantization, float* preScale) {
+        dequantizationScale(quantization, preScale);
+    }
+}
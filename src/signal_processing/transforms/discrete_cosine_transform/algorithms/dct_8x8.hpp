@@ -0,0 +1,128 @@
+#ifndef DCT_8X8_HPP
+#define DCT_8X8_HPP
+
+#include <cstddef>
+
+namespace sp::dct::algo {
+    /**
+     * Side of the blocks of the fixed-size kernels (JPEG blocks).
+     */
+    constexpr size_t DCT_BLOCK_SIZE = 8;
+
+    /**
+     * Number of samples of a block (DCT_BLOCK_SIZE * DCT_BLOCK_SIZE), stored row-major.
+     */
+    constexpr size_t DCT_BLOCK_AREA = DCT_BLOCK_SIZE * DCT_BLOCK_SIZE;
+
+    /**
+     * Fast 8x8 Discrete Cosine Transform (DCT-II) of a block, in place.
+     *
+     * Same result of computeDCT2d on an 8x8 matrix, computed with the Arai-Agui-Nakajima (AAN)
+     * factorization: each 1D pass needs only 5 multiplications and 29 additions, the remaining
+     * 8 scaling factors per dimension are applied once at the end (post-scale).
+     *
+     * The 1D passes are vectorized: the column pass transforms the 8 columns at once
+     * (one SIMD lane per column), and the row pass is a column pass on the transposed block.
+     *
+     * @param block The 64 samples of the block, row-major.
+     */
+    void computeDCT8x8(double* block);
+
+    /**
+     * Fast 8x8 Discrete Cosine Transform (DCT-II) of a block, in place (single precision).
+     *
+     * @param block The 64 samples of the block, row-major.
+     */
+    void computeDCT8x8(float* block);
+
+    /**
+     * Fast 8x8 DCT-II with a custom post-scale, in place.
+     *
+     * The output is the raw AAN output multiplied element-wise by postScale, which lets the caller
+     * fold more work in the same multiplication (e.g. the quantization, see makeDCT8x8QuantizationScale).
+     *
+     * @param block The 64 samples of the block, row-major.
+     * @param postScale The 64 output multipliers, row-major.
+     */
+    void computeDCT8x8Scaled(double* block, const double* postScale);
+
+    /**
+     * Fast 8x8 DCT-II with a custom post-scale, in place (single precision).
+     *
+     * @param block The 64 samples of the block, row-major.
+     * @param postScale The 64 output multipliers, row-major.
+     */
+    void computeDCT8x8Scaled(float* block, const float* postScale);
+
+    /**
+     * Fast 8x8 Inverse Discrete Cosine Transform (DCT-III) of a block, in place.
+     *
+     * Same result of computeIDCT2d on an 8x8 matrix, computed with the AAN factorization
+     * (the scaling factors are applied once at the beginning, pre-scale).
+     *
+     * @param block The 64 coefficients of the block, row-major.
+     */
+    void computeIDCT8x8(double* block);
+
+    /**
+     * Fast 8x8 Inverse Discrete Cosine Transform (DCT-III) of a block, in place (single precision).
+     *
+     * @param block The 64 coefficients of the block, row-major.
+     */
+    void computeIDCT8x8(float* block);
+
+    /**
+     * Fast 8x8 DCT-III with a custom pre-scale, in place.
+     *
+     * The input is multiplied element-wise by preScale before the AAN passes, which lets the caller
+     * fold more work in the same multiplication (e.g. the dequantization, see makeIDCT8x8DequantizationScale).
+     *
+     * @param block The 64 coefficients of the block, row-major.
+     * @param preScale The 64 input multipliers, row-major.
+     */
+    void computeIDCT8x8Scaled(double* block, const double* preScale);
+
+    /**
+     * Fast 8x8 DCT-III with a custom pre-scale, in place (single precision).
+     *
+     * @param block The 64 coefficients of the block, row-major.
+     * @param preScale The 64 input multipliers, row-major.
+     */
+    void computeIDCT8x8Scaled(float* block, const float* preScale);
+
+    /**
+     * Build the post-scale that makes computeDCT8x8Scaled return the quantized coefficients
+     * (orthonormal DCT divided by the quantization matrix, before rounding).
+     *
+     * @param quantization The 64 entries of the quantization matrix, row-major.
+     * @param postScale The 64 output multipliers (output).
+     */
+    void makeDCT8x8QuantizationScale(const double* quantization, double* postScale);
+
+    /**
+     * Single precision version of makeDCT8x8QuantizationScale.
+     *
+     * @param quantization The 64 entries of the quantization matrix, row-major.
+     * @param postScale The 64 output multipliers (output).
+     */
+    void makeDCT8x8QuantizationScale(const double* quantization, float* postScale);
+
+    /**
+     * Build the pre-scale that makes computeIDCT8x8Scaled take the quantized coefficients
+     * (they are multiplied by the quantization matrix and inverse transformed).
+     *
+     * @param quantization The 64 entries of the quantization matrix, row-major.
+     * @param preScale The 64 input multipliers (output).
+     */
+    void makeIDCT8x8DequantizationScale(const double* quantization, double* preScale);
+
+    /**
+     * Single precision version of makeIDCT8x8DequantizationScale.
+     *
+     * @param quantization The 64 entries of the quantization matrix, row-major.
+     * @param preScale The 64 input multipliers (output).
+     */
+    void makeIDCT8x8DequantizationScale(const double* quantization, float* preScale);
+}
+
+#endif //DCT_8X8_HPP
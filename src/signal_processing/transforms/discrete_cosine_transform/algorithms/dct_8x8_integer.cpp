@@ -0,0 +1,349 @@
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "transforms/discrete_cosine_transform/algorithms/dct_8x8_integer.hpp"
+
+namespace sp::dct::algo {
+    /**
+     * Fractional bits of the ISLOW constants and extra bits kept between the two passes.
+     */
+    constexpr int ISLOW_CONST_BITS = 13;
+    constexpr int ISLOW_PASS1_BITS = 2;
+
+    /**
+     * ISLOW constants: round(x * 2^13).
+     */
+    constexpr int32_t FIX_0_298631336 = 2446;
+    constexpr int32_t FIX_0_390180644 = 3196;
+    constexpr int32_t FIX_0_541196100 = 4433;
+    constexpr int32_t FIX_0_765366865 = 6270;
+    constexpr int32_t FIX_0_899976223 = 7373;
+    constexpr int32_t FIX_1_175875602 = 9633;
+    constexpr int32_t FIX_1_501321110 = 12299;
+    constexpr int32_t FIX_1_847759065 = 15137;
+    constexpr int32_t FIX_1_961570560 = 16069;
+    constexpr int32_t FIX_2_053119869 = 16819;
+    constexpr int32_t FIX_2_562915447 = 20995;
+    constexpr int32_t FIX_3_072711026 = 25172;
+
+    /**
+     * Fractional bits of the IFAST constants and extra bits kept between the two inverse passes.
+     */
+    constexpr int IFAST_CONST_BITS = 8;
+    constexpr int IFAST_PASS1_BITS = 2;
+
+    /**
+     * IFAST constants: round(x * 2^8).
+     */
+    constexpr int32_t IFAST_0_382683433 = 98;
+    constexpr int32_t IFAST_0_541196100 = 139;
+    constexpr int32_t IFAST_0_707106781 = 181;
+    constexpr int32_t IFAST_1_306562965 = 334;
+    constexpr int32_t IFAST_1_082392200 = 277;
+    constexpr int32_t IFAST_1_414213562 = 362;
+    constexpr int32_t IFAST_1_847759065 = 473;
+    constexpr int32_t IFAST_2_613125930 = 669;
+
+    /**
+     * Divide by 2^n rounding to the nearest integer.
+     */
+    static inline int32_t descale(const int32_t x, const int n) {
+        return (x + (1 << (n - 1))) >> n;
+    }
+
+    /**
+     * Multiply by an IFAST constant.
+     */
+    static inline int32_t ifastMultiply(const int32_t x, const int32_t constant) {
+        return descale(x * constant, IFAST_CONST_BITS);
+    }
+
+    /**
+     * One ISLOW forward pass over the 8 lines of a block.
+     *
+     * @param block The block.
+     * @param step Distance between two samples of the same line (1 for rows, 8 for columns).
+     * @param lineStep Distance between the first samples of two lines (8 for rows, 1 for columns).
+     * @param first True for the first pass (the outputs keep PASS1_BITS extra bits).
+     */
+    static void islowForwardPass(int32_t* block, const int step, const int lineStep, const bool first) {
+        const int evenShift = first ? 0 : ISLOW_PASS1_BITS;
+        const int evenUp = first ? ISLOW_PASS1_BITS : 0;
+        const int shift = first ? ISLOW_CONST_BITS - ISLOW_PASS1_BITS : ISLOW_CONST_BITS + ISLOW_PASS1_BITS;
+
+        #pragma omp simd
+        for (int line = 0; line < 8; ++line) {
+            int32_t* d = block + line * lineStep;
+
+            int32_t tmp0 = d[0] + d[7 * step], tmp7 = d[0] - d[7 * step];
+            int32_t tmp1 = d[step] + d[6 * step], tmp6 = d[step] - d[6 * step];
+            int32_t tmp2 = d[2 * step] + d[5 * step], tmp5 = d[2 * step] - d[5 * step];
+            int32_t tmp3 = d[3 * step] + d[4 * step], tmp4 = d[3 * step] - d[4 * step];
+
+            // even part
+            const int32_t tmp10 = tmp0 + tmp3, tmp13 = tmp0 - tmp3;
+            const int32_t tmp11 = tmp1 + tmp2, tmp12 = tmp1 - tmp2;
+
+            if (first) {
+                d[0] = (tmp10 + tmp11) << evenUp;
+                d[4 * step] = (tmp10 - tmp11) << evenUp;
+            } else {
+                d[0] = descale(tmp10 + tmp11, evenShift);
+                d[4 * step] = descale(tmp10 - tmp11, evenShift);
+            }
+
+            const int32_t z1 = (tmp12 + tmp13) * FIX_0_541196100;
+            d[2 * step] = descale(z1 + tmp13 * FIX_0_765366865, shift);
+            d[6 * step] = descale(z1 - tmp12 * FIX_1_847759065, shift);
+
+            // odd part
+            int32_t o1 = tmp4 + tmp7, o2 = tmp5 + tmp6, o3 = tmp4 + tmp6, o4 = tmp5 + tmp7;
+            const int32_t z5 = (o3 + o4) * FIX_1_175875602;
+
+            tmp4 *= FIX_0_298631336;
+            tmp5 *= FIX_2_053119869;
+            tmp6 *= FIX_3_072711026;
+            tmp7 *= FIX_1_501321110;
+            o1 *= -FIX_0_899976223;
+            o2 *= -FIX_2_562915447;
+            o3 = o3 * -FIX_1_961570560 + z5;
+            o4 = o4 * -FIX_0_390180644 + z5;
+
+            d[7 * step] = descale(tmp4 + o1 + o3, shift);
+            d[5 * step] = descale(tmp5 + o2 + o4, shift);
+            d[3 * step] = descale(tmp6 + o2 + o3, shift);
+            d[step] = descale(tmp7 + o1 + o4, shift);
+        }
+    }
+
+    /**
+     * One ISLOW inverse pass over the 8 lines of a block.
+     *
+     * @param block The block.
+     * @param step Distance between two samples of the same line (1 for rows, 8 for columns).
+     * @param lineStep Distance between the first samples of two lines (8 for rows, 1 for columns).
+     * @param first True for the first pass (the outputs keep PASS1_BITS extra bits).
+     */
+    static void islowInversePass(int32_t* block, const int step, const int lineStep, const bool first) {
+        const int shift = first ? ISLOW_CONST_BITS - ISLOW_PASS1_BITS : ISLOW_CONST_BITS + ISLOW_PASS1_BITS + 3;
+
+        #pragma omp simd
+        for (int line = 0; line < 8; ++line) {
+            int32_t* d = block + line * lineStep;
+
+            // even part
+            const int32_t z1 = (d[2 * step] + d[6 * step]) * FIX_0_541196100;
+            const int32_t even2 = z1 - d[6 * step] * FIX_1_847759065;
+            const int32_t even3 = z1 + d[2 * step] * FIX_0_765366865;
+            const int32_t even0 = (d[0] + d[4 * step]) * (1 << ISLOW_CONST_BITS);
+            const int32_t even1 = (d[0] - d[4 * step]) * (1 << ISLOW_CONST_BITS);
+
+            const int32_t tmp10 = even0 + even3, tmp13 = even0 - even3;
+            const int32_t tmp11 = even1 + even2, tmp12 = even1 - even2;
+
+            // odd part
+            int32_t tmp0 = d[7 * step], tmp1 = d[5 * step], tmp2 = d[3 * step], tmp3 = d[step];
+            int32_t o1 = tmp0 + tmp3, o2 = tmp1 + tmp2, o3 = tmp0 + tmp2, o4 = tmp1 + tmp3;
+            const int32_t z5 = (o3 + o4) * FIX_1_175875602;
+
+            tmp0 *= FIX_0_298631336;
+            tmp1 *= FIX_2_053119869;
+            tmp2 *= FIX_3_072711026;
+            tmp3 *= FIX_1_501321110;
+            o1 *= -FIX_0_899976223;
+            o2 *= -FIX_2_562915447;
+            o3 = o3 * -FIX_1_961570560 + z5;
+            o4 = o4 * -FIX_0_390180644 + z5;
+
+            tmp0 += o1 + o3;
+            tmp1 += o2 + o4;
+            tmp2 += o2 + o3;
+            tmp3 += o1 + o4;
+
+            d[0] = descale(tmp10 + tmp3, shift);
+            d[7 * step] = descale(tmp10 - tmp3, shift);
+            d[step] = descale(tmp11 + tmp2, shift);
+            d[6 * step] = descale(tmp11 - tmp2, shift);
+            d[2 * step] = descale(tmp12 + tmp1, shift);
+            d[5 * step] = descale(tmp12 - tmp1, shift);
+            d[3 * step] = descale(tmp13 + tmp0, shift);
+            d[4 * step] = descale(tmp13 - tmp0, shift);
+        }
+    }
+
+    /**
+     * One IFAST forward pass over the 8 lines of a block.
+     *
+     * @param block The block.
+     * @param step Distance between two samples of the same line (1 for rows, 8 for columns).
+     * @param lineStep Distance between the first samples of two lines (8 for rows, 1 for columns).
+     */
+    static void ifastForwardPass(int32_t* block, const int step, const int lineStep) {
+        #pragma omp simd
+        for (int line = 0; line < 8; ++line) {
+            int32_t* d = block + line * lineStep;
+
+            const int32_t tmp0 = d[0] + d[7 * step], tmp7 = d[0] - d[7 * step];
+            const int32_t tmp1 = d[step] + d[6 * step], tmp6 = d[step] - d[6 * step];
+            const int32_t tmp2 = d[2 * step] + d[5 * step], tmp5 = d[2 * step] - d[5 * step];
+            const int32_t tmp3 = d[3 * step] + d[4 * step], tmp4 = d[3 * step] - d[4 * step];
+
+            // even part
+            const int32_t tmp10 = tmp0 + tmp3, tmp13 = tmp0 - tmp3;
+            const int32_t tmp11 = tmp1 + tmp2, tmp12 = tmp1 - tmp2;
+
+            d[0] = tmp10 + tmp11;
+            d[4 * step] = tmp10 - tmp11;
+            const int32_t z1 = ifastMultiply(tmp12 + tmp13, IFAST_0_707106781);
+            d[2 * step] = tmp13 + z1;
+            d[6 * step] = tmp13 - z1;
+
+            // odd part
+            const int32_t odd10 = tmp4 + tmp5, odd11 = tmp5 + tmp6, odd12 = tmp6 + tmp7;
+            const int32_t z5 = ifastMultiply(odd10 - odd12, IFAST_0_382683433);
+            const int32_t z2 = ifastMultiply(odd10, IFAST_0_541196100) + z5;
+            const int32_t z4 = ifastMultiply(odd12, IFAST_1_306562965) + z5;
+            const int32_t z3 = ifastMultiply(odd11, IFAST_0_707106781);
+            const int32_t z11 = tmp7 + z3, z13 = tmp7 - z3;
+
+            d[5 * step] = z13 + z2;
+            d[3 * step] = z13 - z2;
+            d[step] = z11 + z4;
+            d[7 * step] = z11 - z4;
+        }
+    }
+
+    /**
+     * One IFAST inverse pass over the 8 lines of a block.
+     *
+     * @param block The block.
+     * @param step Distance between two samples of the same line (1 for rows, 8 for columns).
+     * @param lineStep Distance between the first samples of two lines (8 for rows, 1 for columns).
+     * @param first True for the first pass (the outputs keep PASS1_BITS extra bits).
+     */
+    static void ifastInversePass(int32_t* block, const int step, const int lineStep, const bool first) {
+        #pragma omp simd
+        for (int line = 0; line < 8; ++line) {
+            int32_t* d = block + line * lineStep;
+
+            // even part
+            const int32_t tmp10 = d[0] + d[4 * step], tmp11 = d[0] - d[4 * step];
+            const int32_t tmp13 = d[2 * step] + d[6 * step];
+            const int32_t tmp12 = ifastMultiply(d[2 * step] - d[6 * step], IFAST_1_414213562) - tmp13;
+
+            const int32_t even0 = tmp10 + tmp13, even3 = tmp10 - tmp13;
+            const int32_t even1 = tmp11 + tmp12, even2 = tmp11 - tmp12;
+
+            // odd part
+            const int32_t z13 = d[5 * step] + d[3 * step], z10 = d[5 * step] - d[3 * step];
+            const int32_t z11 = d[step] + d[7 * step], z12 = d[step] - d[7 * step];
+
+            const int32_t odd7 = z11 + z13;
+            const int32_t odd11 = ifastMultiply(z11 - z13, IFAST_1_414213562);
+            const int32_t z5 = ifastMultiply(z10 + z12, IFAST_1_847759065);
+            const int32_t odd10 = ifastMultiply(z12, IFAST_1_082392200) - z5;
+            const int32_t odd12 = z5 - ifastMultiply(z10, IFAST_2_613125930);
+
+            const int32_t odd6 = odd12 - odd7;
+            const int32_t odd5 = odd11 - odd6;
+            const int32_t odd4 = odd10 + odd5;
+
+            int32_t out[8] = {
+                even0 + odd7, even1 + odd6, even2 + odd5, even3 - odd4,
+                even3 + odd4, even2 - odd5, even1 - odd6, even0 - odd7
+            };
+            for (int k = 0; k < 8; ++k) {
+                d[k * step] = first ? out[k] : descale(out[k], IFAST_PASS1_BITS + 3);
+            }
+        }
+    }
+
+    void computeDCT8x8Islow(int32_t* block) {
+        islowForwardPass(block, 1, DCT_BLOCK_SIZE, true);
+        islowForwardPass(block, DCT_BLOCK_SIZE, 1, false);
+    }
+
+    void computeDCT8x8Ifast(int32_t* block) {
+        ifastForwardPass(block, 1, DCT_BLOCK_SIZE);
+        ifastForwardPass(block, DCT_BLOCK_SIZE, 1);
+    }
+
+    void computeIDCT8x8Islow(int32_t* block) {
+        islowInversePass(block, DCT_BLOCK_SIZE, 1, true);
+        islowInversePass(block, 1, DCT_BLOCK_SIZE, false);
+    }
+
+    void computeIDCT8x8Ifast(int32_t* block) {
+        ifastInversePass(block, DCT_BLOCK_SIZE, 1, true);
+        ifastInversePass(block, 1, DCT_BLOCK_SIZE, false);
+    }
+
+    void computeDCT8x8Integer(int32_t* block, const IntegerDCTMethod method) {
+        if (method == IntegerDCTMethod::IFAST) {
+            computeDCT8x8Ifast(block);
+        } else {
+            computeDCT8x8Islow(block);
+        }
+    }
+
+    void computeIDCT8x8Integer(int32_t* block, const IntegerDCTMethod method) {
+        if (method == IntegerDCTMethod::IFAST) {
+            computeIDCT8x8Ifast(block);
+        } else {
+            computeIDCT8x8Islow(block);
+        }
+    }
+
+    /**
+     * The AAN scaling factor of the frequency k: 1 for k = 0, sqrt(2) * cos(k * pi / 16) otherwise.
+     */
+    static double aanScale(const size_t k) {
+        return k == 0 ? 1.0 : std::sqrt(2.0) * std::cos(static_cast<double>(k) * M_PI / 16.0);
+    }
+
+    IntegerQuantizer::IntegerQuantizer(const double* quantization, const IntegerDCTMethod method)
+        : method(method) {
+        for (size_t i = 0; i < DCT_BLOCK_SIZE; ++i) {
+            for (size_t j = 0; j < DCT_BLOCK_SIZE; ++j) {
+                const size_t index = i * DCT_BLOCK_SIZE + j;
+                const double q = std::round(quantization[index]);
+                if (q < 1.0 || q > 65535.0) {
+                    throw std::invalid_argument(
+                        "The quantization entries must be in [1, 65535]. Given: " + std::to_string(quantization[index])
+                    );
+                }
+
+                // scaling of the forward DCT output and of the inverse DCT input
+                const double forwardScale = method == IntegerDCTMethod::IFAST ? 8.0 * aanScale(i) * aanScale(j) : 8.0;
+                const double inverseScale = method == IntegerDCTMethod::IFAST ? 4.0 * aanScale(i) * aanScale(j) : 1.0;
+
+                const double divisor = q * forwardScale;
+                // shift = 30 + e with divisor = m * 2^e, m in [0.5, 1), so that the reciprocal is in (2^30, 2^31]
+                int exponent;
+                std::frexp(divisor, &exponent);
+                this->shift[index] = static_cast<uint32_t>(30 + exponent);
+                this->reciprocal[index] = static_cast<uint32_t>(std::ceil(std::ldexp(1.0, 30 + exponent) / divisor));
+                this->multiplier[index] = static_cast<int32_t>(std::lround(q * inverseScale));
+            }
+        }
+    }
+
+    void IntegerQuantizer::quantize(const int32_t* block, int16_t* coefficients) const {
+        #pragma omp simd
+        for (size_t k = 0; k < DCT_BLOCK_AREA; ++k) {
+            const int32_t c = block[k];
+            const auto magnitude = static_cast<uint64_t>(c < 0 ? -c : c);
+            const uint64_t half = static_cast<uint64_t>(1) << (this->shift[k] - 1);
+            const auto q = static_cast<int32_t>((magnitude * this->reciprocal[k] + half) >> this->shift[k]);
+            coefficients[k] = static_cast<int16_t>(c < 0 ? -q : q);
+        }
+    }
+
+    void IntegerQuantizer::dequantize(const int16_t* coefficients, int32_t* block) const {
+        #pragma omp simd
+        for (size_t k = 0; k < DCT_BLOCK_AREA; ++k) {
+            block[k] = static_cast<int32_t>(coefficients[k]) * this->multiplier[k];
+        }
+    }
+}
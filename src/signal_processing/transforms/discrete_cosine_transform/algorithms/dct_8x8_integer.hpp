@@ -0,0 +1,146 @@
+#ifndef DCT_8X8_INTEGER_HPP
+#define DCT_8X8_INTEGER_HPP
+
+#include <cstdint>
+
+#include "transforms/discrete_cosine_transform/algorithms/dct_8x8.hpp"
+
+namespace sp::dct::algo {
+    /**
+     * Fixed-point 8x8 DCT algorithms (same naming of the IJG libjpeg).
+     */
+    enum class IntegerDCTMethod {
+        /**
+         * Accurate: Loeffler-Ligtenberg-Moschytz factorization with 13-bit constants (12 multiplications per pass).
+         */
+        ISLOW,
+        /**
+         * Fast: AAN factorization with 8-bit constants (5 multiplications per pass), the scaling is folded
+         * in the quantization; less accurate, especially with fine quantization.
+         */
+        IFAST
+    };
+
+    /**
+     * Fixed-point 8x8 forward DCT, accurate version (in place).
+     *
+     * The input are the samples centered in 0 (e.g. pixel - 128), the output are the orthonormal
+     * DCT coefficients (same of computeDCT8x8) multiplied by 8.
+     * All the arithmetic is on 32-bit integers.
+     *
+     * @param block The 64 samples of the block, row-major.
+     */
+    void computeDCT8x8Islow(int32_t* block);
+
+    /**
+     * Fixed-point 8x8 forward DCT, fast version (in place).
+     *
+     * The output are the orthonormal DCT coefficients multiplied by 8 * aan(i) * aan(j), where
+     * aan(0) = 1 and aan(k) = sqrt(2) * cos(k * pi / 16); the IntegerQuantizer removes this scaling.
+     *
+     * @param block The 64 samples of the block, row-major.
+     */
+    void computeDCT8x8Ifast(int32_t* block);
+
+    /**
+     * Fixed-point 8x8 inverse DCT, accurate version (in place).
+     *
+     * The input are the orthonormal DCT coefficients (e.g. dequantized by IntegerQuantizer),
+     * the output are the samples centered in 0, rounded to the nearest integer.
+     *
+     * @param block The 64 coefficients of the block, row-major.
+     */
+    void computeIDCT8x8Islow(int32_t* block);
+
+    /**
+     * Fixed-point 8x8 inverse DCT, fast version (in place).
+     *
+     * The input are the orthonormal DCT coefficients multiplied by 4 * aan(i) * aan(j)
+     * (the IntegerQuantizer applies this scaling during the dequantization).
+     *
+     * @param block The 64 coefficients of the block, row-major.
+     */
+    void computeIDCT8x8Ifast(int32_t* block);
+
+    /**
+     * Fixed-point 8x8 forward DCT with the chosen method (in place).
+     *
+     * @param block The 64 samples of the block, row-major.
+     * @param method The algorithm.
+     */
+    void computeDCT8x8Integer(int32_t* block, IntegerDCTMethod method);
+
+    /**
+     * Fixed-point 8x8 inverse DCT with the chosen method (in place).
+     *
+     * @param block The 64 coefficients of the block, row-major.
+     * @param method The algorithm.
+     */
+    void computeIDCT8x8Integer(int32_t* block, IntegerDCTMethod method);
+
+    /**
+     * Integer quantization and dequantization of the output of the fixed-point DCTs.
+     *
+     * The quantization divides by the scaled divisors d[k] (the quantization matrix times the scaling
+     * of the chosen forward DCT) without divisions: q = (|c| * r + 2^(s - 1)) >> s with sign,
+     * where r = ceil(2^s / d) is a precomputed 32-bit reciprocal of the exact (non-integer) divisor,
+     * so the result is the division rounded half away from zero, like std::round.
+     * The dequantization is a single integer multiplication by the quantization matrix times
+     * the scaling expected by the chosen inverse DCT.
+     */
+    class IntegerQuantizer {
+    public:
+        /**
+         * Create the tables for a quantization matrix.
+         *
+         * @param quantization The 64 entries of the quantization matrix, row-major (rounded to integers).
+         * @param method The fixed-point DCT that produces and consumes the coefficients.
+         * @throws std::invalid_argument if an entry of the quantization matrix is not in [1, 65535].
+         */
+        IntegerQuantizer(const double* quantization, IntegerDCTMethod method);
+
+        /**
+         * Quantize the output of the forward DCT (rounding to the nearest integer).
+         *
+         * @param block The 64 outputs of computeDCT8x8Integer.
+         * @param coefficients The 64 quantized coefficients (output).
+         */
+        void quantize(const int32_t* block, int16_t* coefficients) const;
+
+        /**
+         * Dequantize the coefficients into the input of the inverse DCT.
+         *
+         * @param coefficients The 64 quantized coefficients.
+         * @param block The 64 inputs of computeIDCT8x8Integer (output).
+         */
+        void dequantize(const int16_t* coefficients, int32_t* block) const;
+
+        /**
+         * Get the DCT method of the tables.
+         * @return The method.
+         */
+        [[nodiscard]] IntegerDCTMethod getMethod() const {
+            return method;
+        }
+
+    private:
+        /**
+         * The DCT method.
+         */
+        IntegerDCTMethod method;
+        /**
+         * The reciprocals of the scaled divisors.
+         */
+        uint32_t reciprocal[DCT_BLOCK_AREA];
+        /**
+         * The shifts of the reciprocals.
+         */
+        uint32_t shift[DCT_BLOCK_AREA];
+        /**
+         * The dequantization multipliers.
+         */
+        int32_t multiplier[DCT_BLOCK_AREA];
+    };
+}
+
+#endif //DCT_8X8_INTEGER_HPP
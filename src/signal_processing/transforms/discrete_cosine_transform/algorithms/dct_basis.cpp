@@ -0,0 +1,328 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <omp.h>
+
+#include "transforms/discrete_cosine_transform/algorithms/dct_basis.hpp"
+
+namespace sp::dct::algo {
+    /**
+     * Number of output columns processed together by a thread (4 KiB of doubles per row).
+     */
+    constexpr size_t COLUMN_BLOCK = 512;
+
+    /**
+     * Number of rows of A that share the same row of B in multiplyTransposed.
+     */
+    constexpr size_t ROW_BLOCK = 4;
+
+    /**
+     * Build the orthonormal DCT-II basis of length N (row-major).
+     */
+    static std::shared_ptr<const std::vector<double>> buildBasis(const size_t length) {
+        auto basis = std::make_shared<std::vector<double>>(length * length);
+        const double N = static_cast<double>(length);
+        for (size_t k = 0; k < length; ++k) {
+            const double alpha = k == 0 ? std::sqrt(1.0 / N) : std::sqrt(2.0 / N);
+            for (size_t n = 0; n < length; ++n) {
+                // cos(pi * (2n + 1) * k / (2N)), with the argument reduced modulo 4N for accuracy
+                const size_t phase = ((2 * n + 1) * k) % (4 * length);
+                (*basis)[k * length + n] = alpha * std::cos(M_PI * static_cast<double>(phase) / (2.0 * N));
+            }
+        }
+        return basis;
+    }
+
+    DCTBasisCache::DCTBasisCache(const size_t capacity) : capacity(capacity), usage(0) {}
+
+    std::shared_ptr<const std::vector<double>> DCTBasisCache::get(const size_t length) {
+        if (length == 0) {
+            throw std::invalid_argument("The DCT basis length must be greater than 0. Given: 0");
+        }
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            const auto it = this->index.find(length);
+            if (it != this->index.end()) {
+                // move to the front (most recently used)
+                this->entries.splice(this->entries.begin(), this->entries, it->second);
+                return it->second->second;
+            }
+        }
+
+        // build outside of the lock, so that other lengths are not blocked
+        auto basis = buildBasis(length);
+        const size_t entrySize = length * length;
+        if (entrySize > this->capacity) {
+            return basis;
+        }
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        // another thread may have inserted the same length in the meantime
+        const auto it = this->index.find(length);
+        if (it != this->index.end()) {
+            this->entries.splice(this->entries.begin(), this->entries, it->second);
+            return it->second->second;
+        }
+        // evict the least recently used bases
+        while (this->usage + entrySize > this->capacity) {
+            const size_t evicted = this->entries.back().first;
+            this->usage -= evicted * evicted;
+            this->index.erase(evicted);
+            this->entries.pop_back();
+        }
+        this->entries.emplace_front(length, basis);
+        this->index[length] = this->entries.begin();
+        this->usage += entrySize;
+        return basis;
+    }
+
+    void DCTBasisCache::clear() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->entries.clear();
+        this->index.clear();
+        this->usage = 0;
+    }
+
+    size_t DCTBasisCache::getUsage() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->usage;
+    }
+
+    size_t DCTBasisCache::getNumEntries() {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->entries.size();
+    }
+
+    DCTBasisCache& DCTBasisCache::global() {
+        static DCTBasisCache cache;
+        return cache;
+    }
+
+    /**
+     * Out = A * B (transposeA false) or Out = A^T * B (transposeA true), all row-major.
+     *
+     * A is M x K (or K x M if transposed), B is K x N, Out is M x N.
+     * Each thread owns a block of COLUMN_BLOCK output columns, so the block of every output row
+     * stays in cache while the K rows of B are accumulated into it (vectorized axpy).
+     */
+    static void multiply(
+        const double* A, const double* B, double* out,
+        const size_t M, const size_t N, const size_t K, const bool transposeA, const bool parallel
+    ) {
+        const long numBlocks = static_cast<long>((N + COLUMN_BLOCK - 1) / COLUMN_BLOCK);
+
+        #pragma omp parallel for schedule(static) if(parallel && !omp_in_parallel())
+        for (long block = 0; block < numBlocks; ++block) {
+            const size_t begin = static_cast<size_t>(block) * COLUMN_BLOCK;
+            const size_t end = std::min(N, begin + COLUMN_BLOCK);
+            for (size_t i = 0; i < M; ++i) {
+                double* row = out + i * N;
+                std::fill(row + begin, row + end, 0.0);
+                for (size_t k = 0; k < K; ++k) {
+                    const double a = transposeA ? A[k * M + i] : A[i * K + k];
+                    const double* b = B + k * N;
+                    #pragma omp simd
+                    for (size_t j = begin; j < end; ++j) {
+                        row[j] += a * b[j];
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Out = A * B^T, all row-major: A is M x K, B is N x K, Out is M x N.
+     *
+     * Every output is a dot product of two contiguous rows; ROW_BLOCK rows of A are processed
+     * together, so each row of B is loaded once for all of them.
+     */
+    static void multiplyTransposed(
+        const double* A, const double* B, double* out,
+        const size_t M, const size_t N, const size_t K, const bool parallel
+    ) {
+        #pragma omp parallel for schedule(static) if(parallel && !omp_in_parallel())
+        for (long jj = 0; jj < static_cast<long>(N); ++jj) {
+            const auto j = static_cast<size_t>(jj);
+            const double* b = B + j * K;
+            size_t i = 0;
+            for (; i + ROW_BLOCK <= M; i += ROW_BLOCK) {
+                const double* a0 = A + i * K;
+                const double* a1 = a0 + K;
+                const double* a2 = a1 + K;
+                const double* a3 = a2 + K;
+                double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+                #pragma omp simd reduction(+:s0, s1, s2, s3)
+                for (size_t k = 0; k < K; ++k) {
+                    s0 += a0[k] * b[k];
+                    s1 += a1[k] * b[k];
+                    s2 += a2[k] * b[k];
+                    s3 += a3[k] * b[k];
+                }
+                out[i * N + j] = s0;
+                out[(i + 1) * N + j] = s1;
+                out[(i + 2) * N + j] = s2;
+                out[(i + 3) * N + j] = s3;
+            }
+            for (; i < M; ++i) {
+                const double* a = A + i * K;
+                double s = 0.0;
+                #pragma omp simd reduction(+:s)
+                for (size_t k = 0; k < K; ++k) {
+                    s += a[k] * b[k];
+                }
+                out[i * N + j] = s;
+            }
+        }
+    }
+
+    void applyDCTBasis(
+        const double* basis, const double* x, double* y, const size_t length, const bool inverse, const bool parallel
+    ) {
+        applyDCTBasisBatch(basis, x, y, length, 1, inverse, parallel);
+    }
+
+    void applyDCTBasis2d(
+        const double* rowBasis, const double* colBasis, double* data,
+        const size_t rows, const size_t cols, const bool inverse, const bool parallel
+    ) {
+        std::vector<double> temp(rows * cols);
+        if (inverse) {
+            // T = Y * C_cols, A = C_rows^T * T
+            multiply(data, colBasis, temp.data(), rows, cols, cols, false, parallel);
+            multiply(rowBasis, temp.data(), data, rows, cols, rows, true, parallel);
+        } else {
+            // T = A * C_cols^T, Y = C_rows * T
+            multiplyTransposed(data, colBasis, temp.data(), rows, cols, cols, parallel);
+            multiply(rowBasis, temp.data(), data, rows, cols, rows, false, parallel);
+        }
+    }
+
+    void applyDCTBasisBatch(
+        const double* basis, const double* x, double* y,
+        const size_t length, const size_t count, const bool inverse, const bool parallel
+    ) {
+        if (inverse) {
+            // Y = X * C
+            multiply(x, basis, y, count, length, length, false, parallel);
+        } else {
+            // Y = X * C^T
+            multiplyTransposed(x, basis, y, count, length, length, parallel);
+        }
+    }
+
+    void applyDCTCosineTable(
+        const double* x, double* y, const size_t length, const size_t count, const bool inverse, const bool parallel
+    ) {
+        // table of cos(pi * p / (2N)), p = 0, ..., 4N - 1: the cosine of (n, k) is the entry (2n + 1) * k mod 4N,
+        // which moves by a constant step along each sum
+        const size_t period = 4 * length;
+        std::vector<double> table(period);
+        for (size_t p = 0; p < period; ++p) {
+            table[p] = std::cos(M_PI * static_cast<double>(p) / (2.0 * static_cast<double>(length)));
+        }
+        const double alphaDC = std::sqrt(1.0 / static_cast<double>(length));
+        const double alphaAC = std::sqrt(2.0 / static_cast<double>(length));
+        std::vector<double> scaled(inverse ? length : 0);
+
+        for (size_t line = 0; line < count; ++line) {
+            const double* in = x + line * length;
+            double* out = y + line * length;
+            if (inverse) {
+                // y[n] = sum_k alpha_k * X[k] * cos(pi * (2n + 1) * k / (2N)): the step along k is 2n + 1
+                scaled[0] = alphaDC * in[0];
+                for (size_t k = 1; k < length; ++k) {
+                    scaled[k] = alphaAC * in[k];
+                }
+                #pragma omp parallel for schedule(static) if(parallel && !omp_in_parallel())
+                for (long nn = 0; nn < static_cast<long>(length); ++nn) {
+                    const size_t step = 2 * static_cast<size_t>(nn) + 1;
+                    size_t p = 0;
+                    double sum = 0.0;
+                    for (size_t k = 0; k < length; ++k) {
+                        sum += scaled[k] * table[p];
+                        p += step;
+                        p = p >= period ? p - period : p;
+                    }
+                    out[nn] = sum;
+                }
+            } else {
+                // y[k] = alpha_k * sum_n x[n] * cos(pi * (2n + 1) * k / (2N)): the step along n is 2k
+                #pragma omp parallel for schedule(static) if(parallel && !omp_in_parallel())
+                for (long kk = 0; kk < static_cast<long>(length); ++kk) {
+                    const auto k = static_cast<size_t>(kk);
+                    size_t p = k;
+                    double sum = 0.0;
+                    for (size_t n = 0; n < length; ++n) {
+                        sum += in[n] * table[p];
+                        p += 2 * k;
+                        p = p >= period ? p - period : p;
+                    }
+                    out[k] = (k == 0 ? alphaDC : alphaAC) * sum;
+                }
+            }
+        }
+    }
+
+    void computeDirectDCT1d(std::vector<double> &input, const bool inverse, const bool parallel) {
+        if (input.empty()) {
+            return;
+        }
+        if (!DCTBasisCache::global().fits(input.size())) {
+            std::vector<double> output(input.size());
+            applyDCTCosineTable(input.data(), output.data(), input.size(), 1, inverse, parallel);
+            input.swap(output);
+            return;
+        }
+        const auto basis = DCTBasisCache::global().get(input.size());
+        std::vector<double> output(input.size());
+        applyDCTBasis(basis->data(), input.data(), output.data(), input.size(), inverse, parallel);
+        input.swap(output);
+    }
+
+    void computeDirectDCT2d(std::vector<std::vector<double>> &input, const bool inverse, const bool parallel) {
+        if (input.empty() || input[0].empty()) {
+            return;
+        }
+        const size_t rows = input.size();
+        const size_t cols = input[0].size();
+
+        if (!DCTBasisCache::global().fits(rows) || !DCTBasisCache::global().fits(cols)) {
+            // separable fallback, one line at a time
+            #pragma omp parallel for if(parallel && !omp_in_parallel())
+            for (long i = 0; i < static_cast<long>(rows); ++i) {
+                computeDirectDCT1d(input[i], inverse, false);
+            }
+            #pragma omp parallel for if(parallel && !omp_in_parallel())
+            for (long j = 0; j < static_cast<long>(cols); ++j) {
+                std::vector<double> column(rows);
+                for (size_t i = 0; i < rows; ++i) {
+                    column[i] = input[i][j];
+                }
+                computeDirectDCT1d(column, inverse, false);
+                for (size_t i = 0; i < rows; ++i) {
+                    input[i][j] = column[i];
+                }
+            }
+            return;
+        }
+
+        const auto rowBasis = DCTBasisCache::global().get(rows);
+        const auto colBasis = DCTBasisCache::global().get(cols);
+
+        // contiguous copy of the matrix
+        std::vector<double> data(rows * cols);
+        for (size_t i = 0; i < rows; ++i) {
+            std::copy(input[i].begin(), input[i].end(), data.begin() + static_cast<long>(i * cols));
+        }
+
+        applyDCTBasis2d(rowBasis->data(), colBasis->data(), data.data(), rows, cols, inverse, parallel);
+
+        for (size_t i = 0; i < rows; ++i) {
+            std::copy(
+                data.begin() + static_cast<long>(i * cols), data.begin() + static_cast<long>((i + 1) * cols),
+                input[i].begin()
+            );
+        }
+    }
+}
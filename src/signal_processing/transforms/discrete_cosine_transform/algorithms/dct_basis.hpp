@@ -0,0 +1,208 @@
+#ifndef DCT_BASIS_HPP
+#define DCT_BASIS_HPP
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace sp::dct::algo {
+    /**
+     * Thread-safe LRU cache of the orthonormal DCT-II basis matrices.
+     *
+     * The basis of length N is the N x N row-major matrix
+     * @code
+     *      C[k][n] = alpha_k * cos(pi * (2n + 1) * k / (2N)),   alpha_0 = sqrt(1/N), alpha_k = sqrt(2/N)
+     * @endcode
+     * so the DCT-II is X = C * x and the DCT-III (inverse) is x = C^T * X.
+     *
+     * The cache is bounded by the total number of stored entries (doubles): when a new basis does not fit,
+     * the least recently used ones are evicted. A basis larger than the whole capacity is built and returned
+     * but not stored. The returned matrices are shared and immutable, so they stay valid after an eviction.
+     */
+    class DCTBasisCache {
+    public:
+        /**
+         * Default capacity: 4M doubles (32 MiB), e.g. every basis up to N = 1448, or one basis of N = 2048.
+         */
+        static constexpr size_t DEFAULT_CAPACITY = static_cast<size_t>(1) << 22;
+
+        /**
+         * Create an empty cache.
+         *
+         * @param capacity The maximum number of doubles stored (sum of N * N over the cached bases).
+         */
+        explicit DCTBasisCache(size_t capacity = DEFAULT_CAPACITY);
+
+        /**
+         * Get the basis of a given length, building it if it is not cached.
+         *
+         * @param length The length N (greater than 0).
+         * @return The N x N row-major basis matrix.
+         * @throws std::invalid_argument if the length is 0.
+         */
+        std::shared_ptr<const std::vector<double>> get(size_t length);
+
+        /**
+         * Check whether the basis of a given length can be stored in the cache.
+         *
+         * @param length The length N.
+         * @return True if N * N is not greater than the capacity.
+         */
+        [[nodiscard]] bool fits(const size_t length) const {
+            return length * length <= capacity;
+        }
+
+        /**
+         * Remove all the cached bases.
+         */
+        void clear();
+
+        /**
+         * Get the number of doubles currently stored.
+         * @return The sum of N * N over the cached bases.
+         */
+        size_t getUsage();
+
+        /**
+         * Get the number of cached bases.
+         * @return The number of cached lengths.
+         */
+        size_t getNumEntries();
+
+        /**
+         * Get the capacity of the cache.
+         * @return The maximum number of doubles stored.
+         */
+        [[nodiscard]] size_t getCapacity() const {
+            return capacity;
+        }
+
+        /**
+         * The cache shared by the direct DCT/IDCT algorithms.
+         * @return The global cache.
+         */
+        static DCTBasisCache& global();
+
+    private:
+        /**
+         * The maximum number of doubles stored.
+         */
+        size_t capacity;
+        /**
+         * The number of doubles currently stored.
+         */
+        size_t usage;
+        /**
+         * The cached bases, from the most to the least recently used.
+         */
+        std::list<std::pair<size_t, std::shared_ptr<const std::vector<double>>>> entries;
+        /**
+         * Position of each cached length in entries.
+         */
+        std::unordered_map<size_t, decltype(entries)::iterator> index;
+        /**
+         * Lock of entries, index and usage (the bases are built outside of it).
+         */
+        std::mutex mutex;
+    };
+
+    /**
+     * Multiply a vector by a DCT basis (direct transform as a matrix-vector product).
+     *
+     * The product is blocked on the columns, so that a chunk of x stays in the L1 cache
+     * while all the rows are visited, and the inner loops are vectorized.
+     *
+     * @param basis The N x N basis matrix (see DCTBasisCache).
+     * @param x The N input values.
+     * @param y The N output values (must not overlap x).
+     * @param length The length N.
+     * @param inverse False for y = C * x (DCT-II), true for y = C^T * x (DCT-III).
+     * @param parallel True to distribute the work among the OpenMP threads.
+     */
+    void applyDCTBasis(
+        const double* basis, const double* x, double* y, size_t length, bool inverse, bool parallel
+    );
+
+    /**
+     * Multiply a batch of contiguous vectors by a DCT basis (direct transform of many lines).
+     *
+     * The vectors are the rows of a count x N matrix X, so the batch is a single matrix-matrix product
+     * (Y = X * C^T for the DCT-II, Y = X * C for the DCT-III).
+     *
+     * @param basis The N x N basis matrix (see DCTBasisCache).
+     * @param x The count * N input values (vector i starts at x + i * N).
+     * @param y The count * N output values (must not overlap x).
+     * @param length The length N.
+     * @param count The number of vectors.
+     * @param inverse False for the DCT-II, true for the DCT-III.
+     * @param parallel True to distribute the work among the OpenMP threads.
+     */
+    void applyDCTBasisBatch(
+        const double* basis, const double* x, double* y, size_t length, size_t count, bool inverse, bool parallel
+    );
+
+    /**
+     * Direct transform of a batch of contiguous vectors with the table of the 4N distinct cosines.
+     *
+     * It needs O(N) memory instead of the N x N basis: the index of the cosine of each product
+     * is updated incrementally, so there is no trigonometric call in the sums.
+     *
+     * @param x The count * N input values (vector i starts at x + i * N).
+     * @param y The count * N output values (must not overlap x).
+     * @param length The length N.
+     * @param count The number of vectors.
+     * @param inverse False for the DCT-II, true for the DCT-III.
+     * @param parallel True to distribute the work among the OpenMP threads.
+     */
+    void applyDCTCosineTable(
+        const double* x, double* y, size_t length, size_t count, bool inverse, bool parallel
+    );
+
+    /**
+     * 2D direct transform of a row-major matrix as two matrix-matrix products.
+     *
+     * The forward transform is Y = C_rows * A * C_cols^T, the inverse A = C_rows^T * Y * C_cols;
+     * the rows of the matrix are processed as one batch in each product.
+     *
+     * @param rowBasis The basis of length rows.
+     * @param colBasis The basis of length cols.
+     * @param data The rows x cols matrix, row-major (transformed in place).
+     * @param rows The number of rows.
+     * @param cols The number of columns.
+     * @param inverse False for the DCT-II, true for the DCT-III.
+     * @param parallel True to distribute the work among the OpenMP threads.
+     */
+    void applyDCTBasis2d(
+        const double* rowBasis, const double* colBasis, double* data,
+        size_t rows, size_t cols, bool inverse, bool parallel
+    );
+
+    /**
+     * Direct 1D transform of a vector with the cached basis (in place).
+     *
+     * Lengths whose basis does not fit the global cache use applyDCTCosineTable instead.
+     *
+     * @param input The input vector.
+     * @param inverse False for the DCT-II, true for the DCT-III.
+     * @param parallel True to distribute the work among the OpenMP threads.
+     */
+    void computeDirectDCT1d(std::vector<double> &input, bool inverse, bool parallel);
+
+    /**
+     * Direct 2D transform of a matrix with the cached bases (in place).
+     *
+     * If a basis does not fit the global cache, the rows and then the columns are transformed
+     * one at a time with computeDirectDCT1d.
+     *
+     * @param input The input matrix (all the rows with the same size).
+     * @param inverse False for the DCT-II, true for the DCT-III.
+     * @param parallel True to distribute the work among the OpenMP threads.
+     */
+    void computeDirectDCT2d(std::vector<std::vector<double>> &input, bool inverse, bool parallel);
+}
+
+#endif //DCT_BASIS_HPP
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <complex>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <omp.h>
+
+#include "transforms/discrete_cosine_transform/algorithms/dct_batch.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_8x8.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_basis.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_nd.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/fast_dct.hpp"
+
+namespace sp::dct::algo {
+    /**
+     * Number of lines gathered and transformed together by a thread.
+     */
+    constexpr size_t LINE_BLOCK = 16;
+
+    void computeDCTAxis(
+        double* data, const size_t outer, const size_t outerStride, const size_t length,
+        const size_t lengthStride, const size_t inner, const bool inverse, const bool parallel
+    ) {
+        const size_t numLines = outer * inner;
+        // the DCT of length 1 is the identity (alpha_0 = 1)
+        if (numLines == 0 || length <= 1) {
+            return;
+        }
+
+        // one algorithm for all the lines of the axis
+        std::unique_ptr<FastDCTPlan> plan;
+        std::shared_ptr<const std::vector<double>> basis;
+        if (isFastDCTLength(length)) {
+            plan.reset(new FastDCTPlan(length));
+        } else if (DCTBasisCache::global().fits(length)) {
+            basis = DCTBasisCache::global().get(length);
+        }
+        // no nested parallel region if the caller is already parallel
+        const bool useThreads = parallel && !omp_in_parallel();
+        // with a single line, the parallelism goes inside the direct transform
+        const bool parallelLine = useThreads && numLines == 1;
+        const long numBlocks = static_cast<long>((numLines + LINE_BLOCK - 1) / LINE_BLOCK);
+
+        #pragma omp parallel if(useThreads && numBlocks > 1)
+        {
+            // per-thread buffers, reused for all the blocks of the thread
+            std::vector<double> lines(LINE_BLOCK * length);
+            std::vector<double> output(plan ? 0 : LINE_BLOCK * length);
+            std::vector<std::complex<double>> workspace;
+            double* starts[LINE_BLOCK];
+
+            #pragma omp for schedule(static)
+            for (long block = 0; block < numBlocks; ++block) {
+                const size_t first = static_cast<size_t>(block) * LINE_BLOCK;
+                const size_t count = std::min(LINE_BLOCK, numLines - first);
+                for (size_t l = 0; l < count; ++l) {
+                    const size_t line = first + l;
+                    starts[l] = data + (line / inner) * outerStride + line % inner;
+                }
+
+                // contiguous lines are transformed in place by the FFT-based algorithm
+                if (plan && lengthStride == 1) {
+                    for (size_t l = 0; l < count; ++l) {
+                        if (inverse) {
+                            plan->inverse(starts[l], workspace);
+                        } else {
+                            plan->forward(starts[l], workspace);
+                        }
+                    }
+                    continue;
+                }
+
+                // gather: adjacent lines are adjacent in memory, so every step along the axis is a contiguous read
+                for (size_t n = 0; n < length; ++n) {
+                    const size_t offset = n * lengthStride;
+                    for (size_t l = 0; l < count; ++l) {
+                        lines[l * length + n] = starts[l][offset];
+                    }
+                }
+
+                const double* result = output.data();
+                if (plan) {
+                    for (size_t l = 0; l < count; ++l) {
+                        if (inverse) {
+                            plan->inverse(lines.data() + l * length, workspace);
+                        } else {
+                            plan->forward(lines.data() + l * length, workspace);
+                        }
+                    }
+                    result = lines.data();
+                } else if (basis) {
+                    applyDCTBasisBatch(
+                        basis->data(), lines.data(), output.data(), length, count, inverse, parallelLine
+                    );
+                } else {
+                    applyDCTCosineTable(lines.data(), output.data(), length, count, inverse, parallelLine);
+                }
+
+                // scatter
+                for (size_t n = 0; n < length; ++n) {
+                    const size_t offset = n * lengthStride;
+                    for (size_t l = 0; l < count; ++l) {
+                        starts[l][offset] = result[l * length + n];
+                    }
+                }
+            }
+        }
+    }
+
+    void computeDCTBatch(
+        double* data, const size_t length, const size_t count, const size_t stride, const bool inverse,
+        const bool parallel
+    ) {
+        if (stride < length) {
+            throw std::invalid_argument(
+                "The stride of the lines must be at least their length. Given: " + std::to_string(stride) +
+                ", Length: " + std::to_string(length)
+            );
+        }
+        // the lines are the outer index of a strided view with a single inner index
+        computeDCTAxis(data, count, stride, length, 1, 1, inverse, parallel);
+    }
+
+    void computeDCTBatch(std::vector<double> &input, const bool inverse, const bool parallel) {
+        computeDCTBatch(input.data(), input.size(), 1, input.size(), inverse, parallel);
+    }
+
+    void computeDCTBatch(std::vector<std::vector<double>> &input, const bool inverse, const bool parallel) {
+        if (input.empty() || input[0].empty()) {
+            return;
+        }
+        const size_t rows = input.size();
+        const size_t cols = input[0].size();
+        for (const auto &row : input) {
+            if (row.size() != cols) {
+                throw std::invalid_argument(
+                    "All the rows must have the same size. Given: " + std::to_string(row.size()) +
+                    ", Expected: " + std::to_string(cols)
+                );
+            }
+        }
+
+        // contiguous copy of the matrix
+        std::vector<double> data(rows * cols);
+        for (size_t i = 0; i < rows; ++i) {
+            std::copy(input[i].begin(), input[i].end(), data.begin() + static_cast<long>(i * cols));
+        }
+
+        computeDCT2dStrided(data.data(), rows, cols, cols, inverse, parallel);
+
+        for (size_t i = 0; i < rows; ++i) {
+            std::copy(
+                data.begin() + static_cast<long>(i * cols), data.begin() + static_cast<long>((i + 1) * cols),
+                input[i].begin()
+            );
+        }
+    }
+
+    void computeDCT8x8Batch(double* blocks, const size_t count, const double* postScale, const bool parallel) {
+        #pragma omp parallel for schedule(static) if(parallel && count > 1 && !omp_in_parallel())
+        for (long i = 0; i < static_cast<long>(count); ++i) {
+            computeDCT8x8Scaled(blocks + static_cast<size_t>(i) * DCT_BLOCK_AREA, postScale);
+        }
+    }
+
+    void computeIDCT8x8Batch(double* blocks, const size_t count, const double* preScale, const bool parallel) {
+        #pragma omp parallel for schedule(static) if(parallel && count > 1 && !omp_in_parallel())
+        for (long i = 0; i < static_cast<long>(count); ++i) {
+            computeIDCT8x8Scaled(blocks + static_cast<size_t>(i) * DCT_BLOCK_AREA, preScale);
+        }
+    }
+}
@@ -0,0 +1,102 @@
+#ifndef DCT_BATCH_HPP
+#define DCT_BATCH_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace sp::dct::algo {
+    /**
+     * Orthonormal DCT-II (or DCT-III) along one axis of a strided array (in place).
+     *
+     * The array is seen as outer x length x inner elements: line (o, j) starts at
+     * data + o * outerStride + j and its n-th element is at n * lengthStride from the start,
+     * while the inner index j is contiguous. Every axis of a row-major N-D array (and the rows or
+     * the columns of a padded matrix) has this form, so no transposed copy is ever needed.
+     *
+     * The lines are gathered in small blocks of adjacent j (so the reads are contiguous), transformed
+     * with the FFT-based algorithm (power-of-2 lengths), the cached basis or the cosine table,
+     * and scattered back.
+     *
+     * @param data Pointer to the first element.
+     * @param outer The number of outer indices.
+     * @param outerStride The distance between two consecutive outer indices.
+     * @param length The length of the transformed axis.
+     * @param lengthStride The distance between two consecutive elements of a line.
+     * @param inner The number of contiguous inner indices.
+     * @param inverse False for the DCT-II, true for the DCT-III.
+     * @param parallel True to distribute the lines among the OpenMP threads
+     *                 (ignored inside an active parallel region).
+     */
+    void computeDCTAxis(
+        double* data, size_t outer, size_t outerStride, size_t length, size_t lengthStride, size_t inner,
+        bool inverse, bool parallel
+    );
+
+    /**
+     * Orthonormal DCT-II (or DCT-III) of a batch of equally spaced lines (in place).
+     *
+     * Line i starts at data + i * stride. All the lines are transformed in a single parallel region
+     * (one block of lines per task), and the algorithm (FFT-based, cached basis or cosine table) and its
+     * tables are chosen once for the whole batch. A single line is parallelized inside its transform instead.
+     *
+     * The function is nesting-aware: called from inside an active parallel region (e.g. one task per image
+     * of a batch), it runs sequentially in the calling thread instead of opening a nested region.
+     *
+     * @param data Pointer to the first line.
+     * @param length The length of each line.
+     * @param count The number of lines.
+     * @param stride The distance between the starts of two consecutive lines (at least length).
+     * @param inverse False for the DCT-II, true for the DCT-III.
+     * @param parallel True to distribute the lines among the OpenMP threads.
+     * @throws std::invalid_argument if the stride is smaller than the length.
+     */
+    void computeDCTBatch(double* data, size_t length, size_t count, size_t stride, bool inverse, bool parallel);
+
+    /**
+     * Orthonormal DCT-II (or DCT-III) of a single vector (in place), see computeDCTBatch.
+     *
+     * @param input The input vector.
+     * @param inverse False for the DCT-II, true for the DCT-III.
+     * @param parallel True to use the OpenMP threads.
+     */
+    void computeDCTBatch(std::vector<double> &input, bool inverse, bool parallel);
+
+    /**
+     * Orthonormal 2D DCT-II (or DCT-III) of a matrix stored as a vector of rows (in place).
+     *
+     * The matrix is copied in a contiguous buffer, transformed with two batched axis passes
+     * (rows, then columns) and copied back.
+     *
+     * @param input The input matrix (all the rows with the same size).
+     * @param inverse False for the DCT-II, true for the DCT-III.
+     * @param parallel True to use the OpenMP threads.
+     * @throws std::invalid_argument if the rows do not have the same size.
+     */
+    void computeDCTBatch(std::vector<std::vector<double>> &input, bool inverse, bool parallel);
+
+    /**
+     * Fast 8x8 DCT-II with post-scale (see computeDCT8x8Scaled) of a batch of contiguous blocks (in place).
+     *
+     * Block i is the 64 values at blocks + 64 * i, row-major. Nesting-aware like computeDCTBatch.
+     *
+     * @param blocks Pointer to the count * 64 samples.
+     * @param count The number of blocks.
+     * @param postScale The 64 output multipliers, row-major.
+     * @param parallel True to distribute the blocks among the OpenMP threads.
+     */
+    void computeDCT8x8Batch(double* blocks, size_t count, const double* postScale, bool parallel);
+
+    /**
+     * Fast 8x8 DCT-III with pre-scale (see computeIDCT8x8Scaled) of a batch of contiguous blocks (in place).
+     *
+     * Block i is the 64 values at blocks + 64 * i, row-major. Nesting-aware like computeDCTBatch.
+     *
+     * @param blocks Pointer to the count * 64 coefficients.
+     * @param count The number of blocks.
+     * @param preScale The 64 input multipliers, row-major.
+     * @param parallel True to distribute the blocks among the OpenMP threads.
+     */
+    void computeIDCT8x8Batch(double* blocks, size_t count, const double* preScale, bool parallel);
+}
+
+#endif //DCT_BATCH_HPP
@@ -0,0 +1,44 @@
+#include <stdexcept>
+#include <string>
+
+#include "transforms/discrete_cosine_transform/algorithms/dct_nd.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_batch.hpp"
+
+namespace sp::dct::algo {
+    void computeDCT2dStrided(
+        double* data, const size_t rows, const size_t cols, const size_t stride, const bool inverse, const bool parallel
+    ) {
+        if (rows == 0 || cols == 0 || stride < cols) {
+            throw std::invalid_argument(
+                "Invalid matrix layout. Given: " + std::to_string(rows) + "x" + std::to_string(cols) +
+                " with stride " + std::to_string(stride)
+            );
+        }
+        // rows: rows lines of cols contiguous elements
+        computeDCTAxis(data, rows, stride, cols, 1, 1, inverse, parallel);
+        // columns: cols adjacent lines of rows elements, stride apart
+        computeDCTAxis(data, 1, 0, rows, stride, cols, inverse, parallel);
+    }
+
+    void computeDCTND(
+        double* data, const size_t* dims, const size_t numDims, const bool inverse, const bool parallel
+    ) {
+        for (size_t axis = 0; axis < numDims; ++axis) {
+            if (dims[axis] == 0) {
+                throw std::invalid_argument(
+                    "All the dimensions must be greater than 0. Given: 0 at axis " + std::to_string(axis)
+                );
+            }
+        }
+        for (size_t axis = 0; axis < numDims; ++axis) {
+            size_t outer = 1, inner = 1;
+            for (size_t i = 0; i < axis; ++i) {
+                outer *= dims[i];
+            }
+            for (size_t i = axis + 1; i < numDims; ++i) {
+                inner *= dims[i];
+            }
+            computeDCTAxis(data, outer, dims[axis] * inner, dims[axis], inner, inner, inverse, parallel);
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef DCT_ND_HPP
+#define DCT_ND_HPP
+
+#include <cstddef>
+
+namespace sp::dct::algo {
+    /**
+     * 2D DCT-II (or DCT-III) of a row-major matrix with a row stride (in place).
+     *
+     * Element (i, j) is data[i * stride + j], so a sub-matrix of a bigger image (or a padded buffer)
+     * can be transformed without copies.
+     *
+     * @param data Pointer to the element (0, 0).
+     * @param rows The number of rows.
+     * @param cols The number of columns.
+     * @param stride The distance between two consecutive rows (at least cols).
+     * @param inverse False for the DCT-II, true for the DCT-III.
+     * @param parallel True to distribute the work among the OpenMP threads.
+     * @throws std::invalid_argument if a size is 0 or the stride is smaller than the number of columns.
+     */
+    void computeDCT2dStrided(
+        double* data, size_t rows, size_t cols, size_t stride, bool inverse, bool parallel
+    );
+
+    /**
+     * N-D DCT-II (or DCT-III) of a contiguous row-major array (in place), one axis pass at a time.
+     *
+     * @param data Pointer to the product of the dimensions values.
+     * @param dims The size of each dimension (the last one is contiguous).
+     * @param numDims The number of dimensions.
+     * @param inverse False for the DCT-II, true for the DCT-III.
+     * @param parallel True to distribute the work among the OpenMP threads.
+     * @throws std::invalid_argument if a dimension is 0.
+     */
+    void computeDCTND(double* data, const size_t* dims, size_t numDims, bool inverse, bool parallel);
+}
+
+#endif //DCT_ND_HPP
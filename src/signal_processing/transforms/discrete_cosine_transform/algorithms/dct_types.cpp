@@ -0,0 +1,117 @@
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "transforms/discrete_cosine_transform/algorithms/dct_types.hpp"
+
+namespace sp::dct::algo {
+    /**
+     * Check whether a length is a positive power of 2.
+     */
+    static bool isPowerOfTwo(const size_t length) {
+        return length > 0 && (length & (length - 1)) == 0;
+    }
+
+    /**
+     * Validate the length of a FastDCT1Plan before the FFT plan is built.
+     *
+     * @param length The signal length.
+     * @return The length of the FFT of the even extension, 2(N - 1).
+     * @throws std::invalid_argument if length - 1 is not a positive power of 2.
+     */
+    static size_t checkDCT1Length(const size_t length) {
+        if (length < 2 || !isPowerOfTwo(length - 1)) {
+            throw std::invalid_argument(
+                "The FFT-based DCT-I needs a size that is a power of 2 plus one. Given: " + std::to_string(length)
+            );
+        }
+        return 2 * (length - 1);
+    }
+
+    /**
+     * Validate the length of a FastDCT4Plan before the FFT plan is built.
+     *
+     * @param length The signal length.
+     * @return The length of the complex FFT, N/2 (1 for N = 1).
+     * @throws std::invalid_argument if the length is not a positive power of 2.
+     */
+    static size_t checkDCT4Length(const size_t length) {
+        if (!isPowerOfTwo(length)) {
+            throw std::invalid_argument(
+                "The FFT-based DCT-IV needs a size that is a power of 2. Given: " + std::to_string(length)
+            );
+        }
+        return length > 1 ? length / 2 : 1;
+    }
+
+    FastDCT1Plan::FastDCT1Plan(const size_t length) : length(length), plan(checkDCT1Length(length)) {}
+
+    void FastDCT1Plan::transform(double* data, std::vector<std::complex<double>>& workspace) const {
+        const size_t M = this->length - 1;
+        const double boundary = 1.0 / std::sqrt(2.0);
+        workspace.resize(2 * M);
+        // 1. even extension of the weighted signal c_n * x[n]
+        const double first = boundary * data[0];
+        const double last = boundary * data[M];
+        workspace[0] = first;
+        workspace[M] = last;
+        for (size_t n = 1; n < M; ++n) {
+            workspace[n] = data[n];
+            workspace[2 * M - n] = data[n];
+        }
+        // 2. 2M-point FFT, the result is real
+        this->plan.forward(workspace.data(), 1);
+        // 3. sum_n c_n x[n] cos(pi n k / M) = (Re(E[k]) + c_0 x[0] + (-1)^k c_M x[M]) / 2, then the scaling
+        const double scale = std::sqrt(2.0 / static_cast<double>(M)) / 2.0;
+        for (size_t k = 0; k <= M; ++k) {
+            const double sum = workspace[k].real() + first + (k % 2 == 0 ? last : -last);
+            data[k] = scale * (k == 0 || k == M ? boundary : 1.0) * sum;
+        }
+    }
+
+    FastDCT4Plan::FastDCT4Plan(const size_t length) : length(length), plan(checkDCT4Length(length)) {
+        const size_t half = length / 2;
+        const double N = static_cast<double>(length);
+        const double scale = std::sqrt(2.0 / N);
+        this->preTwiddles.resize(half);
+        this->postTwiddles.resize(half);
+        for (size_t n = 0; n < half; ++n) {
+            this->preTwiddles[n] = std::polar(1.0, -M_PI * (4.0 * static_cast<double>(n) + 1.0) / (4.0 * N));
+            this->postTwiddles[n] = std::polar(scale, -M_PI * static_cast<double>(n) / N);
+        }
+    }
+
+    void FastDCT4Plan::transform(double* data, std::vector<std::complex<double>>& workspace) const {
+        const size_t N = this->length;
+        // the DCT-IV of length 1 is x[0] * sqrt(2) * cos(pi / 4) = x[0]
+        if (N == 1) {
+            return;
+        }
+        const size_t half = N / 2;
+        workspace.resize(half);
+        // 1. pack the even samples and the reversed odd samples, pre-twiddle
+        for (size_t n = 0; n < half; ++n) {
+            workspace[n] = std::complex<double>(data[2 * n], data[N - 1 - 2 * n]) * this->preTwiddles[n];
+        }
+        // 2. N/2-point FFT
+        this->plan.forward(workspace.data(), 1);
+        // 3. post-twiddle (with the orthonormal scaling) and unpack
+        for (size_t k = 0; k < half; ++k) {
+            const std::complex<double> y = workspace[k] * this->postTwiddles[k];
+            data[2 * k] = y.real();
+            data[N - 1 - 2 * k] = -y.imag();
+        }
+    }
+
+    void computeDCT1(std::vector<double> &input) {
+        const FastDCT1Plan plan(input.size());
+        std::vector<std::complex<double>> workspace;
+        plan.transform(input.data(), workspace);
+    }
+
+    void computeDCT4(std::vector<double> &input) {
+        const FastDCT4Plan plan(input.size());
+        std::vector<std::complex<double>> workspace;
+        plan.transform(input.data(), workspace);
+    }
+}
@@ -0,0 +1,136 @@
+#ifndef DCT_TYPES_HPP
+#define DCT_TYPES_HPP
+
+#include <complex>
+#include <vector>
+
+#include "transforms/fourier_transform/algorithms/cooley_tukey/cooley_tukey_batch.hpp"
+
+namespace sp::dct::algo {
+    /**
+     * Precomputed plan for the O(N log N) orthonormal DCT-I of length N = M + 1, with M a power of 2.
+     *
+     * @code
+     *      X[k] = sqrt(2/M) * c_k * sum_{n=0}^{M} c_n * x[n] * cos(pi * n * k / M),   c_0 = c_M = 1/sqrt(2), c_n = 1
+     * @endcode
+     *
+     * The transform is its own inverse. It is computed with a 2M-point FFT of the even extension
+     * x[0], ..., x[M], x[M - 1], ..., x[1], whose real part is 2 * sum(...) minus the two boundary terms.
+     *
+     * The plan is immutable after construction, so it can be shared by many threads.
+     */
+    class FastDCT1Plan {
+    public:
+        /**
+         * Create a plan for DCT-I of the given length.
+         *
+         * @param length The length N of the signals, a power of 2 plus one (at least 2).
+         * @throws std::invalid_argument if length - 1 is not a positive power of 2.
+         */
+        explicit FastDCT1Plan(size_t length);
+
+        /**
+         * Orthonormal DCT-I of a signal (in-place), also its inverse.
+         *
+         * @param data Pointer to the N samples.
+         * @param workspace Buffer for the FFT (resized to 2(N - 1) if needed, it can be reused among calls).
+         */
+        void transform(double* data, std::vector<std::complex<double>>& workspace) const;
+
+        /**
+         * Get the length of the signals.
+         * @return The length N.
+         */
+        [[nodiscard]] size_t getLength() const {
+            return length;
+        }
+
+    private:
+        /**
+         * The signal length N.
+         */
+        size_t length;
+        /**
+         * The FFT plan of length 2(N - 1).
+         */
+        fft::algo::cooley_tukey::BatchPlan plan;
+    };
+
+    /**
+     * Precomputed plan for the O(N log N) orthonormal DCT-IV of length N (a power of 2).
+     *
+     * @code
+     *      X[k] = sqrt(2/N) * sum_{n=0}^{N-1} x[n] * cos(pi * (2n + 1) * (2k + 1) / (4N))
+     * @endcode
+     *
+     * The transform is its own inverse. It is computed with an N/2-point complex FFT:
+     *  1. z[n] = (x[2n] + i * x[N - 1 - 2n]) * e^(-i * pi * (4n + 1) / (4N)), n < N/2;
+     *  2. Z = FFT_(N/2)(z);
+     *  3. y[k] = Z[k] * e^(-i * pi * k / N), X[2k] = Re(y[k]), X[N - 1 - 2k] = -Im(y[k]).
+     *
+     * It is the core of the MDCT (see sp::dct::mdct).
+     * The plan is immutable after construction, so it can be shared by many threads.
+     */
+    class FastDCT4Plan {
+    public:
+        /**
+         * Create a plan for DCT-IV of the given length.
+         *
+         * @param length The length N of the signals, a power of 2.
+         * @throws std::invalid_argument if the length is not a positive power of 2.
+         */
+        explicit FastDCT4Plan(size_t length);
+
+        /**
+         * Orthonormal DCT-IV of a signal (in-place), also its inverse.
+         *
+         * @param data Pointer to the N samples.
+         * @param workspace Buffer for the FFT (resized to N/2 if needed, it can be reused among calls).
+         */
+        void transform(double* data, std::vector<std::complex<double>>& workspace) const;
+
+        /**
+         * Get the length of the signals.
+         * @return The length N.
+         */
+        [[nodiscard]] size_t getLength() const {
+            return length;
+        }
+
+    private:
+        /**
+         * The signal length N.
+         */
+        size_t length;
+        /**
+         * The FFT plan of length N/2 (unused for N = 1).
+         */
+        fft::algo::cooley_tukey::BatchPlan plan;
+        /**
+         * The pre-twiddles e^(-i * pi * (4n + 1) / (4N)), n < N/2.
+         */
+        std::vector<std::complex<double>> preTwiddles;
+        /**
+         * The post-twiddles sqrt(2/N) * e^(-i * pi * k / N), k < N/2 (the scaling is folded in).
+         */
+        std::vector<std::complex<double>> postTwiddles;
+    };
+
+    /**
+     * Orthonormal DCT-I of a vector (in-place), with a one-shot FastDCT1Plan.
+     *
+     * @param input The input vector, its size minus one must be a power of 2.
+     * @throws std::invalid_argument if the size minus one is not a positive power of 2.
+     */
+    void computeDCT1(std::vector<double> &input);
+
+    /**
+     * Orthonormal DCT-IV of a vector (in-place), with a one-shot FastDCT4Plan.
+     *
+     * @param input The input vector, its size must be a power of 2.
+     * @throws std::invalid_argument if the size is not a positive power of 2.
+     */
+    void computeDCT4(std::vector<double> &input);
+}
+
+#endif //DCT_TYPES_HPP
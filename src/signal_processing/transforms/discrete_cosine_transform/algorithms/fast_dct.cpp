@@ -0,0 +1,173 @@
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "transforms/discrete_cosine_transform/algorithms/fast_dct.hpp"
+
+namespace sp::dct::algo {
+    /**
+     * Validate the length of a FastDCTPlan before the FFT plan is built.
+     *
+     * @param length The signal length.
+     * @return The same length.
+     * @throws std::invalid_argument if the length is not a positive power of 2.
+     */
+    static size_t checkFastDCTLength(const size_t length) {
+        if (!isFastDCTLength(length)) {
+            throw std::invalid_argument(
+                "The FFT-based DCT needs a size that is a power of 2. Given: " + std::to_string(length)
+            );
+        }
+        return length;
+    }
+
+    FastDCTPlan::FastDCTPlan(const size_t length)
+        : length(checkFastDCTLength(length)), plan(length),
+          scaleDC(std::sqrt(1.0 / static_cast<double>(length))),
+          scaleAC(std::sqrt(2.0 / static_cast<double>(length))) {
+        this->twiddles.resize(length);
+        for (size_t k = 0; k < length; ++k) {
+            this->twiddles[k] = std::polar(1.0, -M_PI * static_cast<double>(k) / (2.0 * static_cast<double>(length)));
+        }
+    }
+
+    void FastDCTPlan::forward(double* data, std::vector<std::complex<double>>& workspace) const {
+        const size_t N = this->length;
+        workspace.resize(N);
+        // 1. Makhoul reordering: even samples, then odd samples in reverse order
+        for (size_t n = 0; n < N / 2; ++n) {
+            workspace[n] = data[2 * n];
+            workspace[N - 1 - n] = data[2 * n + 1];
+        }
+        if (N == 1) {
+            workspace[0] = data[0];
+        }
+        // 2. N-point FFT
+        this->plan.forward(workspace.data(), 1);
+        // 3. post-twiddle and orthonormal scaling
+        data[0] = this->scaleDC * workspace[0].real();
+        for (size_t k = 1; k < N; ++k) {
+            data[k] = this->scaleAC * (this->twiddles[k] * workspace[k]).real();
+        }
+    }
+
+    void FastDCTPlan::inverse(double* data, std::vector<std::complex<double>>& workspace) const {
+        const size_t N = this->length;
+        workspace.resize(N);
+        // 1. undo the scaling and build the Hermitian spectrum of the reordered signal
+        workspace[0] = data[0] / this->scaleDC;
+        for (size_t k = 1; k < N; ++k) {
+            const double re = data[k] / this->scaleAC;
+            const double im = -data[N - k] / this->scaleAC;
+            workspace[k] = std::conj(this->twiddles[k]) * std::complex<double>(re, im);
+        }
+        // 2. N-point inverse FFT (normalized by 1/N), the result is real
+        this->plan.inverse(workspace.data(), 1);
+        // 3. undo the reordering
+        for (size_t n = 0; n < N / 2; ++n) {
+            data[2 * n] = workspace[n].real();
+            data[2 * n + 1] = workspace[N - 1 - n].real();
+        }
+        if (N == 1) {
+            data[0] = workspace[0].real();
+        }
+    }
+
+    bool isFastDCTLength(const size_t length) {
+        return length > 0 && (length & (length - 1)) == 0;
+    }
+
+    /**
+     * Check that a matrix can be transformed with the FFT-based DCT.
+     */
+    static void checkFastDCTMatrix(const std::vector<std::vector<double>> &input) {
+        if (input.empty() || !isFastDCTLength(input.size()) || !isFastDCTLength(input[0].size())) {
+            throw std::invalid_argument(
+                "The FFT-based DCT needs rows and columns that are powers of 2. Given: " +
+                std::to_string(input.size()) + "x" + std::to_string(input.empty() ? 0 : input[0].size())
+            );
+        }
+    }
+
+    /**
+     * Apply the forward or inverse FFT-based DCT to all the rows and then to all the columns of a matrix.
+     *
+     * The columns are gathered one at a time in a buffer, so no transposed copy of the matrix is needed.
+     */
+    static void transform2d(std::vector<std::vector<double>> &input, const bool inverse, const bool parallel) {
+        checkFastDCTMatrix(input);
+        const size_t rows = input.size();
+        const size_t cols = input[0].size();
+        const FastDCTPlan rowPlan(cols);
+        const FastDCTPlan colPlan(rows);
+
+        #pragma omp parallel if(parallel)
+        {
+            // per-thread buffers, reused for all the rows and columns of the thread
+            std::vector<std::complex<double>> workspace;
+            std::vector<double> column(rows);
+
+            #pragma omp for
+            for (size_t i = 0; i < rows; ++i) {
+                if (inverse) {
+                    rowPlan.inverse(input[i].data(), workspace);
+                } else {
+                    rowPlan.forward(input[i].data(), workspace);
+                }
+            }
+
+            #pragma omp for
+            for (size_t j = 0; j < cols; ++j) {
+                for (size_t i = 0; i < rows; ++i) {
+                    column[i] = input[i][j];
+                }
+                if (inverse) {
+                    colPlan.inverse(column.data(), workspace);
+                } else {
+                    colPlan.forward(column.data(), workspace);
+                }
+                for (size_t i = 0; i < rows; ++i) {
+                    input[i][j] = column[i];
+                }
+            }
+        }
+    }
+
+    void computeFastDCT1d(std::vector<double> &input) {
+        if (!isFastDCTLength(input.size())) {
+            throw std::invalid_argument(
+                "The FFT-based DCT needs a size that is a power of 2. Given: " + std::to_string(input.size())
+            );
+        }
+        const FastDCTPlan plan(input.size());
+        std::vector<std::complex<double>> workspace;
+        plan.forward(input.data(), workspace);
+    }
+
+    void computeFastDCT2d(std::vector<std::vector<double>> &input) {
+        transform2d(input, false, false);
+    }
+
+    void computeFastDCT2dOpenMP(std::vector<std::vector<double>> &input) {
+        transform2d(input, false, true);
+    }
+
+    void computeFastIDCT1d(std::vector<double> &input) {
+        if (!isFastDCTLength(input.size())) {
+            throw std::invalid_argument(
+                "The FFT-based IDCT needs a size that is a power of 2. Given: " + std::to_string(input.size())
+            );
+        }
+        const FastDCTPlan plan(input.size());
+        std::vector<std::complex<double>> workspace;
+        plan.inverse(input.data(), workspace);
+    }
+
+    void computeFastIDCT2d(std::vector<std::vector<double>> &input) {
+        transform2d(input, true, false);
+    }
+
+    void computeFastIDCT2dOpenMP(std::vector<std::vector<double>> &input) {
+        transform2d(input, true, true);
+    }
+}
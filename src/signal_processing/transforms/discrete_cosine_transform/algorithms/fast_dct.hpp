@@ -0,0 +1,150 @@
+#ifndef FAST_DCT_HPP
+#define FAST_DCT_HPP
+
+#include <complex>
+#include <vector>
+
+#include "transforms/fourier_transform/algorithms/cooley_tukey/cooley_tukey_batch.hpp"
+
+namespace sp::dct::algo {
+    /**
+     * Precomputed plan for the O(N log N) orthonormal DCT-II (and its inverse, the DCT-III)
+     * of length N, using Makhoul's N-point reordering on top of the Cooley-Tukey FFT.
+     *
+     * Forward (DCT-II):
+     *  1. reorder the input: v[n] = x[2n], v[N - 1 - n] = x[2n + 1] (even samples, then odd samples reversed);
+     *  2. V = FFT_N(v);
+     *  3. X[k] = alpha_k * Re(e^(-i * pi * k / (2N)) * V[k]).
+     *
+     * Inverse (DCT-III):
+     *  1. V[k] = e^(i * pi * k / (2N)) * (X[k] / alpha_k - i * X[N - k] / alpha_(N-k)), with X[N] = 0;
+     *  2. v = IFFT_N(V) (real);
+     *  3. undo the reordering: x[2n] = v[n], x[2n + 1] = v[N - 1 - n].
+     *
+     * The scaling is the same of computeDCT1d / computeIDCT1d:
+     * alpha_0 = sqrt(1/N), alpha_k = sqrt(2/N) for k > 0 (orthonormal transform).
+     *
+     * The plan is immutable after construction, so it can be shared by many threads.
+     */
+    class FastDCTPlan {
+    public:
+        /**
+         * Create a plan for DCTs of the given length.
+         *
+         * @param length The length N of the signals, a power of 2.
+         * @throws std::invalid_argument if the length is not a positive power of 2.
+         */
+        explicit FastDCTPlan(size_t length);
+
+        /**
+         * Orthonormal DCT-II of a signal (in-place).
+         *
+         * @param data Pointer to the N samples.
+         * @param workspace Buffer for the FFT (resized to N if needed, it can be reused among calls).
+         */
+        void forward(double* data, std::vector<std::complex<double>>& workspace) const;
+
+        /**
+         * Orthonormal DCT-III (inverse of the DCT-II) of a signal (in-place).
+         *
+         * @param data Pointer to the N coefficients.
+         * @param workspace Buffer for the FFT (resized to N if needed, it can be reused among calls).
+         */
+        void inverse(double* data, std::vector<std::complex<double>>& workspace) const;
+
+        /**
+         * Get the length of the signals.
+         * @return The length N.
+         */
+        [[nodiscard]] size_t getLength() const {
+            return length;
+        }
+
+    private:
+        /**
+         * The signal length N.
+         */
+        size_t length;
+        /**
+         * The FFT plan of length N.
+         */
+        fft::algo::cooley_tukey::BatchPlan plan;
+        /**
+         * The post-twiddles e^(-i * pi * k / (2N)), k = 0, ..., N - 1.
+         */
+        std::vector<std::complex<double>> twiddles;
+        /**
+         * The orthonormal scaling factors sqrt(1/N) and sqrt(2/N).
+         */
+        double scaleDC, scaleAC;
+    };
+
+    /**
+     * Check if the FFT-based DCT can be used for a given length.
+     *
+     * @param length The signal length.
+     * @return True if the length is a positive power of 2.
+     */
+    bool isFastDCTLength(size_t length);
+
+    /**
+     * Sequential FFT-based Discrete Cosine Transform (DCT-II) Algorithm (1D).
+     *
+     * Same result of computeDCT1d, in O(N log N).
+     * The output is stored in the same input vector, which is modified in place.
+     *
+     * @param input The input vector of double numbers (size power of 2).
+     * @throws std::invalid_argument if the size is not a power of 2.
+     */
+    void computeFastDCT1d(std::vector<double> &input);
+
+    /**
+     * Sequential FFT-based Discrete Cosine Transform (DCT-II) Algorithm (2D).
+     *
+     * Same result of computeDCT2d, in O(R * C * log(R * C)): the rows are transformed in place
+     * and the columns are gathered one at a time (no full transposed copy).
+     *
+     * @param input The input matrix (rows and columns powers of 2).
+     * @throws std::invalid_argument if the sizes are not powers of 2.
+     */
+    void computeFastDCT2d(std::vector<std::vector<double>> &input);
+
+    /**
+     * Parallel FFT-based Discrete Cosine Transform (DCT-II) Algorithm (2D).
+     *
+     * The rows (and then the columns) are distributed among the OpenMP threads.
+     *
+     * @param input The input matrix (rows and columns powers of 2).
+     * @throws std::invalid_argument if the sizes are not powers of 2.
+     */
+    void computeFastDCT2dOpenMP(std::vector<std::vector<double>> &input);
+
+    /**
+     * Sequential FFT-based Inverse Discrete Cosine Transform (DCT-III) Algorithm (1D).
+     *
+     * Same result of computeIDCT1d, in O(N log N).
+     * The output is stored in the same input vector, which is modified in place.
+     *
+     * @param input The input vector of double numbers (size power of 2).
+     * @throws std::invalid_argument if the size is not a power of 2.
+     */
+    void computeFastIDCT1d(std::vector<double> &input);
+
+    /**
+     * Sequential FFT-based Inverse Discrete Cosine Transform (DCT-III) Algorithm (2D).
+     *
+     * @param input The input matrix (rows and columns powers of 2).
+     * @throws std::invalid_argument if the sizes are not powers of 2.
+     */
+    void computeFastIDCT2d(std::vector<std::vector<double>> &input);
+
+    /**
+     * Parallel FFT-based Inverse Discrete Cosine Transform (DCT-III) Algorithm (2D).
+     *
+     * @param input The input matrix (rows and columns powers of 2).
+     * @throws std::invalid_argument if the sizes are not powers of 2.
+     */
+    void computeFastIDCT2dOpenMP(std::vector<std::vector<double>> &input);
+}
+
+#endif //FAST_DCT_HPP
@@ -9,6 +9,7 @@ namespace sp::dct::algo {
     * Sequential Inverse Discrete Cosine Transform (IDCT) Algorithm (1D).
     *
     * The output is stored in the same input vector, which is modified in place.
+    * Computed as a matrix-vector product with the cached basis (see DCTBasisCache).
     *
     * @param input The input vector of double numbers.
     */
@@ -18,6 +19,7 @@ namespace sp::dct::algo {
     * Sequential Inverse Discrete Cosine Transform (IDCT) Algorithm (2D).
     *
     * The output is stored in the same input vector, which is modified in place.
+    * Computed as two matrix-matrix products with the cached bases (see DCTBasisCache).
     *
     * @param input The input vector of vector double numbers.
     */
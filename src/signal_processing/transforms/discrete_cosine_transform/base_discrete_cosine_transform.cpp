@@ -1,4 +1,5 @@
 #include <stdexcept>
+#include <string>
 
 #include "base_discrete_cosine_transform.hpp"
 
@@ -83,4 +84,47 @@ namespace sp::dct::solver {
         this->compute(output, mode);
     };
 
+    /**
+     * Compute the Discrete Cosine Transform of a flat row-major matrix (in-place).
+     *
+     * @param data Pointer to the element (0, 0).
+     * @param rows The number of rows.
+     * @param cols The number of columns.
+     * @param stride The distance between two consecutive rows (at least cols).
+     * @param mode The mode of computation.
+     */
+    void DiscreteCosineTransformSolver::compute(
+        double* data, const size_t rows, const size_t cols, const size_t stride, const ComputationMode mode
+    ) {
+        if (data == nullptr || rows == 0 || cols == 0) {
+            throw std::invalid_argument("Input matrix is empty.");
+        }
+        if (stride < cols) {
+            throw std::invalid_argument(
+                "The row stride must be at least the number of columns. Given: " + std::to_string(stride) +
+                ", Columns: " + std::to_string(cols)
+            );
+        }
+        if (mode == ComputationMode::SEQUENTIAL) {
+            this->computeSequential(data, rows, cols, stride);
+        } else if (mode == ComputationMode::OPENMP) {
+            this->computeOpenMP(data, rows, cols, stride);
+        } else {
+            throw std::invalid_argument("Invalid mode specified.");
+        }
+    };
+
+    /**
+     * Compute the Discrete Cosine Transform of a contiguous flat row-major matrix (in-place).
+     *
+     * @param data Pointer to the rows * cols values.
+     * @param rows The number of rows.
+     * @param cols The number of columns.
+     * @param mode The mode of computation.
+     */
+    void DiscreteCosineTransformSolver::compute(
+        double* data, const size_t rows, const size_t cols, const ComputationMode mode
+    ) {
+        this->compute(data, rows, cols, cols, mode);
+    };
 }
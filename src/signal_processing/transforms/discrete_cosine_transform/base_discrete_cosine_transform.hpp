@@ -1,5 +1,6 @@
 #ifndef BASE_DISCRETE_COSINE_TRANSFORM_HPP
 #define BASE_DISCRETE_COSINE_TRANSFORM_HPP
+#include <cstddef>
 #include <vector>
 
 namespace sp::dct::solver {
@@ -72,6 +73,31 @@ namespace sp::dct::solver {
             const ComputationMode mode
         );
 
+        /**
+         * Compute the Discrete Cosine Transform of a flat row-major matrix (in-place).
+         *
+         * Element (i, j) is data[i * stride + j]: the matrix is a single allocation and can be
+         * a sub-matrix of a bigger buffer. A 1D signal is a matrix with one row.
+         *
+         * @param data Pointer to the element (0, 0).
+         * @param rows The number of rows.
+         * @param cols The number of columns.
+         * @param stride The distance between two consecutive rows (at least cols).
+         * @param mode The mode of computation.
+         * @throws std::invalid_argument if data is null, a size is 0 or the stride is smaller than cols.
+         */
+        void compute(double* data, size_t rows, size_t cols, size_t stride, const ComputationMode mode);
+
+        /**
+         * Compute the Discrete Cosine Transform of a contiguous flat row-major matrix (in-place).
+         *
+         * @param data Pointer to the rows * cols values.
+         * @param rows The number of rows.
+         * @param cols The number of columns.
+         * @param mode The mode of computation.
+         */
+        void compute(double* data, size_t rows, size_t cols, const ComputationMode mode);
+
     protected:
         /**
          * Internal method to compute the Discrete Cosine Transform in sequential mode.
@@ -108,6 +134,30 @@ namespace sp::dct::solver {
          * @param input The input matrix to be transformed.
          */
         virtual void computeOpenMP(std::vector<std::vector<double>>& input) = 0;
+
+        /**
+         * Internal method to compute the Discrete Cosine Transform of a flat matrix in sequential mode.
+         *
+         * It modifies the matrix in-place.
+         *
+         * @param data Pointer to the element (0, 0).
+         * @param rows The number of rows.
+         * @param cols The number of columns.
+         * @param stride The distance between two consecutive rows.
+         */
+        virtual void computeSequential(double* data, size_t rows, size_t cols, size_t stride) = 0;
+
+        /**
+         * Internal method to compute the Discrete Cosine Transform of a flat matrix in parallel mode using OpenMP.
+         *
+         * It modifies the matrix in-place.
+         *
+         * @param data Pointer to the element (0, 0).
+         * @param rows The number of rows.
+         * @param cols The number of columns.
+         * @param stride The distance between two consecutive rows.
+         */
+        virtual void computeOpenMP(double* data, size_t rows, size_t cols, size_t stride) = 0;
     };
 }
 #endif //BASE_DISCRETE_COSINE_TRANSFORM_HPP
@@ -0,0 +1,146 @@
+#ifndef BASE_DISCRETE_COSINE_TRANSFORM_ND_HPP
+#define BASE_DISCRETE_COSINE_TRANSFORM_ND_HPP
+
+#include <array>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <omp.h>
+
+#include "transforms/discrete_cosine_transform/base_discrete_cosine_transform.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_nd.hpp"
+
+namespace sp::dct::solver {
+    /**
+     * Abstract template class for N-dimensional Discrete Cosine Transform solvers.
+     *
+     * The input is a single contiguous row-major array (e.g. frames x rows x columns for a video volume).
+     * Every axis is transformed in place with strided passes over the array: no transposed copy and
+     * no per-row allocation. Unlike the FFT, the dimensions can have any positive size.
+     *
+     * @tparam N Number of dimensions, cannot be less than 1.
+     */
+    template <size_t N>
+    class BaseDiscreteCosineTransformND {
+    public:
+        static_assert(
+            N > 0,
+            "The number of dimensions N must be greater than 0."
+        );
+
+        /**
+         * The dimensions of the input array, dims[N - 1] is the contiguous one.
+         */
+        const std::array<size_t, N> dims;
+
+        /**
+         * Create a Discrete Cosine Transform solver.
+         *
+         * @param dimensions An array of dimensions for the Discrete Cosine Transform.
+         * @throws std::invalid_argument if a dimension is 0.
+         */
+        explicit BaseDiscreteCosineTransformND(const std::array<size_t, N>& dimensions): dims(dimensions) {
+            for (const size_t &dim : dimensions) {
+                if (dim == 0) {
+                    throw std::invalid_argument("All dimensions must be greater than 0.");
+                }
+            }
+        }
+
+        virtual ~BaseDiscreteCosineTransformND() = default;
+
+        /**
+         * Compute the Discrete Cosine Transform of the input array (in-place).
+         *
+         * @param input The input array, row-major.
+         * @param mode The mode of computation.
+         * @param threads The number of CPU threads to use for parallel computation (if applicable).
+         *                If not specified, the default number of threads will be used.
+         * @throws std::invalid_argument if the input size does not match the expected size (based on dimensions).
+         */
+        void compute(
+            std::vector<double> &input,
+            const ComputationMode mode,
+            const int threads = omp_get_max_threads()
+        ) {
+            // check if the size of the input vector corresponds to the multiplication of each element of dims
+            const size_t expected_size = std::accumulate(
+                dims.begin(), dims.end(), static_cast<size_t>(1), std::multiplies<size_t>()
+            );
+            if (input.size() != expected_size) {
+                throw std::invalid_argument(
+                    "Input vector size does not match the expected size based on dimensions. Given: " +
+                    std::to_string(input.size()) + ", Expected: " +
+                    std::to_string(expected_size)
+                );
+            }
+            this->compute(input.data(), mode, threads);
+        }
+
+        /**
+         * Compute the Discrete Cosine Transform of the input array and store the result in the output array.
+         *
+         * The input array will not be modified.
+         *
+         * @param input The input array, row-major.
+         * @param output The output array after transformation.
+         * @param mode The mode of computation.
+         * @param threads The number of CPU threads to use for parallel computation (if applicable).
+         */
+        void compute(
+            const std::vector<double> &input,
+            std::vector<double> &output,
+            const ComputationMode mode,
+            const int threads = omp_get_max_threads()
+        ) {
+            output = input;
+            this->compute(output, mode, threads);
+        }
+
+        /**
+         * Compute the Discrete Cosine Transform of a raw array (in-place).
+         *
+         * @param data Pointer to the product of the dimensions values, row-major.
+         * @param mode The mode of computation.
+         * @param threads The number of CPU threads to use for parallel computation (if applicable).
+         * @throws std::invalid_argument if data is null.
+         */
+        void compute(
+            double* data,
+            const ComputationMode mode,
+            const int threads = omp_get_max_threads()
+        ) {
+            if (data == nullptr) {
+                throw std::invalid_argument("Input array is empty.");
+            }
+            if (mode == ComputationMode::SEQUENTIAL) {
+                algo::computeDCTND(data, dims.data(), N, this->isInverse(), false);
+            } else if (mode == ComputationMode::OPENMP) {
+                // save the number of threads before calling the OpenMP function
+                const int numThreads = omp_get_max_threads();
+                if (threads > 0) {
+                    omp_set_num_threads(threads);
+                }
+                algo::computeDCTND(data, dims.data(), N, this->isInverse(), true);
+                // restore the number of threads to the original value
+                omp_set_num_threads(numThreads);
+            } else {
+                throw std::invalid_argument("Invalid mode specified.");
+            }
+        }
+
+    protected:
+        /**
+         * Get the direction of the transform.
+         *
+         * This method should be overridden by derived classes.
+         *
+         * @return False for the DCT-II, true for its inverse (DCT-III).
+         */
+        [[nodiscard]] virtual bool isInverse() const = 0;
+    };
+}
+
+#endif //BASE_DISCRETE_COSINE_TRANSFORM_ND_HPP
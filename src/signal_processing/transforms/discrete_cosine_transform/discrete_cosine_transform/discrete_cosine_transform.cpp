@@ -1,49 +1,87 @@
 #include "discrete_cosine_transform.hpp"
-#include "transforms/discrete_cosine_transform/algorithms/dct.hpp"
-#include "transforms/discrete_cosine_transform/algorithms/dct_openmp.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_batch.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_nd.hpp"
 
 namespace sp::dct::solver {
     /**
      * Internal method to compute the Discrete Cosine Transform in sequential mode.
      *
      * This method modifies the input vector in place.
+     * It goes through the batched DCT engine: power-of-2 sizes use the FFT-based algorithm (Makhoul),
+     * the others the cached basis.
      *
      * @param input The input vector to be transformed.
      */
     void DiscreteCosineTransform::computeSequential(std::vector<double> &input){
-        return algo::computeDCT1d(input);
+        return algo::computeDCTBatch(input, false, false);
     };
 
     /**
      * Internal method to compute the Discrete Cosine Transform in parallel mode using OpenMP.
      *
      * This method modifies the input vector in place.
+     * It goes through the batched DCT engine: power-of-2 sizes use the FFT-based algorithm (Makhoul),
+     * the others the cached basis.
      *
      * @param input The input vector to be transformed.
      */
     void DiscreteCosineTransform::computeOpenMP(std::vector<double> &input){
-        return algo::computeDCT1dOpenMP(input);
+        return algo::computeDCTBatch(input, false, true);
     };
 
     /**
      * Internal method to compute the Discrete Cosine Transform in sequential mode.
      *
      * This method modifies the input matrix in place.
+     * It goes through the batched DCT engine: power-of-2 sizes use the FFT-based algorithm (Makhoul),
+     * the others the cached basis.
      *
      * @param input The input matrix to be transformed.
      */
     void DiscreteCosineTransform::computeSequential(std::vector<std::vector<double>> &input){
-        return algo::computeDCT2d(input);
+        return algo::computeDCTBatch(input, false, false);
     };
 
     /**
      * Internal method to compute the Discrete Cosine Transform in parallel mode using OpenMP.
      *
      * This method modifies the input matrix in place.
+     * It goes through the batched DCT engine: power-of-2 sizes use the FFT-based algorithm (Makhoul),
+     * the others the cached basis.
      *
      * @param input The input matrix to be transformed.
      */
     void DiscreteCosineTransform::computeOpenMP(std::vector<std::vector<double>> &input){
-        return algo::computeDCT2dOpenMP(input);
+        return algo::computeDCTBatch(input, false, true);
+    };
+
+    /**
+     * Internal method to compute the Discrete Cosine Transform of a flat matrix in sequential mode.
+     *
+     * This method modifies the matrix in place.
+     * The rows and then the columns are transformed with strided axis passes (no transposed copy).
+     *
+     * @param data Pointer to the element (0, 0).
+     * @param rows The number of rows.
+     * @param cols The number of columns.
+     * @param stride The distance between two consecutive rows.
+     */
+    void DiscreteCosineTransform::computeSequential(double* data, const size_t rows, const size_t cols, const size_t stride){
+        return algo::computeDCT2dStrided(data, rows, cols, stride, false, false);
+    };
+
+    /**
+     * Internal method to compute the Discrete Cosine Transform of a flat matrix in parallel mode using OpenMP.
+     *
+     * This method modifies the matrix in place.
+     * The rows and then the columns are transformed with strided axis passes (no transposed copy).
+     *
+     * @param data Pointer to the element (0, 0).
+     * @param rows The number of rows.
+     * @param cols The number of columns.
+     * @param stride The distance between two consecutive rows.
+     */
+    void DiscreteCosineTransform::computeOpenMP(double* data, const size_t rows, const size_t cols, const size_t stride){
+        return algo::computeDCT2dStrided(data, rows, cols, stride, false, true);
     };
 }
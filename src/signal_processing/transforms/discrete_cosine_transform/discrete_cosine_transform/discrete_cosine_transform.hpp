@@ -49,6 +49,30 @@ namespace sp::dct::solver {
          * @param input The input matrix to be transformed.
          */
         void computeOpenMP(std::vector<std::vector<double>> &input) override;
+
+        /**
+         * Internal method to compute the Discrete Cosine Transform of a flat matrix in sequential mode.
+         *
+         * This method modifies the matrix in place.
+         *
+         * @param data Pointer to the element (0, 0).
+         * @param rows The number of rows.
+         * @param cols The number of columns.
+         * @param stride The distance between two consecutive rows.
+         */
+        void computeSequential(double* data, size_t rows, size_t cols, size_t stride) override;
+
+        /**
+         * Internal method to compute the Discrete Cosine Transform of a flat matrix in parallel mode using OpenMP.
+         *
+         * This method modifies the matrix in place.
+         *
+         * @param data Pointer to the element (0, 0).
+         * @param rows The number of rows.
+         * @param cols The number of columns.
+         * @param stride The distance between two consecutive rows.
+         */
+        void computeOpenMP(double* data, size_t rows, size_t cols, size_t stride) override;
     };
 }
 #endif //DISCRETE_COSINE_TRANSFORM_HPP
\ No newline at end of file
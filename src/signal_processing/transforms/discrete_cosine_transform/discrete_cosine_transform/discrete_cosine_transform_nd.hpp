@@ -0,0 +1,39 @@
+#ifndef DISCRETE_COSINE_TRANSFORM_ND_HPP
+#define DISCRETE_COSINE_TRANSFORM_ND_HPP
+
+#include "transforms/discrete_cosine_transform/base_discrete_cosine_transform_nd.hpp"
+
+namespace sp::dct::solver {
+    /**
+     * N-dimensional Discrete Cosine Transform (DCT) class.
+     *
+     * This class is a template for performing orthonormal DCT-II in N dimensions
+     * (e.g. 3D for the DCT of video volumes).
+     *
+     * The solver can be used in two modes:
+     *  - SEQUENTIAL: For sequential execution.
+     *  - OPENMP: For parallel execution using OpenMP.
+     *
+     * @tparam N Dimensions of the DCT (1D, 2D, 3D, etc.), cannot be less than 1.
+     */
+    template <size_t N>
+    class DiscreteCosineTransformND final : public BaseDiscreteCosineTransformND<N> {
+    public:
+        /**
+         * Create a Discrete Cosine Transform solver.
+         *
+         * @param dimensions An array of dimensions for the DCT.
+         */
+        explicit DiscreteCosineTransformND(const std::array<size_t, N>& dimensions)
+            : BaseDiscreteCosineTransformND<N>(dimensions) {}
+    protected:
+        /**
+         * The forward transform (DCT-II).
+         */
+        [[nodiscard]] bool isInverse() const override {
+            return false;
+        }
+    };
+}
+
+#endif //DISCRETE_COSINE_TRANSFORM_ND_HPP
@@ -1,49 +1,87 @@
 #include "inverse_discrete_cosine_transform.hpp"
-#include "transforms/discrete_cosine_transform/algorithms/idct.hpp"
-#include "transforms/discrete_cosine_transform/algorithms/idct_openmp.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_batch.hpp"
+#include "transforms/discrete_cosine_transform/algorithms/dct_nd.hpp"
 
 namespace sp::dct::solver{
     /**
      * Internal method to compute the Inverse Discrete Cosine Transform in sequential mode.
      *
      * The input vector is transformed in place.
+     * It goes through the batched DCT engine: power-of-2 sizes use the FFT-based algorithm (Makhoul),
+     * the others the cached basis.
      *
      * @param input The input vector to be transformed.
      */
     void InverseDiscreteCosineTransform::computeSequential(std::vector<double> &input){
-        return algo::computeIDCT1d(input);
+        return algo::computeDCTBatch(input, true, false);
     };
 
     /**
      * Internal method to compute the Inverse Discrete Cosine Transform in parallel mode (OpenMP).
      *
      * The input vector is transformed in place.
+     * It goes through the batched DCT engine: power-of-2 sizes use the FFT-based algorithm (Makhoul),
+     * the others the cached basis.
      *
      * @param input The input vector to be transformed.
      */
     void InverseDiscreteCosineTransform::computeOpenMP(std::vector<double> &input){
-        return algo::computeIDCT1dOpenMP(input);
+        return algo::computeDCTBatch(input, true, true);
     };
 
     /**
      * Internal method to compute the Inverse Discrete Cosine Transform in sequential mode.
      *
      * The input matrix is transformed in place.
+     * It goes through the batched DCT engine: power-of-2 sizes use the FFT-based algorithm (Makhoul),
+     * the others the cached basis.
      *
      * @param input The input matrix to be transformed.
      */
     void InverseDiscreteCosineTransform::computeSequential(std::vector<std::vector<double>> &input){
-        return algo::computeIDCT2d(input);
+        return algo::computeDCTBatch(input, true, false);
     };
 
     /**
      * Internal method to compute the Inverse Discrete Cosine Transform in parallel mode (OpenMP).
      *
      * The input matrix is transformed in place.
+     * It goes through the batched DCT engine: power-of-2 sizes use the FFT-based algorithm (Makhoul),
+     * the others the cached basis.
      *
      * @param input The input matrix to be transformed.
      */
     void InverseDiscreteCosineTransform::computeOpenMP(std::vector<std::vector<double>> &input){
-        return algo::computeIDCT2dOpenMP(input);
+        return algo::computeDCTBatch(input, true, true);
+    };
+
+    /**
+     * Internal method to compute the Inverse Discrete Cosine Transform of a flat matrix in sequential mode.
+     *
+     * The matrix is transformed in place.
+     * The rows and then the columns are transformed with strided axis passes (no transposed copy).
+     *
+     * @param data Pointer to the element (0, 0).
+     * @param rows The number of rows.
+     * @param cols The number of columns.
+     * @param stride The distance between two consecutive rows.
+     */
+    void InverseDiscreteCosineTransform::computeSequential(double* data, const size_t rows, const size_t cols, const size_t stride){
+        return algo::computeDCT2dStrided(data, rows, cols, stride, true, false);
+    };
+
+    /**
+     * Internal method to compute the Inverse Discrete Cosine Transform of a flat matrix in parallel mode (OpenMP).
+     *
+     * The matrix is transformed in place.
+     * The rows and then the columns are transformed with strided axis passes (no transposed copy).
+     *
+     * @param data Pointer to the element (0, 0).
+     * @param rows The number of rows.
+     * @param cols The number of columns.
+     * @param stride The distance between two consecutive rows.
+     */
+    void InverseDiscreteCosineTransform::computeOpenMP(double* data, const size_t rows, const size_t cols, const size_t stride){
+        return algo::computeDCT2dStrided(data, rows, cols, stride, true, true);
     };
 }
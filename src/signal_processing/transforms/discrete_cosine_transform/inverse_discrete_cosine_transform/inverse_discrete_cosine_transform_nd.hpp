@@ -0,0 +1,38 @@
+#ifndef INVERSE_DISCRETE_COSINE_TRANSFORM_ND_HPP
+#define INVERSE_DISCRETE_COSINE_TRANSFORM_ND_HPP
+
+#include "transforms/discrete_cosine_transform/base_discrete_cosine_transform_nd.hpp"
+
+namespace sp::dct::solver {
+    /**
+     * N-dimensional Inverse Discrete Cosine Transform (IDCT) class.
+     *
+     * This class is a template for performing the inverse of the orthonormal DCT-II (DCT-III) in N dimensions.
+     *
+     * The solver can be used in two modes:
+     *  - SEQUENTIAL: For sequential execution.
+     *  - OPENMP: For parallel execution using OpenMP.
+     *
+     * @tparam N Dimensions of the IDCT (1D, 2D, 3D, etc.), cannot be less than 1.
+     */
+    template <size_t N>
+    class InverseDiscreteCosineTransformND final : public BaseDiscreteCosineTransformND<N> {
+    public:
+        /**
+         * Create an Inverse Discrete Cosine Transform solver.
+         *
+         * @param dimensions An array of dimensions for the IDCT.
+         */
+        explicit InverseDiscreteCosineTransformND(const std::array<size_t, N>& dimensions)
+            : BaseDiscreteCosineTransformND<N>(dimensions) {}
+    protected:
+        /**
+         * The inverse transform (DCT-III).
+         */
+        [[nodiscard]] bool isInverse() const override {
+            return true;
+        }
+    };
+}
+
+#endif //INVERSE_DISCRETE_COSINE_TRANSFORM_ND_HPP
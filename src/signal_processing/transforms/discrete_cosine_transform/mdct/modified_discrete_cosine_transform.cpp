@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "transforms/discrete_cosine_transform/mdct/modified_discrete_cosine_transform.hpp"
+
+namespace sp::dct::mdct {
+    /**
+     * Modified Bessel function of the first kind of order 0 (power series).
+     */
+    static double besselI0(const double x) {
+        const double q = x * x / 4.0;
+        double term = 1.0, sum = 1.0;
+        for (int k = 1; k < 100 && term > 1e-17 * sum; ++k) {
+            term *= q / (static_cast<double>(k) * static_cast<double>(k));
+            sum += term;
+        }
+        return sum;
+    }
+
+    /**
+     * Validate the number of coefficients of an MDCT before its DCT-IV plan is built.
+     *
+     * @param numCoefficients The number N of coefficients per frame.
+     * @return The number of coefficients.
+     * @throws std::invalid_argument if N is not a power of 2 greater than 1.
+     */
+    static size_t checkNumCoefficients(const size_t numCoefficients) {
+        if (numCoefficients < 2 || (numCoefficients & (numCoefficients - 1)) != 0) {
+            throw std::invalid_argument(
+                "The number of MDCT coefficients must be a power of 2 greater than 1. Given: " +
+                std::to_string(numCoefficients)
+            );
+        }
+        return numCoefficients;
+    }
+
+    std::vector<double> makeMDCTWindow(const MDCTWindow type, const size_t numCoefficients, const double alpha) {
+        if (numCoefficients == 0) {
+            throw std::invalid_argument("The number of MDCT coefficients must be greater than 0");
+        }
+        const size_t N = numCoefficients;
+        std::vector<double> window(2 * N);
+        switch (type) {
+            case MDCTWindow::SINE:
+                for (size_t n = 0; n < 2 * N; ++n) {
+                    window[n] = std::sin(M_PI * (static_cast<double>(n) + 0.5) / static_cast<double>(2 * N));
+                }
+                break;
+            case MDCTWindow::KAISER_BESSEL_DERIVED: {
+                // cumulative sums of a Kaiser window of length N + 1
+                std::vector<double> cumulative(N + 1);
+                double sum = 0.0;
+                for (size_t n = 0; n <= N; ++n) {
+                    const double r = 2.0 * static_cast<double>(n) / static_cast<double>(N) - 1.0;
+                    sum += besselI0(M_PI * alpha * std::sqrt(std::max(0.0, 1.0 - r * r)));
+                    cumulative[n] = sum;
+                }
+                for (size_t n = 0; n < N; ++n) {
+                    window[n] = std::sqrt(cumulative[n] / sum);
+                    window[2 * N - 1 - n] = window[n];
+                }
+                break;
+            }
+        }
+        return window;
+    }
+
+    MDCTPlan::MDCTPlan(const size_t numCoefficients, const std::vector<double>& window) :
+        numCoefficients(checkNumCoefficients(numCoefficients)), window(window), dct4(numCoefficients) {
+        const size_t N = numCoefficients;
+        if (window.size() != 2 * N) {
+            throw std::invalid_argument(
+                "The MDCT window must have twice the number of coefficients samples. Given: " +
+                std::to_string(window.size()) + " samples for " + std::to_string(N) + " coefficients"
+            );
+        }
+        constexpr double tolerance = 1e-9;
+        for (size_t n = 0; n < N; ++n) {
+            if (std::abs(window[n] - window[2 * N - 1 - n]) > tolerance) {
+                throw std::invalid_argument("The MDCT window must be symmetric. Mismatch at " + std::to_string(n));
+            }
+            if (std::abs(window[n] * window[n] + window[n + N] * window[n + N] - 1.0) > tolerance) {
+                throw std::invalid_argument(
+                    "The MDCT window must satisfy the Princen-Bradley condition. Mismatch at " + std::to_string(n)
+                );
+            }
+        }
+    }
+
+    void MDCTPlan::forward(
+        const double* frame, double* coefficients, std::vector<std::complex<double>>& workspace
+    ) const {
+        const size_t N = this->numCoefficients;
+        const size_t half = N / 2;
+        const double* w = this->window.data();
+        // fold the windowed quarters (a, b, c, d) into (-c_r - d, a - b_r)
+        for (size_t n = 0; n < half; ++n) {
+            const size_t c = N + half - 1 - n, d = N + half + n;
+            const size_t a = n, b = N - 1 - n;
+            coefficients[n] = -w[c] * frame[c] - w[d] * frame[d];
+            coefficients[half + n] = w[a] * frame[a] - w[b] * frame[b];
+        }
+        this->dct4.transform(coefficients, workspace);
+    }
+
+    void MDCTPlan::inverse(
+        const double* coefficients, double* frame, std::vector<std::complex<double>>& workspace
+    ) const {
+        const size_t N = this->numCoefficients;
+        const size_t half = N / 2;
+        // u = DCT-IV(X) = (p, q) in the first half of the frame
+        std::copy(coefficients, coefficients + N, frame);
+        this->dct4.transform(frame, workspace);
+        // unfold into (q, -q_r, -p_r, -p), filling the second half first so that p is read before it is overwritten
+        for (size_t n = 0; n < half; ++n) {
+            frame[N + half + n] = -frame[n];
+            frame[N + n] = -frame[half - 1 - n];
+        }
+        for (size_t n = 0; n < half; ++n) {
+            frame[n] = frame[half + n];
+        }
+        for (size_t n = 0; n < half; ++n) {
+            frame[half + n] = -frame[half - 1 - n];
+        }
+        const double* w = this->window.data();
+        for (size_t n = 0; n < 2 * N; ++n) {
+            frame[n] *= w[n];
+        }
+    }
+
+    ModifiedDiscreteCosineTransform::ModifiedDiscreteCosineTransform(
+        const size_t numCoefficients, const MDCTWindow window
+    ) : ModifiedDiscreteCosineTransform(
+        numCoefficients, makeMDCTWindow(window, checkNumCoefficients(numCoefficients))
+    ) {}
+
+    ModifiedDiscreteCosineTransform::ModifiedDiscreteCosineTransform(
+        const size_t numCoefficients, const std::vector<double>& window
+    ) : plan(numCoefficients, window), history(2 * numCoefficients, 0.0), filled(numCoefficients) {}
+
+    void ModifiedDiscreteCosineTransform::emitFrame(std::vector<double>& frames) {
+        const size_t N = this->plan.getNumCoefficients();
+        const size_t offset = frames.size();
+        frames.resize(offset + N);
+        this->plan.forward(this->history.data(), frames.data() + offset, this->workspace);
+        std::copy(this->history.begin() + static_cast<long>(N), this->history.end(), this->history.begin());
+        this->filled = N;
+    }
+
+    size_t ModifiedDiscreteCosineTransform::push(const double* samples, const size_t count, std::vector<double>& frames) {
+        const size_t N = this->plan.getNumCoefficients();
+        size_t numFrames = 0;
+        size_t consumed = 0;
+        while (consumed < count) {
+            const size_t chunk = std::min(count - consumed, 2 * N - this->filled);
+            std::copy(samples + consumed, samples + consumed + chunk, this->history.begin() + static_cast<long>(this->filled));
+            this->filled += chunk;
+            consumed += chunk;
+            if (this->filled == 2 * N) {
+                this->emitFrame(frames);
+                ++numFrames;
+            }
+        }
+        return numFrames;
+    }
+
+    size_t ModifiedDiscreteCosineTransform::push(const std::vector<double>& samples, std::vector<double>& frames) {
+        return this->push(samples.data(), samples.size(), frames);
+    }
+
+    size_t ModifiedDiscreteCosineTransform::flush(std::vector<double>& frames) {
+        const size_t N = this->plan.getNumCoefficients();
+        size_t numFrames = 0;
+        // complete the pending samples with zeros
+        if (this->filled > N) {
+            std::fill(this->history.begin() + static_cast<long>(this->filled), this->history.end(), 0.0);
+            this->emitFrame(frames);
+            ++numFrames;
+        }
+        // the last N samples are reconstructed only by the overlap with one more frame
+        std::fill(this->history.begin() + static_cast<long>(N), this->history.end(), 0.0);
+        this->emitFrame(frames);
+        ++numFrames;
+        this->reset();
+        return numFrames;
+    }
+
+    void ModifiedDiscreteCosineTransform::reset() {
+        std::fill(this->history.begin(), this->history.end(), 0.0);
+        this->filled = this->plan.getNumCoefficients();
+    }
+
+    InverseModifiedDiscreteCosineTransform::InverseModifiedDiscreteCosineTransform(
+        const size_t numCoefficients, const MDCTWindow window
+    ) : InverseModifiedDiscreteCosineTransform(
+        numCoefficients, makeMDCTWindow(window, checkNumCoefficients(numCoefficients))
+    ) {}
+
+    InverseModifiedDiscreteCosineTransform::InverseModifiedDiscreteCosineTransform(
+        const size_t numCoefficients, const std::vector<double>& window
+    ) : plan(numCoefficients, window), overlap(numCoefficients, 0.0), frame(2 * numCoefficients), primed(false) {}
+
+    size_t InverseModifiedDiscreteCosineTransform::push(
+        const double* coefficients, const size_t numFrames, std::vector<double>& samples
+    ) {
+        const size_t N = this->plan.getNumCoefficients();
+        size_t numSamples = 0;
+        for (size_t f = 0; f < numFrames; ++f) {
+            this->plan.inverse(coefficients + f * N, this->frame.data(), this->workspace);
+            // the first half completes the previous frame (the first frame only overlaps the initial zeros)
+            if (this->primed) {
+                const size_t offset = samples.size();
+                samples.resize(offset + N);
+                for (size_t n = 0; n < N; ++n) {
+                    samples[offset + n] = this->overlap[n] + this->frame[n];
+                }
+                numSamples += N;
+            }
+            this->primed = true;
+            std::copy(this->frame.begin() + static_cast<long>(N), this->frame.end(), this->overlap.begin());
+        }
+        return numSamples;
+    }
+
+    size_t InverseModifiedDiscreteCosineTransform::push(
+        const std::vector<double>& coefficients, std::vector<double>& samples
+    ) {
+        const size_t N = this->plan.getNumCoefficients();
+        if (coefficients.size() % N != 0) {
+            throw std::invalid_argument(
+                "The number of coefficients must be a multiple of " + std::to_string(N) + ". Given: " +
+                std::to_string(coefficients.size())
+            );
+        }
+        return this->push(coefficients.data(), coefficients.size() / N, samples);
+    }
+
+    void InverseModifiedDiscreteCosineTransform::reset() {
+        std::fill(this->overlap.begin(), this->overlap.end(), 0.0);
+        this->primed = false;
+    }
+}
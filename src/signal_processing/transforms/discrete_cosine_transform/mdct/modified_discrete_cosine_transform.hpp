@@ -0,0 +1,308 @@
+#ifndef MODIFIED_DISCRETE_COSINE_TRANSFORM_HPP
+#define MODIFIED_DISCRETE_COSINE_TRANSFORM_HPP
+
+#include <complex>
+#include <vector>
+
+#include "transforms/discrete_cosine_transform/algorithms/dct_types.hpp"
+
+/**
+ * Modified Discrete Cosine Transform module.
+ *
+ * This module provides the MDCT/IMDCT of single frames and the streaming analysis (signal to frames
+ * of coefficients) and synthesis (frames to signal, overlap-add) used by transform audio codecs.
+ */
+namespace sp::dct::mdct {
+    /**
+     * Enumeration for the MDCT windows.
+     *
+     * Both satisfy the Princen-Bradley condition w[n]^2 + w[n + N]^2 = 1 and are symmetric,
+     * so the time-domain aliasing of two 50% overlapped frames cancels (TDAC):
+     *  - <code>SINE</code>: w[n] = sin(pi * (n + 1/2) / (2N)) (MP3, Vorbis-like codecs).
+     *  - <code>KAISER_BESSEL_DERIVED</code>: cumulative Kaiser window (AAC, AC-3), better stop-band rejection.
+     */
+    enum class MDCTWindow {
+        SINE,
+        KAISER_BESSEL_DERIVED
+    };
+
+    /**
+     * Generate the 2N samples of an MDCT window.
+     *
+     * @param type The window.
+     * @param numCoefficients The number N of coefficients per frame (half the frame length).
+     * @param alpha The Kaiser parameter of the KBD window (ignored by the sine window).
+     * @return The 2N window samples.
+     * @throws std::invalid_argument if numCoefficients is 0.
+     */
+    std::vector<double> makeMDCTWindow(MDCTWindow type, size_t numCoefficients, double alpha = 4.0);
+
+    /**
+     * Precomputed plan for the windowed MDCT and IMDCT of frames of 2N samples (N a power of 2).
+     *
+     * @code
+     *      X[k] = sqrt(2/N) * sum_{n=0}^{2N-1} w[n] * x[n] * cos(pi / N * (n + 1/2 + N/2) * (k + 1/2))
+     * @endcode
+     *
+     * The frame (a, b, c, d), in quarters of N/2 samples, is folded into the N samples
+     * (-c_r - d, a - b_r) (r = reversed) and transformed by the orthonormal DCT-IV, so the cost is
+     * one N/2-point FFT per frame. The IMDCT is the transpose: DCT-IV, unfolding and windowing.
+     * With a Princen-Bradley window, the overlap-add of consecutive IMDCT frames (hop N)
+     * reconstructs the signal exactly.
+     *
+     * The plan is immutable after construction, so it can be shared by many threads.
+     */
+    class MDCTPlan {
+    public:
+        /**
+         * Create a plan with a user-defined window.
+         *
+         * @param numCoefficients The number N of coefficients per frame (power of 2, at least 2).
+         * @param window The 2N window samples.
+         * @throws std::invalid_argument if N is not a power of 2 greater than 1, the window size is not 2N,
+         *         or the window is not symmetric or does not satisfy the Princen-Bradley condition.
+         */
+        MDCTPlan(size_t numCoefficients, const std::vector<double>& window);
+
+        /**
+         * Windowed MDCT of a frame.
+         *
+         * @param frame The 2N samples of the frame.
+         * @param coefficients The N coefficients (output, must not overlap frame).
+         * @param workspace Buffer for the FFT (resized if needed, it can be reused among calls).
+         */
+        void forward(const double* frame, double* coefficients, std::vector<std::complex<double>>& workspace) const;
+
+        /**
+         * Windowed IMDCT of a frame (to be overlap-added with the previous and next frames).
+         *
+         * @param coefficients The N coefficients.
+         * @param frame The 2N windowed samples (output, must not overlap coefficients).
+         * @param workspace Buffer for the FFT (resized if needed, it can be reused among calls).
+         */
+        void inverse(const double* coefficients, double* frame, std::vector<std::complex<double>>& workspace) const;
+
+        /**
+         * Get the number of coefficients per frame.
+         * @return The number N (the hop size).
+         */
+        [[nodiscard]] size_t getNumCoefficients() const {
+            return numCoefficients;
+        }
+
+        /**
+         * Get the window.
+         * @return The 2N window samples.
+         */
+        [[nodiscard]] const std::vector<double>& getWindow() const {
+            return window;
+        }
+
+    private:
+        /**
+         * The number N of coefficients per frame.
+         */
+        size_t numCoefficients;
+        /**
+         * The 2N window samples.
+         */
+        std::vector<double> window;
+        /**
+         * The DCT-IV of length N.
+         */
+        algo::FastDCT4Plan dct4;
+    };
+
+    /**
+     * Streaming MDCT analysis of a real signal, with 50% overlapped frames.
+     *
+     * Samples are pushed incrementally (any number at a time); every N samples a frame of 2N samples
+     * (the previous N and the new N) is complete and its N coefficients are emitted.
+     * The stream starts with N zero samples, so the first frame already contains the first N samples
+     * and the synthesis (InverseModifiedDiscreteCosineTransform) is aligned with the input.
+     *
+     * The internal buffers are allocated once; pushing samples allocates only if
+     * the output vector has to grow (reserve it to avoid that).
+     */
+    class ModifiedDiscreteCosineTransform {
+    public:
+        /**
+         * Create a streaming MDCT with one of the predefined windows.
+         *
+         * @param numCoefficients The number N of coefficients per frame, also the hop size (power of 2, at least 2).
+         * @param window The window.
+         * @throws std::invalid_argument if N is not a power of 2 greater than 1.
+         */
+        explicit ModifiedDiscreteCosineTransform(size_t numCoefficients, MDCTWindow window = MDCTWindow::SINE);
+
+        /**
+         * Create a streaming MDCT with a user-defined window.
+         *
+         * @param numCoefficients The number N of coefficients per frame, also the hop size (power of 2, at least 2).
+         * @param window The 2N window samples (symmetric, Princen-Bradley).
+         * @throws std::invalid_argument if N or the window are not valid (see MDCTPlan).
+         */
+        ModifiedDiscreteCosineTransform(size_t numCoefficients, const std::vector<double>& window);
+
+        /**
+         * Push new samples and append the coefficients of the completed frames to the output.
+         *
+         * Each emitted frame is made of N coefficients, appended one frame after the other (row-major).
+         *
+         * @param samples Pointer to the new samples.
+         * @param count The number of new samples.
+         * @param frames The vector where the coefficients of the completed frames are appended.
+         * @return The number of frames appended.
+         */
+        size_t push(const double* samples, size_t count, std::vector<double>& frames);
+
+        /**
+         * Push new samples and append the coefficients of the completed frames to the output.
+         *
+         * @param samples The new samples.
+         * @param frames The vector where the coefficients of the completed frames are appended.
+         * @return The number of frames appended.
+         */
+        size_t push(const std::vector<double>& samples, std::vector<double>& frames);
+
+        /**
+         * End the stream: pad with zeros, append the frames needed to reconstruct all the pushed samples
+         * and reset the stream.
+         *
+         * @param frames The vector where the coefficients of the last frames are appended.
+         * @return The number of frames appended.
+         */
+        size_t flush(std::vector<double>& frames);
+
+        /**
+         * Discard the input history, as if no sample had been pushed.
+         */
+        void reset();
+
+        /**
+         * Get the number of coefficients per frame.
+         * @return The number N (the hop size).
+         */
+        [[nodiscard]] size_t getNumCoefficients() const {
+            return plan.getNumCoefficients();
+        }
+
+        /**
+         * Get the window.
+         * @return The 2N window samples.
+         */
+        [[nodiscard]] const std::vector<double>& getWindow() const {
+            return plan.getWindow();
+        }
+
+    private:
+        /**
+         * The MDCT of the frames.
+         */
+        MDCTPlan plan;
+        /**
+         * The current frame: the last N samples of the previous frame, then the new ones.
+         */
+        std::vector<double> history;
+        /**
+         * Number of valid samples in the history (at least N).
+         */
+        size_t filled;
+        /**
+         * Buffer for the FFT of the DCT-IV.
+         */
+        std::vector<std::complex<double>> workspace;
+
+        /**
+         * Transform the (full) history, append the coefficients and slide the history by N samples.
+         *
+         * @param frames The vector where the coefficients are appended.
+         */
+        void emitFrame(std::vector<double>& frames);
+    };
+
+    /**
+     * Streaming IMDCT synthesis with overlap-add (time-domain aliasing cancellation).
+     *
+     * Frames of N coefficients (e.g. from ModifiedDiscreteCosineTransform) are pushed incrementally;
+     * every frame after the first one completes N output samples. With the same window of the analysis,
+     * the output is the analyzed signal, aligned with it (the first frame only fills the overlap).
+     */
+    class InverseModifiedDiscreteCosineTransform {
+    public:
+        /**
+         * Create a streaming IMDCT with one of the predefined windows.
+         *
+         * @param numCoefficients The number N of coefficients per frame (power of 2, at least 2).
+         * @param window The window (the same of the analysis).
+         * @throws std::invalid_argument if N is not a power of 2 greater than 1.
+         */
+        explicit InverseModifiedDiscreteCosineTransform(size_t numCoefficients, MDCTWindow window = MDCTWindow::SINE);
+
+        /**
+         * Create a streaming IMDCT with a user-defined window.
+         *
+         * @param numCoefficients The number N of coefficients per frame (power of 2, at least 2).
+         * @param window The 2N window samples (the same of the analysis).
+         * @throws std::invalid_argument if N or the window are not valid (see MDCTPlan).
+         */
+        InverseModifiedDiscreteCosineTransform(size_t numCoefficients, const std::vector<double>& window);
+
+        /**
+         * Push frames of coefficients and append the completed samples to the output.
+         *
+         * @param coefficients Pointer to numFrames * N coefficients (row-major).
+         * @param numFrames The number of frames.
+         * @param samples The vector where the completed samples are appended.
+         * @return The number of samples appended.
+         */
+        size_t push(const double* coefficients, size_t numFrames, std::vector<double>& samples);
+
+        /**
+         * Push frames of coefficients and append the completed samples to the output.
+         *
+         * @param coefficients The coefficients of the frames, one frame after the other.
+         * @param samples The vector where the completed samples are appended.
+         * @return The number of samples appended.
+         * @throws std::invalid_argument if the number of coefficients is not a multiple of N.
+         */
+        size_t push(const std::vector<double>& coefficients, std::vector<double>& samples);
+
+        /**
+         * Discard the overlap, as if no frame had been pushed.
+         */
+        void reset();
+
+        /**
+         * Get the number of coefficients per frame.
+         * @return The number N (the hop size).
+         */
+        [[nodiscard]] size_t getNumCoefficients() const {
+            return plan.getNumCoefficients();
+        }
+
+    private:
+        /**
+         * The IMDCT of the frames.
+         */
+        MDCTPlan plan;
+        /**
+         * The second half of the previous windowed frame.
+         */
+        std::vector<double> overlap;
+        /**
+         * The current windowed frame (2N samples).
+         */
+        std::vector<double> frame;
+        /**
+         * True after the first frame (which only fills the overlap).
+         */
+        bool primed;
+        /**
+         * Buffer for the FFT of the DCT-IV.
+         */
+        std::vector<std::complex<double>> workspace;
+    };
+}
+
+#endif //MODIFIED_DISCRETE_COSINE_TRANSFORM_HPP
@@ -0,0 +1,120 @@
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <omp.h>
+
+#include "transforms/fourier_transform/algorithms/cooley_tukey/cooley_tukey_batch.hpp"
+
+namespace sp::fft::algo::cooley_tukey {
+    BatchPlan::BatchPlan(const size_t length) : length(length) {
+        if (length == 0 || (length & (length - 1)) != 0) {
+            throw std::invalid_argument(
+                "The FFT length must be a positive power of 2. Given: " + std::to_string(length)
+            );
+        }
+        const auto log2N = static_cast<size_t>(std::log2(length));
+
+        // bit-reversal table (same permutation as utils::bit_rev, computed once)
+        this->bitReversed.resize(length);
+        for (size_t i = 0; i < length; ++i) {
+            size_t reversed = 0;
+            for (size_t j = 0; j < log2N; ++j) {
+                if (i & (static_cast<size_t>(1) << j)) {
+                    reversed |= static_cast<size_t>(1) << (log2N - j - 1);
+                }
+            }
+            this->bitReversed[i] = reversed;
+        }
+
+        // twiddle factors of the last stage; stage m uses every (N/m)-th entry
+        this->twiddles.resize(length / 2);
+        for (size_t j = 0; j < length / 2; ++j) {
+            this->twiddles[j] = std::polar(1.0, -2 * M_PI * static_cast<double>(j) / static_cast<double>(length));
+        }
+    }
+
+    void BatchPlan::transform(std::complex<double>* signal, const bool inverse) const {
+        const size_t N = this->length;
+
+        // 1. Bit-Reversal Permutation (table-driven).
+        for (size_t i = 0; i < N; ++i) {
+            const size_t r = this->bitReversed[i];
+            if (r > i) {
+                std::swap(signal[i], signal[r]);
+            }
+        }
+
+        // 2. Iterative Cooley-Tukey FFT (same stages of computeFFT, with tabulated twiddles).
+        for (size_t m = 2; m <= N; m <<= 1) {
+            const size_t m2 = m >> 1;
+            const size_t twiddleStride = N / m;
+            for (size_t k = 0; k < N; k += m) {
+                for (size_t j = 0; j < m2; ++j) {
+                    const std::complex<double> w = inverse
+                        ? std::conj(this->twiddles[j * twiddleStride])
+                        : this->twiddles[j * twiddleStride];
+                    const std::complex<double> t = w * signal[k + j + m2];
+                    const std::complex<double> u = signal[k + j];
+                    signal[k + j] = u + t;
+                    signal[k + j + m2] = u - t;
+                }
+            }
+        }
+
+        if (inverse) {
+            const double scale = 1.0 / static_cast<double>(N);
+            for (size_t i = 0; i < N; ++i) {
+                signal[i] *= scale;
+            }
+        }
+    }
+
+    void BatchPlan::forward(std::complex<double>* data, const size_t count) const {
+        for (size_t i = 0; i < count; ++i) {
+            this->transform(data + i * this->length, false);
+        }
+    }
+
+    void BatchPlan::inverse(std::complex<double>* data, const size_t count) const {
+        for (size_t i = 0; i < count; ++i) {
+            this->transform(data + i * this->length, true);
+        }
+    }
+
+    void BatchPlan::forwardOpenMP(std::complex<double>* data, const size_t count) const {
+        // one parallel region for the whole batch, unless we are already inside one
+        #pragma omp parallel for if(count > 1 && !omp_in_parallel())
+        for (size_t i = 0; i < count; ++i) {
+            this->transform(data + i * this->length, false);
+        }
+    }
+
+    void BatchPlan::inverseOpenMP(std::complex<double>* data, const size_t count) const {
+        #pragma omp parallel for if(count > 1 && !omp_in_parallel())
+        for (size_t i = 0; i < count; ++i) {
+            this->transform(data + i * this->length, true);
+        }
+    }
+
+    void computeFFTBatch(std::vector<std::complex<double>>& data, const size_t length) {
+        if (length == 0 || data.size() % length != 0) {
+            throw std::invalid_argument(
+                "The batch size (" + std::to_string(data.size()) +
+                ") is not a multiple of the signal length (" + std::to_string(length) + ")."
+            );
+        }
+        const BatchPlan plan(length);
+        plan.forward(data.data(), data.size() / length);
+    }
+
+    void computeInverseFFTBatch(std::vector<std::complex<double>>& data, const size_t length) {
+        if (length == 0 || data.size() % length != 0) {
+            throw std::invalid_argument(
+                "The batch size (" + std::to_string(data.size()) +
+                ") is not a multiple of the signal length (" + std::to_string(length) + ")."
+            );
+        }
+        const BatchPlan plan(length);
+        plan.inverse(data.data(), data.size() / length);
+    }
+}
@@ -0,0 +1,126 @@
+#ifndef COOLEY_TUKEY_BATCH_HPP
+#define COOLEY_TUKEY_BATCH_HPP
+
+#include <complex>
+#include <vector>
+
+namespace sp::fft::algo::cooley_tukey {
+    /**
+     * Precomputed plan for batches of 1D Cooley-Tukey FFTs of the same length.
+     *
+     * The single-signal kernels (computeFFT, computeInverseFFT) recompute the bit-reversed indices
+     * and the twiddle factors at every call. When many signals of the same length are transformed
+     * (rows of a matrix, frames of a spectrogram, blocks of a stream), the plan computes them once:
+     *  - the bit-reversal permutation table;
+     *  - the N/2 twiddle factors e^(-2 * pi * i * j / N), computed directly (no recurrence error).
+     *
+     * The plan is immutable after construction, so it can be shared by many threads.
+     *
+     * It handles only the
+     * <a href="https://en.wikipedia.org/wiki/Cooley%E2%80%93Tukey_FFT_algorithm#The_radix-2_DIT_case">radix-2 case</a>.
+     */
+    class BatchPlan {
+    public:
+        /**
+         * Create a plan for FFTs of the given length.
+         *
+         * @param length The length of each signal of the batch.
+         * @throws std::invalid_argument if the length is not a positive power of 2.
+         */
+        explicit BatchPlan(size_t length);
+
+        /**
+         * Forward FFT of a batch of contiguous signals (in-place).
+         *
+         * @param data Pointer to count * getLength() complex numbers; signal i starts at data + i * getLength().
+         * @param count The number of signals in the batch.
+         */
+        void forward(std::complex<double>* data, size_t count) const;
+
+        /**
+         * Inverse FFT of a batch of contiguous signals (in-place), normalized by 1/N.
+         *
+         * @param data Pointer to count * getLength() complex numbers; signal i starts at data + i * getLength().
+         * @param count The number of signals in the batch.
+         */
+        void inverse(std::complex<double>* data, size_t count) const;
+
+        /**
+         * Forward FFT of a batch of contiguous signals (in-place) using OpenMP.
+         *
+         * The signals are distributed among the threads.
+         * If it is called from inside an active parallel region, it runs sequentially
+         * to avoid nested parallel regions.
+         *
+         * @param data Pointer to count * getLength() complex numbers.
+         * @param count The number of signals in the batch.
+         */
+        void forwardOpenMP(std::complex<double>* data, size_t count) const;
+
+        /**
+         * Inverse FFT of a batch of contiguous signals (in-place) using OpenMP, normalized by 1/N.
+         *
+         * The signals are distributed among the threads.
+         * If it is called from inside an active parallel region, it runs sequentially
+         * to avoid nested parallel regions.
+         *
+         * @param data Pointer to count * getLength() complex numbers.
+         * @param count The number of signals in the batch.
+         */
+        void inverseOpenMP(std::complex<double>* data, size_t count) const;
+
+        /**
+         * Get the length of the signals handled by the plan.
+         * @return The FFT length.
+         */
+        [[nodiscard]] size_t getLength() const {
+            return length;
+        }
+
+    private:
+        /**
+         * The FFT length (N).
+         */
+        size_t length;
+        /**
+         * Bit-reversed index of each position: bitReversed[i] is the position of element i after the permutation.
+         */
+        std::vector<size_t> bitReversed;
+        /**
+         * Forward twiddle factors e^(-2 * pi * i * j / N) for j in [0, N/2).
+         * The inverse transform uses their complex conjugates.
+         */
+        std::vector<std::complex<double>> twiddles;
+
+        /**
+         * Transform a single signal in-place.
+         *
+         * @param signal Pointer to the getLength() complex numbers of the signal.
+         * @param inverse True for the inverse transform (conjugated twiddles and 1/N normalization).
+         */
+        void transform(std::complex<double>* signal, bool inverse) const;
+    };
+
+    /**
+     * Sequential batched Cooley-Tukey FFT (1D).
+     *
+     * The input vector holds data.size() / length contiguous signals of the given length,
+     * each one is transformed in place.
+     *
+     * @param data The batch of signals (row-major, one signal per row).
+     * @param length The length of each signal (power of 2).
+     * @throws std::invalid_argument if data.size() is not a multiple of length.
+     */
+    void computeFFTBatch(std::vector<std::complex<double>>& data, size_t length);
+
+    /**
+     * Sequential batched Cooley-Tukey Inverse FFT (1D), normalized by 1/length.
+     *
+     * @param data The batch of signals (row-major, one signal per row).
+     * @param length The length of each signal (power of 2).
+     * @throws std::invalid_argument if data.size() is not a multiple of length.
+     */
+    void computeInverseFFTBatch(std::vector<std::complex<double>>& data, size_t length);
+}
+
+#endif //COOLEY_TUKEY_BATCH_HPP
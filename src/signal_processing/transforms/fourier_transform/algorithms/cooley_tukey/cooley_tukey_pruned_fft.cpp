@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "transforms/fourier_transform/algorithms/cooley_tukey/cooley_tukey_pruned_fft.hpp"
+
+namespace sp::fft::algo::cooley_tukey {
+    /**
+     * Smallest power of 2 greater than or equal to value (value > 0).
+     */
+    static size_t nextPowerOfTwo(const size_t value) {
+        size_t power = 1;
+        while (power < value) {
+            power <<= 1;
+        }
+        return power;
+    }
+
+    /**
+     * Choose between the input-pruned (true) and the output-pruned (false) decomposition
+     * by comparing the number of butterflies and multiplications of the two.
+     */
+    static bool chooseInputPruning(
+        const size_t fftSize, const size_t inputLength, const size_t outputCount
+    ) {
+        const size_t inputSub = nextPowerOfTwo(inputLength);
+        const size_t inputRows = std::min(fftSize / inputSub, outputCount);
+        const double inputCost = static_cast<double>(inputRows * inputSub) *
+            (std::log2(static_cast<double>(inputSub)) + 1);
+
+        const size_t outputSub = nextPowerOfTwo(outputCount);
+        const size_t outputRows = std::min(fftSize / outputSub, inputLength);
+        const double outputCost = static_cast<double>(outputRows) *
+            (static_cast<double>(outputSub) * (std::log2(static_cast<double>(outputSub)) + 1) +
+             static_cast<double>(outputCount));
+
+        return inputCost <= outputCost;
+    }
+
+    /**
+     * Validate the arguments of the plan (before the sub-plan is built).
+     */
+    static size_t validatedFFTSize(
+        const size_t fftSize, const size_t inputLength, const size_t outputOffset, const size_t outputCount
+    ) {
+        if (fftSize == 0 || (fftSize & (fftSize - 1)) != 0) {
+            throw std::invalid_argument(
+                "The FFT size must be a positive power of 2. Given: " + std::to_string(fftSize)
+            );
+        }
+        if (inputLength == 0 || inputLength > fftSize) {
+            throw std::invalid_argument(
+                "The input length must be in [1, " + std::to_string(fftSize) + "]. Given: " + std::to_string(inputLength)
+            );
+        }
+        if (outputCount == 0 || outputOffset >= fftSize || outputCount > fftSize - outputOffset) {
+            throw std::invalid_argument(
+                "The output range [" + std::to_string(outputOffset) + ", " +
+                std::to_string(outputOffset + outputCount) + ") must be a non-empty range inside [0, " +
+                std::to_string(fftSize) + ")."
+            );
+        }
+        return fftSize;
+    }
+
+    PrunedPlan::PrunedPlan(
+        const size_t fftSize,
+        const size_t inputLength,
+        const size_t outputOffset,
+        const size_t outputCount
+    ) : fftSize(validatedFFTSize(fftSize, inputLength, outputOffset, outputCount)),
+        inputLength(inputLength), outputOffset(outputOffset), outputCount(outputCount),
+        inputPruned(chooseInputPruning(fftSize, inputLength, outputCount)),
+        subSize(nextPowerOfTwo(inputPruned ? inputLength : outputCount)),
+        numSubTransforms(fftSize / subSize),
+        plan(subSize) {
+        const size_t P = this->numSubTransforms;
+        if (this->inputPruned) {
+            // the output range touches min(P, K) residues r = k mod P
+            if (outputCount >= P) {
+                this->activeRows.resize(P);
+                for (size_t r = 0; r < P; ++r) {
+                    this->activeRows[r] = r;
+                }
+            } else {
+                this->activeRows.resize(outputCount);
+                for (size_t j = 0; j < outputCount; ++j) {
+                    this->activeRows[j] = (outputOffset + j) % P;
+                }
+            }
+        } else {
+            // the sub-sequences x[P * m + p] with p >= L are all zero
+            this->activeRows.resize(std::min(P, inputLength));
+            for (size_t p = 0; p < this->activeRows.size(); ++p) {
+                this->activeRows[p] = p;
+            }
+        }
+
+        // two-level twiddle table: N = 2^bits, fine table of 2^(bits / 2) entries
+        const auto bits = static_cast<size_t>(std::log2(static_cast<double>(fftSize)));
+        this->twiddleShift = bits / 2;
+        this->twiddleMask = (static_cast<size_t>(1) << this->twiddleShift) - 1;
+        this->fineTwiddles.resize(this->twiddleMask + 1);
+        for (size_t j = 0; j <= this->twiddleMask; ++j) {
+            this->fineTwiddles[j] = std::polar(1.0, -2 * M_PI * static_cast<double>(j) / static_cast<double>(fftSize));
+        }
+        this->coarseTwiddles.resize(fftSize >> this->twiddleShift);
+        for (size_t j = 0; j < this->coarseTwiddles.size(); ++j) {
+            this->coarseTwiddles[j] = std::polar(
+                1.0, -2 * M_PI * static_cast<double>(j << this->twiddleShift) / static_cast<double>(fftSize)
+            );
+        }
+    }
+
+    void PrunedPlan::gather(
+        const std::complex<double>* input,
+        std::complex<double>* rows,
+        const bool parallel
+    ) const {
+        const size_t numRows = this->activeRows.size();
+        const size_t S = this->subSize;
+        const size_t L = this->inputLength;
+        const size_t P = this->numSubTransforms;
+        #pragma omp parallel for if(parallel && numRows > 1)
+        for (size_t i = 0; i < numRows; ++i) {
+            std::complex<double>* row = rows + i * S;
+            if (this->inputPruned) {
+                // modulated copy of the non-zero input: x[n] * W_N^(n * r), zero-padded to L'
+                const size_t r = this->activeRows[i];
+                for (size_t n = 0; n < L; ++n) {
+                    row[n] = input[n] * this->twiddle(n * r);
+                }
+                std::fill(row + L, row + S, std::complex<double>(0.0, 0.0));
+            } else {
+                // decimated sub-sequence x'[P * m + p], with x'[n] = x[n] * W_N^(n * offset)
+                // (no modulation is needed when the range starts at the bin 0)
+                const size_t p = this->activeRows[i];
+                const bool modulate = this->outputOffset != 0;
+                for (size_t m = 0; m < S; ++m) {
+                    const size_t n = P * m + p;
+                    if (n >= L) {
+                        row[m] = std::complex<double>(0.0, 0.0);
+                    } else {
+                        row[m] = modulate ? input[n] * this->twiddle(n * this->outputOffset) : input[n];
+                    }
+                }
+            }
+        }
+    }
+
+    void PrunedPlan::scatter(
+        const std::complex<double>* rows,
+        std::complex<double>* output,
+        const bool parallel
+    ) const {
+        const size_t K = this->outputCount;
+        const size_t S = this->subSize;
+        const size_t P = this->numSubTransforms;
+        const size_t numRows = this->activeRows.size();
+        if (this->inputPruned) {
+            const bool allRows = numRows == P;
+            #pragma omp parallel for if(parallel && K > 1)
+            for (size_t j = 0; j < K; ++j) {
+                // X[r + P * s] is the bin s of the sub-FFT of residue r
+                const size_t k = this->outputOffset + j;
+                const size_t r = k % P;
+                const size_t s = k / P;
+                const size_t i = allRows ? r : (r + P - this->outputOffset % P) % P;
+                output[j] = rows[i * S + s];
+            }
+        } else {
+            #pragma omp parallel for if(parallel && K > 1)
+            for (size_t k = 0; k < K; ++k) {
+                // X[offset + k] = sum_p W_N^(p * k) * Z_p[k]
+                std::complex<double> sum(0.0, 0.0);
+                for (size_t i = 0; i < numRows; ++i) {
+                    sum += this->twiddle(this->activeRows[i] * k) * rows[i * S + k];
+                }
+                output[k] = sum;
+            }
+        }
+    }
+
+    void PrunedPlan::execute(
+        const std::complex<double>* input,
+        std::complex<double>* output,
+        std::vector<std::complex<double>>& workspace
+    ) const {
+        workspace.resize(this->getWorkspaceSize());
+        this->gather(input, workspace.data(), false);
+        this->plan.forward(workspace.data(), this->activeRows.size());
+        this->scatter(workspace.data(), output, false);
+    }
+
+    void PrunedPlan::executeOpenMP(
+        const std::complex<double>* input,
+        std::complex<double>* output,
+        std::vector<std::complex<double>>& workspace
+    ) const {
+        workspace.resize(this->getWorkspaceSize());
+        this->gather(input, workspace.data(), true);
+        this->plan.forwardOpenMP(workspace.data(), this->activeRows.size());
+        this->scatter(workspace.data(), output, true);
+    }
+
+    void computeInputPrunedFFT(std::vector<std::complex<double>>& input, const size_t nonZeroLength) {
+        const PrunedPlan plan(input.size(), nonZeroLength, 0, input.size());
+        std::vector<std::complex<double>> output(input.size());
+        std::vector<std::complex<double>> workspace;
+        plan.execute(input.data(), output.data(), workspace);
+        input.swap(output);
+    }
+
+    void computeOutputPrunedFFT(std::vector<std::complex<double>>& input, const size_t outputLength) {
+        const PrunedPlan plan(input.size(), input.size(), 0, outputLength);
+        std::vector<std::complex<double>> output(outputLength);
+        std::vector<std::complex<double>> workspace;
+        plan.execute(input.data(), output.data(), workspace);
+        input.swap(output);
+    }
+}
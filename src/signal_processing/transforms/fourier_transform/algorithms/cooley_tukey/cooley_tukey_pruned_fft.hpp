@@ -0,0 +1,220 @@
+#ifndef COOLEY_TUKEY_PRUNED_FFT_HPP
+#define COOLEY_TUKEY_PRUNED_FFT_HPP
+
+#include <complex>
+#include <vector>
+
+#include "transforms/fourier_transform/algorithms/cooley_tukey/cooley_tukey_batch.hpp"
+
+namespace sp::fft::algo::cooley_tukey {
+    /**
+     * Precomputed plan for a pruned FFT of length N.
+     *
+     * Only the first L input samples are non-zero (zero-padding) and only the outputs
+     * X[offset], ..., X[offset + K - 1] are wanted. A full radix-2 FFT still runs every butterfly
+     * over N points; the pruned FFT splits the transform in smaller FFTs so that the work
+     * scales with the useful data:
+     *
+     *  - input pruning, with L' = 2^ceil(log2(L)) and P = N / L',
+     *    each output index is k = r + P * s, so
+     *          X[r + P * s] = sum_{n<L'} (x[n] * W_N^(n * r)) * W_L'^(n * s)
+     *    i.e. P FFTs of length L' on modulated copies of the non-zero input: O(N * log(L)).
+     *
+     *  - output pruning, with K' = 2^ceil(log2(K)) and P = N / K',
+     *    each input index is n = P * m + p, so
+     *          X[offset + k] = sum_{p<P} W_N^(p * k) * FFT_K'(x'[P * m + p])[k],   x'[n] = x[n] * W_N^(n * offset)
+     *    i.e. P FFTs of length K' (only the ones with non-zero input) plus K * P combinations: O(N * log(K)).
+     *
+     * The plan uses the cheaper of the two (a full FFT when L = K = N).
+     * It is immutable after construction, so it can be shared by many threads
+     * (each one with its own workspace).
+     */
+    class PrunedPlan {
+    public:
+        /**
+         * Create a pruned FFT plan.
+         *
+         * @param fftSize The length N of the (zero-padded) transform, a power of 2.
+         * @param inputLength The number L of non-zero input samples (1 <= L <= N).
+         * @param outputOffset The index of the first wanted output bin.
+         * @param outputCount The number K of wanted output bins (offset + K <= N).
+         * @throws std::invalid_argument if the arguments are not valid.
+         */
+        PrunedPlan(size_t fftSize, size_t inputLength, size_t outputOffset, size_t outputCount);
+
+        /**
+         * Compute the wanted outputs.
+         *
+         * @param input Pointer to the L non-zero input samples.
+         * @param output Pointer to the K output bins X[offset], ..., X[offset + K - 1].
+         * @param workspace Buffer for the sub-FFTs (resized to getWorkspaceSize() if needed, it can be reused among calls).
+         */
+        void execute(
+            const std::complex<double>* input,
+            std::complex<double>* output,
+            std::vector<std::complex<double>>& workspace
+        ) const;
+
+        /**
+         * Compute the wanted outputs using OpenMP (the sub-FFTs and the combinations are distributed among the threads).
+         *
+         * @param input Pointer to the L non-zero input samples.
+         * @param output Pointer to the K output bins X[offset], ..., X[offset + K - 1].
+         * @param workspace Buffer for the sub-FFTs (resized to getWorkspaceSize() if needed, it can be reused among calls).
+         */
+        void executeOpenMP(
+            const std::complex<double>* input,
+            std::complex<double>* output,
+            std::vector<std::complex<double>>& workspace
+        ) const;
+
+        /**
+         * Get the length of the (zero-padded) transform.
+         * @return The FFT length N.
+         */
+        [[nodiscard]] size_t getFFTSize() const {
+            return fftSize;
+        }
+
+        /**
+         * Get the number of non-zero input samples.
+         * @return The input length L.
+         */
+        [[nodiscard]] size_t getInputLength() const {
+            return inputLength;
+        }
+
+        /**
+         * Get the index of the first wanted output bin.
+         * @return The output offset.
+         */
+        [[nodiscard]] size_t getOutputOffset() const {
+            return outputOffset;
+        }
+
+        /**
+         * Get the number of wanted output bins.
+         * @return The output count K.
+         */
+        [[nodiscard]] size_t getOutputCount() const {
+            return outputCount;
+        }
+
+        /**
+         * Check if the plan prunes the input (true) or the output (false).
+         * @return True if the input-pruned decomposition is used.
+         */
+        [[nodiscard]] bool isInputPruned() const {
+            return inputPruned;
+        }
+
+        /**
+         * Get the number of samples of the workspace of execute and executeOpenMP.
+         * @return The size of the rows of the active sub-FFTs.
+         */
+        [[nodiscard]] size_t getWorkspaceSize() const {
+            return activeRows.size() * subSize;
+        }
+
+    private:
+        /**
+         * The FFT length N.
+         */
+        size_t fftSize;
+        /**
+         * The number of non-zero input samples L.
+         */
+        size_t inputLength;
+        /**
+         * The first wanted output bin.
+         */
+        size_t outputOffset;
+        /**
+         * The number of wanted output bins K.
+         */
+        size_t outputCount;
+        /**
+         * True if the input-pruned decomposition is used, false for the output-pruned one.
+         */
+        bool inputPruned;
+        /**
+         * The length of the sub-FFTs (L' or K').
+         */
+        size_t subSize;
+        /**
+         * The number of sub-FFTs of the decomposition (P = N / subSize).
+         */
+        size_t numSubTransforms;
+        /**
+         * The sub-FFTs actually computed (the other ones are not needed or have only zeros as input).
+         */
+        std::vector<size_t> activeRows;
+        /**
+         * The plan of the sub-FFTs.
+         */
+        BatchPlan plan;
+        /**
+         * Two-level table of W_N^j = e^(-2 * pi * i * j / N): W_N^j = coarse[j >> shift] * fine[j & mask].
+         * It needs O(sqrt(N)) memory instead of O(N).
+         */
+        std::vector<std::complex<double>> coarseTwiddles, fineTwiddles;
+        /**
+         * The split of the twiddle index between the two tables.
+         */
+        size_t twiddleShift, twiddleMask;
+
+        /**
+         * Get the twiddle factor W_N^j.
+         * @param j The exponent (any value, it is reduced modulo N).
+         * @return e^(-2 * pi * i * j / N).
+         */
+        [[nodiscard]] std::complex<double> twiddle(size_t j) const {
+            j &= fftSize - 1;
+            return coarseTwiddles[j >> twiddleShift] * fineTwiddles[j & twiddleMask];
+        }
+
+        /**
+         * Fill the sub-FFT inputs of the active rows.
+         *
+         * @param input Pointer to the L non-zero input samples.
+         * @param rows The buffer of activeRows.size() x subSize samples.
+         * @param parallel True to distribute the rows among the OpenMP threads.
+         */
+        void gather(const std::complex<double>* input, std::complex<double>* rows, bool parallel) const;
+
+        /**
+         * Combine the sub-FFT outputs into the wanted output bins.
+         *
+         * @param rows The buffer of activeRows.size() x subSize transformed samples.
+         * @param output Pointer to the K output bins.
+         * @param parallel True to distribute the output bins among the OpenMP threads.
+         */
+        void scatter(const std::complex<double>* rows, std::complex<double>* output, bool parallel) const;
+    };
+
+    /**
+     * Input-pruned Cooley-Tukey FFT (1D).
+     *
+     * Only the first nonZeroLength samples of the input are read, the others are assumed to be zero.
+     * The output is stored in the same input vector (all the N bins), which is modified in place.
+     *
+     * @param input The input vector of N complex numbers (N power of 2).
+     * @param nonZeroLength The number of non-zero input samples.
+     * @throws std::invalid_argument if nonZeroLength is 0 or greater than N, or N is not a power of 2.
+     */
+    void computeInputPrunedFFT(std::vector<std::complex<double>>& input, size_t nonZeroLength);
+
+    /**
+     * Output-pruned Cooley-Tukey FFT (1D).
+     *
+     * Only the first outputLength bins are computed; the input vector is replaced by them
+     * (so its size becomes outputLength).
+     *
+     * @param input The input vector of N complex numbers (N power of 2).
+     * @param outputLength The number of wanted output bins.
+     * @throws std::invalid_argument if outputLength is 0 or greater than N, or N is not a power of 2.
+     */
+    void computeOutputPrunedFFT(std::vector<std::complex<double>>& input, size_t outputLength);
+}
+
+#endif //COOLEY_TUKEY_PRUNED_FFT_HPP
@@ -0,0 +1,53 @@
+#include <stdexcept>
+#include <string>
+
+#include "transforms/fourier_transform/pruned_fast_fourier_transform/pruned_fast_fourier_transform.hpp"
+
+namespace sp::fft::solver {
+    PrunedFastFourierTransform::PrunedFastFourierTransform(
+        const size_t fftSize,
+        const size_t inputLength,
+        const size_t outputOffset,
+        const size_t outputCount
+    ) : plan(fftSize, inputLength, outputOffset, outputCount) {}
+
+    void PrunedFastFourierTransform::compute(
+        const std::vector<std::complex<double>>& input,
+        std::vector<std::complex<double>>& output,
+        const ComputationMode mode,
+        const int threads
+    ) const {
+        std::vector<std::complex<double>> workspace;
+        this->compute(input, output, workspace, mode, threads);
+    }
+
+    void PrunedFastFourierTransform::compute(
+        const std::vector<std::complex<double>>& input,
+        std::vector<std::complex<double>>& output,
+        std::vector<std::complex<double>>& workspace,
+        const ComputationMode mode,
+        const int threads
+    ) const {
+        if (input.size() != this->plan.getInputLength()) {
+            throw std::invalid_argument(
+                "Input vector size does not match the declared input length. Given: " +
+                std::to_string(input.size()) + ", Expected: " + std::to_string(this->plan.getInputLength())
+            );
+        }
+        output.resize(this->plan.getOutputCount());
+        if (mode == ComputationMode::SEQUENTIAL) {
+            this->plan.execute(input.data(), output.data(), workspace);
+        } else if (mode == ComputationMode::OPENMP) {
+            // save the number of threads before calling the OpenMP function
+            const int numThreads = omp_get_max_threads();
+            if (threads > 0) {
+                omp_set_num_threads(threads);
+            }
+            this->plan.executeOpenMP(input.data(), output.data(), workspace);
+            // restore the number of threads to the original value
+            omp_set_num_threads(numThreads);
+        } else {
+            throw std::invalid_argument("Invalid mode specified.");
+        }
+    }
+}
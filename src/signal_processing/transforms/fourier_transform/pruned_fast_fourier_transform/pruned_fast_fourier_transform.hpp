@@ -0,0 +1,106 @@
+#ifndef PRUNED_FAST_FOURIER_TRANSFORM_HPP
+#define PRUNED_FAST_FOURIER_TRANSFORM_HPP
+
+#include <complex>
+#include <vector>
+#include <omp.h>
+
+#include "transforms/fourier_transform/base_fourier_transform.hpp"
+#include "transforms/fourier_transform/algorithms/cooley_tukey/cooley_tukey_pruned_fft.hpp"
+
+namespace sp::fft::solver {
+    /**
+     * Pruned Fast Fourier Transform (FFT) class (1D).
+     *
+     * It computes a range of bins of the FFT of length N of a zero-padded signal:
+     * the caller declares the number of non-zero input samples and the wanted output range,
+     * and the work scales with them instead of with N (see algo::cooley_tukey::PrunedPlan).
+     *
+     * Typical uses:
+     *  - a short signal zero-padded to a large power of 2 (spectral interpolation);
+     *  - only the first K bins (or a band) of a large transform.
+     *
+     * The plan is computed once in the constructor, so the same solver can be reused for many signals.
+     *
+     * The solver can be used in two modes:
+     *  - SEQUENTIAL: For sequential execution.
+     *  - OPENMP: For parallel execution using OpenMP.
+     */
+    class PrunedFastFourierTransform {
+    public:
+        /**
+         * Create a Pruned Fast Fourier Transform solver.
+         *
+         * @param fftSize The length N of the zero-padded transform, a power of 2.
+         * @param inputLength The number of non-zero input samples (the input is implicitly zero-padded to N).
+         * @param outputOffset The index of the first wanted output bin.
+         * @param outputCount The number of wanted output bins.
+         * @throws std::invalid_argument if fftSize is not a power of 2, inputLength is not in [1, N]
+         *                               or the output range is empty or exceeds N.
+         */
+        PrunedFastFourierTransform(size_t fftSize, size_t inputLength, size_t outputOffset, size_t outputCount);
+
+        /**
+         * Create a Pruned Fast Fourier Transform solver that computes the first outputCount bins.
+         *
+         * @param fftSize The length N of the zero-padded transform, a power of 2.
+         * @param inputLength The number of non-zero input samples.
+         * @param outputCount The number of wanted output bins, starting from the bin 0.
+         */
+        PrunedFastFourierTransform(const size_t fftSize, const size_t inputLength, const size_t outputCount)
+            : PrunedFastFourierTransform(fftSize, inputLength, 0, outputCount) {}
+
+        /**
+         * Compute the wanted output bins.
+         *
+         * @param input The non-zero input samples; its size must be equal to the input length.
+         * @param output The output bins X[offset], ..., X[offset + count - 1] (resized to the output count).
+         * @param mode The mode of computation.
+         * @param threads The number of CPU threads to use for parallel computation (if applicable).
+         *                If not specified, the default number of threads will be used.
+         * @throws std::invalid_argument if the input size does not match the input length.
+         */
+        void compute(
+            const std::vector<std::complex<double>>& input,
+            std::vector<std::complex<double>>& output,
+            ComputationMode mode,
+            int threads = omp_get_max_threads()
+        ) const;
+
+        /**
+         * Compute the wanted output bins with a buffer of the caller for the sub-FFTs
+         * (no allocation when the same workspace is reused for many signals).
+         *
+         * @param input The non-zero input samples; its size must be equal to the input length.
+         * @param output The output bins X[offset], ..., X[offset + count - 1] (resized to the output count).
+         * @param workspace Buffer for the sub-FFTs (resized if needed, it can be reused among calls).
+         * @param mode The mode of computation.
+         * @param threads The number of CPU threads to use for parallel computation (if applicable).
+         *                If not specified, the default number of threads will be used.
+         * @throws std::invalid_argument if the input size does not match the input length.
+         */
+        void compute(
+            const std::vector<std::complex<double>>& input,
+            std::vector<std::complex<double>>& output,
+            std::vector<std::complex<double>>& workspace,
+            ComputationMode mode,
+            int threads = omp_get_max_threads()
+        ) const;
+
+        /**
+         * Get the underlying plan.
+         * @return The pruned FFT plan.
+         */
+        [[nodiscard]] const algo::cooley_tukey::PrunedPlan& getPlan() const {
+            return plan;
+        }
+
+    private:
+        /**
+         * The pruned FFT plan.
+         */
+        algo::cooley_tukey::PrunedPlan plan;
+    };
+}
+
+#endif //PRUNED_FAST_FOURIER_TRANSFORM_HPP
@@ -0,0 +1,319 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include "transforms/fourier_transform/sparse_fourier_transform/sparse_fourier_transform.hpp"
+#include "transforms/fourier_transform/algorithms/cooley_tukey/cooley_tukey_fft.hpp"
+
+namespace sp::fft::sparse {
+    /**
+     * Smallest power of 2 greater than or equal to value (value > 0).
+     */
+    static size_t nextPowerOfTwo(const size_t value) {
+        size_t power = 1;
+        while (power < value) {
+            power <<= 1;
+        }
+        return power;
+    }
+
+    /**
+     * Number of buckets: a power of 2, at most N (validated before the plan is built).
+     */
+    static size_t bucketCount(const size_t size, const size_t k, const SparseOptions& options) {
+        if (size == 0 || (size & (size - 1)) != 0) {
+            throw std::invalid_argument(
+                "The signal size must be a positive power of 2. Given: " + std::to_string(size)
+            );
+        }
+        if (k == 0 || k > size) {
+            throw std::invalid_argument(
+                "The sparsity k must be in [1, " + std::to_string(size) + "]. Given: " + std::to_string(k)
+            );
+        }
+        if (options.iterations == 0) {
+            throw std::invalid_argument("At least one iteration is needed.");
+        }
+        const size_t wanted = nextPowerOfTwo(std::max<size_t>(k * std::max<size_t>(options.bucketsPerCoefficient, 1), 2));
+        return std::min(wanted, size);
+    }
+
+    /**
+     * Inverse of an odd number modulo 2^64 (Newton iteration, each step doubles the correct bits).
+     */
+    static uint64_t inverseOdd(const uint64_t value) {
+        uint64_t inverse = value;
+        for (int i = 0; i < 6; ++i) {
+            inverse *= 2 - value * inverse;
+        }
+        return inverse;
+    }
+
+    /**
+     * Median of a vector (it is reordered).
+     */
+    static double median(std::vector<double>& values) {
+        const size_t middle = values.size() / 2;
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(middle), values.end());
+        return values[middle];
+    }
+
+    /**
+     * Half-width of the window, in buckets: the window spans 2 * WINDOW_HALF_WIDTH * B samples.
+     * The Gaussian taper has standard deviation 2B, so at the edges it is below 1e-7.
+     */
+    constexpr size_t WINDOW_HALF_WIDTH = 12;
+
+    /**
+     * Buckets whose window response (relative to the center) is below this value are not decoded:
+     * the coefficient is near the edge and it is decoded, with a better gain, in the neighbouring bucket.
+     */
+    constexpr double MIN_WINDOW_GAIN = 0.25;
+
+    SparseFourierTransform::SparseFourierTransform(
+        const size_t size,
+        const size_t k,
+        const SparseOptions& options
+    ) : size(size), k(k), options(options), numBuckets(bucketCount(size, k, options)), numShifts(1),
+        plan(numBuckets), engine(options.seed), fallback(false) {
+        const size_t B = this->numBuckets;
+        // log2(N / B) + 1 shifts give the low bits of a frequency modulo 2N / B
+        for (size_t stride = size / B; stride > 1; stride >>= 1) {
+            ++this->numShifts;
+        }
+
+        // flat window: sinc (box of N / B bins in frequency) tapered by a Gaussian
+        const size_t halfWidth = WINDOW_HALF_WIDTH * B;
+        const double deviation = 2.0 * static_cast<double>(B);
+        this->window.resize(2 * halfWidth);
+        double gain = 0.0;
+        for (size_t i = 0; i < this->window.size(); ++i) {
+            const double n = static_cast<double>(i) - static_cast<double>(halfWidth);
+            const double x = n / static_cast<double>(B);
+            const double sinc = n == 0.0 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+            this->window[i] = sinc * std::exp(-n * n / (2 * deviation * deviation));
+            gain += this->window[i];
+        }
+        for (double& value : this->window) {
+            value /= gain;
+        }
+    }
+
+    std::vector<Coefficient> SparseFourierTransform::compute(const std::vector<std::complex<double>>& input) {
+        if (input.size() != this->size) {
+            throw std::invalid_argument(
+                "Input vector size does not match the expected size. Given: " +
+                std::to_string(input.size()) + ", Expected: " + std::to_string(this->size)
+            );
+        }
+        // the hashing pays off only if the window is shorter than the signal
+        if (2 * this->window.size() > this->size) {
+            return this->computeFull(input);
+        }
+
+        // 1. locate the candidates with independent random permutations
+        std::vector<Coefficient> found;
+        for (size_t iteration = 0; iteration < this->options.iterations; ++iteration) {
+            this->hashAndLocate(input, found);
+        }
+
+        // 2. voting: keep the frequencies located by the majority of the permutations
+        std::sort(found.begin(), found.end(), [](const Coefficient& a, const Coefficient& b) {
+            return a.frequency < b.frequency;
+        });
+        std::vector<Coefficient> result;
+        std::vector<double> realParts, imagParts;
+        for (size_t first = 0; first < found.size();) {
+            size_t last = first;
+            while (last < found.size() && found[last].frequency == found[first].frequency) {
+                ++last;
+            }
+            if (2 * (last - first) > this->options.iterations) {
+                realParts.clear();
+                imagParts.clear();
+                for (size_t i = first; i < last; ++i) {
+                    realParts.push_back(found[i].value.real());
+                    imagParts.push_back(found[i].value.imag());
+                }
+                result.push_back({found[first].frequency, {median(realParts), median(imagParts)}});
+            }
+            first = last;
+        }
+        std::sort(result.begin(), result.end(), [](const Coefficient& a, const Coefficient& b) {
+            return std::norm(a.value) > std::norm(b.value);
+        });
+        if (result.size() > this->k) {
+            result.resize(this->k);
+        }
+
+        // 3. verification: fall back to the full transform if the signal is not k-sparse
+        if (result.empty() || this->residualRatio(input, result) > this->options.maxResidualRatio) {
+            return this->computeFull(input);
+        }
+        this->fallback = false;
+        return result;
+    }
+
+    void SparseFourierTransform::hashAndLocate(
+        const std::vector<std::complex<double>>& input,
+        std::vector<Coefficient>& found
+    ) {
+        const size_t N = this->size;
+        const size_t B = this->numBuckets;
+        const size_t L = N / B;
+        const size_t mask = N - 1;
+        const size_t rows = this->numShifts + 1;
+        const size_t W = this->window.size();
+        const size_t halfWidth = W / 2;
+
+        // random spectral permutation: y[n] = x[sigma * n] has Y[sigma * f] = X[f] (sigma odd)
+        std::uniform_int_distribution<size_t> distribution(0, N / 2 - 1);
+        const size_t sigma = 2 * distribution(this->engine) + 1;
+        const size_t sigmaInverse = static_cast<size_t>(inverseOdd(sigma)) & mask;
+
+        // folded windowed signals z_a[i] = sum_{n = i mod B} g[n] * y[n + a], with a = 0 and a = N / 2^s
+        std::vector<std::complex<double>> buckets(rows * B, std::complex<double>(0.0, 0.0));
+        for (size_t row = 0; row < rows; ++row) {
+            const size_t shift = row == 0 ? 0 : N >> row;
+            std::complex<double>* z = &buckets[row * B];
+            // time n = i - W / 2; W / 2 is a multiple of B, so n mod B = i mod B
+            const size_t start = (N - halfWidth + shift) & mask;
+            for (size_t i = 0; i < W; ++i) {
+                const size_t time = (start + i) & mask;
+                z[i & (B - 1)] += this->window[i] * input[(sigma * time) & mask];
+            }
+        }
+        // Z_a[b] = (1 / N) * sum_f' Y[f'] * e^(2 * pi * i * f' * a / N) * G(f' - b * N / B)
+        this->plan.forward(buckets.data(), rows);
+
+        // the largest buckets (2k, to also catch the leakage of off-bin tones)
+        const size_t candidates = std::min(B, 2 * this->k);
+        std::vector<size_t> order(B);
+        std::iota(order.begin(), order.end(), 0);
+        std::partial_sort(
+            order.begin(), order.begin() + static_cast<std::ptrdiff_t>(candidates), order.end(),
+            [&buckets](const size_t a, const size_t b) {
+                return std::norm(buckets[a]) > std::norm(buckets[b]);
+            }
+        );
+
+        std::vector<Coefficient> located;
+        std::vector<double> gains;
+        for (size_t c = 0; c < candidates; ++c) {
+            const size_t b = order[c];
+            const std::complex<double> reference = buckets[b];
+            if (std::norm(reference) == 0.0) {
+                continue;
+            }
+            // low bits: the shift N / 2^s decides the bit s - 1 of f'
+            size_t low = 0;
+            for (size_t s = 1; s <= this->numShifts; ++s) {
+                const std::complex<double> ratio = buckets[s * B + b] * std::conj(reference);
+                const size_t step = static_cast<size_t>(1) << (s - 1);
+                const double scale = 2 * M_PI / static_cast<double>(static_cast<size_t>(1) << s);
+                // the two hypotheses (low and low + 2^(s-1)) have expected phases pi radians apart
+                const double match0 = (ratio * std::polar(1.0, -scale * static_cast<double>(low))).real();
+                const double match1 = (ratio * std::polar(1.0, -scale * static_cast<double>(low + step))).real();
+                if (match1 > match0) {
+                    low += step;
+                }
+            }
+            // high bits: f' is the value with those low bits (modulo 2L) in [b * L - L, b * L + L)
+            const size_t first = (b * L + N - L) & mask;
+            const size_t permuted = (first + ((low - first) & (2 * L - 1))) & mask;
+            const auto offset = static_cast<long long>((permuted - first) & mask) - static_cast<long long>(L);
+
+            const std::complex<double> gain = this->windowResponse(offset);
+            if (std::abs(gain) < MIN_WINDOW_GAIN) {
+                continue;
+            }
+            // average the estimates of all the shifts, rotated back by e^(-2 * pi * i * f' * a / N)
+            std::complex<double> value = reference;
+            for (size_t s = 1; s <= this->numShifts; ++s) {
+                const size_t phase = (permuted * (N >> s)) & mask;
+                value += buckets[s * B + b] *
+                    std::polar(1.0, -2 * M_PI * static_cast<double>(phase) / static_cast<double>(N));
+            }
+            value *= static_cast<double>(N) / static_cast<double>(rows) / gain;
+            located.push_back({(permuted * sigmaInverse) & mask, value});
+            gains.push_back(std::abs(gain));
+        }
+
+        // a coefficient near the edge of two buckets is located twice: keep the one with the larger gain
+        for (size_t i = 0; i < located.size(); ++i) {
+            bool duplicate = false;
+            for (size_t j = 0; j < located.size(); ++j) {
+                if (j != i && located[j].frequency == located[i].frequency &&
+                    (gains[j] > gains[i] || (gains[j] == gains[i] && j < i))) {
+                    duplicate = true;
+                    break;
+                }
+            }
+            if (!duplicate) {
+                found.push_back(located[i]);
+            }
+        }
+    }
+
+    std::complex<double> SparseFourierTransform::windowResponse(const long long offset) const {
+        // G(d) = sum_n g[n] * e^(2 * pi * i * d * n / N), with n = i - W / 2
+        const auto halfWidth = static_cast<long long>(this->window.size() / 2);
+        const auto N = static_cast<long long>(this->size);
+        std::complex<double> response(0.0, 0.0);
+        for (size_t i = 0; i < this->window.size(); ++i) {
+            const long long n = static_cast<long long>(i) - halfWidth;
+            // reduce d * n modulo N (N is a power of 2) to keep the angle accurate
+            const long long reduced = ((offset * n) % N + N) % N;
+            response += this->window[i] *
+                std::polar(1.0, 2 * M_PI * static_cast<double>(reduced) / static_cast<double>(N));
+        }
+        return response;
+    }
+
+    double SparseFourierTransform::residualRatio(
+        const std::vector<std::complex<double>>& input,
+        const std::vector<Coefficient>& coefficients
+    ) {
+        const size_t N = this->size;
+        const size_t samples = std::max<size_t>(64, 8 * this->k);
+        std::uniform_int_distribution<size_t> distribution(0, N - 1);
+        double signalEnergy = 0.0;
+        double residualEnergy = 0.0;
+        for (size_t i = 0; i < samples; ++i) {
+            const size_t n = distribution(this->engine);
+            // inverse DFT of the sparse spectrum at the sample n
+            std::complex<double> estimate(0.0, 0.0);
+            for (const Coefficient& c : coefficients) {
+                const size_t index = (c.frequency * n) & (N - 1);
+                estimate += c.value * std::polar(1.0, 2 * M_PI * static_cast<double>(index) / static_cast<double>(N));
+            }
+            estimate /= static_cast<double>(N);
+            signalEnergy += std::norm(input[n]);
+            residualEnergy += std::norm(input[n] - estimate);
+        }
+        return signalEnergy > 0.0 ? residualEnergy / signalEnergy : 0.0;
+    }
+
+    std::vector<Coefficient> SparseFourierTransform::computeFull(const std::vector<std::complex<double>>& input) {
+        this->fallback = true;
+        std::vector<std::complex<double>> spectrum = input;
+        fft::algo::cooley_tukey::computeFFT(spectrum);
+
+        std::vector<size_t> order(spectrum.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::partial_sort(
+            order.begin(), order.begin() + static_cast<std::ptrdiff_t>(this->k), order.end(),
+            [&spectrum](const size_t a, const size_t b) {
+                return std::norm(spectrum[a]) > std::norm(spectrum[b]);
+            }
+        );
+        std::vector<Coefficient> result(this->k);
+        for (size_t i = 0; i < this->k; ++i) {
+            result[i] = {order[i], spectrum[order[i]]};
+        }
+        return result;
+    }
+}
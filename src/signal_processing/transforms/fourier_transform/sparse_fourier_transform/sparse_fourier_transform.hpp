@@ -0,0 +1,211 @@
+#ifndef SPARSE_FOURIER_TRANSFORM_HPP
+#define SPARSE_FOURIER_TRANSFORM_HPP
+
+#include <complex>
+#include <random>
+#include <vector>
+
+#include "transforms/fourier_transform/algorithms/cooley_tukey/cooley_tukey_batch.hpp"
+
+/**
+ * Sparse Fast Fourier Transform module.
+ *
+ * Engines that recover only the few dominant coefficients of a spectrum,
+ * reading a sub-linear number of input samples.
+ */
+namespace sp::fft::sparse {
+    /**
+     * A non-zero coefficient of a sparse spectrum.
+     */
+    struct Coefficient {
+        /**
+         * The frequency bin, in [0, N).
+         */
+        size_t frequency;
+        /**
+         * The DFT value X[frequency] (same scaling as computeFFT).
+         */
+        std::complex<double> value;
+    };
+
+    /**
+     * Tuning parameters of the sparse FFT.
+     */
+    struct SparseOptions {
+        /**
+         * Number of hash buckets per wanted coefficient (rounded up to a power of 2).
+         * More buckets mean fewer collisions and more robustness to noise, but more samples read.
+         */
+        size_t bucketsPerCoefficient = 16;
+        /**
+         * Number of independent random spectral permutations (hashings);
+         * a frequency is accepted if it is located by the majority of them.
+         */
+        size_t iterations = 5;
+        /**
+         * If the k recovered coefficients leave more than this fraction of the signal energy
+         * (estimated on random samples), the sparsity assumption is considered failed
+         * and the full FFT is computed instead.
+         */
+        double maxResidualRatio = 0.5;
+        /**
+         * Seed of the random permutations (the result is deterministic for a given seed).
+         */
+        unsigned int seed = 42;
+    };
+
+    /**
+     * Sparse Fast Fourier Transform engine (sFFT-style, hashing based).
+     *
+     * It estimates the k largest coefficients of the N-point DFT of a signal with
+     * a few dominant frequencies (e.g. a sum of tones plus noise) in sub-linear time:
+     *
+     *  1. Hashing: the spectrum is randomly permuted (y[n] = x[sigma * n], sigma odd, so Y[sigma * f] = X[f]),
+     *     multiplied by a flat window (a Gaussian-tapered sinc of W = O(B) samples) and folded
+     *     in B samples; the B-point FFT of the folded signal puts each permuted coefficient
+     *     in the bucket of its high bits (f' ~ b * N / B), scaled by the window response.
+     *  2. Location: the window shifted by a = N / 2^s multiplies the bucket by e^(2 * pi * i * f' * a / N),
+     *     so each shift reveals one more low bit of f' (the two candidates are always pi radians apart,
+     *     so the decision is robust to noise); the bucket gives the high bits.
+     *  3. Estimation: the bucket values of all the shifts, rotated back and divided by the window response,
+     *     are averaged.
+     *  4. Voting: steps 1-3 are repeated with different permutations; frequencies found by
+     *     the majority of them are kept (collisions and noise buckets do not repeat),
+     *     and their value is the median of the estimates.
+     *
+     * The work is O(iterations * B * log(N)) with B ~ bucketsPerCoefficient * k, i.e.
+     * it reads only O(k * log(N)) samples per iteration.
+     *
+     * Fallback: the result is checked on random samples of the signal; if the residual energy
+     * is too high (the signal is not k-sparse), or N is too small for the hashing to pay off,
+     * the full FFT is computed and its k largest coefficients are returned.
+     */
+    class SparseFourierTransform {
+    public:
+        /**
+         * Create a sparse FFT engine.
+         *
+         * @param size The length N of the signals, a power of 2.
+         * @param k The number of dominant coefficients to recover (sparsity).
+         * @param options The tuning parameters.
+         * @throws std::invalid_argument if size is not a power of 2 or k is 0 or greater than size.
+         */
+        SparseFourierTransform(size_t size, size_t k, const SparseOptions& options = SparseOptions());
+
+        /**
+         * Compute the k largest coefficients of the DFT of the input.
+         *
+         * @param input The input signal of N complex samples.
+         * @return At most k coefficients, sorted by decreasing magnitude.
+         * @throws std::invalid_argument if the input size is not equal to N.
+         */
+        std::vector<Coefficient> compute(const std::vector<std::complex<double>>& input);
+
+        /**
+         * Check whether the last compute call fell back to the full FFT.
+         * @return True if the full transform was used.
+         */
+        [[nodiscard]] bool usedFallback() const {
+            return fallback;
+        }
+
+        /**
+         * Get the length of the signals.
+         * @return The length N.
+         */
+        [[nodiscard]] size_t getSize() const {
+            return size;
+        }
+
+        /**
+         * Get the number of coefficients to recover.
+         * @return The sparsity k.
+         */
+        [[nodiscard]] size_t getK() const {
+            return k;
+        }
+
+        /**
+         * Get the number of hash buckets.
+         * @return The number of buckets B.
+         */
+        [[nodiscard]] size_t getNumBuckets() const {
+            return numBuckets;
+        }
+
+    private:
+        /**
+         * The signal length N.
+         */
+        size_t size;
+        /**
+         * The sparsity k.
+         */
+        size_t k;
+        /**
+         * The tuning parameters.
+         */
+        SparseOptions options;
+        /**
+         * The number of buckets B (power of 2).
+         */
+        size_t numBuckets;
+        /**
+         * The number of shifts needed to locate a frequency (log2(N / B) + 1).
+         */
+        size_t numShifts;
+        /**
+         * The flat window, W samples centered in 0 (index i is the time i - W / 2), normalized to unit gain at DC.
+         */
+        std::vector<double> window;
+        /**
+         * The plan of the B-point FFTs (one per shift).
+         */
+        fft::algo::cooley_tukey::BatchPlan plan;
+        /**
+         * Random generator of the permutations and of the verification samples.
+         */
+        std::mt19937 engine;
+        /**
+         * True if the last compute call used the full FFT.
+         */
+        bool fallback;
+
+        /**
+         * Locate and estimate the dominant coefficients with a random spectral permutation.
+         *
+         * @param input The input signal.
+         * @param found The located coefficients are appended here.
+         */
+        void hashAndLocate(const std::vector<std::complex<double>>& input, std::vector<Coefficient>& found);
+
+        /**
+         * Frequency response of the window.
+         *
+         * @param offset The distance (in bins) from the center of the bucket.
+         * @return The gain of the window at that distance.
+         */
+        [[nodiscard]] std::complex<double> windowResponse(long long offset) const;
+
+        /**
+         * Estimate the fraction of the signal energy not explained by the coefficients.
+         *
+         * @param input The input signal.
+         * @param coefficients The recovered coefficients.
+         * @return The residual energy ratio, in [0, +inf).
+         */
+        double residualRatio(
+            const std::vector<std::complex<double>>& input, const std::vector<Coefficient>& coefficients
+        );
+
+        /**
+         * Compute the full FFT and keep its k largest coefficients.
+         *
+         * @param input The input signal.
+         * @return The k largest coefficients, sorted by decreasing magnitude.
+         */
+        std::vector<Coefficient> computeFull(const std::vector<std::complex<double>>& input);
+    };
+}
+
+#endif //SPARSE_FOURIER_TRANSFORM_HPP
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "transforms/short_time_fourier_transform/inverse_short_time_fourier_transform.hpp"
+
+namespace sp::stft {
+    constexpr size_t InverseShortTimeFourierTransform::BATCH_ROWS;
+
+    /**
+     * Overlaps whose squared-window sum is below this value are considered vanished.
+     */
+    constexpr double MIN_OVERLAP_NORM = 1e-10;
+
+    InverseShortTimeFourierTransform::InverseShortTimeFourierTransform(
+        const size_t frameSize,
+        const size_t hopSize,
+        const WindowType window
+    ) : InverseShortTimeFourierTransform(frameSize, hopSize, makeWindow(window, frameSize)) {}
+
+    InverseShortTimeFourierTransform::InverseShortTimeFourierTransform(
+        const size_t frameSize,
+        const size_t hopSize,
+        const std::vector<double>& window
+    ) : frameSize(frameSize), hopSize(hopSize), window(window), plan(frameSize),
+        overlap(frameSize, 0.0), batch(BATCH_ROWS * frameSize, std::complex<double>(0.0, 0.0)),
+        framesPushed(0), samplesEmitted(0) {
+        if (hopSize == 0 || hopSize > frameSize) {
+            throw std::invalid_argument(
+                "The hop size must be in [1, " + std::to_string(frameSize) + "]. Given: " + std::to_string(hopSize)
+            );
+        }
+        if (window.size() != frameSize) {
+            throw std::invalid_argument(
+                "The window size (" + std::to_string(window.size()) +
+                ") must be equal to the frame size (" + std::to_string(frameSize) + ")."
+            );
+        }
+        // steady-state normalization: every output sample is covered by the frames at positions n + k * hop
+        this->normalization.assign(hopSize, 0.0);
+        for (size_t n = 0; n < hopSize; ++n) {
+            double sum = 0.0;
+            for (size_t pos = n; pos < frameSize; pos += hopSize) {
+                sum += this->window[pos] * this->window[pos];
+            }
+            if (sum < MIN_OVERLAP_NORM) {
+                throw std::invalid_argument(
+                    "The window overlaps vanish with hop size " + std::to_string(hopSize) +
+                    ": the signal cannot be reconstructed."
+                );
+            }
+            this->normalization[n] = 1.0 / sum;
+        }
+    }
+
+    size_t InverseShortTimeFourierTransform::push(
+        const std::complex<double>* frames,
+        const size_t frameCount,
+        std::vector<double>& samples
+    ) {
+        const size_t N = this->frameSize;
+        const size_t numBins = this->getNumBins();
+        const size_t samplesBefore = samples.size();
+
+        for (size_t first = 0; first < frameCount; first += 2 * BATCH_ROWS) {
+            const size_t count = std::min(2 * BATCH_ROWS, frameCount - first);
+            const size_t rows = (count + 1) / 2;
+
+            /**
+             * Pack two one-sided spectra in a full complex spectrum Z = X1 + i * X2,
+             * where the negative frequencies are X[N - k] = conj(X[k]);
+             * the inverse FFT of Z is x1 + i * x2.
+             * DC and Nyquist bins of a real signal are real, so only their real part is used.
+             */
+            for (size_t r = 0; r < rows; ++r) {
+                const std::complex<double>* X1 = frames + (first + 2 * r) * numBins;
+                const std::complex<double>* X2 = 2 * r + 1 < count ? X1 + numBins : nullptr;
+                std::complex<double>* Z = &this->batch[r * N];
+                for (size_t k = 0; k < numBins; ++k) {
+                    std::complex<double> x1 = X1[k];
+                    std::complex<double> x2 = X2 != nullptr ? X2[k] : std::complex<double>(0.0, 0.0);
+                    if (k == 0 || k == N / 2) {
+                        x1 = x1.real();
+                        x2 = x2.real();
+                    }
+                    const std::complex<double> ix2(-x2.imag(), x2.real());
+                    Z[k] = x1 + ix2;
+                    if (k != 0 && k != N / 2) {
+                        const std::complex<double> ix2c(x2.imag(), x2.real());
+                        Z[N - k] = std::conj(x1) + ix2c;
+                    }
+                }
+            }
+            this->plan.inverse(this->batch.data(), rows);
+
+            for (size_t f = 0; f < count; ++f) {
+                this->overlapAdd(&this->batch[(f / 2) * N], f % 2 == 1, samples);
+            }
+        }
+        return samples.size() - samplesBefore;
+    }
+
+    size_t InverseShortTimeFourierTransform::push(
+        const std::vector<std::complex<double>>& frames,
+        std::vector<double>& samples
+    ) {
+        if (frames.size() % this->getNumBins() != 0) {
+            throw std::invalid_argument(
+                "The frames size (" + std::to_string(frames.size()) +
+                ") is not a multiple of the number of bins (" + std::to_string(this->getNumBins()) + ")."
+            );
+        }
+        return this->push(frames.data(), frames.size() / this->getNumBins(), samples);
+    }
+
+    size_t InverseShortTimeFourierTransform::flush(std::vector<double>& samples) {
+        const size_t tail = this->frameSize - this->hopSize;
+        if (this->framesPushed > 0) {
+            for (size_t n = 0; n < tail; ++n) {
+                const double norm = this->partialNorm(this->samplesEmitted + n);
+                samples.push_back(norm < MIN_OVERLAP_NORM ? 0.0 : this->overlap[n] / norm);
+            }
+        }
+        const size_t emitted = this->framesPushed > 0 ? tail : 0;
+        this->reset();
+        return emitted;
+    }
+
+    void InverseShortTimeFourierTransform::reset() {
+        std::fill(this->overlap.begin(), this->overlap.end(), 0.0);
+        this->framesPushed = 0;
+        this->samplesEmitted = 0;
+    }
+
+    void InverseShortTimeFourierTransform::overlapAdd(
+        const std::complex<double>* frame,
+        const bool imaginary,
+        std::vector<double>& samples
+    ) {
+        const size_t N = this->frameSize;
+        const size_t hop = this->hopSize;
+        for (size_t n = 0; n < N; ++n) {
+            const double value = imaginary ? frame[n].imag() : frame[n].real();
+            this->overlap[n] += this->window[n] * value;
+        }
+        ++this->framesPushed;
+
+        // the first hop samples are complete: no future frame overlaps them
+        for (size_t n = 0; n < hop; ++n) {
+            const size_t t = this->samplesEmitted + n;
+            if (t >= N) {
+                samples.push_back(this->overlap[n] * this->normalization[n]);
+            } else {
+                // start of the stream: the frames before the first one are missing
+                const double norm = this->partialNorm(t);
+                samples.push_back(norm < MIN_OVERLAP_NORM ? 0.0 : this->overlap[n] / norm);
+            }
+        }
+        this->samplesEmitted += hop;
+
+        std::copy(this->overlap.begin() + static_cast<std::ptrdiff_t>(hop), this->overlap.end(),
+                  this->overlap.begin());
+        std::fill(this->overlap.end() - static_cast<std::ptrdiff_t>(hop), this->overlap.end(), 0.0);
+    }
+
+    double InverseShortTimeFourierTransform::partialNorm(const size_t t) const {
+        // sum of the squared window over the frames pushed so far that cover the output sample t
+        double sum = 0.0;
+        for (size_t f = this->framesPushed; f-- > 0;) {
+            const size_t start = f * this->hopSize;
+            if (start > t) {
+                continue;
+            }
+            const size_t pos = t - start;
+            if (pos >= this->frameSize) {
+                break;
+            }
+            sum += this->window[pos] * this->window[pos];
+        }
+        return sum;
+    }
+}
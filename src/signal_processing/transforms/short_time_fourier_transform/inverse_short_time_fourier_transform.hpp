@@ -0,0 +1,155 @@
+#ifndef INVERSE_SHORT_TIME_FOURIER_TRANSFORM_HPP
+#define INVERSE_SHORT_TIME_FOURIER_TRANSFORM_HPP
+
+#include <complex>
+#include <vector>
+
+#include "transforms/fourier_transform/algorithms/cooley_tukey/cooley_tukey_batch.hpp"
+#include "transforms/short_time_fourier_transform/window_functions.hpp"
+
+namespace sp::stft {
+    /**
+     * Streaming Inverse Short-Time Fourier Transform (ISTFT) with weighted overlap-add.
+     *
+     * Each pushed frame (frameSize / 2 + 1 bins, as emitted by ShortTimeFourierTransform)
+     * is transformed back to the time domain, multiplied by the synthesis window and added
+     * to the overlap buffer; then hopSize samples are complete and emitted.
+     *
+     * The output is normalized by the sum of the squared (analysis * synthesis) window overlaps,
+     * so STFT followed by ISTFT with the same window and hop reconstructs the signal.
+     * At the start and at the end of the stream (see flush) the overlap is incomplete and
+     * the partial sums are used, so only the samples where the window vanishes are lost.
+     *
+     * As in the forward transform, two frames are packed in a single complex inverse FFT.
+     */
+    class InverseShortTimeFourierTransform {
+    public:
+        /**
+         * Create an ISTFT with one of the predefined windows.
+         *
+         * @param frameSize The number of samples of each frame (FFT length, power of 2).
+         * @param hopSize The number of samples between the start of two consecutive frames (1 <= hop <= frame).
+         * @param window The window function used for analysis and synthesis.
+         * @throws std::invalid_argument if frameSize is not a power of 2 or hopSize is out of range.
+         * @throws std::invalid_argument if the window overlaps vanish somewhere (the signal cannot be recovered).
+         */
+        InverseShortTimeFourierTransform(size_t frameSize, size_t hopSize, WindowType window = WindowType::HANN);
+
+        /**
+         * Create an ISTFT with a user-defined window.
+         *
+         * @param frameSize The number of samples of each frame (FFT length, power of 2).
+         * @param hopSize The number of samples between the start of two consecutive frames (1 <= hop <= frame).
+         * @param window The window samples; its size must be equal to frameSize.
+         * @throws std::invalid_argument if the arguments are not valid (see the other constructor).
+         */
+        InverseShortTimeFourierTransform(size_t frameSize, size_t hopSize, const std::vector<double>& window);
+
+        /**
+         * Push spectrum frames and append the completed output samples.
+         *
+         * Each frame pushed completes hopSize output samples.
+         *
+         * @param frames Pointer to frameCount * getNumBins() complex numbers (row-major).
+         * @param frameCount The number of frames.
+         * @param samples The vector where the completed samples are appended.
+         * @return The number of samples appended.
+         */
+        size_t push(const std::complex<double>* frames, size_t frameCount, std::vector<double>& samples);
+
+        /**
+         * Push spectrum frames and append the completed output samples.
+         *
+         * @param frames The frames (row-major), its size must be a multiple of getNumBins().
+         * @param samples The vector where the completed samples are appended.
+         * @return The number of samples appended.
+         * @throws std::invalid_argument if the size of frames is not a multiple of getNumBins().
+         */
+        size_t push(const std::vector<std::complex<double>>& frames, std::vector<double>& samples);
+
+        /**
+         * Append the samples still in the overlap buffer (the tail of the last frame)
+         * and clear the state.
+         *
+         * @param samples The vector where the remaining frameSize - hopSize samples are appended.
+         * @return The number of samples appended.
+         */
+        size_t flush(std::vector<double>& samples);
+
+        /**
+         * Clear the overlap buffer, as if no frame had been pushed.
+         */
+        void reset();
+
+        /**
+         * Get the number of bins expected for each frame (frameSize / 2 + 1).
+         * @return The number of bins per frame.
+         */
+        [[nodiscard]] size_t getNumBins() const {
+            return frameSize / 2 + 1;
+        }
+
+    private:
+        /**
+         * Number of packed complex inverse FFTs in a batch (each one carries two frames).
+         */
+        static constexpr size_t BATCH_ROWS = 8;
+
+        /**
+         * The frame size (N).
+         */
+        size_t frameSize;
+        /**
+         * The hop size.
+         */
+        size_t hopSize;
+        /**
+         * The synthesis window (same as the analysis window).
+         */
+        std::vector<double> window;
+        /**
+         * Inverse of the sum of the squared window overlaps, for each position modulo the hop size.
+         */
+        std::vector<double> normalization;
+        /**
+         * The plan shared by all the inverse FFTs.
+         */
+        fft::algo::cooley_tukey::BatchPlan plan;
+        /**
+         * Overlap-add accumulator (frameSize samples).
+         */
+        std::vector<double> overlap;
+        /**
+         * Packed spectra waiting for the inverse FFT (BATCH_ROWS x frameSize).
+         */
+        std::vector<std::complex<double>> batch;
+        /**
+         * Number of frames pushed since the last reset.
+         */
+        size_t framesPushed;
+        /**
+         * Number of samples emitted since the last reset.
+         */
+        size_t samplesEmitted;
+
+        /**
+         * Overlap-add a windowed time-domain frame and emit the completed hopSize samples.
+         *
+         * @param frame Pointer to the packed time-domain row.
+         * @param imaginary True if the frame is stored in the imaginary part of the row.
+         * @param samples The vector where the completed samples are appended.
+         */
+        void overlapAdd(const std::complex<double>* frame, bool imaginary, std::vector<double>& samples);
+
+        /**
+         * Sum of the squared window over the frames pushed so far that cover an output sample.
+         * It is used where the overlap is incomplete (start and end of the stream).
+         *
+         * @param t The index of the output sample since the last reset.
+         * @return The sum of the squared window values that contributed to the sample.
+         */
+        [[nodiscard]] double partialNorm(size_t t) const;
+    };
+}
+
+#endif //INVERSE_SHORT_TIME_FOURIER_TRANSFORM_HPP
@@ -0,0 +1,54 @@
+#include <stdexcept>
+#include <string>
+
+#include "transforms/short_time_fourier_transform/multi_channel_short_time_fourier_transform.hpp"
+
+namespace sp::stft {
+    MultiChannelShortTimeFourierTransform::MultiChannelShortTimeFourierTransform(
+        const size_t channels,
+        const size_t frameSize,
+        const size_t hopSize,
+        const WindowType window
+    ) : MultiChannelShortTimeFourierTransform(channels, frameSize, hopSize, makeWindow(window, frameSize)) {}
+
+    MultiChannelShortTimeFourierTransform::MultiChannelShortTimeFourierTransform(
+        const size_t channels,
+        const size_t frameSize,
+        const size_t hopSize,
+        const std::vector<double>& window
+    ) {
+        if (channels == 0) {
+            throw std::invalid_argument("The number of channels must be greater than 0.");
+        }
+        this->channels.reserve(channels);
+        for (size_t c = 0; c < channels; ++c) {
+            this->channels.emplace_back(frameSize, hopSize, window);
+        }
+    }
+
+    void MultiChannelShortTimeFourierTransform::push(
+        const std::vector<std::vector<double>>& samples,
+        std::vector<std::vector<std::complex<double>>>& frames,
+        const int threads
+    ) {
+        const size_t numChannels = this->channels.size();
+        if (samples.size() != numChannels) {
+            throw std::invalid_argument(
+                "The number of sample vectors (" + std::to_string(samples.size()) +
+                ") does not match the number of channels (" + std::to_string(numChannels) + ")."
+            );
+        }
+        frames.resize(numChannels);
+        // each channel owns its history, batch and output vector: no synchronization is needed
+        #pragma omp parallel for num_threads(threads > 0 ? threads : 1) if(numChannels > 1 && threads > 1)
+        for (size_t c = 0; c < numChannels; ++c) {
+            this->channels[c].push(samples[c], frames[c]);
+        }
+    }
+
+    void MultiChannelShortTimeFourierTransform::reset() {
+        for (ShortTimeFourierTransform& channel : this->channels) {
+            channel.reset();
+        }
+    }
+}
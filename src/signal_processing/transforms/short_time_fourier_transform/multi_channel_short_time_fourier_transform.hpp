@@ -0,0 +1,90 @@
+#ifndef MULTI_CHANNEL_SHORT_TIME_FOURIER_TRANSFORM_HPP
+#define MULTI_CHANNEL_SHORT_TIME_FOURIER_TRANSFORM_HPP
+
+#include <complex>
+#include <vector>
+#include <omp.h>
+
+#include "transforms/short_time_fourier_transform/short_time_fourier_transform.hpp"
+
+namespace sp::stft {
+    /**
+     * Streaming Short-Time Fourier Transform of a multi-channel signal.
+     *
+     * Each channel has its own ShortTimeFourierTransform (same frame size, hop and window);
+     * the channels are independent, so they are processed in parallel using OpenMP.
+     */
+    class MultiChannelShortTimeFourierTransform {
+    public:
+        /**
+         * Create a multi-channel STFT with one of the predefined windows.
+         *
+         * @param channels The number of channels.
+         * @param frameSize The number of samples of each frame (FFT length, power of 2).
+         * @param hopSize The number of samples between the start of two consecutive frames.
+         * @param window The window function applied to each frame.
+         * @throws std::invalid_argument if channels is 0 or the STFT parameters are not valid.
+         */
+        MultiChannelShortTimeFourierTransform(
+            size_t channels, size_t frameSize, size_t hopSize, WindowType window = WindowType::HANN
+        );
+
+        /**
+         * Create a multi-channel STFT with a user-defined window.
+         *
+         * @param channels The number of channels.
+         * @param frameSize The number of samples of each frame (FFT length, power of 2).
+         * @param hopSize The number of samples between the start of two consecutive frames.
+         * @param window The window samples; its size must be equal to frameSize.
+         * @throws std::invalid_argument if channels is 0 or the STFT parameters are not valid.
+         */
+        MultiChannelShortTimeFourierTransform(
+            size_t channels, size_t frameSize, size_t hopSize, const std::vector<double>& window
+        );
+
+        /**
+         * Push new samples of every channel and append the completed frames of each channel.
+         *
+         * @param samples The new samples, one vector per channel.
+         * @param frames The output spectra, one vector per channel (resized to the number of channels if needed).
+         * @param threads The number of CPU threads to use. If not specified, the default number of threads is used.
+         * @throws std::invalid_argument if the number of sample vectors does not match the number of channels.
+         */
+        void push(
+            const std::vector<std::vector<double>>& samples,
+            std::vector<std::vector<std::complex<double>>>& frames,
+            int threads = omp_get_max_threads()
+        );
+
+        /**
+         * Discard the input history of every channel.
+         */
+        void reset();
+
+        /**
+         * Get the STFT of a channel.
+         *
+         * @param channel The channel index.
+         * @return The STFT of the channel.
+         */
+        ShortTimeFourierTransform& getChannel(size_t channel) {
+            return channels.at(channel);
+        }
+
+        /**
+         * Get the number of channels.
+         * @return The number of channels.
+         */
+        [[nodiscard]] size_t getNumChannels() const {
+            return channels.size();
+        }
+
+    private:
+        /**
+         * One STFT per channel.
+         */
+        std::vector<ShortTimeFourierTransform> channels;
+    };
+}
+
+#endif //MULTI_CHANNEL_SHORT_TIME_FOURIER_TRANSFORM_HPP
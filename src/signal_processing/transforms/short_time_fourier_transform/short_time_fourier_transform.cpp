@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "transforms/short_time_fourier_transform/short_time_fourier_transform.hpp"
+
+namespace sp::stft {
+    constexpr size_t ShortTimeFourierTransform::BATCH_ROWS;
+
+    ShortTimeFourierTransform::ShortTimeFourierTransform(
+        const size_t frameSize,
+        const size_t hopSize,
+        const WindowType window
+    ) : ShortTimeFourierTransform(frameSize, hopSize, makeWindow(window, frameSize)) {}
+
+    ShortTimeFourierTransform::ShortTimeFourierTransform(
+        const size_t frameSize,
+        const size_t hopSize,
+        const std::vector<double>& window
+    ) : frameSize(frameSize), hopSize(hopSize), window(window), plan(frameSize),
+        history(frameSize, 0.0), filled(0),
+        batch(BATCH_ROWS * frameSize, std::complex<double>(0.0, 0.0)), pendingFrames(0) {
+        if (hopSize == 0 || hopSize > frameSize) {
+            throw std::invalid_argument(
+                "The hop size must be in [1, " + std::to_string(frameSize) + "]. Given: " + std::to_string(hopSize)
+            );
+        }
+        if (window.size() != frameSize) {
+            throw std::invalid_argument(
+                "The window size (" + std::to_string(window.size()) +
+                ") must be equal to the frame size (" + std::to_string(frameSize) + ")."
+            );
+        }
+    }
+
+    size_t ShortTimeFourierTransform::push(
+        const double* samples,
+        size_t count,
+        std::vector<std::complex<double>>& frames
+    ) {
+        const size_t framesBefore = frames.size();
+        while (count > 0) {
+            // fill the history up to a complete frame
+            const size_t take = std::min(count, this->frameSize - this->filled);
+            std::copy(samples, samples + take, this->history.begin() + static_cast<std::ptrdiff_t>(this->filled));
+            this->filled += take;
+            samples += take;
+            count -= take;
+
+            if (this->filled == this->frameSize) {
+                this->gatherFrame();
+                if (this->pendingFrames == 2 * BATCH_ROWS) {
+                    this->flushBatch(frames);
+                }
+                // hop: keep the overlapping part of the frame
+                std::copy(
+                    this->history.begin() + static_cast<std::ptrdiff_t>(this->hopSize),
+                    this->history.end(),
+                    this->history.begin()
+                );
+                this->filled -= this->hopSize;
+            }
+        }
+        // do not hold completed frames back: the stream consumer expects them now
+        this->flushBatch(frames);
+        return (frames.size() - framesBefore) / this->getNumBins();
+    }
+
+    size_t ShortTimeFourierTransform::push(
+        const std::vector<double>& samples,
+        std::vector<std::complex<double>>& frames
+    ) {
+        return this->push(samples.data(), samples.size(), frames);
+    }
+
+    void ShortTimeFourierTransform::reset() {
+        std::fill(this->history.begin(), this->history.end(), 0.0);
+        this->filled = 0;
+        this->pendingFrames = 0;
+    }
+
+    void ShortTimeFourierTransform::gatherFrame() {
+        std::complex<double>* row = &this->batch[(this->pendingFrames / 2) * this->frameSize];
+        if (this->pendingFrames % 2 == 0) {
+            // even frame: real part (the imaginary part is cleared for a possible missing pair)
+            for (size_t n = 0; n < this->frameSize; ++n) {
+                row[n] = std::complex<double>(this->window[n] * this->history[n], 0.0);
+            }
+        } else {
+            // odd frame: imaginary part of the same row
+            for (size_t n = 0; n < this->frameSize; ++n) {
+                row[n].imag(this->window[n] * this->history[n]);
+            }
+        }
+        ++this->pendingFrames;
+    }
+
+    void ShortTimeFourierTransform::flushBatch(std::vector<std::complex<double>>& frames) {
+        if (this->pendingFrames == 0) {
+            return;
+        }
+        const size_t N = this->frameSize;
+        const size_t numBins = this->getNumBins();
+        const size_t rows = (this->pendingFrames + 1) / 2;
+        this->plan.forward(this->batch.data(), rows);
+
+        /**
+         * Separate the two real frames packed in z = x1 + i * x2:
+         *      X1[k] = (Z[k] + conj(Z[N - k])) / 2
+         *      X2[k] = (Z[k] - conj(Z[N - k])) / (2i)
+         */
+        for (size_t r = 0; r < rows; ++r) {
+            const std::complex<double>* Z = &this->batch[r * N];
+            const bool hasPair = 2 * r + 1 < this->pendingFrames;
+            for (size_t k = 0; k < numBins; ++k) {
+                const std::complex<double> zk = Z[k];
+                const std::complex<double> zNk = std::conj(Z[(N - k) % N]);
+                frames.push_back(0.5 * (zk + zNk));
+            }
+            if (hasPair) {
+                for (size_t k = 0; k < numBins; ++k) {
+                    const std::complex<double> zk = Z[k];
+                    const std::complex<double> zNk = std::conj(Z[(N - k) % N]);
+                    frames.push_back(std::complex<double>(0.0, -0.5) * (zk - zNk));
+                }
+            }
+        }
+        this->pendingFrames = 0;
+    }
+}
@@ -0,0 +1,170 @@
+#ifndef SHORT_TIME_FOURIER_TRANSFORM_HPP
+#define SHORT_TIME_FOURIER_TRANSFORM_HPP
+
+#include <complex>
+#include <vector>
+
+#include "transforms/fourier_transform/algorithms/cooley_tukey/cooley_tukey_batch.hpp"
+#include "transforms/short_time_fourier_transform/window_functions.hpp"
+
+/**
+ * Short-Time Fourier Transform module.
+ *
+ * This module provides streaming analysis (signal to spectrogram frames)
+ * and synthesis (spectrogram frames to signal, overlap-add) of real signals.
+ */
+namespace sp::stft {
+    /**
+     * Streaming Short-Time Fourier Transform (STFT) of a real signal.
+     *
+     * Samples are pushed incrementally (any number at a time); every hopSize samples a new frame
+     * of frameSize samples is complete and its spectrum is emitted.
+     *
+     * Implementation notes:
+     *  - the window is applied while the frame is gathered from the input history,
+     *    so there is no separate windowing pass over the frame;
+     *  - the frames are transformed in batches with the batched 1D FFT path (a shared BatchPlan);
+     *  - since the frames are real, two frames are packed in a single complex FFT
+     *    (one in the real part, one in the imaginary part) and separated afterwards
+     *    using the Hermitian symmetry, which halves the FFT work;
+     *  - only the non-redundant half of each spectrum is emitted: frameSize / 2 + 1 bins per frame.
+     *
+     * The internal buffers are allocated once; pushing samples allocates only if
+     * the output vector has to grow (reserve it to avoid that).
+     */
+    class ShortTimeFourierTransform {
+    public:
+        /**
+         * Create a STFT with one of the predefined windows.
+         *
+         * @param frameSize The number of samples of each frame (FFT length, power of 2).
+         * @param hopSize The number of samples between the start of two consecutive frames (1 <= hop <= frame).
+         * @param window The window function applied to each frame.
+         * @throws std::invalid_argument if frameSize is not a power of 2 or hopSize is out of range.
+         */
+        ShortTimeFourierTransform(size_t frameSize, size_t hopSize, WindowType window = WindowType::HANN);
+
+        /**
+         * Create a STFT with a user-defined window.
+         *
+         * @param frameSize The number of samples of each frame (FFT length, power of 2).
+         * @param hopSize The number of samples between the start of two consecutive frames (1 <= hop <= frame).
+         * @param window The window samples; its size must be equal to frameSize.
+         * @throws std::invalid_argument if frameSize is not a power of 2, hopSize is out of range,
+         *         or the window size does not match the frame size.
+         */
+        ShortTimeFourierTransform(size_t frameSize, size_t hopSize, const std::vector<double>& window);
+
+        /**
+         * Push new samples and append the spectra of the completed frames to the output.
+         *
+         * Each emitted frame is made of getNumBins() complex numbers (bins 0 ... frameSize / 2),
+         * appended one frame after the other (row-major).
+         *
+         * @param samples Pointer to the new samples.
+         * @param count The number of new samples.
+         * @param frames The vector where the spectra of the completed frames are appended.
+         * @return The number of frames appended.
+         */
+        size_t push(const double* samples, size_t count, std::vector<std::complex<double>>& frames);
+
+        /**
+         * Push new samples and append the spectra of the completed frames to the output.
+         *
+         * @param samples The new samples.
+         * @param frames The vector where the spectra of the completed frames are appended.
+         * @return The number of frames appended.
+         */
+        size_t push(const std::vector<double>& samples, std::vector<std::complex<double>>& frames);
+
+        /**
+         * Discard the input history, as if no sample had been pushed.
+         */
+        void reset();
+
+        /**
+         * Get the frame size (FFT length).
+         * @return The frame size.
+         */
+        [[nodiscard]] size_t getFrameSize() const {
+            return frameSize;
+        }
+
+        /**
+         * Get the hop size.
+         * @return The number of samples between two consecutive frames.
+         */
+        [[nodiscard]] size_t getHopSize() const {
+            return hopSize;
+        }
+
+        /**
+         * Get the number of bins emitted for each frame (frameSize / 2 + 1).
+         * @return The number of bins per frame.
+         */
+        [[nodiscard]] size_t getNumBins() const {
+            return frameSize / 2 + 1;
+        }
+
+        /**
+         * Get the window applied to each frame.
+         * @return The window samples.
+         */
+        [[nodiscard]] const std::vector<double>& getWindow() const {
+            return window;
+        }
+
+    private:
+        /**
+         * Number of packed complex FFTs in a batch (each one carries two frames).
+         */
+        static constexpr size_t BATCH_ROWS = 8;
+
+        /**
+         * The frame size (N).
+         */
+        size_t frameSize;
+        /**
+         * The hop size.
+         */
+        size_t hopSize;
+        /**
+         * The analysis window.
+         */
+        std::vector<double> window;
+        /**
+         * The plan shared by all the FFTs of the frames.
+         */
+        fft::algo::cooley_tukey::BatchPlan plan;
+        /**
+         * The last frameSize samples of the input stream (the next frame to be completed).
+         */
+        std::vector<double> history;
+        /**
+         * Number of valid samples in the history.
+         */
+        size_t filled;
+        /**
+         * Windowed frames waiting for the FFT, packed in pairs (BATCH_ROWS x frameSize).
+         */
+        std::vector<std::complex<double>> batch;
+        /**
+         * Number of frames gathered in the batch.
+         */
+        size_t pendingFrames;
+
+        /**
+         * Apply the window to the history and store it in the next free slot of the batch.
+         */
+        void gatherFrame();
+
+        /**
+         * Transform the pending frames, separate the packed pairs and append them to the output.
+         *
+         * @param frames The vector where the spectra are appended.
+         */
+        void flushBatch(std::vector<std::complex<double>>& frames);
+    };
+}
+
+#endif //SHORT_TIME_FOURIER_TRANSFORM_HPP
@@ -0,0 +1,34 @@
+#include <cmath>
+#include <stdexcept>
+
+#include "transforms/short_time_fourier_transform/window_functions.hpp"
+
+namespace sp::stft {
+    std::vector<double> makeWindow(const WindowType type, const size_t length) {
+        if (length == 0) {
+            throw std::invalid_argument("The window length must be greater than 0.");
+        }
+        std::vector<double> window(length);
+        const double N = static_cast<double>(length);
+        for (size_t n = 0; n < length; ++n) {
+            const double phase = 2 * M_PI * static_cast<double>(n) / N;
+            switch (type) {
+                case WindowType::RECTANGULAR:
+                    window[n] = 1.0;
+                    break;
+                case WindowType::HANN:
+                    window[n] = 0.5 - 0.5 * std::cos(phase);
+                    break;
+                case WindowType::HAMMING:
+                    window[n] = 0.54 - 0.46 * std::cos(phase);
+                    break;
+                case WindowType::BLACKMAN:
+                    window[n] = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2 * phase);
+                    break;
+                default:
+                    throw std::invalid_argument("Invalid window type specified.");
+            }
+        }
+        return window;
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef WINDOW_FUNCTIONS_HPP
+#define WINDOW_FUNCTIONS_HPP
+
+#include <vector>
+
+namespace sp::stft {
+    /**
+     * Enumeration for the window functions applied to each frame.
+     *
+     * The windows are:
+     *  - <code>RECTANGULAR</code>: No tapering (all ones).
+     *  - <code>HANN</code>: Raised cosine, 0.5 - 0.5 * cos(2 * pi * n / N).
+     *  - <code>HAMMING</code>: 0.54 - 0.46 * cos(2 * pi * n / N).
+     *  - <code>BLACKMAN</code>: 0.42 - 0.5 * cos(2 * pi * n / N) + 0.08 * cos(4 * pi * n / N).
+     *
+     * The windows are periodic (the denominator is N, not N - 1),
+     * which is the correct choice for spectral analysis with overlapping frames.
+     *
+     * See also: <a href="https://en.wikipedia.org/wiki/Window_function">Window function</a>
+     */
+    enum class WindowType {
+        RECTANGULAR,
+        HANN,
+        HAMMING,
+        BLACKMAN
+    };
+
+    /**
+     * Generate the samples of a (periodic) window function.
+     *
+     * @param type The window function.
+     * @param length The number of samples of the window.
+     * @return The window samples.
+     * @throws std::invalid_argument if the length is 0.
+     */
+    std::vector<double> makeWindow(WindowType type, size_t length);
+}
+
+#endif //WINDOW_FUNCTIONS_HPP
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "transforms/sliding_fourier_transform/goertzel_filter_bank.hpp"
+
+namespace sp::sdft {
+    GoertzelFilterBank::GoertzelFilterBank(const std::vector<double>& frequencies)
+        : frequencies(frequencies), numSamples(0), complexInput(false) {
+        if (frequencies.empty()) {
+            throw std::invalid_argument("At least one target frequency is needed.");
+        }
+        const size_t K = frequencies.size();
+        this->coefficients.resize(K);
+        for (size_t k = 0; k < K; ++k) {
+            this->coefficients[k] = 2 * std::cos(2 * M_PI * frequencies[k]);
+        }
+        this->real1.assign(K, 0.0);
+        this->real2.assign(K, 0.0);
+        this->imag1.assign(K, 0.0);
+        this->imag2.assign(K, 0.0);
+    }
+
+    void GoertzelFilterBank::process(const double* samples, const size_t count) {
+        const size_t K = this->frequencies.size();
+        const double* c = this->coefficients.data();
+        double* s1 = this->real1.data();
+        double* s2 = this->real2.data();
+        for (size_t n = 0; n < count; ++n) {
+            const double x = samples[n];
+            // one step of all the filters: s[n] = x[n] + 2 * cos(w) * s[n - 1] - s[n - 2]
+            #pragma omp simd
+            for (size_t k = 0; k < K; ++k) {
+                const double s0 = x + c[k] * s1[k] - s2[k];
+                s2[k] = s1[k];
+                s1[k] = s0;
+            }
+        }
+        // the imaginary filters see zeros: keep them aligned with the real ones
+        if (this->complexInput) {
+            double* t1 = this->imag1.data();
+            double* t2 = this->imag2.data();
+            for (size_t n = 0; n < count; ++n) {
+                #pragma omp simd
+                for (size_t k = 0; k < K; ++k) {
+                    const double t0 = c[k] * t1[k] - t2[k];
+                    t2[k] = t1[k];
+                    t1[k] = t0;
+                }
+            }
+        }
+        this->numSamples += count;
+    }
+
+    void GoertzelFilterBank::process(const std::vector<double>& signal) {
+        this->process(signal.data(), signal.size());
+    }
+
+    void GoertzelFilterBank::process(const std::vector<std::complex<double>>& signal) {
+        // the filters are linear: the real and imaginary parts are filtered separately
+        this->complexInput = true;
+        const size_t K = this->frequencies.size();
+        const double* c = this->coefficients.data();
+        double* s1 = this->real1.data();
+        double* s2 = this->real2.data();
+        double* t1 = this->imag1.data();
+        double* t2 = this->imag2.data();
+        for (const std::complex<double>& sample : signal) {
+            const double xr = sample.real();
+            const double xi = sample.imag();
+            #pragma omp simd
+            for (size_t k = 0; k < K; ++k) {
+                const double s0 = xr + c[k] * s1[k] - s2[k];
+                s2[k] = s1[k];
+                s1[k] = s0;
+                const double t0 = xi + c[k] * t1[k] - t2[k];
+                t2[k] = t1[k];
+                t1[k] = t0;
+            }
+        }
+        this->numSamples += signal.size();
+    }
+
+    std::vector<std::complex<double>> GoertzelFilterBank::getSpectrum() const {
+        const size_t K = this->frequencies.size();
+        std::vector<std::complex<double>> spectrum(K);
+        if (this->numSamples == 0) {
+            return spectrum;
+        }
+        const auto M = static_cast<double>(this->numSamples);
+        for (size_t k = 0; k < K; ++k) {
+            const double w = 2 * M_PI * this->frequencies[k];
+            /**
+             * After M samples:
+             *      s[M - 1] - e^(-i * w) * s[M - 2] = sum_n x[n] * e^(i * w * (M - 1 - n))
+             * so the DFT is obtained by rotating it by e^(-i * w * (M - 1)).
+             */
+            const std::complex<double> rotation = std::polar(1.0, -w * (M - 1));
+            const std::complex<double> delay = std::polar(1.0, -w);
+            std::complex<double> value = rotation * (this->real1[k] - delay * this->real2[k]);
+            if (this->complexInput) {
+                const std::complex<double> imagPart = rotation * (this->imag1[k] - delay * this->imag2[k]);
+                value += std::complex<double>(-imagPart.imag(), imagPart.real());
+            }
+            spectrum[k] = value;
+        }
+        return spectrum;
+    }
+
+    std::vector<double> GoertzelFilterBank::getPower() const {
+        const size_t K = this->frequencies.size();
+        std::vector<double> power(K);
+        if (this->complexInput) {
+            const std::vector<std::complex<double>> spectrum = this->getSpectrum();
+            for (size_t k = 0; k < K; ++k) {
+                power[k] = std::norm(spectrum[k]);
+            }
+            return power;
+        }
+        // |s[M - 1] - e^(-i * w) * s[M - 2]|^2 = s1^2 + s2^2 - 2 * cos(w) * s1 * s2
+        for (size_t k = 0; k < K; ++k) {
+            const double s1 = this->real1[k];
+            const double s2 = this->real2[k];
+            power[k] = s1 * s1 + s2 * s2 - this->coefficients[k] * s1 * s2;
+        }
+        return power;
+    }
+
+    void GoertzelFilterBank::reset() {
+        std::fill(this->real1.begin(), this->real1.end(), 0.0);
+        std::fill(this->real2.begin(), this->real2.end(), 0.0);
+        std::fill(this->imag1.begin(), this->imag1.end(), 0.0);
+        std::fill(this->imag2.begin(), this->imag2.end(), 0.0);
+        this->numSamples = 0;
+        this->complexInput = false;
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef GOERTZEL_FILTER_BANK_HPP
+#define GOERTZEL_FILTER_BANK_HPP
+
+#include <complex>
+#include <vector>
+
+namespace sp::sdft {
+    /**
+     * Bank of <a href="https://en.wikipedia.org/wiki/Goertzel_algorithm">Goertzel filters</a>.
+     *
+     * It computes the DFT of the pushed samples at K target frequencies:
+     *
+     *      X(f) = sum_{n=0}^{M-1} x[n] * e^(-2 * pi * i * f * n)
+     *
+     * where M is the number of samples pushed since the last reset. Each filter is the
+     * second order recurrence s[n] = x[n] + 2 * cos(2 * pi * f) * s[n - 1] - s[n - 2],
+     * i.e. one multiplication per sample per frequency; the frequencies do not need to be DFT bins.
+     * When only a few frequencies are needed, it is cheaper than a full FFT of the signal.
+     *
+     * The filter states are stored as contiguous arrays and the loop over the frequencies
+     * is vectorized, so the whole bank is updated at once for each sample.
+     *
+     * The frequencies are normalized (cycles per sample), the same unit used by the
+     * signal generators (sp::signal_gen), so a generated signal can be pushed directly.
+     */
+    class GoertzelFilterBank {
+    public:
+        /**
+         * Create a bank of Goertzel filters.
+         *
+         * @param frequencies The target frequencies in cycles per sample (e.g. 0.25 is a quarter of the sampling rate).
+         * @throws std::invalid_argument if frequencies is empty.
+         */
+        explicit GoertzelFilterBank(const std::vector<double>& frequencies);
+
+        /**
+         * Push real samples.
+         *
+         * @param samples Pointer to the samples.
+         * @param count The number of samples.
+         */
+        void process(const double* samples, size_t count);
+
+        /**
+         * Push a real signal.
+         *
+         * @param signal The samples (e.g. from BaseSignalGenerator::generateReal1DSignal).
+         */
+        void process(const std::vector<double>& signal);
+
+        /**
+         * Push a complex signal.
+         *
+         * @param signal The samples (e.g. from BaseSignalGenerator::generate1DSignal).
+         */
+        void process(const std::vector<std::complex<double>>& signal);
+
+        /**
+         * Get the DFT at the target frequencies of all the samples pushed since the last reset.
+         *
+         * @return The DFT values, in the order of the frequencies.
+         */
+        [[nodiscard]] std::vector<std::complex<double>> getSpectrum() const;
+
+        /**
+         * Get the power |X(f)|^2 at the target frequencies.
+         * For real signals it does not need the final complex rotation, so it is cheaper than getSpectrum.
+         *
+         * @return The power values, in the order of the frequencies.
+         */
+        [[nodiscard]] std::vector<double> getPower() const;
+
+        /**
+         * Get the target frequencies.
+         * @return The target frequencies in cycles per sample.
+         */
+        [[nodiscard]] const std::vector<double>& getFrequencies() const {
+            return frequencies;
+        }
+
+        /**
+         * Get the number of samples pushed since the last reset.
+         * @return The number of samples.
+         */
+        [[nodiscard]] size_t getNumSamples() const {
+            return numSamples;
+        }
+
+        /**
+         * Clear the filter states, as if no sample had been pushed.
+         */
+        void reset();
+
+    private:
+        /**
+         * The target frequencies.
+         */
+        std::vector<double> frequencies;
+        /**
+         * The filter coefficients 2 * cos(2 * pi * f).
+         */
+        std::vector<double> coefficients;
+        /**
+         * The last two states s[n - 1], s[n - 2] of the filters for the real part of the signal.
+         */
+        std::vector<double> real1, real2;
+        /**
+         * The last two states of the filters for the imaginary part of the signal (complex signals only).
+         */
+        std::vector<double> imag1, imag2;
+        /**
+         * The number of samples pushed since the last reset.
+         */
+        size_t numSamples;
+        /**
+         * True if at least a complex sample has been pushed (the imaginary states are used).
+         */
+        bool complexInput;
+    };
+}
+
+#endif //GOERTZEL_FILTER_BANK_HPP
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include "transforms/sliding_fourier_transform/sliding_discrete_fourier_transform.hpp"
+
+namespace sp::sdft {
+    /**
+     * All the bins of a window: 0, 1, ..., N - 1.
+     */
+    static std::vector<size_t> allBins(const size_t windowSize) {
+        std::vector<size_t> bins(windowSize);
+        std::iota(bins.begin(), bins.end(), 0);
+        return bins;
+    }
+
+    SlidingDiscreteFourierTransform::SlidingDiscreteFourierTransform(const size_t windowSize)
+        : SlidingDiscreteFourierTransform(windowSize, allBins(windowSize)) {}
+
+    SlidingDiscreteFourierTransform::SlidingDiscreteFourierTransform(
+        const size_t windowSize,
+        const std::vector<size_t>& bins
+    ) : windowSize(windowSize), bins(bins), head(0) {
+        if (windowSize == 0) {
+            throw std::invalid_argument("The window size must be greater than 0.");
+        }
+        if (bins.empty()) {
+            throw std::invalid_argument("At least one bin must be tracked.");
+        }
+        for (const size_t bin : bins) {
+            if (bin >= windowSize) {
+                throw std::invalid_argument(
+                    "The bin " + std::to_string(bin) + " is out of range [0, " + std::to_string(windowSize) + ")."
+                );
+            }
+        }
+        const size_t numBins = bins.size();
+        this->rotationReal.resize(numBins);
+        this->rotationImag.resize(numBins);
+        for (size_t b = 0; b < numBins; ++b) {
+            const double angle = 2 * M_PI * static_cast<double>(bins[b]) / static_cast<double>(windowSize);
+            this->rotationReal[b] = std::cos(angle);
+            this->rotationImag[b] = std::sin(angle);
+        }
+        this->twiddles.resize(windowSize);
+        for (size_t m = 0; m < windowSize; ++m) {
+            this->twiddles[m] = std::polar(1.0, -2 * M_PI * static_cast<double>(m) / static_cast<double>(windowSize));
+        }
+        this->real.assign(numBins, 0.0);
+        this->imag.assign(numBins, 0.0);
+        this->window.assign(windowSize, std::complex<double>(0.0, 0.0));
+    }
+
+    void SlidingDiscreteFourierTransform::update(const std::complex<double> sample) {
+        // the new sample replaces the oldest one in the ring buffer
+        const std::complex<double> delta = sample - this->window[this->head];
+        this->window[this->head] = sample;
+        this->head = this->head + 1 == this->windowSize ? 0 : this->head + 1;
+
+        if (this->head == 0) {
+            // the window is in chronological order: recompute it exactly
+            this->resynchronize();
+            return;
+        }
+
+        const double dr = delta.real();
+        const double di = delta.imag();
+        const size_t numBins = this->bins.size();
+        double* re = this->real.data();
+        double* im = this->imag.data();
+        const double* cr = this->rotationReal.data();
+        const double* ci = this->rotationImag.data();
+        #pragma omp simd
+        for (size_t b = 0; b < numBins; ++b) {
+            // X_k = e^(2 * pi * i * k / N) * (X_k + x[n] - x[n - N])
+            const double ar = re[b] + dr;
+            const double ai = im[b] + di;
+            re[b] = ar * cr[b] - ai * ci[b];
+            im[b] = ar * ci[b] + ai * cr[b];
+        }
+    }
+
+    void SlidingDiscreteFourierTransform::update(const std::vector<std::complex<double>>& signal) {
+        for (const std::complex<double>& sample : signal) {
+            this->update(sample);
+        }
+    }
+
+    void SlidingDiscreteFourierTransform::update(const std::vector<double>& signal) {
+        for (const double sample : signal) {
+            this->update(std::complex<double>(sample, 0.0));
+        }
+    }
+
+    void SlidingDiscreteFourierTransform::update(
+        const std::vector<std::complex<double>>& signal,
+        std::vector<std::complex<double>>& spectra
+    ) {
+        spectra.reserve(spectra.size() + signal.size() * this->bins.size());
+        for (const std::complex<double>& sample : signal) {
+            this->update(sample);
+            for (size_t b = 0; b < this->bins.size(); ++b) {
+                spectra.emplace_back(this->real[b], this->imag[b]);
+            }
+        }
+    }
+
+    void SlidingDiscreteFourierTransform::update(
+        const std::vector<double>& signal,
+        std::vector<std::complex<double>>& spectra
+    ) {
+        spectra.reserve(spectra.size() + signal.size() * this->bins.size());
+        for (const double sample : signal) {
+            this->update(std::complex<double>(sample, 0.0));
+            for (size_t b = 0; b < this->bins.size(); ++b) {
+                spectra.emplace_back(this->real[b], this->imag[b]);
+            }
+        }
+    }
+
+    std::vector<std::complex<double>> SlidingDiscreteFourierTransform::getSpectrum() const {
+        std::vector<std::complex<double>> spectrum(this->bins.size());
+        for (size_t b = 0; b < this->bins.size(); ++b) {
+            spectrum[b] = {this->real[b], this->imag[b]};
+        }
+        return spectrum;
+    }
+
+    void SlidingDiscreteFourierTransform::reset() {
+        std::fill(this->window.begin(), this->window.end(), std::complex<double>(0.0, 0.0));
+        std::fill(this->real.begin(), this->real.end(), 0.0);
+        std::fill(this->imag.begin(), this->imag.end(), 0.0);
+        this->head = 0;
+    }
+
+    void SlidingDiscreteFourierTransform::resynchronize() {
+        const size_t N = this->windowSize;
+        for (size_t b = 0; b < this->bins.size(); ++b) {
+            const size_t k = this->bins[b];
+            std::complex<double> sum(0.0, 0.0);
+            // (k * m) mod N is updated incrementally to avoid the overflow of k * m
+            size_t index = 0;
+            for (size_t m = 0; m < N; ++m) {
+                sum += this->window[m] * this->twiddles[index];
+                index += k;
+                if (index >= N) {
+                    index -= N;
+                }
+            }
+            this->real[b] = sum.real();
+            this->imag[b] = sum.imag();
+        }
+    }
+}
@@ -0,0 +1,167 @@
+#ifndef SLIDING_DISCRETE_FOURIER_TRANSFORM_HPP
+#define SLIDING_DISCRETE_FOURIER_TRANSFORM_HPP
+
+#include <complex>
+#include <vector>
+
+namespace sp::sdft {
+    /**
+     * Sliding Discrete Fourier Transform (SDFT).
+     *
+     * It keeps the DFT of the last N samples (the window) for a set of tracked bins,
+     * updated at every new sample in O(1) per bin:
+     *
+     *      X_k(n) = e^(2 * pi * i * k / N) * (X_k(n - 1) - x[n - N] + x[n])
+     *
+     * where the oldest sample of the window has index 0 in the DFT, so after N samples
+     * the spectrum is the same as computeFFT of the window (for the tracked bins).
+     *
+     * The recurrence accumulates round-off error, so every N samples (when the window
+     * is aligned with the ring buffer) the tracked bins are recomputed exactly from the window:
+     * the amortized cost is still O(1) per bin per sample.
+     *
+     * The signal types are the ones of the signal generators (sp::signal_gen),
+     * so a generated signal can be pushed directly.
+     */
+    class SlidingDiscreteFourierTransform {
+    public:
+        /**
+         * Create a sliding DFT that tracks all the N bins of the window.
+         *
+         * @param windowSize The window length N (any positive size, not only powers of 2).
+         * @throws std::invalid_argument if the window size is 0.
+         */
+        explicit SlidingDiscreteFourierTransform(size_t windowSize);
+
+        /**
+         * Create a sliding DFT that tracks only the given bins.
+         *
+         * @param windowSize The window length N (any positive size, not only powers of 2).
+         * @param bins The indices of the tracked bins, each one in [0, N).
+         * @throws std::invalid_argument if the window size is 0, bins is empty or a bin is out of range.
+         */
+        SlidingDiscreteFourierTransform(size_t windowSize, const std::vector<size_t>& bins);
+
+        /**
+         * Push a new sample and update all the tracked bins.
+         *
+         * @param sample The new sample.
+         */
+        void update(std::complex<double> sample);
+
+        /**
+         * Push a complex signal, sample by sample.
+         *
+         * @param signal The samples (e.g. from BaseSignalGenerator::generate1DSignal).
+         */
+        void update(const std::vector<std::complex<double>>& signal);
+
+        /**
+         * Push a real signal, sample by sample.
+         *
+         * @param signal The samples (e.g. from BaseSignalGenerator::generateReal1DSignal).
+         */
+        void update(const std::vector<double>& signal);
+
+        /**
+         * Push a complex signal and record the tracked bins after every sample.
+         *
+         * @param signal The samples.
+         * @param spectra The vector where, for each sample, the getNumBins() tracked values are appended.
+         */
+        void update(const std::vector<std::complex<double>>& signal, std::vector<std::complex<double>>& spectra);
+
+        /**
+         * Push a real signal and record the tracked bins after every sample.
+         *
+         * @param signal The samples.
+         * @param spectra The vector where, for each sample, the getNumBins() tracked values are appended.
+         */
+        void update(const std::vector<double>& signal, std::vector<std::complex<double>>& spectra);
+
+        /**
+         * Get the current value of a tracked bin.
+         *
+         * @param index The position of the bin in getBins() (not the bin frequency).
+         * @return The DFT value of the bin over the current window.
+         */
+        [[nodiscard]] std::complex<double> getBin(size_t index) const {
+            return {real[index], imag[index]};
+        }
+
+        /**
+         * Get the current values of all the tracked bins.
+         *
+         * @return The DFT values over the current window, in the order of getBins().
+         */
+        [[nodiscard]] std::vector<std::complex<double>> getSpectrum() const;
+
+        /**
+         * Get the tracked bins.
+         * @return The indices of the tracked bins.
+         */
+        [[nodiscard]] const std::vector<size_t>& getBins() const {
+            return bins;
+        }
+
+        /**
+         * Get the number of tracked bins.
+         * @return The number of tracked bins.
+         */
+        [[nodiscard]] size_t getNumBins() const {
+            return bins.size();
+        }
+
+        /**
+         * Get the window length.
+         * @return The window length N.
+         */
+        [[nodiscard]] size_t getWindowSize() const {
+            return windowSize;
+        }
+
+        /**
+         * Clear the window (all zeros) and the spectrum.
+         */
+        void reset();
+
+    private:
+        /**
+         * The window length N.
+         */
+        size_t windowSize;
+        /**
+         * The tracked bins.
+         */
+        std::vector<size_t> bins;
+        /**
+         * Real and imaginary part of the per-bin rotation e^(2 * pi * i * k / N),
+         * stored as separate arrays so the update loop over the bins can be vectorized.
+         */
+        std::vector<double> rotationReal, rotationImag;
+        /**
+         * Real and imaginary part of the tracked bins.
+         */
+        std::vector<double> real, imag;
+        /**
+         * The twiddle factors e^(-2 * pi * i * m / N), used by the exact recomputation.
+         */
+        std::vector<std::complex<double>> twiddles;
+        /**
+         * Ring buffer with the last N samples.
+         */
+        std::vector<std::complex<double>> window;
+        /**
+         * Position of the oldest sample in the ring buffer.
+         */
+        size_t head;
+
+        /**
+         * Recompute the tracked bins from the window, discarding the accumulated round-off error.
+         * It must be called when head is 0 (window in chronological order).
+         */
+        void resynchronize();
+    };
+}
+
+#endif //SLIDING_DISCRETE_FOURIER_TRANSFORM_HPP
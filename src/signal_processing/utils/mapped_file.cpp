@@ -0,0 +1,104 @@
+#include <fcntl.h>
+#include <fstream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "utils/mapped_file.hpp"
+
+namespace sp::utils::io
+{
+    MappedFile::MappedFile(const std::string& path, const bool map) {
+        if (!map || !map_file(path)) {
+            read_file(path);
+        }
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept:
+        bytes(other.bytes), length(other.length), mapped(other.mapped), buffer(std::move(other.buffer)) {
+        other.bytes = nullptr;
+        other.length = 0;
+        other.mapped = false;
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            release();
+            this->bytes = other.bytes;
+            this->length = other.length;
+            this->mapped = other.mapped;
+            this->buffer = std::move(other.buffer);
+            other.bytes = nullptr;
+            other.length = 0;
+            other.mapped = false;
+        }
+        return *this;
+    }
+
+    MappedFile::~MappedFile() {
+        release();
+    }
+
+    bool MappedFile::map_file(const std::string& path) {
+        const int descriptor = open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            throw std::runtime_error("Error: cannot open the file " + path);
+        }
+        struct stat status{};
+        if (fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode)) {
+            close(descriptor);
+            return false;
+        }
+        const auto size = static_cast<size_t>(status.st_size);
+        if (size > 0) {
+            void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (address == MAP_FAILED) {
+                close(descriptor);
+                return false;
+            }
+            this->bytes = static_cast<const uint8_t*>(address);
+            this->mapped = true;
+        }
+        this->length = size;
+        // the mapping stays valid after the descriptor is closed
+        close(descriptor);
+        return true;
+    }
+
+    void MappedFile::read_file(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Error: cannot open the file " + path);
+        }
+        // read in chunks: the size of a pipe is not known in advance (a file is read in one chunk)
+        file.seekg(0, std::ios::end);
+        const std::streamoff fileSize = file.tellg();
+        file.clear();
+        file.seekg(0, std::ios::beg);
+        const size_t chunkSize = fileSize > 0 ? static_cast<size_t>(fileSize) + 1 : static_cast<size_t>(1) << 20;
+        while (file) {
+            const size_t size = this->buffer.size();
+            this->buffer.resize(size + chunkSize);
+            file.read(reinterpret_cast<char*>(this->buffer.data() + size), chunkSize);
+            this->buffer.resize(size + static_cast<size_t>(file.gcount()));
+        }
+        if (file.bad()) {
+            throw std::runtime_error("Error: cannot read the file " + path);
+        }
+        this->bytes = this->buffer.empty() ? nullptr : this->buffer.data();
+        this->length = this->buffer.size();
+        this->mapped = false;
+    }
+
+    void MappedFile::release() {
+        if (this->mapped && this->bytes != nullptr) {
+            munmap(const_cast<uint8_t*>(this->bytes), this->length);
+        }
+        this->buffer.clear();
+        this->buffer.shrink_to_fit();
+        this->bytes = nullptr;
+        this->length = 0;
+        this->mapped = false;
+    }
+}
@@ -0,0 +1,179 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Read-only memory mapping of a file, and bounds-checked decoding of its bytes.
+ */
+namespace sp::utils::io
+{
+    /**
+     * A file mapped read-only in memory (POSIX mmap): its bytes are paged in on demand by the OS,
+     * so a reader that touches only a part of a large file reads only that part from the disk,
+     * and the decoders read the page cache directly, without a copy in a buffer.
+     * When the file cannot be mapped (e.g. a pipe, or a file system without mmap), or on request,
+     * it is read at once with std::ifstream into a buffer owned by the object.
+     * The mapping is released by the destructor; the object can be moved but not copied.
+     */
+    class MappedFile {
+    public:
+        /**
+         * Constructor that maps (or reads) a whole file.
+         *
+         * @param path: path to the file.
+         * @param map: true to map the file (reading it if the mapping fails), false to read it.
+         * @throws std::runtime_error if the file cannot be opened or read.
+         */
+        explicit MappedFile(const std::string& path, bool map = true);
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        ~MappedFile();
+
+        /**
+         * Get the bytes of the file.
+         * @return A pointer to the first byte (nullptr for an empty file).
+         */
+        [[nodiscard]] const uint8_t* data() const {
+            return this->bytes;
+        }
+
+        /**
+         * Get the size of the file.
+         * @return The number of bytes.
+         */
+        [[nodiscard]] size_t size() const {
+            return this->length;
+        }
+
+        /**
+         * Check if the file is mapped.
+         * @return true if the bytes are mapped, false if they were read into a buffer.
+         */
+        [[nodiscard]] bool isMapped() const {
+            return this->mapped;
+        }
+
+    private:
+        const uint8_t* bytes = nullptr;
+        size_t length = 0;
+        bool mapped = false;
+        /**
+         * The bytes of the file when it is not mapped.
+         */
+        std::vector<uint8_t> buffer;
+
+        /**
+         * Function that maps the file.
+         *
+         * @param path: path to the file.
+         * @return: true if the file is mapped (or empty), false if it cannot be mapped.
+         * @throws std::runtime_error if the file cannot be opened.
+         */
+        bool map_file(const std::string& path);
+
+        /**
+         * Function that reads the whole file into the buffer with std::ifstream.
+         *
+         * @param path: path to the file.
+         * @throws std::runtime_error if the file cannot be opened or read.
+         */
+        void read_file(const std::string& path);
+
+        /**
+         * Function that unmaps the file (if mapped) and releases the buffer.
+         */
+        void release();
+    };
+
+    /**
+     * Cursor over a range of bytes (e.g. a MappedFile) that decodes values in the byte order of the
+     * machine (as written by std::ofstream::write), checking the bounds of every read: a truncated or
+     * corrupted file raises an error instead of reading past its end.
+     */
+    class ByteCursor {
+    public:
+        /**
+         * Constructor of a cursor at the first byte.
+         *
+         * @param data: pointer to the first byte.
+         * @param size: number of bytes.
+         */
+        ByteCursor(const uint8_t* data, const size_t size): data(data), size(size), position(0) {}
+
+        /**
+         * Read a value and move past it.
+         *
+         * @tparam T: a trivially copyable type.
+         * @return: the value.
+         * @throws std::runtime_error if there are not enough bytes.
+         */
+        template <typename T>
+        T read() {
+            T value;
+            std::memcpy(&value, take(sizeof(T)), sizeof(T));
+            return value;
+        }
+
+        /**
+         * Get a range of bytes and move past it (zero-copy).
+         *
+         * @param count: number of bytes.
+         * @return: a pointer to the first byte of the range.
+         * @throws std::runtime_error if there are not enough bytes.
+         */
+        const uint8_t* take(const size_t count) {
+            require(count);
+            const uint8_t* range = this->data + this->position;
+            this->position += count;
+            return range;
+        }
+
+        /**
+         * Check that a number of bytes is available.
+         *
+         * @param count: number of bytes.
+         * @throws std::runtime_error if there are not enough bytes.
+         */
+        void require(const size_t count) const {
+            if (count > remaining()) {
+                throw std::runtime_error(
+                    "Error: the data is truncated (" + std::to_string(count) + " bytes needed at offset " +
+                    std::to_string(this->position) + ", " + std::to_string(remaining()) + " available)"
+                );
+            }
+        }
+
+        /**
+         * Get the current position.
+         * @return The number of bytes consumed.
+         */
+        [[nodiscard]] size_t getPosition() const {
+            return this->position;
+        }
+
+        /**
+         * Get the number of bytes after the current position.
+         * @return The number of bytes not consumed yet.
+         */
+        [[nodiscard]] size_t remaining() const {
+            return this->size - this->position;
+        }
+
+    private:
+        const uint8_t* data;
+        size_t size;
+        size_t position;
+    };
+}
+
+#endif //MAPPED_FILE_HPP
@@ -1,42 +1,106 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
 #include <vector>
-#include <iostream>
 
 #include "rle_compressor.hpp"
 
 namespace sp::utils::rle
 {
-    const std::vector<std::pair<int, int>> RLECompressor::compress(const std::vector<double>& input) {
-        // (#value_repetitions, value)
-        std::vector<std::pair<int, int>> compressed;
-        int count = 1;
-
-        for (size_t i = 0; i < input.size(); ++i) {
-            if (input[i] == input[i+1]) {
-                count++;
-                if(input[i] == 0){
-                }
-            } else {
-                //vector.emplace_back(element) --> adds a constructed-in-place element to the end of the vector
-                compressed.emplace_back(count, input[i]);
-                count = 1;
+    /**
+     * Pack 64 flags (0 or 1) into the bits of a mask: 8 flags at a time, the multiplication moves
+     * the lowest bit of every byte into the highest byte (without carries, the bits land in distinct positions).
+     */
+    static uint64_t packFlags(const uint8_t* flags) {
+        uint64_t mask = 0;
+        for (size_t i = 0; i < RUN_SCAN_WIDTH / 8; ++i) {
+            uint64_t word;
+            std::memcpy(&word, flags + 8 * i, sizeof(word));
+            mask |= ((word * 0x0102040810204080ULL) >> 56) << (8 * i);
+        }
+        return mask;
+    }
+
+    template <typename T>
+    size_t RLECompressor::compress(const T* input, const size_t size, std::pair<int, T>* runs) {
+        if (size == 0) {
+            return 0;
+        }
+        size_t numRuns = 0;
+        size_t begin = 0;
+        for (size_t base = 0; base < size; base += RUN_SCAN_WIDTH) {
+            const size_t count = std::min(RUN_SCAN_WIDTH, size - base);
+            const T* chunk = input + base;
+
+            // 1 where an element differs from the previous one (a run begins)
+            uint8_t changes[RUN_SCAN_WIDTH] = {};
+            changes[0] = base > 0 && chunk[0] != chunk[-1];
+            #pragma omp simd
+            for (size_t j = 1; j < count; ++j) {
+                changes[j] = chunk[j] != chunk[j - 1];
+            }
+
+            for (uint64_t mask = packFlags(changes); mask != 0; mask &= mask - 1) {
+                const size_t end = base + __builtin_ctzll(mask);
+                runs[numRuns++] = std::pair<int, T>(static_cast<int>(end - begin), input[begin]);
+                begin = end;
+            }
+        }
+        runs[numRuns++] = std::pair<int, T>(static_cast<int>(size - begin), input[begin]);
+        return numRuns;
+    }
+
+    template <typename T>
+    size_t RLECompressor::decompress(const std::pair<int, T>* runs, const size_t numRuns, T* output, const size_t capacity) {
+        size_t size = 0;
+        for (size_t i = 0; i < numRuns; ++i) {
+            const int count = runs[i].first;
+            if (count < 0 || static_cast<size_t>(count) > capacity - size) {
+                throw std::runtime_error(
+                    "Error: invalid run of " + std::to_string(count) + " values after " + std::to_string(size) +
+                    " of " + std::to_string(capacity)
+                );
             }
+            std::fill_n(output + size, count, runs[i].second);
+            size += count;
         }
+        return size;
+    }
+
+    template size_t RLECompressor::compress<double>(const double*, size_t, std::pair<int, double>*);
+    template size_t RLECompressor::compress<int>(const int*, size_t, std::pair<int, int>*);
+    template size_t RLECompressor::compress<int16_t>(const int16_t*, size_t, std::pair<int, int16_t>*);
+    template size_t RLECompressor::decompress<double>(const std::pair<int, double>*, size_t, double*, size_t);
+    template size_t RLECompressor::decompress<int>(const std::pair<int, int>*, size_t, int*, size_t);
+    template size_t RLECompressor::decompress<int16_t>(const std::pair<int, int16_t>*, size_t, int16_t*, size_t);
 
+    const std::vector<std::pair<int, int>> RLECompressor::compress(const std::vector<double>& input) {
+        // (#value_repetitions, value)
+        std::vector<std::pair<int, double>> runs(input.size());
+        runs.resize(compress(input.data(), input.size(), runs.data()));
+
+        std::vector<std::pair<int, int>> compressed(runs.size());
+        for (size_t i = 0; i < runs.size(); ++i) {
+            compressed[i] = std::make_pair(runs[i].first, static_cast<int>(runs[i].second));
+        }
         return compressed;
     }
 
     const std::vector<double> RLECompressor::decompress(const std::vector<std::pair<int, int>>& compressed) {
-        std::vector<double> decompressed;
-
-        for (auto it = compressed.begin(); it != compressed.end(); ++it) {
-            decompressed.insert(
-                decompressed.end(),
-                it->first,  // repetitions
-                it->second  // value
-            );
-            //decompressed.push_back(value); //vector.push_back(value) --> insert element value at the end of the vector
+        size_t size = 0;
+        for (const std::pair<int, int>& run : compressed) {
+            size += std::max(run.first, 0);
         }
 
+        std::vector<double> decompressed(size);
+        size_t position = 0;
+        for (const std::pair<int, int>& run : compressed) {
+            const size_t count = std::max(run.first, 0);
+            std::fill_n(decompressed.begin() + position, count, static_cast<double>(run.second));
+            position += count;
+        }
         return decompressed;
     }
 }
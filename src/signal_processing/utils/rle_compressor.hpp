@@ -1,5 +1,7 @@
 #ifndef RLE_COMPRESSOR_HPP
 #define RLE_COMPRESSOR_HPP
+#include <cstddef>
+#include <utility>
 #include <vector>
 
 /**
@@ -7,9 +9,18 @@
  *
  * This module provides functions to perform run-length encoding (RLE) compression
  * and decompression on a vector of doubles.
+ *
+ * The pointer overloads write into buffers of the caller (no allocation), and are instantiated for double,
+ * int and int16_t (the quantized coefficients of the JPEG blocks).
  */
 namespace sp::utils::rle
 {
+    /**
+     * Number of elements compared at once by RLECompressor::compress: the comparisons of every element with
+     * the previous one are vectorized, then packed into a 64-bit mask of the beginnings of the runs.
+     */
+    constexpr size_t RUN_SCAN_WIDTH = 64;
+
     class RLECompressor{
     public:
         RLECompressor() = default;
@@ -33,7 +44,33 @@ namespace sp::utils::rle
          * @return decompressed: vector of doubles representing the decompressed data.
          */
         static const std::vector<double> decompress(const std::vector<std::pair<int, int>>& compressed);
+
+        /**
+         * Function that performs run-length encoding (RLE) into a buffer of the caller.
+         * The runs are found RUN_SCAN_WIDTH elements at a time: the beginnings of the runs are the set bits
+         * of a mask of comparisons, visited with a count of trailing zeros (a branch per run, not per element).
+         *
+         * @param input: the elements to compress;
+         * @param size: number of elements;
+         * @param runs: the (count, value) pairs (output, room for size pairs in the worst case).
+         * @return: the number of runs written.
+         */
+        template <typename T>
+        static size_t compress(const T* input, size_t size, std::pair<int, T>* runs);
+
+        /**
+         * Function that decompresses (count, value) pairs into a buffer of the caller.
+         *
+         * @param runs: the (count, value) pairs;
+         * @param numRuns: number of pairs;
+         * @param output: the decompressed elements (output);
+         * @param capacity: number of elements that fit in output.
+         * @return: the number of elements written.
+         * @throws std::runtime_error if a count is negative or the runs do not fit in the output.
+         */
+        template <typename T>
+        static size_t decompress(const std::pair<int, T>* runs, size_t numRuns, T* output, size_t capacity);
     };
 }
 
-#endif //RLE_COMPRESSOR_HPP
\ No newline at end of file
+#endif //RLE_COMPRESSOR_HPP
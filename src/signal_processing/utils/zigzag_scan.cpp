@@ -1,60 +1,86 @@
 #include "zigzag_scan.hpp"
 #include <vector>
-#include <iostream>
+#include <stdexcept>
 
 namespace sp::utils::zigzag
 {
-    const std::vector<double> ZigZagScan::scan(const std::vector<std::vector<double>>& matrix) {
-        std::vector<double> result;
-        if(matrix.empty()){
-            return result;
-        }
+    // #################### ZIGZAG PERMUTATION ####################
 
-        int rows = matrix.size();
-        int cols = matrix[0].size();
-        int r = 0;
-        int c = 0;
+    ZigZagPermutation::ZigZagPermutation(const size_t rows, const size_t cols): rows(rows), cols(cols), order(rows * cols) {
+        size_t r = 0;
+        size_t c = 0;
         bool goingDown = false;
 
-        for(int i = 0; i<rows*cols; ++i){
-            result.push_back(matrix[r][c]);
+        for (size_t i = 0; i < rows * cols; ++i) {
+            this->order[i] = static_cast<uint32_t>(r * cols + c);
 
-            if(goingDown){
-                if(r == rows-1){
+            if (goingDown) {
+                if (r == rows - 1) {
                     // we have reached the bottom edge of the matrix
                     goingDown = false;
                     c++;
-                }
-                else if(c == 0){
+                } else if (c == 0) {
                     // we have reached the left edge of the matrix
                     goingDown = false;
                     r++;
-                }
-                else{
+                } else {
                     //we go down following the current diagonal
                     r++;
                     c--;
                 }
-            }
-            else{ //goingUp
-                if(r == 0){
+            } else { //goingUp
+                if (c == cols - 1) {
+                    // we have reached the right edge of the matrix (checked first for the top-right corner)
+                    goingDown = true;
+                    r++;
+                } else if (r == 0) {
                     //we have reached the top edge of the matrix
                     goingDown = true;
                     c++;
-                }
-                else if(c == cols-1){
-                    // we have reached the right edge of the matrix
-                    goingDown = true;
-                    r++;
-                }
-                else{
+                } else {
                     //we go up following the current diagonal
                     r--;
                     c++;
                 }
             }
         }
+    }
+
+    size_t ZigZagPermutation::getRows() const {
+        return this->rows;
+    }
+
+    size_t ZigZagPermutation::getCols() const {
+        return this->cols;
+    }
+
+    const std::vector<uint32_t>& ZigZagPermutation::getOrder() const {
+        return this->order;
+    }
+
+    // #################### ZIGZAG SCAN ####################
+
+    const std::vector<double> ZigZagScan::scan(const std::vector<std::vector<double>>& matrix) {
+        if (matrix.empty()) {
+            return {};
+        }
+
+        const size_t rows = matrix.size();
+        const size_t cols = matrix[0].size();
+        std::vector<double> result(rows * cols);
+        if (rows == 8 && cols == 8) {
+            for (size_t k = 0; k < rows * cols; ++k) {
+                const size_t index = ZIGZAG_8X8.order[k];
+                result[k] = matrix[index / cols][index % cols];
+            }
+            return result;
+        }
 
+        const ZigZagPermutation permutation(rows, cols);
+        const std::vector<uint32_t>& order = permutation.getOrder();
+        for (size_t k = 0; k < rows * cols; ++k) {
+            result[k] = matrix[order[k] / cols][order[k] % cols];
+        }
         return result;
     }
 
@@ -63,54 +89,18 @@ namespace sp::utils::zigzag
         const int rows,
         const int cols
     ) {
-        if (scanned.size() != rows * cols) {
+        if (rows < 0 || cols < 0 || scanned.size() != static_cast<size_t>(rows) * cols) {
             throw std::runtime_error(
                 "Error: the size of the zigzag scanned vector does not correspond to the matrix sizes"
             );
         }
 
         std::vector<std::vector<double>> matrix(rows, std::vector<double>(cols));
-        int r = 0;
-        int c = 0;
-        int idx = 0;
-        int goingDown = false;
-
-        for (int i = 0; i<rows*cols; ++i){
-            matrix[r][c] = scanned[idx];
-            idx++;
-
-            if(goingDown) {
-                if(r == rows-1) {
-                    // we have reached the bottom edge of the matrix
-                    goingDown = false;
-                    c++;
-                }
-                else if(c == 0) {
-                    // we have reached the left edge of the matrix
-                    goingDown = false;
-                    r++;
-                } else {
-                    //we go down following the current diagonal
-                    r++;
-                    c--;
-                }
-            } else { //goingUp
-                if(r == 0) {
-                    //we have reached the top edge of the matrix
-                    goingDown = true;
-                    c++;
-                } else if(c == cols-1) {
-                    // we have reached the right edge of the matrix
-                    goingDown = true;
-                    r++;
-                } else {
-                    //we go up following the current diagonal
-                    r--;
-                    c++;
-                }
-            }
+        const ZigZagPermutation permutation(rows, cols);
+        const std::vector<uint32_t>& order = permutation.getOrder();
+        for (size_t k = 0; k < scanned.size(); ++k) {
+            matrix[order[k] / cols][order[k] % cols] = scanned[k];
         }
-
         return matrix;
     }
 }
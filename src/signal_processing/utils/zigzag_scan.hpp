@@ -1,5 +1,7 @@
 #ifndef ZIGZAG_SCAN_HPP
 #define ZIGZAG_SCAN_HPP
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 /**
@@ -7,9 +9,239 @@
  *
  * This module provides functions to perform zigzag scanning on a 2D matrix
  * and to reconstruct the original matrix from the zigzag-scanned vector.
+ *
+ * The traversal is a permutation of the elements, so it is precomputed once as a table of indices:
+ * at compile time for N x N blocks (see ZigZagTable and scanBlock), at construction for rows x cols
+ * matrices (see ZigZagPermutation). A scan is then a gather through the table into a buffer of the caller.
  */
 namespace sp::utils::zigzag
 {
+    namespace detail
+    {
+        /**
+         * Compile-time sequence 0, ..., N-1 (std::index_sequence is C++14), built in log2(N) steps.
+         */
+        template <size_t... K>
+        struct IndexSequence {};
+
+        template <typename A, typename B>
+        struct ConcatSequence;
+
+        template <size_t... A, size_t... B>
+        struct ConcatSequence<IndexSequence<A...>, IndexSequence<B...>> {
+            using type = IndexSequence<A..., (sizeof...(A) + B)...>;
+        };
+
+        template <size_t N>
+        struct MakeIndexSequence : ConcatSequence<
+            typename MakeIndexSequence<N / 2>::type,
+            typename MakeIndexSequence<N - N / 2>::type
+        > {};
+
+        template <>
+        struct MakeIndexSequence<0> {
+            using type = IndexSequence<>;
+        };
+
+        template <>
+        struct MakeIndexSequence<1> {
+            using type = IndexSequence<0>;
+        };
+
+        /**
+         * @return: the anti-diagonal of the k-th element of the upper-left triangle (d * (d + 1) / 2 <= k).
+         */
+        constexpr size_t triangleRoot(const size_t k, const size_t d = 0) {
+            return (d + 1) * (d + 2) / 2 > k ? d : triangleRoot(k, d + 1);
+        }
+
+        /**
+         * @return: the row-major index of the i-th element of the anti-diagonal d (d < n): the even ones
+         *          are scanned upwards, the odd ones downwards.
+         */
+        constexpr size_t diagonalIndex(const size_t n, const size_t d, const size_t i) {
+            return d % 2 == 0 ? (d - i) * n + i : i * n + (d - i);
+        }
+
+        constexpr size_t upperZigZagIndex(const size_t n, const size_t d, const size_t k) {
+            return diagonalIndex(n, d, k - d * (d + 1) / 2);
+        }
+
+        /**
+         * @return: the scan position of the element (r, c) of the anti-diagonal d = r + c (d < n).
+         */
+        constexpr size_t upperZigZagPosition(const size_t d, const size_t r, const size_t c) {
+            return d * (d + 1) / 2 + (d % 2 == 0 ? c : r);
+        }
+    }
+
+    /**
+     * Function that computes the row-major index of the k-th element of the zigzag scan of an n x n matrix.
+     * The upper-left triangle is scanned one anti-diagonal at a time, and the scan is symmetric about
+     * the center: the k-th element from the end is the mirror of the k-th one from the beginning.
+     *
+     * @param n: the side of the matrix;
+     * @param k: the scan position (k < n * n).
+     * @return: the row-major index of the element.
+     */
+    constexpr size_t zigzagIndex(const size_t n, const size_t k) {
+        return k < n * (n + 1) / 2
+            ? detail::upperZigZagIndex(n, detail::triangleRoot(k), k)
+            : n * n - 1 - zigzagIndex(n, n * n - 1 - k);
+    }
+
+    /**
+     * Function that computes the scan position of an element of an n x n matrix (the inverse of zigzagIndex).
+     *
+     * @param n: the side of the matrix;
+     * @param index: the row-major index of the element (index < n * n).
+     * @return: the zigzag scan position of the element.
+     */
+    constexpr size_t zigzagPosition(const size_t n, const size_t index) {
+        return index / n + index % n < n
+            ? detail::upperZigZagPosition(index / n + index % n, index / n, index % n)
+            : n * n - 1 - zigzagPosition(n, n * n - 1 - index);
+    }
+
+    /**
+     * Zigzag permutation of an N x N block, and its inverse.
+     */
+    template <size_t N>
+    struct ZigZagTable {
+        static_assert(N > 0 && N <= 256, "the indices of the zigzag table are 16-bit");
+
+        /**
+         * order[k] is the row-major index of the k-th scanned element.
+         */
+        uint16_t order[N * N];
+        /**
+         * position[i] is the scan position of the i-th row-major element.
+         */
+        uint16_t position[N * N];
+    };
+
+    template <size_t N, size_t... K>
+    constexpr ZigZagTable<N> makeZigZagTable(detail::IndexSequence<K...>) {
+        return {
+            {static_cast<uint16_t>(zigzagIndex(N, K))...},
+            {static_cast<uint16_t>(zigzagPosition(N, K))...}
+        };
+    }
+
+    /**
+     * Function that builds the zigzag table of an N x N block at compile time.
+     */
+    template <size_t N>
+    constexpr ZigZagTable<N> makeZigZagTable() {
+        return makeZigZagTable<N>(typename detail::MakeIndexSequence<N * N>::type());
+    }
+
+    /**
+     * Zigzag table of the 8x8 blocks of the DCT (JPEG, ITU T.81, Figure A.6).
+     */
+    constexpr ZigZagTable<8> ZIGZAG_8X8 = makeZigZagTable<8>();
+    static_assert(
+        ZIGZAG_8X8.order[2] == 8 && ZIGZAG_8X8.order[3] == 16 && ZIGZAG_8X8.order[35] == 56 &&
+        ZIGZAG_8X8.order[61] == 55 && ZIGZAG_8X8.position[63] == 63 && ZIGZAG_8X8.position[7] == 28,
+        "wrong 8x8 zigzag table"
+    );
+
+    /**
+     * @return: the zigzag table of the N x N blocks, built at compile time.
+     */
+    template <size_t N>
+    inline const ZigZagTable<N>& getZigZagTable() {
+        static constexpr ZigZagTable<N> table = makeZigZagTable<N>();
+        return table;
+    }
+
+    /**
+     * Function that applies the zigzag scan to an N x N block. The table is a compile-time constant,
+     * so the gather has no branches, and for small blocks the compiler unrolls it into moves at fixed offsets.
+     *
+     * @param block: the N * N elements, row-major;
+     * @param scanned: the N * N elements in zigzag order (output, must not overlap block).
+     */
+    template <size_t N, typename T>
+    inline void scanBlock(const T* block, T* scanned) {
+        const ZigZagTable<N>& table = getZigZagTable<N>();
+        for (size_t k = 0; k < N * N; ++k) {
+            scanned[k] = block[table.order[k]];
+        }
+    }
+
+    /**
+     * Function that applies the inverse zigzag scan to an N x N block (see scanBlock).
+     *
+     * @param scanned: the N * N elements in zigzag order;
+     * @param block: the N * N elements, row-major (output, must not overlap scanned).
+     */
+    template <size_t N, typename T>
+    inline void inverseScanBlock(const T* scanned, T* block) {
+        const ZigZagTable<N>& table = getZigZagTable<N>();
+        for (size_t i = 0; i < N * N; ++i) {
+            block[i] = scanned[table.position[i]];
+        }
+    }
+
+    /**
+     * Zigzag permutation of a rows x cols matrix, computed once at construction
+     * and then applied to any number of matrices with those sizes.
+     */
+    class ZigZagPermutation {
+    public:
+        /**
+         * Constructor that walks the zigzag scan of the matrix and stores the row-major index of every position.
+         *
+         * @param rows: number of rows of the matrices;
+         * @param cols: number of columns of the matrices.
+         */
+        ZigZagPermutation(size_t rows, size_t cols);
+
+        [[nodiscard]] size_t getRows() const;
+        [[nodiscard]] size_t getCols() const;
+
+        /**
+         * @return: the rows * cols row-major indices, in scan order.
+         */
+        [[nodiscard]] const std::vector<uint32_t>& getOrder() const;
+
+        /**
+         * Function that applies the zigzag scan to a matrix.
+         *
+         * @param matrix: the rows * cols elements, row-major;
+         * @param scanned: the rows * cols elements in zigzag order (output, must not overlap matrix).
+         */
+        template <typename T>
+        void scan(const T* matrix, T* scanned) const {
+            const uint32_t* order = this->order.data();
+            const size_t size = this->order.size();
+            for (size_t k = 0; k < size; ++k) {
+                scanned[k] = matrix[order[k]];
+            }
+        }
+
+        /**
+         * Function that applies the inverse zigzag scan to a scanned matrix.
+         *
+         * @param scanned: the rows * cols elements in zigzag order;
+         * @param matrix: the rows * cols elements, row-major (output, must not overlap scanned).
+         */
+        template <typename T>
+        void inverse_scan(const T* scanned, T* matrix) const {
+            const uint32_t* order = this->order.data();
+            const size_t size = this->order.size();
+            for (size_t k = 0; k < size; ++k) {
+                matrix[order[k]] = scanned[k];
+            }
+        }
+
+    private:
+        size_t rows;
+        size_t cols;
+        std::vector<uint32_t> order;
+    };
+
     class ZigZagScan {
     public:
         /**
@@ -36,4 +268,4 @@ namespace sp::utils::zigzag
     };
 }
 
-#endif //ZIGZAG_SCAN_HPP
\ No newline at end of file
+#endif //ZIGZAG_SCAN_HPP
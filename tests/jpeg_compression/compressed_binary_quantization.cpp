@@ -0,0 +1,134 @@
+/**
+ * @file compressed_binary_quantization.cpp
+ * @brief Checks that a compressed binary file is decoded with the quantization matrix of the encoder:
+ *        the image reloaded from the file (whole, memory-mapped and by regions) is the same as the one
+ *        decoded directly from the compressed image, for qualities other than 50 and a custom matrix.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "signal_processing/signal_processing.hpp"
+
+using namespace sp::jpeg;
+
+static int failures = 0;
+
+static void check(const bool condition, const std::string& message) {
+    if (!condition) {
+        printf("FAILED: %s\n", message.c_str());
+        ++failures;
+    }
+}
+
+static const char* PATH = "compressed_binary_quantization_test.bin";
+
+/**
+ * Build a 48x64 image with gradients and texture, so that every coefficient is quantized.
+ */
+static Image makeImage() {
+    Plane<uint8_t> pixels(48, 64);
+    for (size_t r = 0; r < pixels.getRows(); ++r) {
+        uint8_t* row = pixels.row(r);
+        for (size_t c = 0; c < pixels.getCols(); ++c) {
+            row[c] = static_cast<uint8_t>((3 * r + 2 * c + ((r * 7 + c * 13) % 29) * 3) % 256);
+        }
+    }
+    return Image(std::move(pixels));
+}
+
+static bool samePixels(const Image& a, const Image& b) {
+    if (a.pixels.getRows() != b.pixels.getRows() || a.pixels.getCols() != b.pixels.getCols()) {
+        return false;
+    }
+    for (size_t r = 0; r < a.pixels.getRows(); ++r) {
+        if (std::memcmp(a.pixels.row(r), b.pixels.row(r), a.pixels.getCols()) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Save the compressed image, reload it in all the ways and compare the decoded pixels with the direct decode.
+ */
+static void checkRoundTrip(CompressedImage compressed, const std::string& label) {
+    const Image direct = compressed.decompress();
+    for (const bool blockIndex : {false, true}) {
+        const std::string name = label + (blockIndex ? " (indexed)" : "");
+        compressed.save_as_compressed_binary(PATH, blockIndex);
+
+        CompressedImage loaded(PATH, 2);
+        check(samePixels(loaded.decompress(), direct), name + ": decompress after reload");
+
+        CompressedImage mapped(PATH, 4);
+        const size_t rows = direct.pixels.getRows();
+        const size_t cols = direct.pixels.getCols();
+        check(samePixels(mapped.decompress_region(0, 0, cols, rows), direct), name + ": decompress_region of the image");
+
+        const Image region = mapped.decompress_region(8, 16, 24, 16);
+        bool sameRegion = true;
+        for (size_t r = 0; r < 16; ++r) {
+            sameRegion = sameRegion && std::memcmp(region.pixels.row(r), direct.pixels.row(16 + r) + 8, 24) == 0;
+        }
+        check(sameRegion, name + ": decompress_region of a rectangle");
+    }
+}
+
+int main() {
+    Image image = makeImage();
+
+    checkRoundTrip(image.compress(DCTMethod::FLOAT, 10), "quality 10");
+    checkRoundTrip(image.compress(DCTMethod::FLOAT, 90), "quality 90");
+    checkRoundTrip(image.compress(DCTMethod::ISLOW, 75), "quality 75, ISLOW");
+
+    double custom[sp::dct::algo::DCT_BLOCK_AREA];
+    for (size_t i = 0; i < sp::dct::algo::DCT_BLOCK_AREA; ++i) {
+        custom[i] = 2.5 + static_cast<double>(i % 8) * 1.75 + static_cast<double>(i / 8) * 3.0;
+    }
+    checkRoundTrip(image.compress(DCTMethod::FLOAT, custom), "custom matrix");
+
+    // the single-pass encoder writes the same file as compress(method).save_as_compressed_binary
+    {
+        const std::vector<uint8_t> binary = image.compress_to_binary(DCTMethod::FLOAT);
+        std::ofstream(PATH, std::ios::binary).write(
+            reinterpret_cast<const char*>(binary.data()), static_cast<std::streamsize>(binary.size())
+        );
+        CompressedImage loaded(PATH, 2);
+        check(samePixels(loaded.decompress(), image.compress(DCTMethod::FLOAT).decompress()), "compress_to_binary");
+    }
+
+    // a file of version 0 (no magic, no matrix) is decoded with the default matrix
+    {
+        CompressedImage compressed = image.compress(DCTMethod::FLOAT);
+        const int header[3] = {48, 64, 8};
+        std::vector<uint8_t> binary(reinterpret_cast<const uint8_t*>(header), reinterpret_cast<const uint8_t*>(header + 3));
+        int16_t block[sp::dct::algo::DCT_BLOCK_AREA];
+        uint8_t encoded[MAX_ENCODED_BLOCK_SIZE];
+        for (size_t r = 0; r < 48; r += 8) {
+            for (size_t c = 0; c < 64; c += 8) {
+                for (size_t i = 0; i < 8; ++i) {
+                    std::memcpy(block + 8 * i, compressed.compressed.row(r + i) + c, 8 * sizeof(int16_t));
+                }
+                binary.insert(binary.end(), encoded, encoded + encodeBlock(block, encoded));
+            }
+        }
+        std::ofstream(PATH, std::ios::binary).write(
+            reinterpret_cast<const char*>(binary.data()), static_cast<std::streamsize>(binary.size())
+        );
+        CompressedImage loaded(PATH, 2);
+        check(samePixels(loaded.decompress(), compressed.decompress()), "file of version 0");
+    }
+    std::remove(PATH);
+
+    if (failures > 0) {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}
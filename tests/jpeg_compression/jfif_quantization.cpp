@@ -0,0 +1,115 @@
+/**
+ * @file jfif_quantization.cpp
+ * @brief Checks the frame type and the DQT precision of the JFIF files written with 8-bit and 16-bit
+ *        quantization tables, and that both are read back unchanged.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "signal_processing/signal_processing.hpp"
+
+using namespace sp::jpeg;
+
+static int failures = 0;
+
+static void check(const bool condition, const char* message) {
+    if (!condition) {
+        printf("FAILED: %s\n", message);
+        ++failures;
+    }
+}
+
+/**
+ * Build a 16x16 grayscale image with a few non-zero coefficients per block and the given quantization.
+ */
+static JFIFImage makeImage(const double* quantization) {
+    JFIFImage image;
+    image.width = 16;
+    image.height = 16;
+    image.restartInterval = 0;
+    image.components.resize(1);
+    JFIFComponent& component = image.components[0];
+    component.coefficients = Plane<int16_t>(16, 16);
+    for (size_t r = 0; r < 16; ++r) {
+        int16_t* row = component.coefficients.row(r);
+        for (size_t c = 0; c < 16; ++c) {
+            row[c] = (r % 8 < 2 && c % 8 < 3) ? static_cast<int16_t>(r + 2 * c - 5) : 0;
+        }
+    }
+    std::copy(quantization, quantization + sp::dct::algo::DCT_BLOCK_AREA, component.quantization);
+    component.horizontalSampling = 1;
+    component.verticalSampling = 1;
+    return image;
+}
+
+/**
+ * Find the frame marker (SOF0 or SOF1) and the precision of the first DQT by walking the segments.
+ */
+static void readFrameType(const std::vector<uint8_t>& file, int& frameMarker, int& dqtPrecision) {
+    frameMarker = -1;
+    dqtPrecision = -1;
+    size_t position = 2;
+    while (position + 4 <= file.size() && file[position] == 0xFF) {
+        const uint8_t marker = file[position + 1];
+        const size_t length = (static_cast<size_t>(file[position + 2]) << 8) | file[position + 3];
+        if (marker == 0xDB && dqtPrecision < 0) {
+            dqtPrecision = file[position + 4] >> 4;
+        } else if (marker == 0xC0 || marker == 0xC1) {
+            frameMarker = marker;
+        } else if (marker == 0xDA) {
+            return;
+        }
+        position += 2 + length;
+    }
+}
+
+static void checkRoundTrip(const double* quantization, const int expectedMarker, const int expectedPrecision) {
+    const JFIFImage image = makeImage(quantization);
+    for (const bool optimizeHuffman : {false, true}) {
+        const std::vector<uint8_t> file = writeJFIF(image, optimizeHuffman);
+
+        int frameMarker, dqtPrecision;
+        readFrameType(file, frameMarker, dqtPrecision);
+        check(frameMarker == expectedMarker, "frame marker");
+        check(dqtPrecision == expectedPrecision, "DQT precision");
+
+        const JFIFImage decoded = readJFIF(file.data(), file.size());
+        check(decoded.components.size() == 1, "number of components");
+        for (size_t i = 0; i < sp::dct::algo::DCT_BLOCK_AREA; ++i) {
+            check(decoded.components[0].quantization[i] == quantization[i], "quantization entry");
+        }
+        for (size_t r = 0; r < 16; ++r) {
+            for (size_t c = 0; c < 16; ++c) {
+                check(
+                    decoded.components[0].coefficients.row(r)[c] == image.components[0].coefficients.row(r)[c],
+                    "coefficient"
+                );
+            }
+        }
+    }
+}
+
+int main() {
+    double quantization[sp::dct::algo::DCT_BLOCK_AREA];
+
+    // 8-bit table: baseline frame (SOF0) with Pq = 0
+    for (size_t i = 0; i < sp::dct::algo::DCT_BLOCK_AREA; ++i) {
+        quantization[i] = static_cast<double>(1 + 4 * i);
+    }
+    checkRoundTrip(quantization, 0xC0, 0);
+
+    // entries above 255 need Pq = 1, which is only allowed in an extended sequential frame (SOF1)
+    for (size_t i = 0; i < sp::dct::algo::DCT_BLOCK_AREA; ++i) {
+        quantization[i] = static_cast<double>(16 + 37 * i);
+    }
+    checkRoundTrip(quantization, 0xC1, 1);
+
+    if (failures > 0) {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}